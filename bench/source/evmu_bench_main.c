@@ -0,0 +1,356 @@
+/* Headless benchmark harness for the emulator core
+ *
+ * Runs a set of reference workloads in every execution mode, timing how
+ * quickly the core gets through a fixed number of emulated cycles, and
+ * reports the results as JSON for tracking regressions between releases.
+ *
+ * The public memory accessors are also timed on their own, since host code
+ * goes through them rather than the CPU's inlined fast path.
+ *
+ *   ElysianVmuBench [--frames N] [--output path]
+ */
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_cpu.h>
+#include <evmu/hw/evmu_memory.h>
+#include <evmu/hw/evmu_flash.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <gimbal/meta/instances/gimbal_context.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define EVMU_BENCH_FRAME_CYCLES_    10000   // cycles run per EvmuDevice_runUntil(), standing in for a host frame
+#define EVMU_BENCH_DEFAULT_FRAMES_  2000
+#define EVMU_BENCH_SAVE_BASE_       0x8000  // flash the save workload cycles its pages through
+#define EVMU_BENCH_SAVE_PAGES_      64
+#define EVMU_BENCH_SAVE_PAGE_SIZE_  0x80    // bytes written per BIOS fm_wrt_ex call
+
+/* Allocations are counted by having the linker route the library's calls to
+   the C allocator through here, which only GNU-style linkers can do. */
+#ifdef EVMU_BENCH_COUNT_ALLOCS
+static size_t allocations_ = 0;
+
+void* __real_malloc (size_t size);
+void* __real_calloc (size_t count, size_t size);
+void* __real_realloc(void* pPtr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    ++allocations_;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    ++allocations_;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pPtr, size_t size) {
+    ++allocations_;
+    return __real_realloc(pPtr, size);
+}
+#endif
+
+typedef struct EvmuBenchWorkload_ {
+    const char* pName;
+    const char* pDescription;
+    void        (*pFnSetup)(EvmuDevice* pDevice);
+    // Host-side work done between frames, if any
+    void        (*pFnFrame)(EvmuDevice* pDevice, size_t frame);
+} EvmuBenchWorkload_;
+
+typedef struct EvmuBenchResult_ {
+    EvmuCycles  cycles;
+    uint64_t    instructions;
+    double      seconds;
+    size_t      allocations;
+} EvmuBenchResult_;
+
+static void EvmuBench_load_(EvmuDevice* pDevice, EvmuAddress address, const EvmuWord* pBytes, size_t size) {
+    for(size_t b = 0; b < size; ++b)
+        EvmuMemory_writeProgram(pDevice->pMemory, address + b, pBytes[b]);
+}
+
+static void EvmuBench_setupCpuLoop_(EvmuDevice* pDevice) {
+    // loop: ADD #3; ST 0x11; INC 0x12; XOR 0x11; LD 0x12; BR loop
+    const EvmuWord program[] = {
+        0x81, 0x03,
+        0x12, 0x11,
+        0x62, 0x12,
+        0xf2, 0x11,
+        0x02, 0x12,
+        0x01, 0xf4
+    };
+
+    EvmuBench_load_(pDevice, 0x0000, program, sizeof(program));
+}
+
+static void EvmuBench_setupClockIdle_(EvmuDevice* pDevice) {
+    // Reset: JMPF idle
+    const EvmuWord reset[] = { 0x21, 0x02, 0x00 };
+    // Base timer ISR: JMPF isr
+    const EvmuWord vector[] = { 0x21, 0x01, 0x50 };
+    // Timer hook, as in any game: PUSH IE; CLR1 IE, 7; NOT1 EXT, 0; JMPF timer_ex; POP IE; RETI
+    const EvmuWord timerEx[] = {
+        0x61, 0x08,
+        0xdf, 0x08,
+        0xb8, 0x0d,
+        0x21, 0x01, 0x30,
+        0x71, 0x08,
+        0xb0
+    };
+    // isr: CLR1 BTCR, 1; CLR1 BTCR, 3; JMPF timer hook
+    const EvmuWord isr[] = {
+        0xd9, 0x7f,
+        0xdb, 0x7f,
+        0x21, 0x01, 0x30
+    };
+    // idle: SET1 PCON, 0; BR idle
+    const EvmuWord idle[] = {
+        0xf8, 0x07,
+        0x01, 0xfc
+    };
+
+    EvmuBench_load_(pDevice, 0x0000, reset,   sizeof(reset));
+    EvmuBench_load_(pDevice, 0x001b, vector,  sizeof(vector));
+    EvmuBench_load_(pDevice, 0x0130, timerEx, sizeof(timerEx));
+    EvmuBench_load_(pDevice, 0x0150, isr,     sizeof(isr));
+    EvmuBench_load_(pDevice, 0x0200, idle,    sizeof(idle));
+}
+
+static void EvmuBench_setupLcdDraw_(EvmuDevice* pDevice) {
+    /* MOV #0x80, R2
+       row: LD R2; XOR #0x5a; ST @R2; INC R2; LD R2; BNZ row
+       MOV #0x80, R2; LD XBNK; XOR #1; ST XBNK; BR row */
+    const EvmuWord program[] = {
+        0x22, 0x02, 0x80,
+        0x02, 0x02,
+        0xf1, 0x5a,
+        0x16,
+        0x62, 0x02,
+        0x02, 0x02,
+        0x90, 0xf5,
+        0x22, 0x02, 0x80,
+        0x03, 0x25,
+        0xf1, 0x01,
+        0x13, 0x25,
+        0x01, 0xea
+    };
+
+    EvmuBench_load_(pDevice, 0x0000, program, sizeof(program));
+}
+
+static void EvmuBench_setupFlashSave_(EvmuDevice* pDevice) {
+    /* Fills the BIOS's flash write buffer at 0x80-0xff with a new pattern each pass
+       MOV #0x80, R0
+       fill: LD R0; XOR 0x7f; ST @R0; INC R0; LD R0; BNZ fill
+       INC 0x7f; BR start */
+    const EvmuWord program[] = {
+        0x22, 0x00, 0x80,
+        0x02, 0x00,
+        0xf2, 0x7f,
+        0x14,
+        0x62, 0x00,
+        0x02, 0x00,
+        0x90, 0xf5,
+        0x62, 0x7f,
+        0x01, 0xee
+    };
+
+    EvmuBench_load_(pDevice, 0x0000, program, sizeof(program));
+}
+
+// Commits the write buffer to the next flash page once a frame, as fm_wrt_ex does for a saving game
+static void EvmuBench_frameFlashSave_(EvmuDevice* pDevice, size_t frame) {
+    EvmuWord page[EVMU_BENCH_SAVE_PAGE_SIZE_];
+    size_t   bytes = sizeof(page);
+
+    for(size_t b = 0; b < sizeof(page); ++b)
+        page[b] = EvmuMemory_viewData(pDevice->pMemory, 0x80 + b);
+
+    EvmuFlash_writeBytes(pDevice->pFlash,
+                         EVMU_BENCH_SAVE_BASE_ + (frame % EVMU_BENCH_SAVE_PAGES_) * sizeof(page),
+                         page,
+                         &bytes);
+}
+
+static const EvmuBenchWorkload_ workloads_[] = {
+    { "cpuLoop",   "Synthetic LC86K ALU and memory loop",                     EvmuBench_setupCpuLoop_,   NULL                      },
+    { "clockIdle", "HALTed between base timer ticks through the emulated BIOS", EvmuBench_setupClockIdle_, NULL                      },
+    { "lcdDraw",   "XRAM fill across both LCD banks",                         EvmuBench_setupLcdDraw_,   NULL                      },
+    { "flashSave", "Save buffer fill with a flash page written every frame",  EvmuBench_setupFlashSave_, EvmuBench_frameFlashSave_ }
+};
+
+static const struct {
+    EVMU_CPU_EXEC_MODE mode;
+    const char*        pName;
+} execModes_[] = {
+    { EVMU_CPU_EXEC_MODE_INTERPRETER, "interpreter" },
+    { EVMU_CPU_EXEC_MODE_BLOCK,       "block"       },
+#ifdef EVMU_ENABLE_JIT
+    { EVMU_CPU_EXEC_MODE_JIT,         "jit"         }
+#endif
+};
+
+static double EvmuBench_now_(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static EvmuDevice* EvmuBench_createDevice_(const EvmuBenchWorkload_* pWorkload, EVMU_CPU_EXEC_MODE mode) {
+    EvmuDevice* pDevice = EvmuDevice_createExt(EVMU_DEVICE_CREATE_NO_LOG);
+
+    EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+    pWorkload->pFnSetup(pDevice);
+    EvmuCpu_setExecMode(pDevice->pCpu, mode);
+    EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+
+    return pDevice;
+}
+
+static void EvmuBench_runFrames_(const EvmuBenchWorkload_* pWorkload, EvmuDevice* pDevice, size_t frames, EvmuCycles* pCycles) {
+    *pCycles = 0;
+
+    for(size_t f = 0; f < frames; ++f) {
+        *pCycles += EvmuDevice_runUntil(pDevice, EVMU_BENCH_FRAME_CYCLES_, EVMU_DEVICE_STOP_NONE, NULL);
+
+        if(pWorkload->pFnFrame)
+            pWorkload->pFnFrame(pDevice, f);
+    }
+}
+
+static EvmuBenchResult_ EvmuBench_run_(const EvmuBenchWorkload_* pWorkload, EVMU_CPU_EXEC_MODE mode, size_t frames) {
+    EvmuBenchResult_ result = { 0 };
+
+    /* Instructions are counted by a separate, untimed pass with profiling enabled,
+       which retires exactly the same ones, since every workload is deterministic. */
+    EvmuDevice* pDevice = EvmuBench_createDevice_(pWorkload, mode);
+
+    EvmuCpu_setProfiling(pDevice->pCpu, GBL_TRUE);
+    EvmuBench_runFrames_(pWorkload, pDevice, frames, &result.cycles);
+
+    for(size_t pc = 0; pc <= UINT16_MAX; ++pc)
+        result.instructions += EvmuCpu_profileCount(pDevice->pCpu, (EvmuPc)pc);
+
+    GBL_BOX_UNREF(pDevice);
+
+    pDevice = EvmuBench_createDevice_(pWorkload, mode);
+
+#ifdef EVMU_BENCH_COUNT_ALLOCS
+    const size_t allocations = allocations_;
+#endif
+    const double start = EvmuBench_now_();
+
+    EvmuBench_runFrames_(pWorkload, pDevice, frames, &result.cycles);
+
+    result.seconds = EvmuBench_now_() - start;
+#ifdef EVMU_BENCH_COUNT_ALLOCS
+    result.allocations = allocations_ - allocations;
+#endif
+
+    GBL_BOX_UNREF(pDevice);
+
+    return result;
+}
+
+/* Times the public EvmuMemory_readData()/writeData() pair over every RAM address,
+   which host code and the fast path's range-checked wrappers both go through. */
+static EvmuBenchResult_ EvmuBench_runMemoryApi_(size_t frames) {
+    EvmuBenchResult_ result  = { 0 };
+    EvmuDevice*      pDevice = EvmuDevice_createExt(EVMU_DEVICE_CREATE_NO_LOG);
+    EvmuWord         sum     = 0;
+
+    const double start = EvmuBench_now_();
+
+    for(size_t f = 0; f < frames; ++f) {
+        for(EvmuAddress a = EVMU_ADDRESS_SEGMENT_RAM_BASE; a <= EVMU_ADDRESS_SEGMENT_RAM_END; ++a) {
+            EvmuMemory_writeData(pDevice->pMemory, a, (EvmuWord)(a + f));
+            sum += EvmuMemory_readData(pDevice->pMemory, a);
+        }
+    }
+
+    result.seconds      = EvmuBench_now_() - start;
+    result.instructions = (uint64_t)frames * EVMU_ADDRESS_SEGMENT_RAM_SIZE * 2;
+
+    // Keeps the reads from being optimized away
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SEGMENT_RAM_BASE, sum);
+
+    GBL_BOX_UNREF(pDevice);
+
+    return result;
+}
+
+int main(int argc, char* pArgv[]) {
+    size_t      frames = EVMU_BENCH_DEFAULT_FRAMES_;
+    const char* pPath  = NULL;
+
+    for(int a = 1; a < argc; ++a) {
+        if(!strcmp(pArgv[a], "--frames") && a + 1 < argc)
+            frames = strtoul(pArgv[++a], NULL, 10);
+        else if(!strcmp(pArgv[a], "--output") && a + 1 < argc)
+            pPath = pArgv[++a];
+        else {
+            fprintf(stderr, "usage: %s [--frames N] [--output path]\n", pArgv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    FILE* pOut = pPath? fopen(pPath, "w") : stdout;
+
+    if(!pOut) {
+        fprintf(stderr, "Could not open [%s] for writing!\n", pPath);
+        return EXIT_FAILURE;
+    }
+
+    // Anything logged below an error would otherwise end up mixed in with the JSON
+    GblContext_setLogFilter(GblContext_global(), GBL_LOG_LEVEL_ERROR);
+
+    fprintf(pOut, "{\n");
+    fprintf(pOut, "  \"version\": \"%s\",\n", EVMU_VERSION);
+    fprintf(pOut, "  \"frameCycles\": %d,\n", EVMU_BENCH_FRAME_CYCLES_);
+    fprintf(pOut, "  \"frames\": %zu,\n", frames);
+
+    const EvmuBenchResult_ memoryApi = EvmuBench_runMemoryApi_(frames);
+
+    fprintf(pOut, "  \"memoryApi\": {\n");
+    fprintf(pOut, "    \"accesses\": %llu,\n",    (unsigned long long)memoryApi.instructions);
+    fprintf(pOut, "    \"seconds\": %.6f,\n",     memoryApi.seconds);
+    fprintf(pOut, "    \"nsPerAccess\": %.3f\n",
+            memoryApi.instructions? memoryApi.seconds * 1e9 / memoryApi.instructions : 0.0);
+    fprintf(pOut, "  },\n");
+    fprintf(pOut, "  \"results\": [");
+
+    for(size_t w = 0; w < sizeof(workloads_) / sizeof(workloads_[0]); ++w) {
+        for(size_t m = 0; m < sizeof(execModes_) / sizeof(execModes_[0]); ++m) {
+            const EvmuBenchResult_ result  = EvmuBench_run_(&workloads_[w], execModes_[m].mode, frames);
+            const double           seconds = result.seconds > 0.0? result.seconds : 1e-9;
+
+            fprintf(pOut, "%s\n    {\n", w || m? "," : "");
+            fprintf(pOut, "      \"workload\": \"%s\",\n",           workloads_[w].pName);
+            fprintf(pOut, "      \"description\": \"%s\",\n",        workloads_[w].pDescription);
+            fprintf(pOut, "      \"execMode\": \"%s\",\n",           execModes_[m].pName);
+            fprintf(pOut, "      \"cycles\": %llu,\n",               (unsigned long long)result.cycles);
+            fprintf(pOut, "      \"instructions\": %llu,\n",         (unsigned long long)result.instructions);
+            fprintf(pOut, "      \"seconds\": %.6f,\n",              result.seconds);
+            fprintf(pOut, "      \"emulatedMHz\": %.6f,\n",          result.cycles / seconds / 1e6);
+            fprintf(pOut, "      \"instructionsPerSec\": %.1f,\n",   result.instructions / seconds);
+            fprintf(pOut, "      \"nsPerInstruction\": %.3f,\n",
+                    result.instructions? result.seconds * 1e9 / result.instructions : 0.0);
+#ifdef EVMU_BENCH_COUNT_ALLOCS
+            fprintf(pOut, "      \"allocations\": %zu,\n",           result.allocations);
+            fprintf(pOut, "      \"allocationsPerSec\": %.1f\n",     result.allocations / seconds);
+#else
+            fprintf(pOut, "      \"allocations\": null,\n");
+            fprintf(pOut, "      \"allocationsPerSec\": null\n");
+#endif
+            fprintf(pOut, "    }");
+        }
+    }
+
+    fprintf(pOut, "\n  ]\n}\n");
+
+    if(pPath) fclose(pOut);
+
+    return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 
 #include "../types/evmu_peripheral.h"
 #include "evmu_isa.h"
+#include "evmu_pic.h"
 
 #include <gimbal/meta/signals/gimbal_signal.h>
 
@@ -45,6 +46,42 @@ GBL_FORWARD_DECLARE_STRUCT(EvmuCpu);
 //! Program counter for EvmuCpu instructions
 typedef uint16_t EvmuPc;
 
+/*! Execution strategies used by EvmuCpu when updating
+ *
+ *  Every mode produces identical architectural results for each
+ *  instruction. They only differ in how instructions are dispatched
+ *  and how often the timers and interrupt controller are stepped
+ *  alongside the CPU.
+ *
+ *  \sa EvmuCpu_setExecMode()
+ */
+GBL_DECLARE_ENUM(EVMU_CPU_EXEC_MODE) {
+    EVMU_CPU_EXEC_MODE_INTERPRETER, //!< Fetch, decode, and step peripherals after every instruction
+    EVMU_CPU_EXEC_MODE_BLOCK,       //!< Run predecoded basic blocks, stepping peripherals once per block
+    EVMU_CPU_EXEC_MODE_JIT,         //!< Run basic blocks recompiled to native code (requires EVMU_ENABLE_JIT on x86-64)
+    EVMU_CPU_EXEC_MODE_COUNT        //!< Number of execution modes
+};
+
+/*! Output formats for the results of profiling EvmuCpu
+ *
+ *  \sa EvmuCpu_writeProfile()
+ */
+GBL_DECLARE_ENUM(EVMU_CPU_PROFILE_FORMAT) {
+    EVMU_CPU_PROFILE_FORMAT_FLAT,       //!< Table of execution counts and cycles per PC, hottest first
+    EVMU_CPU_PROFILE_FORMAT_CALL_GRAPH, //!< Caller to callee edges with call counts, including ISR entries
+    EVMU_CPU_PROFILE_FORMAT_COLLAPSED,  //!< One "frame;frame;frame cycles" line per stack, for flame graph tools
+    EVMU_CPU_PROFILE_FORMAT_COUNT       //!< Number of profile formats
+};
+
+/*! Callback receiving a chunk of the execution trace, oldest PC first
+ *
+ *  \sa EvmuCpu_setTrace()
+ */
+typedef void (*EvmuCpuTraceFn)(EvmuCpu*      pCpu,
+                               const EvmuPc* pPcs,
+                               size_t        count,
+                               void*         pClosure);
+
 /*! \struct  EvmuCpuClass
  *  \extends EvmuPeripheralClass
  *  \brief   Class for Sanyo LC86k CPU core
@@ -83,7 +120,11 @@ GBL_CLASS_END
  *  you to feed in individual instructions and then query
  *  for their decoded operands and opcode. It also provides
  *  a signal for when the PC changes, which can be used to
- *  implement breakpoints and instruction tracing.
+ *  implement breakpoints, along with a batched trace of
+ *  executed PCs for instruction tracing.
+ *
+ *  \note
+ *  "pcChange" is only emitted while something is connected to it.
  *
  *  \sa EvmuCpuClass
  */
@@ -99,7 +140,9 @@ GBL_PROPERTIES(EvmuCpu,
     (opcode,   GBL_GENERIC, (READ),                    GBL_UINT8_TYPE),
     (operand1, GBL_GENERIC, (READ),                    GBL_INT32_TYPE),
     (operand2, GBL_GENERIC, (READ),                    GBL_INT32_TYPE),
-    (operand3, GBL_GENERIC, (READ),                    GBL_INT32_TYPE)
+    (operand3, GBL_GENERIC, (READ),                    GBL_INT32_TYPE),
+    (execMode, GBL_GENERIC, (READ, WRITE, LOAD, SAVE), GBL_INT32_TYPE),
+    (profiling,GBL_GENERIC, (READ, WRITE),             GBL_BOOL_TYPE)
 )
 
 GBL_SIGNALS(EvmuCpu,
@@ -120,6 +163,54 @@ EVMU_EXPORT EVMU_RESULT EvmuCpu_execute (GBL_SELF,
 
 EVMU_EXPORT EVMU_RESULT EvmuCpu_runNext (GBL_SELF)                             GBL_NOEXCEPT;
 
+EVMU_EXPORT EVMU_CPU_EXEC_MODE
+                        EvmuCpu_execMode(GBL_CSELF)                            GBL_NOEXCEPT;
+EVMU_EXPORT EVMU_RESULT EvmuCpu_setExecMode
+                                        (GBL_SELF, EVMU_CPU_EXEC_MODE mode)    GBL_NOEXCEPT;
+
+/*! \name  Profiling
+ *  \brief Methods for finding where a program spends its cycles
+ *
+ *  While enabled, every instruction the CPU retires is attributed
+ *  to its PC and to the function or ISR it ran within. Results are
+ *  kept when profiling is disabled, until they are cleared. When it
+ *  has never been enabled, profiling costs nothing.
+ *  @{
+ */
+EVMU_EXPORT GblBool     EvmuCpu_profiling       (GBL_CSELF)                       GBL_NOEXCEPT;
+EVMU_EXPORT EVMU_RESULT EvmuCpu_setProfiling    (GBL_SELF, GblBool enabled)       GBL_NOEXCEPT;
+EVMU_EXPORT void        EvmuCpu_clearProfile    (GBL_SELF)                        GBL_NOEXCEPT;
+
+EVMU_EXPORT uint64_t    EvmuCpu_profileCount    (GBL_CSELF, EvmuPc pc)            GBL_NOEXCEPT;
+EVMU_EXPORT EvmuCycles  EvmuCpu_profileCycles   (GBL_CSELF, EvmuPc pc)            GBL_NOEXCEPT;
+EVMU_EXPORT EvmuCycles  EvmuCpu_profileIrqCycles(GBL_CSELF, EVMU_IRQ irq)         GBL_NOEXCEPT;
+
+EVMU_EXPORT EVMU_RESULT EvmuCpu_writeProfile    (GBL_CSELF,
+                                                 EVMU_CPU_PROFILE_FORMAT format,
+                                                 GblStringBuffer*        pBuffer) GBL_NOEXCEPT;
+//! @}
+
+/*! \name  Tracing
+ *  \brief Methods for recording the PC of every executed instruction
+ *
+ *  Executed PCs are recorded into a ring buffer of the given capacity.
+ *  With a flush callback, it is handed each full buffer at a time,
+ *  rather than being notified per instruction. Without one, the ring
+ *  simply keeps the most recent history, which can be read back with
+ *  EvmuCpu_trace(). A capacity of 0 disables tracing.
+ *  @{
+ */
+EVMU_EXPORT EVMU_RESULT EvmuCpu_setTrace        (GBL_SELF,
+                                                 size_t         capacity,
+                                                 EvmuCpuTraceFn pFnFlush,
+                                                 void*          pClosure) GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuCpu_traceCapacity   (GBL_CSELF)                   GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuCpu_trace           (GBL_CSELF,
+                                                 EvmuPc* pPcs,
+                                                 size_t  count)               GBL_NOEXCEPT;
+EVMU_EXPORT void        EvmuCpu_flushTrace      (GBL_SELF)                    GBL_NOEXCEPT;
+//! @}
+
 EVMU_EXPORT double      EvmuCpu_secsPerInstruction
                                         (GBL_CSELF)                            GBL_NOEXCEPT;
 EVMU_EXPORT size_t      EvmuCpu_cyclesPerInstruction
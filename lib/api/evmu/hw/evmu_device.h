@@ -41,6 +41,36 @@
 
 GBL_DECLS_BEGIN
 
+/*! Conditions which can end EvmuDevice_runUntil() before its cycle budget
+ *
+ *  Values are bit flags which may be OR'd together into an EvmuStopMask.
+ *
+ *  \sa EvmuDevice_runUntil()
+ */
+GBL_DECLARE_ENUM(EVMU_DEVICE_STOP) {
+    EVMU_DEVICE_STOP_NONE  = 0x0,   //!< Run for the full cycle budget
+    EVMU_DEVICE_STOP_IRQ   = 0x1,   //!< An interrupt was accepted, which also wakes the CPU from HALT
+    EVMU_DEVICE_STOP_HALT  = 0x2,   //!< The CPU entered HALT mode
+    EVMU_DEVICE_STOP_EVENT = 0x4,   //!< A scheduled peripheral event (base timer tick or LCD refresh) fired
+    EVMU_DEVICE_STOP_ERROR = 0x8    //!< An instruction failed to execute, which always ends the run
+};
+
+//! Bitwise combination of EVMU_DEVICE_STOP flags
+typedef uint8_t EvmuStopMask;
+
+/*! Options for constructing an EvmuDevice with EvmuDevice_createExt()
+ *
+ *  Values are bit flags which may be OR'd together.
+ *
+ *  \sa EvmuDevice_createExt()
+ */
+GBL_DECLARE_ENUM(EVMU_DEVICE_CREATE) {
+    EVMU_DEVICE_CREATE_DEFAULT   = 0x0, //!< Format flash and log the result, allocating every buffer separately
+    EVMU_DEVICE_CREATE_NO_FORMAT = 0x1, //!< Leave flash zeroed rather than formatting it, for when an image is about to be loaded
+    EVMU_DEVICE_CREATE_NO_LOG    = 0x2, //!< Skip logging the root block, FAT, and directory after formatting
+    EVMU_DEVICE_CREATE_ARENA     = 0x4  //!< Carve the BIOS image and CPU block cache out of one allocation with the device
+};
+
 /*! \struct     EvmuDeviceClass
  *  \extends    GblObjectClass
  *  \implements EvmuIBehaviorClass
@@ -61,6 +91,17 @@ GBL_CLASS_DERIVE_EMPTY(EvmuDevice, GblObject, EvmuIBehavior)
  *  components are accessible as EvmuPeripherals attached
  *  to the device.
  *
+ *  \par Thread Safety
+ *  Distinct devices share no emulation state, so each may be
+ *  updated, run, or otherwise driven from its own thread at the
+ *  same time. Types register themselves safely upon first use
+ *  from any thread, and errors raised while stepping are recorded
+ *  within the call record of the thread doing the stepping. A
+ *  single device must only be used by one thread at a time, and
+ *  signal connections should be made while its thread isn't
+ *  stepping it. See EvmuEmulator_update() for stepping many at
+ *  once.
+ *
  *  \sa EvmuDeviceClass
  */
 GBL_INSTANCE_DERIVE(EvmuDevice, GblObject)
@@ -117,6 +158,21 @@ EVMU_EXPORT GblType         EvmuDevice_type             (void)
  */
 EVMU_EXPORT EvmuDevice*     EvmuDevice_create           (void)                         GBL_NOEXCEPT;
 
+/*! Creates a new EvmuDevice with refCount of 1, using the given EVMU_DEVICE_CREATE flags
+ *  \relatesalso EvmuDevice
+ *
+ *  Meant for spinning up many devices at once, such as in tests or
+ *  batch runs, where formatting and logging flash for each one
+ *  dominates startup. With EVMU_DEVICE_CREATE_NO_FORMAT, flash is
+ *  left blank until an image is loaded or the BIOS formats it.
+ *
+ *  \param flags        bitwise combination of EVMU_DEVICE_CREATE values
+ *  \returns            EvmuDevice pointer, or NULL upon failure
+ *
+ *  \sa EvmuDevice_create, EvmuDevice_clone
+ */
+EVMU_EXPORT EvmuDevice*     EvmuDevice_createExt        (GblFlags flags)               GBL_NOEXCEPT;
+
 /*! Unreferences an EvmuDevice
  *  \relatesalso EvmuDevice
  *
@@ -129,6 +185,24 @@ EVMU_EXPORT EvmuDevice*     EvmuDevice_create           (void)
  */
 EVMU_EXPORT GblRefCount     EvmuDevice_unref            (GBL_SELF)                     GBL_NOEXCEPT;
 
+/*! Creates a copy of a running EvmuDevice, with refCount of 1
+ *  \relatesalso EvmuDevice
+ *
+ *  The copy picks up from exactly where the source is, with its own
+ *  memory, flash, and peripheral state, and runs independently from
+ *  then on. Nothing is formatted or reset along the way, and the BIOS
+ *  image is shared between the two until either one loads or writes
+ *  to it, so forking a device costs little more than copying its flash.
+ *
+ *  Like save states, memory handlers, signal connections, and CPU
+ *  profiling and tracing are left behind.
+ *
+ *  \returns            EvmuDevice pointer, or NULL upon failure
+ *
+ *  \sa EvmuDevice_create, EvmuDevice_saveState
+ */
+EVMU_EXPORT EvmuDevice*     EvmuDevice_clone            (GBL_CSELF)                    GBL_NOEXCEPT;
+
 /*! Returns the number of EvmuPeripheral components attached to the device
  *  \relatesalso EvmuDevice
  *
@@ -152,6 +226,94 @@ EVMU_EXPORT EvmuPeripheral* EvmuDevice_findPeripheral   (GBL_CSELF, const char*
  */
 EVMU_EXPORT EvmuPeripheral* EvmuDevice_peripheral       (GBL_CSELF, size_t index)      GBL_NOEXCEPT;
 
+/*! Runs the device for up to the given number of CPU cycles or until a stop condition
+ *  \relatesalso EvmuDevice
+ *
+ *  While the CPU is in HALT mode, nothing but the timers, the base timer, and
+ *  scheduled peripheral events can change state, so rather than stepping cycle by
+ *  cycle, the device skips straight to whichever of them fires next. Gamepad input
+ *  only changes between calls, so it is polled once, up-front.
+ *
+ *  \param maxCycles    upper bound on the number of CPU cycles to run
+ *  \param stopMask     EVMU_DEVICE_STOP flags which end the run early
+ *  \param pReason      optional output for the stop condition(s) hit, or EVMU_DEVICE_STOP_NONE,
+ *                      with EVMU_DEVICE_STOP_ERROR set whether or not it was in stopMask
+ *  \returns            number of CPU cycles actually run
+ *
+ *  \sa EvmuIBehavior_update()
+ */
+EVMU_EXPORT EvmuCycles      EvmuDevice_runUntil         (GBL_SELF,
+                                                         EvmuCycles    maxCycles,
+                                                         EvmuStopMask  stopMask,
+                                                         EvmuStopMask* pReason)        GBL_NOEXCEPT;
+
+/*! \name  Save States
+ *  \brief Methods for capturing and restoring the full emulation state
+ *
+ *  A save state is a compact, versioned binary snapshot of everything
+ *  needed to resume emulation from the exact same point: memory, the
+ *  program memory selection, CPU, timers, interrupts, LCD, buzzer,
+ *  clock signals, flash, gamepad inputs, and the device's timeline.
+ *  States are written to and read from caller-provided memory, without
+ *  any allocation, so rolling back is cheap enough to do every frame.
+ *
+ *  The loaded BIOS image, memory handlers, signal connections, and
+ *  CPU profiling and tracing are considered part of the host rather
+ *  than the emulated hardware, so they are left as they are.
+ *  @{
+ */
+#define EVMU_DEVICE_STATE_VERSION   1   //!< Format version written by EvmuDevice_saveState()
+
+/*! Returns the number of bytes EvmuDevice_saveState() writes for the device
+ *  \relatesalso EvmuDevice
+ */
+EVMU_EXPORT size_t          EvmuDevice_stateSize        (GBL_CSELF)                    GBL_NOEXCEPT;
+
+/*! Writes the device's save state into the given buffer
+ *  \relatesalso EvmuDevice
+ *
+ *  \param pBuffer      destination, at least EvmuDevice_stateSize() bytes
+ *  \param size         size of the destination buffer
+ *  \returns            GBL_RESULT_ERROR_OUT_OF_RANGE if the buffer is too small
+ *
+ *  \sa EvmuDevice_loadState()
+ */
+EVMU_EXPORT EVMU_RESULT     EvmuDevice_saveState        (GBL_CSELF,
+                                                         void*  pBuffer,
+                                                         size_t size)                  GBL_NOEXCEPT;
+
+/*! Restores the device to a save state written by EvmuDevice_saveState()
+ *  \relatesalso EvmuDevice
+ *
+ *  The whole state is validated before anything is applied, so the
+ *  device is left untouched if it turns out to be malformed or from
+ *  an unsupported version.
+ *
+ *  \param pBuffer      save state to restore
+ *  \param size         size of the save state, in bytes
+ *  \returns            GBL_RESULT_ERROR_INVALID_ARG if the state is malformed or unsupported
+ *
+ *  \sa EvmuDevice_saveState()
+ */
+EVMU_EXPORT EVMU_RESULT     EvmuDevice_loadState        (GBL_SELF,
+                                                         const void* pBuffer,
+                                                         size_t      size)             GBL_NOEXCEPT;
+
+/*! Returns a hash of the device's RAM, SFRs, XRAM, and program counter
+ *  \relatesalso EvmuDevice
+ *
+ *  Meant for telling at a glance whether two devices, or one device at
+ *  two points in time, have wound up in the same state. Each 64-bit
+ *  word of memory contributes independently, so only the words which
+ *  changed since the previous call are rehashed. Query it between
+ *  EvmuDevice_runUntil() calls to check every instruction boundary.
+ *
+ *  \note The first call allocates a 1KB copy of the hashed memory.
+ *
+ *  \sa EvmuJournal_bisect()
+ */
+EVMU_EXPORT uint64_t        EvmuDevice_stateHash        (GBL_SELF)                     GBL_NOEXCEPT;
+//! @}
 
 GBL_DECLS_END
 
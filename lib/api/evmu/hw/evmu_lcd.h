@@ -44,6 +44,7 @@
 #define EVMU_LCD_PIXEL_WIDTH    48  //!< Screen resolution (width/rows)
 #define EVMU_LCD_PIXEL_HEIGHT   32  //!< Screen resolution (height/columns)
 #define EVMU_LCD_ICON_COUNT     4   //!< Number of icons
+#define EVMU_LCD_ICON_ROWS      8   //!< Rows of icons drawn beneath the screen by EVMU_LCD_FORMAT_ICONS
 //! @}
 
 /*! \name  Emulator Settings
@@ -83,6 +84,15 @@ GBL_DECLARE_FLAGS(EVMU_LCD_ICONS) {
     EVMU_LCD_ICONS_ALL   = 0xf  //!< All Icons
 };
 
+//! Pixel formats for EvmuLcd_copyFramebuffer()
+GBL_DECLARE_ENUM(EVMU_LCD_FORMAT) {
+    EVMU_LCD_FORMAT_1BPP,           //!< Raw pixels as scrolled by STAD, 8 per byte with the leftmost in the MSB, set for black
+    EVMU_LCD_FORMAT_GRAY8,          //!< EvmuLcd_decoratedPixel() as one byte per pixel
+    EVMU_LCD_FORMAT_RGBA8888,       //!< EvmuLcd_decoratedPixel() as opaque gray R, G, B, and A bytes
+    EVMU_LCD_FORMAT_COUNT,          //!< Number of pixel formats
+    EVMU_LCD_FORMAT_ICONS  = 0x100  //!< OR'd into a format to append EVMU_LCD_ICON_ROWS rows with the active icons
+};
+
 /*! \struct  EvmuLcdClass
  *  \extends EvmuPeripheralClass
  *  \brief   GblClass for EvmuLcd
@@ -181,6 +191,40 @@ EVMU_EXPORT EVMU_LCD_ICONS
 EVMU_EXPORT GblBool EvmuLcd_pixel          (GBL_CSELF, size_t row, size_t col) GBL_NOEXCEPT;
 //! Retrieves the decorated pixel value for the given screen coordinate, with all effects enabled
 EVMU_EXPORT uint8_t EvmuLcd_decoratedPixel (GBL_CSELF, size_t row, size_t col) GBL_NOEXCEPT;
+//! Writes EvmuLcd_decoratedPixel() for the whole screen, row by row, into EVMU_LCD_PIXEL_WIDTH * EVMU_LCD_PIXEL_HEIGHT bytes
+EVMU_EXPORT void    EvmuLcd_decoratedFrame (GBL_CSELF, uint8_t* pPixels)     GBL_NOEXCEPT;
+
+/*! Converts the whole screen into the given pixel format in one call
+ *
+ *  Rows are written top to bottom, \p stride bytes apart, or tightly
+ *  packed if it's 0, starting from the row STAD scrolls to the top.
+ *  Decorated formats apply ghosting, filtering, and color inversion as
+ *  currently configured, with icons drawn black on white to match.
+ *  This is for converting a screen on demand, from the emulation
+ *  thread; other threads follow the screen with EvmuLcd_acquireFrame().
+ *
+ *  \param format  EVMU_LCD_FORMAT, optionally OR'd with EVMU_LCD_FORMAT_ICONS
+ *  \param pDst    buffer with room for EVMU_LCD_PIXEL_HEIGHT rows, plus EVMU_LCD_ICON_ROWS with icons
+ *  \param stride  bytes from the start of one row to the next, or 0
+ */
+EVMU_EXPORT EVMU_RESULT EvmuLcd_copyFramebuffer (GBL_CSELF,
+                                                 EVMU_LCD_FORMAT format,
+                                                 void*           pDst,
+                                                 size_t          stride) GBL_NOEXCEPT;
+
+/*! Returns the latest frame published by the emulation thread, without blocking or copying
+ *
+ *  Frames are what EvmuLcd_copyFramebuffer() writes for a tightly
+ *  packed EVMU_LCD_FORMAT_GRAY8 screen, triple buffered so that
+ *  the emulation thread never waits on the reader, nor overwrites the
+ *  frame it holds. The first call starts the LCD publishing a frame on
+ *  every refresh which changes the screen, returning NULL until one has
+ *  been. Each frame stays valid and unchanged until the next call, and
+ *  only one thread may acquire frames from an LCD at a time.
+ */
+EVMU_EXPORT const uint8_t* EvmuLcd_acquireFrame (GBL_SELF) GBL_NOEXCEPT;
+//! Renders and publishes the current screen from the emulation thread, as refreshes do, such as after changing effects
+EVMU_EXPORT void           EvmuLcd_publishFrame (GBL_SELF) GBL_NOEXCEPT;
 //! @}
 
 /*! \name Display Rendering
@@ -194,6 +238,32 @@ EVMU_EXPORT void EvmuLcd_setIcons (GBL_SELF, EVMU_LCD_ICONS icons)
 EVMU_EXPORT void EvmuLcd_setPixel (GBL_SELF, size_t row, size_t col, GblBool enabled) GBL_NOEXCEPT;
 //! @}
 
+/*! \name  Frame Hashing
+ *  \brief Methods for logging hashes of frames rather than drawing them
+ *
+ *  While hash logging, each refresh only hashes the XRAM visible on the
+ *  screen, as scrolled, along with the icons and whether the screen is
+ *  on, then appends it to an in-memory log. No ghosting or pixel buffer
+ *  work is done, and screen refreshes aren't signaled. XRAM is only
+ *  rehashed after being written, so static screens cost next to nothing.
+ *  Comparing the log against a golden one makes for fast headless
+ *  regression runs.
+ *  \relatesalso EvmuLcd
+ *  @{
+ */
+EVMU_EXPORT GblBool         EvmuLcd_hashLogging    (GBL_CSELF)                GBL_NOEXCEPT;
+EVMU_EXPORT void            EvmuLcd_setHashLogging (GBL_SELF, GblBool enabled) GBL_NOEXCEPT;
+EVMU_EXPORT void            EvmuLcd_clearHashLog   (GBL_SELF)                 GBL_NOEXCEPT;
+//! Returns the hash of every frame logged so far, oldest first, writing how many to \p pCount
+EVMU_EXPORT const uint64_t* EvmuLcd_hashLog        (GBL_CSELF, size_t* pCount) GBL_NOEXCEPT;
+//! Returns the first frame differing from a golden log, where the shorter one ends, or GBL_NPOS if they match
+EVMU_EXPORT size_t          EvmuLcd_compareHashLog (GBL_CSELF,
+                                                    const uint64_t* pGolden,
+                                                    size_t          count)    GBL_NOEXCEPT;
+//! Returns the hash of what's on the screen right now, as would be logged
+EVMU_EXPORT uint64_t        EvmuLcd_frameHash      (GBL_CSELF)                GBL_NOEXCEPT;
+//! @}
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
@@ -53,6 +53,27 @@ GBL_DECLARE_ENUM(EVMU_MEMORY_EXT_SRC) {
     EVMU_MEMORY_EXT_SRC_FLASH_BANK_1 = EVMU_SFR_EXT_FLASH_BANK_1
 };
 
+//! Callback which services a read from a handled internal address
+typedef EvmuWord    (*EvmuMemoryReadFn) (EvmuMemory* pMemory, EvmuAddress address, void* pClosure);
+//! Callback which services a write to a handled internal address, including storing the value
+typedef EVMU_RESULT (*EvmuMemoryWriteFn)(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure);
+
+/*! Read and write handlers for a single internal bus address
+ *
+ *  Every address in the 512-byte internal address space (RAM,
+ *  SFRs, XRAM) has an entry in a dispatch table. Addresses without
+ *  side-effects have direct handlers and are accessed straight
+ *  through the current bank map. Peripherals install handlers for
+ *  the registers they implement with EvmuMemory_setHandler().
+ *
+ *  \sa EvmuMemory_setHandler()
+ */
+typedef struct EvmuMemoryHandler {
+    EvmuMemoryReadFn  pFnRead;  //!< Services reads of the address
+    EvmuMemoryWriteFn pFnWrite; //!< Services writes of the address, in place of storing it
+    void*             pClosure; //!< Userdata passed back to both callbacks
+} EvmuMemoryHandler;
+
 /*! \struct  EvmuMemoryClass
  *  \extends EvmuPeripheralclass
  *  \brief   GblClass structure for EvmuPeripheral
@@ -141,6 +162,16 @@ EVMU_EXPORT EVMU_RESULT EvmuMemory_writeDataLatch    (GBL_SELF,
                                                   EvmuAddress address,
                                                   EvmuWord    value)           GBL_NOEXCEPT;
 
+/* Installs the handler for an internal address, optionally returning the one it replaces,
+   so that it can be chained to. Passing NULL restores direct access. */
+EVMU_EXPORT EVMU_RESULT EvmuMemory_setHandler    (GBL_SELF,
+                                                  EvmuAddress              address,
+                                                  const EvmuMemoryHandler* pHandler,
+                                                  EvmuMemoryHandler*       pPrevious) GBL_NOEXCEPT;
+
+EVMU_EXPORT EvmuMemoryHandler
+                        EvmuMemory_handler       (GBL_CSELF, EvmuAddress addr) GBL_NOEXCEPT;
+
 // External addres space (ROM/Flash)
 EVMU_EXPORT EvmuWord    EvmuMemory_readProgram      (GBL_CSELF, EvmuAddress addr) GBL_NOEXCEPT;
 
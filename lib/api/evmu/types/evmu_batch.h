@@ -0,0 +1,99 @@
+/*! \file
+ *  \brief EvmuBatch lockstep execution of many devices
+ *
+ *  This file provides everything pertaining to the public
+ *  API of the EvmuBatch module.
+ *
+ *  \author    2023 Falco Girgis
+ *  \copyright MIT License
+*/
+#ifndef EVMU_BATCH_H
+#define EVMU_BATCH_H
+
+#include "evmu_ibehavior.h"
+
+/*! \name  Type System
+ *  \brief Type UUID and cast operators
+ *  @{
+ */
+#define EVMU_BATCH_TYPE                 (GBL_TYPEOF(EvmuBatch))                       //!< Type UUID for EvmuBatch
+#define EVMU_BATCH(instance)            (GBL_INSTANCE_CAST(instance, EvmuBatch))      //!< Function-style GblInstance cast
+#define EVMU_BATCH_CLASS(klass)         (GBL_CLASS_CAST(klass, EvmuBatch))            //!< Function-style GblClass cast
+#define EVMU_BATCH_GET_CLASS(instance)  (GBL_INSTANCE_GET_CLASS(instance, EvmuBatch)) //!< Get EvmuBatchClass from GblInstance
+//! @}
+
+#define GBL_SELF_TYPE   EvmuBatch
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(EvmuDevice);
+
+//! Counters gathered across every EvmuBatch_update() since the last EvmuBatch_clearStats()
+typedef struct EvmuBatchStats {
+    uint64_t instructions;  //!< Instructions executed across every lane
+    uint64_t groups;        //!< Lockstep groups formed, one per distinct (bank, PC) per step
+    uint64_t sharedDecodes; //!< Instructions executed from a decode fetched by another lane
+    uint64_t divergences;   //!< Times a group's lanes ended up at more than one PC
+} EvmuBatchStats;
+
+/*! \struct     EvmuBatchClass
+ *  \extends    GblObjectClass
+ *  \implements EvmuIBehaviorClass
+ *  \brief      GblClass structure for EvmuBatch
+ *
+ *  No public methods
+ *
+ *  \sa EvmuBatch
+ */
+GBL_CLASS_DERIVE_EMPTY(EvmuBatch, GblObject, EvmuIBehavior)
+
+/*! \struct     EvmuBatch
+ *  \extends    GblObject
+ *  \implements EvmuIBehavior
+ *  \brief      Lockstep runner for many copies of one program
+ *
+ *  EvmuBatch steps every EvmuDevice it holds (its lanes) by the
+ *  same amount of time, one instruction per lane at a time. It
+ *  is meant for fuzzing and input searches, where many devices
+ *  run the same program and only differ in their inputs.
+ *
+ *  Each step, the lanes about to execute from the same bank and
+ *  PC form a group. The instruction is fetched and decoded once
+ *  for the whole group, then executed on each lane. When lanes
+ *  branch different ways, they simply land in different groups
+ *  on the next step, and rejoin whenever they meet again.
+ *
+ *  Every lane is executed by its own EvmuCpu, so results are
+ *  identical to updating each device on its own with
+ *  EVMU_CPU_EXEC_MODE_INTERPRETER. Lanes overriding
+ *  EvmuCpuClass's fetch, decode, or runNext still have them
+ *  called, never sharing a decode with another lane.
+ *
+ *  A lane whose instruction fails stops where it failed for the
+ *  rest of the update, while the others carry on to its end.
+ *  EvmuBatch_update() then returns the first failure in lane order.
+ *
+ *  \sa EvmuBatchClass
+ */
+GBL_INSTANCE_DERIVE_EMPTY(EvmuBatch, GblObject)
+
+EVMU_EXPORT GblType     EvmuBatch_type      (void)                          GBL_NOEXCEPT;
+
+EVMU_EXPORT EvmuBatch*  EvmuBatch_create    (void)                          GBL_NOEXCEPT;
+EVMU_EXPORT GblRefCount EvmuBatch_unref     (GBL_SELF)                      GBL_NOEXCEPT;
+
+EVMU_EXPORT EVMU_RESULT EvmuBatch_addLane   (GBL_SELF, EvmuDevice* pDevice) GBL_NOEXCEPT;
+EVMU_EXPORT EVMU_RESULT EvmuBatch_removeLane(GBL_SELF, EvmuDevice* pDevice) GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuBatch_laneCount (GBL_CSELF)                     GBL_NOEXCEPT;
+EVMU_EXPORT EvmuDevice* EvmuBatch_lane      (GBL_CSELF, size_t index)       GBL_NOEXCEPT;
+
+EVMU_EXPORT EVMU_RESULT EvmuBatch_update    (GBL_SELF, EvmuTicks ticks)     GBL_NOEXCEPT;
+
+EVMU_EXPORT void        EvmuBatch_stats     (GBL_CSELF, EvmuBatchStats* pStats) GBL_NOEXCEPT;
+EVMU_EXPORT void        EvmuBatch_clearStats(GBL_SELF)                      GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // EVMU_BATCH_H
@@ -61,6 +61,16 @@ GBL_CLASS_DERIVE_EMPTY(EvmuEmulator, GblModule, EvmuIBehavior)
  *  EvmuEmulator is a top-level module object for the
  *  emulation core.
  *
+ *  Updating it steps every EvmuDevice it holds by the same
+ *  amount of time. Devices share no state, so they're stepped
+ *  concurrently on a pool of worker threads, with the update
+ *  returning once every one of them has finished. A device is
+ *  only ever touched by one thread during an update.
+ *  EvmuEmulator_setThreadCount() caps how many threads are used,
+ *  with 0 meaning one per core and 1 stepping every device on the
+ *  calling thread. Any other EvmuIBehavior children, such as an
+ *  EvmuBatch, are then updated in order on the calling thread.
+ *
  *  \sa EvmuEmulatorClass
  */
 GBL_INSTANCE_DERIVE_EMPTY(EvmuEmulator, GblModule)
@@ -79,6 +89,10 @@ EVMU_EXPORT GblBool       EvmuEmulator_foreachDevice (GBL_CSELF,
                                                       EvmuEmulatorIterFn pFnIt,
                                                       void*              pClosure)   GBL_NOEXCEPT;
 
+EVMU_EXPORT EVMU_RESULT   EvmuEmulator_update        (GBL_SELF, EvmuTicks ticks)     GBL_NOEXCEPT;
+EVMU_EXPORT size_t        EvmuEmulator_threadCount   (GBL_CSELF)                     GBL_NOEXCEPT;
+EVMU_EXPORT EVMU_RESULT   EvmuEmulator_setThreadCount(GBL_SELF, size_t count)        GBL_NOEXCEPT;
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
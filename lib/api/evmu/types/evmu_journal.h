@@ -0,0 +1,159 @@
+/*! \file
+ *  \brief EvmuJournal recorder and player of a device's external inputs
+ *
+ *  This file provides everything pertaining to the public
+ *  API of the EvmuJournal module.
+ *
+ *  \author    2023 Falco Girgis
+ *  \copyright MIT License
+*/
+#ifndef EVMU_JOURNAL_H
+#define EVMU_JOURNAL_H
+
+#include "evmu_typedefs.h"
+#include "../hw/evmu_cpu.h"
+#include <gimbal/meta/instances/gimbal_object.h>
+
+/*! \name  Type System
+ *  \brief Type UUID and cast operators
+ *  @{
+ */
+#define EVMU_JOURNAL_TYPE                (GBL_TYPEOF(EvmuJournal))                        //!< Type UUID for EvmuJournal
+#define EVMU_JOURNAL(instance)           (GBL_INSTANCE_CAST(instance, EvmuJournal))       //!< Function-style GblInstance cast
+#define EVMU_JOURNAL_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuJournal))             //!< Function-style GblClass cast
+#define EVMU_JOURNAL_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuJournal))  //!< Get EvmuJournalClass from GblInstance
+//! @}
+
+#define EVMU_JOURNAL_VERSION    2   //!< Format version written by EvmuJournal_save()
+
+#define GBL_SELF_TYPE   EvmuJournal
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(EvmuDevice);
+
+//! What an EvmuJournal is currently doing with its device
+GBL_DECLARE_ENUM(EVMU_JOURNAL_MODE) {
+    EVMU_JOURNAL_MODE_IDLE,         //!< Holding on to whatever was last recorded or loaded
+    EVMU_JOURNAL_MODE_RECORDING,    //!< Appending every external input the device receives
+    EVMU_JOURNAL_MODE_REPLAYING     //!< Feeding recorded inputs back to the device
+};
+
+//! Kinds of external input held by an EvmuJournal
+GBL_DECLARE_ENUM(EVMU_JOURNAL_EVENT) {
+    EVMU_JOURNAL_EVENT_UPDATE,      //!< EvmuIBehavior_update() on the device, with its tick delta
+    EVMU_JOURNAL_EVENT_RUN,         //!< EvmuDevice_runUntil(), with its cycle budget and stop mask
+    EVMU_JOURNAL_EVENT_RESET,       //!< EvmuIBehavior_reset() on the device
+    EVMU_JOURNAL_EVENT_BUTTONS,     //!< Buttons seen by a gamepad poll changed
+    EVMU_JOURNAL_EVENT_DATE_TIME,   //!< EvmuRom_setDateTime(), including the host clock read upon reset
+    EVMU_JOURNAL_EVENT_COUNT        //!< Number of event kinds
+};
+
+#define EVMU_JOURNAL_ADDRESS_NONE   UINT32_MAX  //!< EvmuJournalDivergence::address when memory still matched
+
+//! Where two devices replaying the same journal first stopped matching, from EvmuJournal_bisect()
+typedef struct EvmuJournalDivergence {
+    GblBool     diverged;   //!< Whether the devices ever stopped matching at all
+    size_t      event;      //!< Index of the event being replayed when they did
+    size_t      step;       //!< Instructions into the event, or 0 if the event itself did it
+    EvmuTicks   time;       //!< Master time before the diverging step
+    EvmuPc      pc;         //!< Instruction both devices were about to execute
+    EvmuPc      pcAfter[2]; //!< Where the journal's device and the other device each went next
+    EvmuAddress address;    //!< First internal bus address which differs afterwards, or EVMU_JOURNAL_ADDRESS_NONE
+    uint8_t     bank;       //!< RAM or XRAM bank of the address
+} EvmuJournalDivergence;
+
+/*! \struct     EvmuJournalClass
+ *  \extends    GblObjectClass
+ *  \brief      GblClass structure for EvmuJournal
+ *
+ *  No public methods
+ *
+ *  \sa EvmuJournal
+ */
+GBL_CLASS_DERIVE_EMPTY(EvmuJournal, GblObject)
+
+/*! \struct     EvmuJournal
+ *  \extends    GblObject
+ *  \brief      Records a session's external inputs to reproduce it bit-exactly
+ *
+ *  Everything which reaches a device from outside of the emulated
+ *  hardware is journaled while recording: updates and their tick
+ *  deltas, whether given to the device or to an EvmuBatch it's a lane
+ *  of, EvmuDevice_runUntil() calls, resets, changes to the buttons
+ *  seen by each gamepad poll, and the date and time given to the BIOS.
+ *  Each event is stamped with the device's master time, which only ever
+ *  advances by whole CPU cycles, along with a save state of where the
+ *  recording began.
+ *
+ *  Replaying restores that save state and feeds every event back in
+ *  order, with input back-ends overridden by the recorded buttons. A
+ *  replay which finds an event at a different time than it was
+ *  recorded, meaning the core's behavior has changed, stops and fails.
+ *
+ *  Calls made on the peripherals directly, rather than the device, are
+ *  not journaled. Only one EvmuJournal may be attached to a device.
+ *
+ *  \sa EvmuJournalClass, EvmuDevice_saveState()
+ */
+GBL_INSTANCE_DERIVE_EMPTY(EvmuJournal, GblObject)
+
+EVMU_EXPORT GblType     EvmuJournal_type     (void)                           GBL_NOEXCEPT;
+
+EVMU_EXPORT EvmuJournal* EvmuJournal_create  (EvmuDevice* pDevice)            GBL_NOEXCEPT;
+EVMU_EXPORT GblRefCount EvmuJournal_unref    (GBL_SELF)                       GBL_NOEXCEPT;
+
+EVMU_EXPORT EvmuDevice* EvmuJournal_device   (GBL_CSELF)                      GBL_NOEXCEPT;
+EVMU_EXPORT EVMU_JOURNAL_MODE
+                        EvmuJournal_mode     (GBL_CSELF)                      GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuJournal_count    (GBL_CSELF)                      GBL_NOEXCEPT;
+//! Returns the kind of the event at the given index, or EVMU_JOURNAL_EVENT_COUNT if out of range
+EVMU_EXPORT EVMU_JOURNAL_EVENT
+                        EvmuJournal_event    (GBL_CSELF, size_t index)        GBL_NOEXCEPT;
+
+//! Discards anything held, snapshots the device, and starts journaling from there
+EVMU_EXPORT EVMU_RESULT EvmuJournal_record   (GBL_SELF)                       GBL_NOEXCEPT;
+//! Stops recording, keeping everything journaled so far
+EVMU_EXPORT EVMU_RESULT EvmuJournal_stop     (GBL_SELF)                       GBL_NOEXCEPT;
+//! Restores the starting snapshot and runs the device through every recorded event
+EVMU_EXPORT EVMU_RESULT EvmuJournal_replay   (GBL_SELF)                       GBL_NOEXCEPT;
+
+/*! Replays the journal on its own device and another in lockstep, finding where they diverge
+ *
+ *  Both devices are compared by EvmuDevice_stateHash() and master time
+ *  after every event. The first event after which they differ is then
+ *  replayed again from save states one instruction at a time, or one
+ *  basic block at a time outside of the interpreter, to pinpoint the
+ *  instruction responsible and the first memory address it left
+ *  different. Meant for checking execution modes or core changes
+ *  against each other.
+ *
+ *  \param pOther       device to replay on alongside, which mustn't have a journal attached
+ *  \param pDivergence  receives where the devices diverged, if they did
+ */
+EVMU_EXPORT EVMU_RESULT EvmuJournal_bisect   (GBL_SELF,
+                                              EvmuDevice*            pOther,
+                                              EvmuJournalDivergence* pDivergence)  GBL_NOEXCEPT;
+
+//! Returns the number of bytes EvmuJournal_save() writes
+EVMU_EXPORT size_t      EvmuJournal_saveSize (GBL_CSELF)                      GBL_NOEXCEPT;
+//! Writes the starting snapshot and every event, then a checksum of both, into the given buffer
+EVMU_EXPORT EVMU_RESULT EvmuJournal_save     (GBL_CSELF,
+                                              void*       pBuffer,
+                                              size_t      size)               GBL_NOEXCEPT;
+//! Replaces whatever is held with a journal written by EvmuJournal_save(), ready to replay
+EVMU_EXPORT EVMU_RESULT EvmuJournal_load     (GBL_SELF,
+                                              const void* pBuffer,
+                                              size_t      size)               GBL_NOEXCEPT;
+//! Returns where the event at the given index starts within what EvmuJournal_save() writes
+EVMU_EXPORT size_t
+                        EvmuJournal_eventOffset(GBL_CSELF, size_t index)      GBL_NOEXCEPT;
+//! Recomputes the trailing checksum of a saved journal which was edited in place
+EVMU_EXPORT EVMU_RESULT EvmuJournal_reseal   (void*       pBuffer,
+                                              size_t      size)               GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // EVMU_JOURNAL_H
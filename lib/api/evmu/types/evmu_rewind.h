@@ -0,0 +1,84 @@
+/*! \file
+ *  \brief EvmuRewind ring buffer of incremental snapshots
+ *
+ *  This file provides everything pertaining to the public
+ *  API of the EvmuRewind module.
+ *
+ *  \author    2023 Falco Girgis
+ *  \copyright MIT License
+*/
+#ifndef EVMU_REWIND_H
+#define EVMU_REWIND_H
+
+#include "evmu_typedefs.h"
+#include <gimbal/meta/instances/gimbal_object.h>
+
+/*! \name  Type System
+ *  \brief Type UUID and cast operators
+ *  @{
+ */
+#define EVMU_REWIND_TYPE                (GBL_TYPEOF(EvmuRewind))                        //!< Type UUID for EvmuRewind
+#define EVMU_REWIND(instance)           (GBL_INSTANCE_CAST(instance, EvmuRewind))       //!< Function-style GblInstance cast
+#define EVMU_REWIND_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuRewind))             //!< Function-style GblClass cast
+#define EVMU_REWIND_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuRewind))  //!< Get EvmuRewindClass from GblInstance
+//! @}
+
+#define GBL_SELF_TYPE   EvmuRewind
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(EvmuDevice);
+
+/*! \struct     EvmuRewindClass
+ *  \extends    GblObjectClass
+ *  \brief      GblClass structure for EvmuRewind
+ *
+ *  No public methods
+ *
+ *  \sa EvmuRewind
+ */
+GBL_CLASS_DERIVE_EMPTY(EvmuRewind, GblObject)
+
+/*! \struct     EvmuRewind
+ *  \extends    GblObject
+ *  \brief      Ring buffer of snapshots for rewinding and rolling back a device
+ *
+ *  EvmuRewind keeps the most recent snapshots of a single EvmuDevice,
+ *  up to a fixed capacity, dropping the oldest as new ones are captured.
+ *
+ *  Rather than a full save state, each snapshot stores the CPU and
+ *  peripheral state along with only the 128 byte pages of RAM, XRAM,
+ *  WRAM, and flash which changed before the next snapshot. A single
+ *  copy of every page, as of the newest snapshot, serves as the base
+ *  they are all relative to. Flash writes are tracked as they happen,
+ *  so capturing never scans the whole of flash, and a frame that only
+ *  touches a few bytes costs a few hundred bytes to keep around.
+ *
+ *  Only one EvmuRewind should be attached to a device at a time, since
+ *  capturing consumes the device's record of which flash pages were
+ *  written.
+ *
+ *  \sa EvmuRewindClass, EvmuDevice_saveState()
+ */
+GBL_INSTANCE_DERIVE_EMPTY(EvmuRewind, GblObject)
+
+EVMU_EXPORT GblType     EvmuRewind_type     (void)                          GBL_NOEXCEPT;
+
+EVMU_EXPORT EvmuRewind* EvmuRewind_create   (EvmuDevice* pDevice,
+                                             size_t      capacity)          GBL_NOEXCEPT;
+EVMU_EXPORT GblRefCount EvmuRewind_unref    (GBL_SELF)                      GBL_NOEXCEPT;
+
+EVMU_EXPORT EvmuDevice* EvmuRewind_device   (GBL_CSELF)                     GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuRewind_capacity (GBL_CSELF)                     GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuRewind_count    (GBL_CSELF)                     GBL_NOEXCEPT;
+EVMU_EXPORT size_t      EvmuRewind_bytes    (GBL_CSELF)                     GBL_NOEXCEPT;
+
+EVMU_EXPORT EVMU_RESULT EvmuRewind_capture  (GBL_SELF)                      GBL_NOEXCEPT;
+EVMU_EXPORT EVMU_RESULT EvmuRewind_restore  (GBL_SELF, size_t age)          GBL_NOEXCEPT;
+EVMU_EXPORT void        EvmuRewind_clear    (GBL_SELF)                      GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // EVMU_REWIND_H
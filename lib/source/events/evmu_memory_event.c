@@ -1,19 +1,17 @@
 #include <evmu/events/evmu_memory_event.h>
+#include "../types/evmu_type_.h"
 
 EVMU_EXPORT GblType EvmuMemoryEvent_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuMemoryEvent"),
                                       GBL_EVENT_TYPE,
                                       &(GblTypeInfo){
                                           .classSize    = sizeof(EvmuMemoryEventClass),
                                           .instanceSize = sizeof(EvmuMemoryEvent)
                                       }, GBL_TYPE_FLAGS_NONE);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
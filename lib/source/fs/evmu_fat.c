@@ -3,6 +3,7 @@
 #include "../hw/evmu_memory_.h"
 #include "evmu_fat_.h"
 #include "../hw/evmu_flash_.h"
+#include "../types/evmu_type_.h"
 
 #include <gimbal/utils/gimbal_date_time.h>
 #include <gimbal/preprocessor/gimbal_macro_utils.h>
@@ -118,6 +119,8 @@ EVMU_EXPORT EVMU_RESULT EvmuFat_format(const EvmuFat* pSelf, const EvmuRootBlock
 
     EVMU_LOG_DEBUG("Zeroing flash");
     memset(pMemory_->pFlash->pStorage->pData, 0, pRoot->totalSize * EvmuFat_blockSize(pSelf));
+    EvmuFlash__markDirty_(pMemory_->pFlash, 0, pRoot->totalSize * EvmuFat_blockSize(pSelf));
+    EvmuCpu__flushCache_(pMemory_->pCpu);
 
     EVMU_LOG_DEBUG("Copying root block config");
     EvmuRootBlock* pDstRoot = EvmuFat_root(pSelf);
@@ -394,8 +397,11 @@ EVMU_EXPORT const void* EvmuFat_blockData(const EvmuFat* pSelf, EvmuBlock block)
     const void*  pData     = NULL;
     size_t       flashByte = block * EvmuFat_blockSize(pSelf);
 
-    if(flashByte < EvmuFat_capacity(pSelf))
+    if(flashByte < EvmuFat_capacity(pSelf)) {
         pData = &EVMU_FLASH_(pSelf)->pStorage->pData[flashByte];
+        // Blocks get modified through the returned pointer, so assume they will be
+        EvmuFlash__markDirty_(EVMU_FLASH_(pSelf), flashByte, EvmuFat_blockSize(pSelf));
+    }
 
     return pData;
 }
@@ -472,6 +478,10 @@ EVMU_EXPORT EvmuBlock EvmuFat_blockAlloc(const EvmuFat* pSelf, EvmuBlock prev, E
             pFatTable[i] = EVMU_FAT_BLOCK_FAT_LAST_IN_FILE;
             //Zero out contents of block
             memset(EvmuFat_blockData(pSelf, block), 0, EvmuFat_blockSize(pSelf));
+            EvmuCpu__invalidateCache_(EVMU_MEMORY_(EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf))->pMemory)->pCpu,
+                                      EVMU_CPU__ICACHE_BANK_FLASH_,
+                                      block * EvmuFat_blockSize(pSelf),
+                                      EvmuFat_blockSize(pSelf));
             //Update fat entry if not first block in series
             if(prev != EVMU_FAT_BLOCK_FAT_UNALLOCATED &&
                prev != EVMU_FAT_BLOCK_FAT_LAST_IN_FILE)
@@ -566,6 +576,7 @@ static EVMU_RESULT EvmuFat_root_(const EvmuFat* pSelf, EvmuRootBlock** ppRoot) {
     const size_t    blockSize = EvmuFat_blockSize(pSelf);
 
     *ppRoot = (EvmuRootBlock*)&EVMU_FLASH_(pSelf)->pStorage->pData[EVMU_FAT_BLOCK_ROOT * blockSize];
+    EvmuFlash__markDirty_(EVMU_FLASH_(pSelf), EVMU_FAT_BLOCK_ROOT * blockSize, blockSize);
 
     return GBL_RESULT_SUCCESS;
 }
@@ -613,15 +624,14 @@ EVMU_EXPORT GblType EvmuFat_type(void) {
         .instancePrivateSize = sizeof(EvmuFat_)
     };
 
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
-    if(type == GBL_INVALID_TYPE) {
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuFat"),
                                       EVMU_FLASH_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-
-    }
+    );
 
     return type;
 
@@ -4,6 +4,7 @@
 #include "evmu_fat_.h"
 #include "hw/evmu_memory_.h"
 #include "gyro_vmu_flash.h"
+#include "../types/evmu_type_.h"
 
 EVMU_EXPORT size_t EvmuFileManager_count(const EvmuFileManager* pSelf) {
     size_t              count = 0;
@@ -209,22 +210,20 @@ EVMU_EXPORT EVMU_RESULT EvmuFileManager_defrag(EvmuFileManager* pSelf) {
     {
         EvmuFat*       pFat         = EVMU_FAT(pSelf);
         EvmuFat_*      pFat_        = EVMU_FAT_(pFat);
-        EvmuFlash_*    pFlash_      = EVMU_FLASH_(pFat);
-        EvmuFlash_*    pTempFlash   = NULL;
         const size_t   fileCount    = EvmuFileManager_count(pSelf);
         EvmuFatUsage origMemUsage;
 
         // Cache flash metrics before defrag to validate post-defrag later
         EvmuFat_usage(pFat, &origMemUsage);
         if(fileCount) {
-            // Create temporary device
-            pTempDevice = GBL_NEW(EvmuDevice,
-                                  "name", "tempDefragDevice");
+            // Clone into a temporary device, backing up flash to restore at any point if we fail
+            pTempDevice = EvmuDevice_clone(EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf)));
 
-            pTempFlash  = EVMU_FLASH_(pTempDevice->pFlash);
+            GBL_CTX_VERIFY(pTempDevice,
+                           GBL_RESULT_ERROR_MEM_ALLOC,
+                           "Failed to create temporary device!");
 
-            // Create temporary back-up of flash to restore at any point if we fail
-            GblByteArray_copy(pTempFlash->pStorage, pFlash_->pStorage);
+            GblObject_setName(GBL_OBJECT(pTempDevice), "tempDefragDevice");
 
             EVMU_LOG_VERBOSE("Uninstalling all files.");
             EVMU_LOG_PUSH();
@@ -333,6 +332,8 @@ EVMU_EXPORT EVMU_RESULT EvmuFileManager_defrag(EvmuFileManager* pSelf) {
 
             EVMU_LOG_POP(1);
 
+            // Every file moved, so any cached program code is stale
+            EvmuCpu__flushCache_(EVMU_MEMORY_(EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf))->pMemory)->pCpu);
         }
     }
     GBL_CTX_END_BLOCK();
@@ -349,15 +350,14 @@ EVMU_EXPORT GblType EvmuFileManager_type(void) {
         .instanceSize        = sizeof(EvmuFileManager)
     };
 
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
-    if(type == GBL_INVALID_TYPE) {
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuFileManager"),
                                       EVMU_FAT_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-
-    }
+    );
 
     return type;
 
@@ -1,6 +1,7 @@
 #include "evmu_device_.h"
 #include "evmu_battery_.h"
 #include "evmu_memory_.h"
+#include "../types/evmu_type_.h"
 #include <evmu/hw/evmu_sfr.h>
 #include <evmu/hw/evmu_address_space.h>
 
@@ -44,7 +45,7 @@ static GBL_RESULT EvmuBatteryClass_init_(GblClass* pClass, const void* pUd, GblC
 }
 
 EVMU_EXPORT GblType EvmuBattery_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuBatteryClass),
@@ -53,15 +54,12 @@ EVMU_EXPORT GblType EvmuBattery_type(void) {
         .instancePrivateSize    = sizeof(EvmuBattery_)
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuBattery"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
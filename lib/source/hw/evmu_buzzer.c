@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "../types/evmu_marshal_.h"
+#include "../types/evmu_type_.h"
 
 #define EVMU_BUZZER_FREQ_RESP_BASE_OFFSET_   0xe0
 #define EVMU_BUZZER_FREQ_RESP_DEFAULT_VALUE_ 30
@@ -292,6 +293,19 @@ static GBL_RESULT EvmuBuzzer_IBehavior_reset_(EvmuIBehavior* pIBehavior) {
     GBL_CTX_END();
 }
 
+static EvmuWord EvmuBuzzer_readPort1_(EvmuMemory* pMemory, EvmuAddress address, void* pClosure) {
+    GBL_UNUSED(pMemory, pClosure);
+    // P1DDR and P1FCR are write-only
+    return address == EVMU_ADDRESS_SFR_P1? 0 : 0xff;
+}
+
+static EVMU_RESULT EvmuBuzzer_writeControl_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) {
+    EVMU_MEMORY_(pMemory)->sfr[EVMU_SFR_OFFSET(address)] = value;
+    EvmuBuzzer__memorySink_(pClosure, address, value);
+
+    return GBL_RESULT_SUCCESS;
+}
+
 static GBL_RESULT EvmuBuzzer_GblObject_constructed_(GblObject* pObject) {
     GBL_CTX_BEGIN(NULL);
 
@@ -305,6 +319,23 @@ static GBL_RESULT EvmuBuzzer_GblObject_constructed_(GblObject* pObject) {
     pSelf->pcmChanged = GBL_TRUE;
     pSelf_->enabled   = GBL_TRUE;
 
+    // Timer 1's control registers are handled by EvmuTimers, which forwards them here
+    EvmuDevice* pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pObject));
+
+    if(pDevice && pDevice->pMemory) {
+        const EvmuMemoryHandler port1 = {
+            EvmuBuzzer_readPort1_,   EvmuBuzzer_writeControl_, pSelf_
+        };
+        const EvmuMemoryHandler t1lc = {
+            EvmuMemory__readDirect_, EvmuBuzzer_writeControl_, pSelf_
+        };
+
+        GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, EVMU_ADDRESS_SFR_P1,    &port1, NULL));
+        GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, EVMU_ADDRESS_SFR_P1DDR, &port1, NULL));
+        GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, EVMU_ADDRESS_SFR_P1FCR, &port1, NULL));
+        GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, EVMU_ADDRESS_SFR_T1LC,  &t1lc,  NULL));
+    }
+
     GBL_CTX_END();
 }
 
@@ -343,7 +374,7 @@ static GBL_RESULT EvmuBuzzerClass_init_(GblClass* pClass, const void* pUd, GblCo
 }
 
 EVMU_EXPORT GblType EvmuBuzzer_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuBuzzerClass),
@@ -352,15 +383,12 @@ EVMU_EXPORT GblType EvmuBuzzer_type(void) {
         .instancePrivateSize    = sizeof(EvmuBuzzer_)
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuBuzzer"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
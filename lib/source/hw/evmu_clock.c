@@ -5,6 +5,7 @@
 #include "evmu_device_.h"
 #include "evmu_memory_.h"
 #include "evmu_clock_.h"
+#include "../types/evmu_type_.h"
 
 #define EVMU_CLOCK_OSC_QUARTZ_STABILIZATION_TIME
 #if 0
@@ -393,9 +394,13 @@ EVMU_EXPORT uint64_t EvmuClock_systemCyclesPerSec(const EvmuClock* pSelf) {
 }
 
 EVMU_EXPORT double EvmuClock_systemSecsPerCycle(const EvmuClock* pSelf) {
-    const EvmuWord ocr = EVMU_CLOCK_(pSelf)->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_OCR)];
+    return EvmuClock__systemTCyc_(EVMU_CLOCK_(pSelf)) / 1000000000.0;
+}
+
+EvmuTicks EvmuClock__systemTCyc_(const EvmuClock_* pSelf_) {
+    const EvmuWord ocr = pSelf_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_OCR)];
     const GblBool div6 = !!(ocr & EVMU_SFR_OCR_OCR7_MASK);
-    uint64_t tCyc = 0;
+    EvmuTicks tCyc = 0;
 
     if(ocr & EVMU_SFR_OCR_OCR4_MASK) {
         tCyc = div6? EVMU_CLOCK_OSC_CF_TCYC_1_6:
@@ -408,7 +413,7 @@ EVMU_EXPORT double EvmuClock_systemSecsPerCycle(const EvmuClock* pSelf) {
                    EVMU_CLOCK_OSC_RC_TCYC_1_12;
     }
 
-    return tCyc / 1000000000.0;
+    return tCyc;
 }
 
 
@@ -455,7 +460,7 @@ static GBL_RESULT EvmuClockClass_init_(GblClass* pClass, const void* pData, GblC
 }
 
 GBL_EXPORT GblType EvmuClock_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .pFnClassInit        = EvmuClockClass_init_,
@@ -464,15 +469,12 @@ GBL_EXPORT GblType EvmuClock_type(void) {
         .instancePrivateSize = sizeof(EvmuClock_)
     };
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuClock"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
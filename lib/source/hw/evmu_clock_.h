@@ -33,6 +33,9 @@ typedef struct EvmuClock_ {
     EvmuClockSignal_    signals[EVMU_CLOCK_SIGNAL_COUNT];
 } EvmuClock_;
 
+// Nanoseconds per cycle of the current system clock, for integer timekeeping
+EvmuTicks EvmuClock__systemTCyc_(GBL_CSELF) GBL_NOEXCEPT;
+
 
 #if 0
 
@@ -11,25 +11,22 @@
 #include "evmu_timers_.h"
 #include "evmu_flash_.h"
 #include "../types/evmu_peripheral_.h"
+#include "../types/evmu_type_.h"
 #include <gimbal/meta/signals/gimbal_marshal.h>
+#include <stdlib.h>
 
 EVMU_EXPORT EvmuPc EvmuCpu_pc(const EvmuCpu* pSelf) {
     return EVMU_CPU_(pSelf)->pc;
 }
 
-EVMU_EXPORT void EvmuCpu_setPc(EvmuCpu* pSelf, EvmuPc address) {
-    EvmuCpu_* pSelf_ = EVMU_CPU_(pSelf);
-
-    // Only update if PC actually changed
-    if(pSelf_->pc != address) {
-        pSelf_->pc = address;
-
-        // Update flag for polling
-        pSelf->pcChanged = GBL_TRUE;
+void EvmuCpu__checkPcSignal_(EvmuCpu_* pSelf_) {
+    pSelf_->pcSignal = GblSignal_connectionCount(GBL_INSTANCE(EVMU_CPU_PUBLIC_(pSelf_)), "pcChange") != 0;
+}
 
-        //Notify debugger/UI of next instruction executing
-        GblSignal_emit(GBL_INSTANCE(pSelf), "pcChange", address);
-    }
+EVMU_EXPORT void EvmuCpu_setPc(EvmuCpu* pSelf, EvmuPc address) {
+    // Called between updates, so connections made since the last one haven't been picked up yet
+    EvmuCpu__checkPcSignal_(EVMU_CPU_(pSelf));
+    EvmuCpu__advancePc_(EVMU_CPU_(pSelf), address);
 }
 
 EVMU_EXPORT EvmuWord EvmuCpu_opcode(const EvmuCpu* pSelf) {
@@ -89,6 +86,7 @@ EVMU_EXPORT EVMU_RESULT EvmuCpu_execute(EvmuCpu* pSelf, const EvmuDecodedInstruc
 
 EVMU_EXPORT EVMU_RESULT EvmuCpu_runNext(EvmuCpu* pSelf) {
     GBL_CTX_BEGIN(NULL);
+    EvmuCpu__checkPcSignal_(EVMU_CPU_(pSelf));
     GBL_INSTANCE_VCALL(EvmuCpu, pFnRunNext, pSelf);
     GBL_CTX_END();
 }
@@ -113,27 +111,83 @@ static EVMU_RESULT EvmuCpu_decode_(EvmuCpu* pSelf, const EvmuInstruction* pEncod
     GBL_CTX_END();
 }
 
-static EVMU_RESULT EvmuCpu_runNext_(EvmuCpu* pSelf) {
-    GBL_CTX_BEGIN(NULL);
+EVMU_EXPORT void EvmuCpu__invalidateCache_(EvmuCpu_*              pSelf,
+                                           EVMU_CPU__ICACHE_BANK_ bank,
+                                           EvmuAddress            address,
+                                           size_t                 bytes)
+{
+    // Cheaper to drop everything than to walk a range larger than the cache
+    if(bytes >= EVMU_CPU__ICACHE_SIZE_) {
+        EvmuCpu__flushCache_(pSelf);
+        return;
+    }
 
-    EvmuCpu_*    pSelf_   = EVMU_CPU_(pSelf);
-    EvmuMemory_* pMemory_ = pSelf_->pMemory;
-    EvmuMemory*  pMemory  = EVMU_MEMORY_PUBLIC_(pMemory_);
-    EvmuDevice*  pDevice  = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
-    EvmuRom*     pRom     = pDevice->pRom;
+    // Instructions starting up to 2 bytes before the range can overlap it
+    const EvmuAddress first = address >= EVMU_INSTRUCTION_BYTE_3?
+                                  address - EVMU_INSTRUCTION_BYTE_3 : 0;
 
-    // Fet instruction
-    GBL_INSTANCE_VCALL(EvmuCpu, pFnFetch, pSelf, pSelf_->pc, &pSelf_->curInstr.encoded);
-    pSelf_->curInstr.pFormat = EvmuIsa_format(pSelf_->curInstr.encoded.bytes[EVMU_INSTRUCTION_BYTE_OPCODE]);
+    for(EvmuAddress a = first; a < address + bytes; ++a) {
+        EvmuCpuICacheEntry_* pEntry = &pSelf->icache[a & EVMU_CPU__ICACHE_MASK_];
 
-    //Decode instruction
-    GBL_INSTANCE_VCALL(EvmuCpu, pFnDecode, pSelf, &pSelf_->curInstr.encoded, &pSelf_->curInstr.decoded);
+        if(pEntry->tag == EVMU_CPU__ICACHE_TAG_(bank, a))
+            pEntry->tag = EVMU_CPU__ICACHE_TAG_INVALID_;
+    }
 
-    //Advance program counter
-    EvmuCpu_setPc(pSelf, EvmuCpu_pc(pSelf) + pSelf_->curInstr.pFormat->bytes);
+    if(pSelf->pBlocks) {
+        for(size_t b = 0; b < EVMU_CPU__BLOCK_CACHE_SIZE_; ++b) {
+            EvmuCpuBlock_* pBlock = &pSelf->pBlocks[b];
+            const uint32_t start  = pBlock->tag & 0xffff;
 
-    //Execute instructions
-    GBL_INSTANCE_VCALL(EvmuCpu, pFnExecute, pSelf, &pSelf_->curInstr.decoded);
+            if(pBlock->tag != EVMU_CPU__ICACHE_TAG_INVALID_ &&
+               pBlock->tag >> 16 == bank                    &&
+               start < address + bytes                      &&
+               address < start + pBlock->bytes)
+                pBlock->tag = EVMU_CPU__ICACHE_TAG_INVALID_;
+        }
+    }
+}
+
+EVMU_EXPORT void EvmuCpu__flushCache_(EvmuCpu_* pSelf) {
+    for(size_t e = 0; e < EVMU_CPU__ICACHE_SIZE_; ++e)
+        pSelf->icache[e].tag = EVMU_CPU__ICACHE_TAG_INVALID_;
+
+    if(pSelf->pBlocks)
+        for(size_t b = 0; b < EVMU_CPU__BLOCK_CACHE_SIZE_; ++b)
+            pSelf->pBlocks[b].tag = EVMU_CPU__ICACHE_TAG_INVALID_;
+}
+
+EVMU_CPU__ICACHE_BANK_ EvmuCpu__cacheBank_(const EvmuCpu_* pSelf_) {
+    return (pSelf_->pMemory->pExt == pSelf_->pMemory->rom)?
+                EVMU_CPU__ICACHE_BANK_ROM_ : EVMU_CPU__ICACHE_BANK_FLASH_;
+}
+
+static void EvmuCpu_decodeEntry_(EvmuCpuICacheEntry_* pEntry, const EvmuWord* pSource, uint32_t tag) {
+    pEntry->pFormat = EvmuIsa_format(pSource[EVMU_INSTRUCTION_BYTE_OPCODE]);
+
+    memset(&pEntry->encoded, 0, sizeof(EvmuInstruction));
+    memcpy(pEntry->encoded.bytes, pSource, pEntry->pFormat->bytes);
+    pEntry->encoded.byteCount = pEntry->pFormat->bytes;
+
+    EvmuIsa_decode(&pEntry->encoded, &pEntry->decoded);
+
+    pEntry->tag = tag;
+}
+
+const EvmuCpuICacheEntry_* EvmuCpu__fetch_(EvmuCpu_* pSelf_) {
+    const uint32_t       tag    = EVMU_CPU__ICACHE_TAG_(EvmuCpu__cacheBank_(pSelf_), pSelf_->pc);
+    EvmuCpuICacheEntry_* pEntry = &pSelf_->icache[pSelf_->pc & EVMU_CPU__ICACHE_MASK_];
+
+    // Miss: fetch and decode straight from program memory into the cache line
+    if(pEntry->tag != tag)
+        EvmuCpu_decodeEntry_(pEntry, &pSelf_->pMemory->pExt[pSelf_->pc], tag);
+
+    return pEntry;
+}
+
+static void EvmuCpu_enterBios_(EvmuCpu* pSelf) {
+    EvmuCpu_*   pSelf_  = EVMU_CPU_(pSelf);
+    EvmuMemory* pMemory = EVMU_MEMORY_PUBLIC_(pSelf_->pMemory);
+    EvmuRom*    pRom    = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf))->pRom;
 
     //Check if we entered the firmware
     if(EvmuRom_biosActive(pRom)) {
@@ -147,43 +201,452 @@ static EVMU_RESULT EvmuCpu_runNext_(EvmuCpu* pSelf) {
                                                        EVMU_ADDRESS_SFR_EXT) | 0x1);
         }
     }
+}
+
+// Whether accessing the given address must be in step with the timers and peripherals behind it
+static GblBool EvmuCpu_volatileSfr_(EvmuAddress address) {
+    switch(address) {
+    case EVMU_ADDRESS_SFR_ACC:
+    case EVMU_ADDRESS_SFR_PSW:
+    case EVMU_ADDRESS_SFR_B:
+    case EVMU_ADDRESS_SFR_C:
+    case EVMU_ADDRESS_SFR_TRL:
+    case EVMU_ADDRESS_SFR_TRH:
+    case EVMU_ADDRESS_SFR_SP:
+    case EVMU_ADDRESS_SFR_XBNK:
+    case EVMU_ADDRESS_SFR_VSEL:
+    case EVMU_ADDRESS_SFR_VRMAD1:
+    case EVMU_ADDRESS_SFR_VRMAD2:
+    case EVMU_ADDRESS_SFR_VTRBF:
+        return GBL_FALSE;
+    default:
+        return address >= EVMU_ADDRESS_SEGMENT_SFR_BASE &&
+               address <= EVMU_ADDRESS_SEGMENT_SFR_END;
+    }
+}
+
+static GblBool EvmuCpu_endsBlock_(const EvmuDecodedInstruction* pInstr) {
+    switch(pInstr->opcode) {
+    // Control flow
+    case EVMU_OPCODE_BR:
+    case EVMU_OPCODE_BRF:
+    case EVMU_OPCODE_JMP:
+    case EVMU_OPCODE_JMPF:
+    case EVMU_OPCODE_CALL:
+    case EVMU_OPCODE_CALLR:
+    case EVMU_OPCODE_CALLF:
+    case EVMU_OPCODE_RET:
+    case EVMU_OPCODE_RETI:
+    case EVMU_OPCODE_BEI:
+    case EVMU_OPCODE_BE:
+    case EVMU_OPCODE_BE_IND:
+    case EVMU_OPCODE_BNEI:
+    case EVMU_OPCODE_BNE:
+    case EVMU_OPCODE_BNE_IND:
+    case EVMU_OPCODE_BP:
+    case EVMU_OPCODE_BPC:
+    case EVMU_OPCODE_BN:
+    case EVMU_OPCODE_BZ:
+    case EVMU_OPCODE_BNZ:
+    case EVMU_OPCODE_DBNZ:
+    case EVMU_OPCODE_DBNZ_IND:
+        return GBL_TRUE;
+    // Direct writes
+    case EVMU_OPCODE_ST:
+    case EVMU_OPCODE_MOV:
+    case EVMU_OPCODE_INC:
+    case EVMU_OPCODE_DEC:
+    case EVMU_OPCODE_POP:
+    case EVMU_OPCODE_XCH:
+    case EVMU_OPCODE_CLR1:
+    case EVMU_OPCODE_SET1:
+    case EVMU_OPCODE_NOT1:
+        return EvmuCpu_volatileSfr_(pInstr->operands.direct);
+    // Indirect writes, modes 2 and 3 address the SFR + XRAM half of the bus
+    case EVMU_OPCODE_ST_IND:
+    case EVMU_OPCODE_MOV_IND:
+    case EVMU_OPCODE_INC_IND:
+    case EVMU_OPCODE_DEC_IND:
+    case EVMU_OPCODE_XCH_IND:
+        return (pInstr->operands.indirect & 0x2) != 0;
+    default:
+        return GBL_FALSE;
+    }
+}
+
+/* Accesses of volatile SFRs (ticking timers, ports, ...) must see every cycle
+   before them retired: reads to see the time, and writes so that starting,
+   stopping, or reloading a timer doesn't happen ahead of the cycles leading up to it. */
+static GblBool EvmuCpu_startsBlock_(const EvmuDecodedInstruction* pInstr) {
+    switch(pInstr->opcode) {
+    // Direct writes
+    case EVMU_OPCODE_ST:
+    case EVMU_OPCODE_MOV:
+    case EVMU_OPCODE_POP:
+    // Direct reads
+    case EVMU_OPCODE_LD:
+    case EVMU_OPCODE_ADD:
+    case EVMU_OPCODE_ADDC:
+    case EVMU_OPCODE_SUB:
+    case EVMU_OPCODE_SUBC:
+    case EVMU_OPCODE_AND:
+    case EVMU_OPCODE_OR:
+    case EVMU_OPCODE_XOR:
+    case EVMU_OPCODE_PUSH:
+    case EVMU_OPCODE_XCH:
+    case EVMU_OPCODE_INC:
+    case EVMU_OPCODE_DEC:
+    case EVMU_OPCODE_CLR1:
+    case EVMU_OPCODE_SET1:
+    case EVMU_OPCODE_NOT1:
+    case EVMU_OPCODE_BE:
+    case EVMU_OPCODE_BNE:
+    case EVMU_OPCODE_DBNZ:
+    case EVMU_OPCODE_BP:
+    case EVMU_OPCODE_BPC:
+    case EVMU_OPCODE_BN:
+        return EvmuCpu_volatileSfr_(pInstr->operands.direct);
+    // Indirect writes and reads, modes 2 and 3 address the SFR + XRAM half of the bus
+    case EVMU_OPCODE_ST_IND:
+    case EVMU_OPCODE_MOV_IND:
+    case EVMU_OPCODE_LD_IND:
+    case EVMU_OPCODE_ADD_IND:
+    case EVMU_OPCODE_ADDC_IND:
+    case EVMU_OPCODE_SUB_IND:
+    case EVMU_OPCODE_SUBC_IND:
+    case EVMU_OPCODE_AND_IND:
+    case EVMU_OPCODE_OR_IND:
+    case EVMU_OPCODE_XOR_IND:
+    case EVMU_OPCODE_XCH_IND:
+    case EVMU_OPCODE_INC_IND:
+    case EVMU_OPCODE_DEC_IND:
+    case EVMU_OPCODE_BE_IND:
+    case EVMU_OPCODE_BNE_IND:
+    case EVMU_OPCODE_DBNZ_IND:
+        return (pInstr->operands.indirect & 0x2) != 0;
+    default:
+        return GBL_FALSE;
+    }
+}
+
+static EvmuCpuBlock_* EvmuCpu_block_(EvmuCpu_* pSelf_) {
+    const EVMU_CPU__ICACHE_BANK_ bank   = EvmuCpu__cacheBank_(pSelf_);
+    const uint32_t               tag    = EVMU_CPU__ICACHE_TAG_(bank, pSelf_->pc);
+    EvmuCpuBlock_*               pBlock = &pSelf_->pBlocks[pSelf_->pc & EVMU_CPU__BLOCK_CACHE_MASK_];
+
+    // Miss: predecode instructions until one needs the peripherals caught up, before or after it
+    if(pBlock->tag != tag) {
+        uint32_t pc = pSelf_->pc;
+
+        pBlock->bytes   = 0;
+        pBlock->count   = 0;
+        pBlock->cycles  = 0;
+        pBlock->pNative = NULL;
+
+        for(;;) {
+            EvmuCpuICacheEntry_* pInstr = &pBlock->instrs[pBlock->count];
+
+            EvmuCpu_decodeEntry_(pInstr, &pSelf_->pMemory->pExt[pc], EVMU_CPU__ICACHE_TAG_(bank, pc));
+
+            // Leave it to lead the next block, once the timers have caught up to it
+            if(pBlock->count && EvmuCpu_startsBlock_(&pInstr->decoded))
+                break;
+
+            ++pBlock->count;
+            pBlock->bytes  += pInstr->pFormat->bytes;
+            pBlock->cycles += pInstr->pFormat->cc;
+            pc             += pInstr->pFormat->bytes;
+
+            if(EvmuCpu_endsBlock_(&pInstr->decoded)          ||
+               pBlock->count == EVMU_CPU__BLOCK_INSTR_MAX_   ||
+               pc + EVMU_INSTRUCTION_BYTE_3 > 0xffff)
+                break;
+        }
+
+        pBlock->tag = tag;
+    }
+
+    return pBlock;
+}
+
+static EVMU_RESULT EvmuCpu_execute_(EvmuCpu* pSelf, const EvmuDecodedInstruction* pInstr);
 
+/* Runs a whole basic block, storing the number of cycles it took. Like the
+   interpreter, an instruction failing to execute stops there, with its error
+   propagated once the instructions retired so far have been accounted for. */
+static EVMU_RESULT EvmuCpu_runBlock_(EvmuCpu* pSelf, EvmuCycles* pCycles) {
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuCpu_*           pSelf_  = EVMU_CPU_(pSelf);
+    EvmuCpuBlock_*      pBlock  = EvmuCpu_block_(pSelf_);
+    const EvmuCpuClass* pClass  = EVMU_CPU_GET_CLASS(pSelf);
+    EVMU_RESULT         result  = GBL_RESULT_SUCCESS;
+    uint8_t             retired = pBlock->count;
+
+#ifdef EVMU_CPU__JIT_
+    // Translations inline the default execute logic, so an override must still be dispatched to
+    if(pSelf_->execMode == EVMU_CPU_EXEC_MODE_JIT && pClass->pFnExecute == EvmuCpu_execute_ &&
+       (pBlock->pNative || (pBlock->pNative = EvmuCpu__jitCompile_(pSelf_, pBlock))))
+    {
+        pSelf_->jit.pFault = NULL;
+        result = ((EVMU_RESULT (*)(void))pBlock->pNative)();
+
+        if(pSelf_->jit.pFault)
+            retired = (uint8_t)(pSelf_->jit.pFault - pBlock->instrs) + 1;
+    } else
+#endif
+    for(uint8_t i = 0; i < pBlock->count; ++i) {
+        const EvmuCpuICacheEntry_* pInstr = &pBlock->instrs[i];
+
+        pSelf_->curInstr.encoded = pInstr->encoded;
+        pSelf_->curInstr.decoded = pInstr->decoded;
+        pSelf_->curInstr.pFormat = pInstr->pFormat;
+
+        EvmuCpu__advancePc_(pSelf_, pSelf_->pc + pInstr->pFormat->bytes);
+        result = pClass->pFnExecute(pSelf, &pInstr->decoded);
+
+        if(!GBL_RESULT_SUCCESS(result)) {
+            retired = i + 1;
+            break;
+        }
+    }
+
+    // Blocks are straight-line, so every instruction retired once and only the last could branch
+    if(retired == pBlock->count) {
+        *pCycles = pBlock->cycles;
+    } else {
+        *pCycles = 0;
+        for(uint8_t i = 0; i < retired; ++i)
+            *pCycles += pBlock->instrs[i].pFormat->cc;
+    }
+
+    if(pSelf_->pProfiler) {
+        EvmuPc pc = pBlock->tag & 0xffff;
+
+        for(uint8_t i = 0; i < retired; ++i) {
+            EvmuCpu__profileInstr_(pSelf_, pBlock->tag >> 16, pc, pBlock->instrs[i].pFormat);
+            pc += pBlock->instrs[i].pFormat->bytes;
+        }
+    }
+
+    if(pSelf_->trace.pPcs) {
+        EvmuPc pc = pBlock->tag & 0xffff;
+
+        for(uint8_t i = 0; i < retired; ++i) {
+            EvmuCpu__tracePc_(pSelf_, pc);
+            pc += pBlock->instrs[i].pFormat->bytes;
+        }
+    }
+
+    EvmuCpu_enterBios_(pSelf);
+
+    GBL_CTX_VERIFY_CALL(result);
     GBL_CTX_END();
 }
 
+// Retires whatever instruction is in curInstr, located at the current PC
+static EVMU_RESULT EvmuCpu_runCurrent_(EvmuCpu* pSelf) {
+    EvmuCpu_* pSelf_ = EVMU_CPU_(pSelf);
+
+    // Sampled up-front for the profiler, since executing can switch banks
+    const EvmuPc                 pc   = pSelf_->pc;
+    const EVMU_CPU__ICACHE_BANK_ bank = pSelf_->pProfiler? EvmuCpu__cacheBank_(pSelf_) :
+                                                           EVMU_CPU__ICACHE_BANK_ROM_;
+
+    //Advance program counter
+    EvmuCpu__advancePc_(pSelf_, pc + pSelf_->curInstr.pFormat->bytes);
+
+    //Execute instructions
+    const EVMU_RESULT result = EVMU_CPU_GET_CLASS(pSelf)->pFnExecute(pSelf, &pSelf_->curInstr.decoded);
+
+    if(pSelf_->pProfiler)
+        EvmuCpu__profileInstr_(pSelf_, bank, pc, pSelf_->curInstr.pFormat);
+
+    if(pSelf_->trace.pPcs)
+        EvmuCpu__tracePc_(pSelf_, pc);
+
+    EvmuCpu_enterBios_(pSelf);
+
+    return result;
+}
+
+EVMU_RESULT EvmuCpu__runDecoded_(EvmuCpu_* pSelf_, const EvmuCpuICacheEntry_* pEntry) {
+    pSelf_->curInstr.encoded = pEntry->encoded;
+    pSelf_->curInstr.decoded = pEntry->decoded;
+    pSelf_->curInstr.pFormat = pEntry->pFormat;
+
+    return EvmuCpu_runCurrent_(EVMU_CPU_PUBLIC_(pSelf_));
+}
+
+static EVMU_RESULT EvmuCpu_runNext_(EvmuCpu* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuCpu_*           pSelf_   = EVMU_CPU_(pSelf);
+    const EvmuCpuClass* pClass   = EVMU_CPU_GET_CLASS(pSelf);
+
+    // Only the built-in fetch + decode may be served from the cache, overrides still get called
+    if(pClass->pFnFetch == EvmuCpu_fetch_ && pClass->pFnDecode == EvmuCpu_decode_) {
+        GBL_CTX_VERIFY_CALL(EvmuCpu__runDecoded_(pSelf_, EvmuCpu__fetch_(pSelf_)));
+    } else {
+        // Fet instruction
+        GBL_INSTANCE_VCALL(EvmuCpu, pFnFetch, pSelf, pSelf_->pc, &pSelf_->curInstr.encoded);
+        pSelf_->curInstr.pFormat = EvmuIsa_format(pSelf_->curInstr.encoded.bytes[EVMU_INSTRUCTION_BYTE_OPCODE]);
+
+        //Decode instruction
+        GBL_INSTANCE_VCALL(EvmuCpu, pFnDecode, pSelf, &pSelf_->curInstr.encoded, &pSelf_->curInstr.decoded);
+
+        GBL_CTX_VERIFY_CALL(EvmuCpu_runCurrent_(pSelf));
+    }
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_CPU_EXEC_MODE EvmuCpu_execMode(const EvmuCpu* pSelf) {
+    return EVMU_CPU_(pSelf)->execMode;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuCpu_setExecMode(EvmuCpu* pSelf, EVMU_CPU_EXEC_MODE mode) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_ARG(mode < EVMU_CPU_EXEC_MODE_COUNT);
+
+    EvmuCpu_* pSelf_ = EVMU_CPU_(pSelf);
+
+#ifndef EVMU_CPU__JIT_
+    GBL_CTX_VERIFY(mode != EVMU_CPU_EXEC_MODE_JIT,
+                   GBL_RESULT_UNSUPPORTED,
+                   "JIT execution mode requires building with EVMU_ENABLE_JIT on x86-64!");
+#endif
+
+    if(mode != EVMU_CPU_EXEC_MODE_INTERPRETER && !pSelf_->pBlocks) {
+        pSelf_->pBlocks = malloc(sizeof(EvmuCpuBlock_) * EVMU_CPU__BLOCK_CACHE_SIZE_);
+
+        GBL_CTX_VERIFY(pSelf_->pBlocks,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to allocate basic block cache!");
+
+        for(size_t b = 0; b < EVMU_CPU__BLOCK_CACHE_SIZE_; ++b)
+            pSelf_->pBlocks[b].tag = EVMU_CPU__ICACHE_TAG_INVALID_;
+    }
+
+#ifdef EVMU_CPU__JIT_
+    if(mode == EVMU_CPU_EXEC_MODE_JIT)
+        GBL_CTX_VERIFY_CALL(EvmuCpu__jitInit_(pSelf_));
+#endif
+
+    pSelf_->execMode = mode;
+
+    GBL_CTX_END();
+}
+
+void EvmuCpu__flushTrace_(EvmuCpu_* pSelf) {
+    EvmuCpuTrace_* pTrace = &pSelf->trace;
+    EvmuCpu*       pCpu   = EVMU_CPU_PUBLIC_(pSelf);
+
+    if(!pTrace->size || !pTrace->pFnFlush) return;
+
+    // Without wrapping, everything held is one contiguous chunk ending at head
+    if(pTrace->size <= pTrace->head) {
+        pTrace->pFnFlush(pCpu, &pTrace->pPcs[pTrace->head - pTrace->size], pTrace->size, pTrace->pClosure);
+    } else {
+        const size_t tail = pTrace->size - pTrace->head;
+
+        pTrace->pFnFlush(pCpu, &pTrace->pPcs[pTrace->capacity - tail], tail, pTrace->pClosure);
+        if(pTrace->head)
+            pTrace->pFnFlush(pCpu, pTrace->pPcs, pTrace->head, pTrace->pClosure);
+    }
+
+    pTrace->head = 0;
+    pTrace->size = 0;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuCpu_setTrace(EvmuCpu*       pSelf,
+                                         size_t         capacity,
+                                         EvmuCpuTraceFn pFnFlush,
+                                         void*          pClosure)
+{
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuCpuTrace_* pTrace = &EVMU_CPU_(pSelf)->trace;
+
+    // Hand off whatever was recorded under the previous configuration
+    EvmuCpu__flushTrace_(EVMU_CPU_(pSelf));
+
+    if(capacity != pTrace->capacity) {
+        EvmuPc* pPcs = NULL;
+
+        if(capacity) {
+            pPcs = malloc(sizeof(EvmuPc) * capacity);
+
+            GBL_CTX_VERIFY(pPcs,
+                           GBL_RESULT_ERROR_MEM_ALLOC,
+                           "Failed to allocate CPU trace of %zu entries!",
+                           capacity);
+        }
+
+        free(pTrace->pPcs);
+        pTrace->pPcs     = pPcs;
+        pTrace->capacity = capacity;
+    }
+
+    pTrace->head     = 0;
+    pTrace->size     = 0;
+    pTrace->pFnFlush = pFnFlush;
+    pTrace->pClosure = pClosure;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT size_t EvmuCpu_traceCapacity(const EvmuCpu* pSelf) {
+    return EVMU_CPU_(pSelf)->trace.capacity;
+}
+
+EVMU_EXPORT size_t EvmuCpu_trace(const EvmuCpu* pSelf, EvmuPc* pPcs, size_t count) {
+    const EvmuCpuTrace_* pTrace = &EVMU_CPU_(pSelf)->trace;
+
+    if(count > pTrace->size)
+        count = pTrace->size;
+
+    // Copies the most recent count PCs, oldest first
+    for(size_t i = 0; i < count; ++i)
+        pPcs[i] = pTrace->pPcs[(pTrace->head + pTrace->capacity - count + i) % pTrace->capacity];
+
+    return count;
+}
+
+EVMU_EXPORT void EvmuCpu_flushTrace(EvmuCpu* pSelf) {
+    EvmuCpu__flushTrace_(EVMU_CPU_(pSelf));
+}
+
 static  EVMU_RESULT EvmuCpu_execute_(EvmuCpu* pSelf, const EvmuDecodedInstruction* pInstr) {
 #define PC                      pSelf_->pc
 #define OP(NAME)                pOperands->NAME
 #define SFR(NAME)               EVMU_ADDRESS_SFR_##NAME
 #define SFR_MSK(NAME, FIELD)    EVMU_SFR_##NAME##_##FIELD##_MASK
 #define SFR_POS(NAME, FIELD)    EVMU_SFR_##NAME##_##FIELD##_POS
-#define INDIRECT()              EvmuMemory_indirectAddress(pMemory, OP(indirect))
-#define VIEW(ADDR)              EvmuMemory_viewData(pMemory, ADDR)
-#define READ(ADDR)              EvmuMemory_readData(pMemory, ADDR)
-#define READ_LATCH(ADDR)        EvmuMemory_readDataLatch(pMemory, ADDR)
-#define WRITE(ADDR, VAL)        EvmuMemory_writeData(pMemory, ADDR, VAL)
+#define INDIRECT()              EvmuMemory__indirectAddress_(pMemory_, OP(indirect))
+#define VIEW(ADDR)              ((ADDR) == SFR(VTRBF)? EvmuMemory_viewData(pMemory, ADDR) : READ(ADDR))
+#define READ(ADDR)              EvmuMemory__readData_(pMemory_, ADDR)
+#define READ_LATCH(ADDR)        EvmuMemory__readDataLatch_(pMemory_, ADDR)
+#define WRITE(ADDR, VAL)        EvmuMemory__writeData_(pMemory_, ADDR, VAL)
 #define READ_EXT(ADDR)          EvmuMemory_readProgram(pMemory, ADDR)
 #define WRITE_EXT(ADDR, VAL)    EvmuMemory_writeProgram(pMemory, ADDR, VAL)
 #define READ_FLASH(ADDR)        EvmuFlash_readByte(pFlash, ADDR)
 #define WRITE_FLASH(ADDR, VAL)  EvmuFlash_writeByte(pFlash, ADDR, VAL)
-#define PUSH(VALUE)             EvmuMemory_pushStack(pMemory, VALUE)
-#define POP()                   EvmuMemory_popStack(pMemory)
+#define PUSH(VALUE)             EvmuMemory__pushStack_(pMemory_, VALUE)
+#define POP()                   EvmuMemory__popStack_(pMemory_)
 #define PUSH_PC()               GBL_STMT_START { PUSH(PC & 0xff); PUSH((PC & 0xff00) >> 8u); } GBL_STMT_END
 #define POP_PC()                GBL_STMT_START { PC = POP() << 8u; PC |= POP(); } GBL_STMT_END
 #define PSW(FLAG, EXPR)         WRITE(SFR(PSW), (READ(SFR(PSW)) & ~SFR_MSK(PSW, FLAG)) | ((EXPR)? SFR_MSK(PSW, FLAG) : 0))
 #define LOGIC_OP(OP, RHS)       WRITE(SFR(ACC), READ(SFR(ACC)) OP (RHS))
 #define BR(EXPR, OFFSET)        if((EXPR)) PC += OFFSET
-#define OP_ADD_CY_EXP           (a+b+c>255)
-#define OP_ADD_AC_EXP           ((a&15)+((b+c)&15)>15)
-#define OP_ADD_OV_EXP           (0x80&(~a^(b+c))&((b+c)^(a+(b+c))))
-#define OP_ADD_(RVALUE, CY_EN)  OP_ARITH(+, (RVALUE), CY_EN, OP_ADD_CY_EXP, OP_ADD_AC_EXP, OP_ADD_OV_EXP)
+#define OP_ADD_(RVALUE, CY_EN)  OP_ARITH(+, ADD, (RVALUE), CY_EN)
 #define OP_ADD(RVALUE)          OP_ADD_(RVALUE, 0)
 #define OP_ADD_CARRY(RVALUE)    OP_ADD_(RVALUE, 1)
-#define OP_SUB_CY_EXP           (a-b-c<0)
-#define OP_SUB_AC_EXP           ((a&15)-(b&15)-c<0)
-#define OP_SUB_OV_(a, b)        (((int8_t)(a^(b)) < 0 && (int8_t)(b^(a-b)) >= 0))
-#define OP_SUB_OV_EXP           (OP_SUB_OV_(a,(b+c)))
-#define OP_SUB_(RVALUE, CY_EN)  OP_ARITH(-, (RVALUE), CY_EN, OP_SUB_CY_EXP, OP_SUB_AC_EXP, OP_SUB_OV_EXP)
+#define OP_SUB_(RVALUE, CY_EN)  OP_ARITH(-, SUB, (RVALUE), CY_EN)
 #define OP_SUB(RVALUE)          OP_SUB_(RVALUE, 0)
 #define OP_SUB_CARRY(RVALUE)    OP_SUB_(RVALUE, 1)
 
@@ -203,22 +666,15 @@ static  EVMU_RESULT EvmuCpu_execute_(EvmuCpu* pSelf, const EvmuDecodedInstructio
         BR(v1 OPERATOR v2, OFFSET);              \
     } GBL_STMT_END
 
-#define OP_ARITH(OP, RVALUE, CY_EN, CY_EXP, AC_EXP, OV_EXP) \
-    GBL_STMT_START {                                        \
-        const EvmuWord a = READ(SFR(ACC));                  \
-        const EvmuWord b = (RVALUE);                        \
-        const EvmuWord c = CY_EN?                           \
-            ((READ(SFR(PSW)) & SFR_MSK(PSW, CY))            \
-                >> SFR_POS(PSW, CY)) : 0;                   \
-        const EvmuWord r = a OP b OP c;                     \
-        EvmuWord p  = READ(SFR(PSW)) & ~(SFR_MSK(PSW, CY) | \
-                                         SFR_MSK(PSW, AC) | \
-                                         SFR_MSK(PSW, OV)); \
-        p           |= (CY_EXP)? SFR_MSK(PSW, CY) : 0;      \
-        p           |= (AC_EXP)? SFR_MSK(PSW, AC) : 0;      \
-        p           |= (OV_EXP)? SFR_MSK(PSW, OV) : 0;      \
-        WRITE(SFR(ACC), r);                                 \
-        WRITE(SFR(PSW), p);                                 \
+// CY, AC, and OV are left for EvmuMemory to compute once PSW is actually observed
+#define OP_ARITH(OP, KIND, RVALUE, CY_EN)                                   \
+    GBL_STMT_START {                                                        \
+        const EvmuWord a = READ(SFR(ACC));                                  \
+        const EvmuWord b = (RVALUE);                                        \
+        const EvmuWord c = CY_EN? EvmuMemory__carry_(pMemory_) : 0;         \
+        WRITE(SFR(ACC), a OP b OP c);                                       \
+        EvmuMemory__deferFlags_(pMemory_, EVMU_MEMORY__ALU_OP_##KIND##_,    \
+                                a, b, c);                                   \
     } GBL_STMT_END
 
     GBL_CTX_BEGIN(pSelf);
@@ -529,29 +985,125 @@ static  EVMU_RESULT EvmuCpu_execute_(EvmuCpu* pSelf, const EvmuDecodedInstructio
     GBL_CTX_END();
 }
 
+EvmuCycles EvmuCpu__haltCycles_(EvmuCpu_* pSelf_, EvmuTicks deadline, EvmuCycles budget) {
+    EvmuDevice_*    pDevice_ = EVMU_DEVICE_(EvmuPeripheral_device(EVMU_PERIPHERAL(EVMU_CPU_PUBLIC_(pSelf_))));
+    const EvmuTicks now      = pDevice_->scheduler.now;
+    const EvmuTicks tCyc     = EvmuClock__systemTCyc_(pDevice_->pClock);
+    EvmuCycles      cycles   = 1;
+
+    if(pDevice_->pPic->processThisInstr) {
+        /* Halted with nothing for the PIC to accept: only a timer overflow or a
+           scheduled event can raise an interrupt, so skip straight to the first. */
+        cycles = EvmuTimers__cyclesUntilOverflow_(pDevice_->pTimers);
+
+        if((deadline - now + tCyc - 1) / tCyc < cycles)
+            cycles = (deadline - now + tCyc - 1) / tCyc;
+        if(budget < cycles)
+            cycles = budget;
+    }
+
+    return cycles;
+}
+
+GblBool EvmuCpu__builtinFetch_(const EvmuCpu_* pSelf_) {
+    const EvmuCpuClass* pClass = EVMU_CPU_GET_CLASS(EVMU_CPU_PUBLIC_(pSelf_));
+
+    return pClass->pFnFetch   == EvmuCpu_fetch_  &&
+           pClass->pFnDecode  == EvmuCpu_decode_ &&
+           pClass->pFnRunNext == EvmuCpu_runNext_;
+}
+
+EVMU_RESULT EvmuCpu__run_(EvmuCpu_*     pSelf_,
+                          EvmuTicks     end,
+                          EvmuCycles    maxCycles,
+                          EvmuStopMask  stopMask,
+                          EvmuStopMask* pReason,
+                          EvmuCycles*   pElapsed)
+{
+    EvmuCpu*            pSelf      = EVMU_CPU_PUBLIC_(pSelf_);
+    EvmuDevice*         pDevice    = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+    EvmuDevice_*        pDevice_   = EVMU_DEVICE_(pDevice);
+    EvmuScheduler_*     pScheduler = &pDevice_->scheduler;
+    const EvmuCpuClass* pClass     = EVMU_CPU_GET_CLASS(pSelf);
+    const EvmuWord*     pPcon      = &pDevice_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PCON)];
+    EvmuStopMask        reason     = EVMU_DEVICE_STOP_NONE;
+    EvmuCycles          elapsed    = 0;
+    EVMU_RESULT         result     = GBL_RESULT_SUCCESS;
+
+    // Blocks are built from the default fetch/decode/runNext logic, so overriding any falls back
+    const GblBool blockMode = pSelf_->execMode != EVMU_CPU_EXEC_MODE_INTERPRETER &&
+                              EvmuCpu__builtinFetch_(pSelf_);
+
+    // Connections made between updates are picked up here rather than on every instruction
+    EvmuCpu__checkPcSignal_(pSelf_);
+
+    while(pScheduler->now < end && elapsed < maxCycles && !reason) {
+        // Only the CPU, PIC, and cycle-counting timers step until the next peripheral event
+        const EvmuTicks deadline = EvmuDevice__nextDeadline_(pDevice_, end);
+
+        while(pScheduler->now < deadline && elapsed < maxCycles) {
+            const EvmuTicks tCyc   = EvmuClock__systemTCyc_(pDevice_->pClock);
+            EvmuCycles      cycles = 1;
+
+            if(EvmuPic_update(EVMU_PIC_PUBLIC_(pDevice_->pPic)) && (stopMask & EVMU_DEVICE_STOP_IRQ)) {
+                reason |= EVMU_DEVICE_STOP_IRQ;
+                break;
+            }
+
+            if(!(*pPcon & EVMU_SFR_PCON_HALT_MASK)) {
+                if(blockMode) {
+                    result = EvmuCpu_runBlock_(pSelf, &cycles);
+                } else {
+                    result = pClass->pFnRunNext(pSelf);
+                    cycles = EvmuCpu_cyclesPerInstruction(pSelf);
+                }
+
+                // Whatever did run still takes its cycles before the failure ends the run
+                if(!GBL_RESULT_SUCCESS(result))
+                    reason |= EVMU_DEVICE_STOP_ERROR;
+                else if((*pPcon & EVMU_SFR_PCON_HALT_MASK) && (stopMask & EVMU_DEVICE_STOP_HALT))
+                    reason |= EVMU_DEVICE_STOP_HALT;
+
+            } else {
+                cycles = EvmuCpu__haltCycles_(pSelf_, deadline, maxCycles - elapsed);
+            }
+
+            EvmuTimers__advance_(pDevice_->pTimers, cycles);
+            pScheduler->now += cycles * tCyc;
+            elapsed         += cycles;
+
+            if(reason) break;
+        }
+
+        if(EvmuDevice__nextDeadline_(pDevice_, pScheduler->now + 1) <= pScheduler->now &&
+           (stopMask & EVMU_DEVICE_STOP_EVENT))
+            reason |= EVMU_DEVICE_STOP_EVENT;
+
+        EvmuDevice__runEvents_(pDevice_);
+    }
+
+    if(pReason)  *pReason  = reason;
+    if(pElapsed) *pElapsed = elapsed;
+
+    return result;
+}
+
 static EVMU_RESULT EvmuCpu_IBehavior_update_(EvmuIBehavior* pIBehav, EvmuTicks ticks) {
     GBL_CTX_BEGIN(NULL);
 
     EvmuCpu*     pSelf    = EVMU_CPU(pIBehav);
     EvmuDevice*  pDevice  = EvmuPeripheral_device(EVMU_PERIPHERAL(pIBehav));
     EvmuDevice_* pDevice_ = EVMU_DEVICE_(pDevice);
-    //do timing in time domain, so when clock frequency changes, it's automatically handled
-    double time = 0.0;
-    double deltaTime = (double)ticks / 1000000000.0;
 
     EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice->pGamepad), ticks);
 
-    while(time < deltaTime) {
-        EvmuPic_update(EVMU_PIC_PUBLIC_(pDevice_->pPic));
-        EvmuTimers_update(EVMU_TIMERS_PUBLIC_(pDevice_->pTimers));
-        if(!(pDevice_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PCON)] & EVMU_SFR_PCON_HALT_MASK))
-            EvmuCpu_runNext(pSelf);
-
-        const double cpuTime = EvmuCpu_secsPerInstruction(pSelf);
-        time += cpuTime;
-        EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice->pLcd), cpuTime*1000000.0);
-
-    }
+    //do timing in integer nanoseconds on the device's timeline, so nothing drifts across updates
+    GBL_CTX_VERIFY_CALL(EvmuCpu__run_(EVMU_CPU_(pSelf),
+                                      pDevice_->scheduler.now + ticks,
+                                      UINT64_MAX,
+                                      EVMU_DEVICE_STOP_NONE,
+                                      NULL,
+                                      NULL));
 
     GBL_CTX_END();
 }
@@ -563,6 +1115,8 @@ static GBL_RESULT EvmuCpu_IBehavior_reset_(EvmuIBehavior* pSelf) {
 
     GBL_CTX_INFO("Resetting VMU CPU.");
 
+    EvmuCpu__flushCache_(EVMU_CPU_(pSelf));
+
     memset(&EVMU_CPU_(pSelf)->curInstr.encoded, 0, sizeof(EvmuInstruction));
     memset(&EVMU_CPU_(pSelf)->curInstr.decoded, 0, sizeof(EvmuInstruction));
     EVMU_CPU_(pSelf)->curInstr.pFormat = EvmuIsa_format(EVMU_OPCODE_NOP);
@@ -579,6 +1133,12 @@ static GBL_RESULT EvmuCpu_GblObject_setProperty_(GblObject* pObject, const GblPr
     case EvmuCpu_Property_Id_pc:
         EvmuCpu_setPc(pSelf, GblVariant_toUint16(pValue));
         break;
+    case EvmuCpu_Property_Id_execMode:
+        GBL_CTX_VERIFY_CALL(EvmuCpu_setExecMode(pSelf, GblVariant_toInt32(pValue)));
+        break;
+    case EvmuCpu_Property_Id_profiling:
+        GBL_CTX_VERIFY_CALL(EvmuCpu_setProfiling(pSelf, GblVariant_toBool(pValue)));
+        break;
     default:
         GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_PROPERTY,
                            "Attempt to write unknown EvmuCpu property: [%s]",
@@ -606,6 +1166,12 @@ static GBL_RESULT EvmuCpu_GblObject_property_(const GblObject* pObject, const Gb
     case EvmuCpu_Property_Id_operand3:
         GblVariant_setInt32(pValue, EvmuCpu_operand(pSelf, pProp->id - EvmuCpu_Property_Id_operand1));
         break;
+    case EvmuCpu_Property_Id_execMode:
+        GblVariant_setInt32(pValue, EvmuCpu_execMode(pSelf));
+        break;
+    case EvmuCpu_Property_Id_profiling:
+        GblVariant_setBool(pValue, EvmuCpu_profiling(pSelf));
+        break;
     default:
         GBL_CTX_RECORD_SET(GBL_RESULT_ERROR_INVALID_PROPERTY,
                            "Attempt to read unknown EvmuCpu property: [%s]",
@@ -618,7 +1184,30 @@ static GBL_RESULT EvmuCpu_GblObject_property_(const GblObject* pObject, const Gb
 
 static GBL_RESULT EvmuCpu_GblObject_constructed_(GblObject* pObject) {
     GBL_CTX_BEGIN(NULL);
+    EvmuCpu_* pSelf_ = EVMU_CPU_(pObject);
+
     GblObject_setName(pObject, EVMU_CPU_NAME);
+
+    // Switching execution modes is then free of allocations
+    pSelf_->pBlocks     = EvmuDevice__arenaAlloc_(sizeof(EvmuCpuBlock_) * EVMU_CPU__BLOCK_CACHE_SIZE_);
+    pSelf_->arenaBlocks = pSelf_->pBlocks != NULL;
+
+    EvmuCpu__flushCache_(pSelf_);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuCpu_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+#ifdef EVMU_CPU__JIT_
+    EvmuCpu__jitDeinit_(EVMU_CPU_(pBox));
+#endif
+    if(!EVMU_CPU_(pBox)->arenaBlocks)
+        free(EVMU_CPU_(pBox)->pBlocks);
+    free(EVMU_CPU_(pBox)->pProfile);
+    free(EVMU_CPU_(pBox)->trace.pPcs);
+    GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.base.pFnDestructor, pBox);
+
     GBL_CTX_END();
 }
 
@@ -636,6 +1225,7 @@ static GBL_RESULT EvmuCpuClass_init_(GblClass* pClass, const void* pData, GblCon
                           GBL_UINT16_TYPE);
     }
 
+    GBL_BOX_CLASS(pClass)       ->pFnDestructor  = EvmuCpu_GblBox_destructor_;
     GBL_OBJECT_CLASS(pClass)    ->pFnConstructed = EvmuCpu_GblObject_constructed_;
     GBL_OBJECT_CLASS(pClass)    ->pFnProperty    = EvmuCpu_GblObject_property_;
     GBL_OBJECT_CLASS(pClass)    ->pFnSetProperty = EvmuCpu_GblObject_setProperty_;
@@ -650,7 +1240,7 @@ static GBL_RESULT EvmuCpuClass_init_(GblClass* pClass, const void* pData, GblCon
 }
 
 GBL_EXPORT GblType EvmuCpu_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     static GblTypeInfo typeInfo = {
         .pFnClassInit        = EvmuCpuClass_init_,
@@ -659,15 +1249,12 @@ GBL_EXPORT GblType EvmuCpu_type(void) {
         .instancePrivateSize = sizeof(EvmuCpu_)
     };
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuCpu"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &typeInfo,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
     return type;
 }
 
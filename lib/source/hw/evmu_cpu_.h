@@ -2,11 +2,30 @@
 #define EVMU_CPU__H
 
 #include <evmu/hw/evmu_cpu.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_pic.h>
 #include <gyro_vmu_instr.h>
 
 #define EVMU_CPU_(instance)     ((EvmuCpu_*)GBL_INSTANCE_PRIVATE(instance, EVMU_CPU_TYPE))
 #define EVMU_CPU_PUBLIC_(priv)  ((EvmuCpu*)GBL_INSTANCE_PUBLIC(priv, EVMU_CPU_TYPE))
 
+#define EVMU_CPU__ICACHE_SIZE_          1024                        //!< Predecoded instruction cache entries (power of 2)
+#define EVMU_CPU__ICACHE_MASK_          (EVMU_CPU__ICACHE_SIZE_ - 1)
+#define EVMU_CPU__ICACHE_TAG_INVALID_   0xffffffff
+#define EVMU_CPU__ICACHE_TAG_(bank, pc) ((uint32_t)(bank) << 16 | (uint16_t)(pc))
+
+#define EVMU_CPU__BLOCK_CACHE_SIZE_     256                         //!< Basic blocks cached in EVMU_CPU_EXEC_MODE_BLOCK (power of 2)
+#define EVMU_CPU__BLOCK_CACHE_MASK_     (EVMU_CPU__BLOCK_CACHE_SIZE_ - 1)
+#define EVMU_CPU__BLOCK_INSTR_MAX_      16                          //!< Longest basic block, bounds peripheral update latency
+
+#define EVMU_CPU__PROFILE_NODES_        4096                        //!< Calling contexts the profiler can tell apart
+#define EVMU_CPU__PROFILE_NODE_NONE_    0xffff
+
+// The recompiler emits x86-64 SysV code into anonymous executable mappings
+#if defined(EVMU_ENABLE_JIT) && defined(__x86_64__) && (defined(__unix__) || defined(__APPLE__))
+#   define EVMU_CPU__JIT_
+#endif
+
 #define GBL_SELF_TYPE EvmuCpu_
 
 GBL_DECLS_BEGIN
@@ -32,6 +51,70 @@ typedef struct EvmuStackFrame_ {
 } EvmuStackFrame_;
 
 
+// Program memory an instruction cache entry was fetched from
+typedef enum EVMU_CPU__ICACHE_BANK_ {
+    EVMU_CPU__ICACHE_BANK_ROM_,
+    EVMU_CPU__ICACHE_BANK_FLASH_,
+    EVMU_CPU__ICACHE_BANK_COUNT_
+} EVMU_CPU__ICACHE_BANK_;
+
+// Fetched + decoded instruction, direct-mapped by PC and tagged by bank
+typedef struct EvmuCpuICacheEntry_ {
+    uint32_t                        tag;
+    EvmuInstruction                 encoded;
+    EvmuDecodedInstruction          decoded;
+    const EvmuInstructionFormat*    pFormat;
+} EvmuCpuICacheEntry_;
+
+/* Straight-line run of instructions ending in a branch, a write which
+   peripherals must observe immediately, or EVMU_CPU__BLOCK_INSTR_MAX_.
+   A read of a volatile SFR only ever leads a block, so it sees timers
+   advanced through every instruction before it. */
+typedef struct EvmuCpuBlock_ {
+    uint32_t            tag;        // bank + starting PC, same encoding as the icache
+    uint16_t            bytes;      // program bytes spanned, for invalidation
+    uint8_t             count;      // number of instructions
+    uint8_t             cycles;     // sum of every instruction's clock cycles
+    void*               pNative;    // translation for EVMU_CPU_EXEC_MODE_JIT, NULL until compiled
+    EvmuCpuICacheEntry_ instrs[EVMU_CPU__BLOCK_INSTR_MAX_];
+} EvmuCpuBlock_;
+
+/* Function or ISR as reached through one particular chain of callers,
+   forming a calling context tree rooted at whatever was running when
+   profiling started. */
+typedef struct EvmuCpuProfileNode_ {
+    uint32_t        tag;        // bank + entry PC, same encoding as the icache
+    uint16_t        parent;
+    uint16_t        child;      // first callee
+    uint16_t        sibling;    // next callee of the parent
+    uint8_t         irq;        // innermost EVMU_IRQ being serviced, EVMU_IRQ_COUNT if none
+    GblBool         isr;        // entered by the PIC rather than a CALL
+    uint64_t        calls;
+    EvmuCycles      cycles;     // spent within this context itself, excluding callees
+} EvmuCpuProfileNode_;
+
+// Everything gathered while profiling, only allocated once it's been enabled
+typedef struct EvmuCpuProfile_ {
+    uint64_t            counts   [EVMU_CPU__ICACHE_BANK_COUNT_][UINT16_MAX + 1];
+    EvmuCycles          cycles   [EVMU_CPU__ICACHE_BANK_COUNT_][UINT16_MAX + 1];
+    uint64_t            irqCounts[EVMU_IRQ_COUNT];
+    EvmuCycles          irqCycles[EVMU_IRQ_COUNT];
+    EvmuCpuProfileNode_ nodes    [EVMU_CPU__PROFILE_NODES_];
+    uint16_t            nodeCount;
+    uint16_t            current;    // context the CPU is executing within
+    uint16_t            untracked;  // calls entered after running out of nodes, charged to current
+} EvmuCpuProfile_;
+
+// Ring of executed PCs, only allocated while tracing
+typedef struct EvmuCpuTrace_ {
+    EvmuPc*         pPcs;
+    size_t          capacity;
+    size_t          head;       // next slot to be written
+    size_t          size;       // PCs currently held, up to capacity
+    EvmuCpuTraceFn  pFnFlush;
+    void*           pClosure;
+} EvmuCpuTrace_;
+
 typedef struct EvmuCpu_ {
     EvmuMemory_*    pMemory;
 
@@ -43,6 +126,24 @@ typedef struct EvmuCpu_ {
         const EvmuInstructionFormat*    pFormat;
     } curInstr;
 
+    EvmuCpuICacheEntry_ icache[EVMU_CPU__ICACHE_SIZE_];
+
+    EVMU_CPU_EXEC_MODE  execMode;
+    EvmuCpuBlock_*      pBlocks;    // lazily allocated upon entering EVMU_CPU_EXEC_MODE_BLOCK, or up front from an arena
+    GblBool             arenaBlocks; // pBlocks belongs to the device's arena rather than the heap
+
+    struct {
+        uint8_t*        pCode;      // arena mapped upon entering EVMU_CPU_EXEC_MODE_JIT, W^X page by page
+        size_t          used;       // bytes of the arena handed out to translations
+        const EvmuCpuICacheEntry_*
+                        pFault;     // instruction the last translation bailed out on, NULL if none
+    } jit;
+
+    EvmuCpuProfile_*    pProfile;   // results, kept around after profiling is disabled
+    EvmuCpuProfile_*    pProfiler;  // same as pProfile while profiling, NULL otherwise
+
+    EvmuCpuTrace_       trace;
+    GblBool             pcSignal;   // "pcChange" had connections when last checked
 } EvmuCpu_;
 
 
@@ -54,6 +155,91 @@ EVMU_INLINE void EvmuCpu__setPc_(GBL_SELF, EvmuAddress value) GBL_NOEXCEPT {
     pSelf->pc = value;
 }
 
+// Moves the PC while stepping, emitting "pcChange" only when it had connections last checked
+EVMU_INLINE void EvmuCpu__advancePc_(GBL_SELF, EvmuPc address) GBL_NOEXCEPT {
+    // Only update if PC actually changed
+    if(pSelf->pc != address) {
+        pSelf->pc = address;
+
+        // Update flag for polling
+        EVMU_CPU_PUBLIC_(pSelf)->pcChanged = GBL_TRUE;
+
+        //Notify debugger/UI of next instruction executing
+        if(pSelf->pcSignal)
+            GblSignal_emit(GBL_INSTANCE(EVMU_CPU_PUBLIC_(pSelf)), "pcChange", address);
+    }
+}
+
+// Drops every cached instruction overlapping [address, address + bytes) within the given bank
+EVMU_EXPORT void EvmuCpu__invalidateCache_(GBL_SELF,
+                                           EVMU_CPU__ICACHE_BANK_ bank,
+                                           EvmuAddress            address,
+                                           size_t                 bytes)    GBL_NOEXCEPT;
+// Drops every cached instruction
+EVMU_EXPORT void EvmuCpu__flushCache_     (GBL_SELF)                        GBL_NOEXCEPT;
+
+// Caches whether anything is connected to "pcChange", so stepping can skip emitting it
+void             EvmuCpu__checkPcSignal_  (GBL_SELF)                        GBL_NOEXCEPT;
+// Whether the built-in fetch, decode, and runNext are all in use, rather than overrides
+GblBool          EvmuCpu__builtinFetch_   (GBL_CSELF)                       GBL_NOEXCEPT;
+// Bank the next instruction will be fetched from
+EVMU_CPU__ICACHE_BANK_
+                 EvmuCpu__cacheBank_      (GBL_CSELF)                       GBL_NOEXCEPT;
+// Fetches and decodes the instruction at the current PC through the instruction cache
+const EvmuCpuICacheEntry_*
+                 EvmuCpu__fetch_          (GBL_SELF)                        GBL_NOEXCEPT;
+// Executes an already decoded instruction as though it had just been fetched from the current PC
+EVMU_RESULT      EvmuCpu__runDecoded_     (GBL_SELF,
+                                           const EvmuCpuICacheEntry_* pEntry) GBL_NOEXCEPT;
+/* Cycles a halted CPU idles for in one step, skipping ahead to the next timer overflow
+   without passing the deadline or the budget when the PIC has nothing to accept. */
+EvmuCycles       EvmuCpu__haltCycles_     (GBL_SELF,
+                                           EvmuTicks  deadline,
+                                           EvmuCycles budget)               GBL_NOEXCEPT;
+
+/* Runs the CPU along with its cycle-counting peripherals until master time reaches
+   end, maxCycles elapse, an EVMU_DEVICE_STOP condition in stopMask is hit, or an
+   instruction fails, returning that failure along with the cycles run until it. */
+EVMU_RESULT      EvmuCpu__run_            (GBL_SELF,
+                                           EvmuTicks     end,
+                                           EvmuCycles    maxCycles,
+                                           EvmuStopMask  stopMask,
+                                           EvmuStopMask* pReason,
+                                           EvmuCycles*   pElapsed)          GBL_NOEXCEPT;
+
+// Attributes a retired instruction, following it into or out of a call once it has executed
+void             EvmuCpu__profileInstr_   (GBL_SELF,
+                                           EVMU_CPU__ICACHE_BANK_        bank,
+                                           EvmuPc                        pc,
+                                           const EvmuInstructionFormat*  pFormat)  GBL_NOEXCEPT;
+// Enters the calling context of an ISR accepted by the PIC
+void             EvmuCpu__profileIrq_     (GBL_SELF, EVMU_IRQ irq)          GBL_NOEXCEPT;
+
+// Hands everything held in the trace ring to its flush callback, oldest first
+void             EvmuCpu__flushTrace_     (GBL_SELF)                        GBL_NOEXCEPT;
+
+EVMU_INLINE void EvmuCpu__tracePc_(GBL_SELF, EvmuPc pc) GBL_NOEXCEPT {
+    EvmuCpuTrace_* pTrace = &pSelf->trace;
+
+    pTrace->pPcs[pTrace->head] = pc;
+
+    if(++pTrace->head == pTrace->capacity)
+        pTrace->head = 0;
+
+    if(pTrace->size < pTrace->capacity &&
+       ++pTrace->size == pTrace->capacity && pTrace->pFnFlush)
+        EvmuCpu__flushTrace_(pSelf);
+}
+
+#ifdef EVMU_CPU__JIT_
+// Maps the executable arena used for translated blocks
+EVMU_RESULT EvmuCpu__jitInit_   (GBL_SELF)                                  GBL_NOEXCEPT;
+// Unmaps the executable arena, dropping every translation
+void        EvmuCpu__jitDeinit_ (GBL_SELF)                                  GBL_NOEXCEPT;
+// Translates a basic block to native code, returning NULL if it couldn't be
+void*       EvmuCpu__jitCompile_(GBL_SELF, EvmuCpuBlock_* pBlock)           GBL_NOEXCEPT;
+#endif
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
@@ -0,0 +1,326 @@
+/*  x86-64 recompiler backend for EVMU_CPU_EXEC_MODE_JIT
+ *
+ *  Translates the basic blocks built for EVMU_CPU_EXEC_MODE_BLOCK into
+ *  straight-line native code. Instructions which only touch general-purpose
+ *  RAM or ACC without affecting the arithmetic flags are emitted inline.
+ *  RAM addresses with an installed EvmuMemoryHandler are never inlined.
+ *  Everything else, including any SFR access with side-effects, becomes a
+ *  call back into EvmuCpuClass::pFnExecute, so the interpreter remains the
+ *  single source of truth for the rest of the ISA.
+ *
+ *  A failing EVMU_RESULT from the interpreter ends the translation right
+ *  there, and is handed back to EvmuCpu_runBlock_() just as if the block
+ *  had been interpreted.
+ *
+ *  The arena is never writable and executable at once: pages are flipped to
+ *  read/write while a block is being emitted, then back to read/execute.
+ *
+ *  Translations hang off of their EvmuCpuBlock_, so they are dropped along
+ *  with it whenever flash is rewritten, and since blocks are tagged by
+ *  program bank, toggling EXT can never run code from the wrong bank.
+ */
+#include "evmu_cpu_.h"
+
+#ifdef EVMU_CPU__JIT_
+
+#include "evmu_memory_.h"
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define EVMU_CPU_JIT_ARENA_SIZE_    (256 * 1024)    // executable memory per EvmuCpu
+#define EVMU_CPU_JIT_BLOCK_MAX_     1024            // upper bound on code emitted for one block
+
+// Odd parity for every byte value, matching PSW.P
+#define EVMU_CPU_JIT_P2_(n) n, n^1, n^1, n
+#define EVMU_CPU_JIT_P4_(n) EVMU_CPU_JIT_P2_(n), EVMU_CPU_JIT_P2_(n^1), EVMU_CPU_JIT_P2_(n^1), EVMU_CPU_JIT_P2_(n)
+#define EVMU_CPU_JIT_P6_(n) EVMU_CPU_JIT_P4_(n), EVMU_CPU_JIT_P4_(n^1), EVMU_CPU_JIT_P4_(n^1), EVMU_CPU_JIT_P4_(n)
+
+static const uint8_t parityTable_[256] = {
+    EVMU_CPU_JIT_P6_(0), EVMU_CPU_JIT_P6_(1), EVMU_CPU_JIT_P6_(1), EVMU_CPU_JIT_P6_(0)
+};
+
+/* Register assignments within a translated block (all callee-saved):
+ *   rbx - &EvmuMemory_::sfr[0]       (ACC, followed by PSW)
+ *   r12 - &EvmuMemory_::pIntMap[0]   (current RAM bank, reloaded per access)
+ *   r13 - parityTable_
+ *   r14 - EvmuCpu* passed to the interpreter
+ *   r15 - EvmuCpu_jitExecute_()
+ */
+typedef struct EvmuCpuJitEmitter_ {
+    uint8_t* pCur;
+} EvmuCpuJitEmitter_;
+
+static void EvmuCpuJit_emit_(EvmuCpuJitEmitter_* pEmit, const uint8_t* pBytes, size_t count) {
+    memcpy(pEmit->pCur, pBytes, count);
+    pEmit->pCur += count;
+}
+
+#define EVMU_CPU_JIT_EMIT_(pEmit, ...) \
+    EvmuCpuJit_emit_(pEmit, (const uint8_t[]){ __VA_ARGS__ }, sizeof((const uint8_t[]){ __VA_ARGS__ }))
+
+static void EvmuCpuJit_emit32_(EvmuCpuJitEmitter_* pEmit, uint32_t value) {
+    memcpy(pEmit->pCur, &value, sizeof(value));
+    pEmit->pCur += sizeof(value);
+}
+
+static void EvmuCpuJit_emit64_(EvmuCpuJitEmitter_* pEmit, uint64_t value) {
+    memcpy(pEmit->pCur, &value, sizeof(value));
+    pEmit->pCur += sizeof(value);
+}
+
+/* Called from translated code for every instruction which isn't emitted inline,
+   returning non-zero only when the translation has to bail out on an error. */
+static EVMU_RESULT EvmuCpu_jitExecute_(EvmuCpu* pSelf, const EvmuCpuICacheEntry_* pInstr, EvmuPc nextPc) {
+    EvmuCpu_* pSelf_ = EVMU_CPU_(pSelf);
+
+    pSelf_->curInstr.encoded = pInstr->encoded;
+    pSelf_->curInstr.decoded = pInstr->decoded;
+    pSelf_->curInstr.pFormat = pInstr->pFormat;
+
+    EvmuCpu__advancePc_(pSelf_, nextPc);
+
+    const EVMU_RESULT result = EVMU_CPU_GET_CLASS(pSelf)->pFnExecute(pSelf, &pInstr->decoded);
+
+    if(GBL_RESULT_SUCCESS(result))
+        return GBL_RESULT_SUCCESS;
+
+    pSelf_->jit.pFault = pInstr;
+    return result;
+}
+
+// Called from translated code falling through to the next block
+static void EvmuCpu_jitFallThrough_(EvmuCpu* pSelf, EvmuPc nextPc) {
+    EvmuCpu__advancePc_(EVMU_CPU_(pSelf), nextPc);
+}
+
+// Changes the protection of every arena page overlapping [pStart, pEnd)
+static GblBool EvmuCpuJit_protect_(uint8_t* pStart, uint8_t* pEnd, int prot) {
+    const uintptr_t page  = (uintptr_t)sysconf(_SC_PAGESIZE);
+    const uintptr_t first = (uintptr_t)pStart & ~(page - 1);
+    const uintptr_t last  = ((uintptr_t)pEnd + page - 1) & ~(page - 1);
+
+    return mprotect((void*)first, last - first, prot) == 0;
+}
+
+// Throws away every translation, starting the arena over
+static void EvmuCpuJit_reset_(EvmuCpu_* pSelf) {
+    for(size_t b = 0; b < EVMU_CPU__BLOCK_CACHE_SIZE_; ++b)
+        pSelf->pBlocks[b].pNative = NULL;
+
+    pSelf->jit.used = 0;
+}
+
+// mov rax, [r12] (base of the active RAM bank)
+static void EvmuCpuJit_emitRamBase_(EvmuCpuJitEmitter_* pEmit) {
+    EVMU_CPU_JIT_EMIT_(pEmit, 0x49, 0x8b, 0x04, 0x24);
+}
+
+// Stores cl into ACC, refreshing PSW.P only when ACC changes. EvmuMemory_ defers this
+// for interpreted writes, but a parity still pending there resolves to the same value.
+static void EvmuCpuJit_emitWriteAcc_(EvmuCpuJitEmitter_* pEmit) {
+    EVMU_CPU_JIT_EMIT_(pEmit,
+                       0x3a, 0x0b,                          // cmp   cl, [rbx]
+                       0x74, 0x12,                          // je    +18
+                       0x88, 0x0b,                          // mov   [rbx], cl
+                       0x0f, 0xb6, 0xc1,                    // movzx eax, cl
+                       0x41, 0x0f, 0xb6, 0x44, 0x05, 0x00,  // movzx eax, byte [r13 + rax]
+                       0x80, 0x63, 0x01, 0xfe,              // and   byte [rbx + 1], 0xfe
+                       0x08, 0x43, 0x01);                   // or    [rbx + 1], al
+}
+
+// Emits an instruction inline if it can't have side-effects beyond RAM, ACC, and PSW.P
+static GblBool EvmuCpuJit_emitNative_(EvmuCpuJitEmitter_*           pEmit,
+                                      const EvmuMemory_*            pMemory,
+                                      const EvmuDecodedInstruction* pInstr) {
+    const uint16_t direct = pInstr->operands.direct;
+    const GblBool  ram    = direct <= EVMU_ADDRESS_SEGMENT_RAM_END &&
+                            EvmuMemory__isDirect_(pMemory, direct);
+    const uint8_t  bit    = 1u << pInstr->operands.bit;
+
+    switch(pInstr->opcode) {
+    case EVMU_OPCODE_NOP:
+        return GBL_TRUE;
+    case EVMU_OPCODE_ST:
+        if(!ram) return GBL_FALSE;
+        EVMU_CPU_JIT_EMIT_(pEmit, 0x8a, 0x0b);              // mov cl, [rbx]
+        EvmuCpuJit_emitRamBase_(pEmit);
+        EVMU_CPU_JIT_EMIT_(pEmit, 0x88, 0x88);              // mov [rax + d], cl
+        EvmuCpuJit_emit32_(pEmit, direct);
+        return GBL_TRUE;
+    case EVMU_OPCODE_MOV:
+        if(!ram) return GBL_FALSE;
+        EvmuCpuJit_emitRamBase_(pEmit);
+        EVMU_CPU_JIT_EMIT_(pEmit, 0xc6, 0x80);              // mov byte [rax + d], i
+        EvmuCpuJit_emit32_(pEmit, direct);
+        EVMU_CPU_JIT_EMIT_(pEmit, pInstr->operands.immediate);
+        return GBL_TRUE;
+    case EVMU_OPCODE_INC:
+    case EVMU_OPCODE_DEC:
+        if(!ram) return GBL_FALSE;
+        EvmuCpuJit_emitRamBase_(pEmit);
+        EVMU_CPU_JIT_EMIT_(pEmit, 0xfe,                     // inc/dec byte [rax + d]
+                           pInstr->opcode == EVMU_OPCODE_INC? 0x80 : 0x88);
+        EvmuCpuJit_emit32_(pEmit, direct);
+        return GBL_TRUE;
+    case EVMU_OPCODE_SET1:
+    case EVMU_OPCODE_CLR1:
+    case EVMU_OPCODE_NOT1:
+        if(!ram) return GBL_FALSE;
+        EvmuCpuJit_emitRamBase_(pEmit);
+        EVMU_CPU_JIT_EMIT_(pEmit, 0x80,                     // or/and/xor byte [rax + d], mask
+                           pInstr->opcode == EVMU_OPCODE_SET1? 0x88 :
+                           pInstr->opcode == EVMU_OPCODE_CLR1? 0xa0 : 0xb0);
+        EvmuCpuJit_emit32_(pEmit, direct);
+        EVMU_CPU_JIT_EMIT_(pEmit, pInstr->opcode == EVMU_OPCODE_CLR1? (uint8_t)~bit : bit);
+        return GBL_TRUE;
+    case EVMU_OPCODE_LD:
+        if(!ram) return GBL_FALSE;
+        EvmuCpuJit_emitRamBase_(pEmit);
+        EVMU_CPU_JIT_EMIT_(pEmit, 0x0f, 0xb6, 0x88);        // movzx ecx, byte [rax + d]
+        EvmuCpuJit_emit32_(pEmit, direct);
+        EvmuCpuJit_emitWriteAcc_(pEmit);
+        return GBL_TRUE;
+    case EVMU_OPCODE_ANDI:
+    case EVMU_OPCODE_ORI:
+    case EVMU_OPCODE_XORI:
+        EVMU_CPU_JIT_EMIT_(pEmit, 0x0f, 0xb6, 0x0b,         // movzx ecx, byte [rbx]
+                           0x81,                            // and/or/xor ecx, i
+                           pInstr->opcode == EVMU_OPCODE_ANDI? 0xe1 :
+                           pInstr->opcode == EVMU_OPCODE_ORI?  0xc9 : 0xf1);
+        EvmuCpuJit_emit32_(pEmit, pInstr->operands.immediate);
+        EvmuCpuJit_emitWriteAcc_(pEmit);
+        return GBL_TRUE;
+    case EVMU_OPCODE_AND:
+    case EVMU_OPCODE_OR:
+    case EVMU_OPCODE_XOR:
+        if(!ram) return GBL_FALSE;
+        EvmuCpuJit_emitRamBase_(pEmit);
+        EVMU_CPU_JIT_EMIT_(pEmit, 0x0f, 0xb6, 0x0b,         // movzx ecx, byte [rbx]
+                           pInstr->opcode == EVMU_OPCODE_AND? 0x22 :
+                           pInstr->opcode == EVMU_OPCODE_OR?  0x0a : 0x32,
+                           0x88);                           // and/or/xor cl, [rax + d]
+        EvmuCpuJit_emit32_(pEmit, direct);
+        EvmuCpuJit_emitWriteAcc_(pEmit);
+        return GBL_TRUE;
+    default:
+        return GBL_FALSE;
+    }
+}
+
+EVMU_RESULT EvmuCpu__jitInit_(EvmuCpu_* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    if(!pSelf->jit.pCode) {
+        void* pCode = mmap(NULL,
+                           EVMU_CPU_JIT_ARENA_SIZE_,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS,
+                           -1,
+                           0);
+
+        GBL_CTX_VERIFY(pCode != MAP_FAILED,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to map executable memory for the recompiler!");
+
+        pSelf->jit.pCode = pCode;
+        pSelf->jit.used  = 0;
+    }
+
+    GBL_CTX_END();
+}
+
+void EvmuCpu__jitDeinit_(EvmuCpu_* pSelf) {
+    if(pSelf->jit.pCode) {
+        munmap(pSelf->jit.pCode, EVMU_CPU_JIT_ARENA_SIZE_);
+        pSelf->jit.pCode = NULL;
+    }
+
+    if(pSelf->pBlocks)
+        for(size_t b = 0; b < EVMU_CPU__BLOCK_CACHE_SIZE_; ++b)
+            pSelf->pBlocks[b].pNative = NULL;
+}
+
+void* EvmuCpu__jitCompile_(EvmuCpu_* pSelf, EvmuCpuBlock_* pBlock) {
+    if(!pSelf->jit.pCode) return NULL;
+
+    // Out of room
+    if(pSelf->jit.used + EVMU_CPU_JIT_BLOCK_MAX_ > EVMU_CPU_JIT_ARENA_SIZE_)
+        EvmuCpuJit_reset_(pSelf);
+
+    uint8_t*           pEntry  = pSelf->jit.pCode + pSelf->jit.used;
+    EvmuCpuJitEmitter_ emit    = { pEntry };
+    EvmuPc             pc      = pBlock->tag & 0xffff;
+    GblBool            native  = GBL_FALSE;
+    uint8_t*           pBails[EVMU_CPU__BLOCK_INSTR_MAX_];
+    uint8_t            bails   = 0;
+
+    // Neighboring translations sharing these pages can't run while this one is emitted
+    if(!EvmuCpuJit_protect_(pEntry, pEntry + EVMU_CPU_JIT_BLOCK_MAX_, PROT_READ | PROT_WRITE))
+        return NULL;
+
+    // Prologue, 5 pushes leave the stack 16-byte aligned for calls
+    EVMU_CPU_JIT_EMIT_(&emit, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57);
+    EVMU_CPU_JIT_EMIT_(&emit, 0x48, 0xbb);                  // mov rbx, &sfr[0]
+    EvmuCpuJit_emit64_(&emit, (uintptr_t)pSelf->pMemory->sfr);
+    EVMU_CPU_JIT_EMIT_(&emit, 0x49, 0xbc);                  // mov r12, &pIntMap[0]
+    EvmuCpuJit_emit64_(&emit, (uintptr_t)pSelf->pMemory->pIntMap);
+    EVMU_CPU_JIT_EMIT_(&emit, 0x49, 0xbd);                  // mov r13, parityTable_
+    EvmuCpuJit_emit64_(&emit, (uintptr_t)parityTable_);
+    EVMU_CPU_JIT_EMIT_(&emit, 0x49, 0xbe);                  // mov r14, pSelf
+    EvmuCpuJit_emit64_(&emit, (uintptr_t)EVMU_CPU_PUBLIC_(pSelf));
+    EVMU_CPU_JIT_EMIT_(&emit, 0x49, 0xbf);                  // mov r15, EvmuCpu_jitExecute_
+    EvmuCpuJit_emit64_(&emit, (uintptr_t)EvmuCpu_jitExecute_);
+
+    for(uint8_t i = 0; i < pBlock->count; ++i) {
+        const EvmuCpuICacheEntry_* pInstr = &pBlock->instrs[i];
+
+        pc    += pInstr->pFormat->bytes;
+        native = EvmuCpuJit_emitNative_(&emit, pSelf->pMemory, &pInstr->decoded);
+
+        if(!native) {
+            EVMU_CPU_JIT_EMIT_(&emit, 0x4c, 0x89, 0xf7);    // mov rdi, r14
+            EVMU_CPU_JIT_EMIT_(&emit, 0x48, 0xbe);          // mov rsi, pInstr
+            EvmuCpuJit_emit64_(&emit, (uintptr_t)pInstr);
+            EVMU_CPU_JIT_EMIT_(&emit, 0xba);                // mov edx, pc
+            EvmuCpuJit_emit32_(&emit, pc);
+            EVMU_CPU_JIT_EMIT_(&emit, 0x41, 0xff, 0xd7);    // call r15
+            EVMU_CPU_JIT_EMIT_(&emit, 0x85, 0xc0);          // test eax, eax
+            EVMU_CPU_JIT_EMIT_(&emit, 0x0f, 0x85);          // jnz  epilogue
+            pBails[bails++] = emit.pCur;
+            EvmuCpuJit_emit32_(&emit, 0);
+        }
+    }
+
+    // Fall through to the next block when the last instruction didn't set the PC itself
+    if(native) {
+        EVMU_CPU_JIT_EMIT_(&emit, 0x4c, 0x89, 0xf7);        // mov rdi, r14
+        EVMU_CPU_JIT_EMIT_(&emit, 0xbe);                    // mov esi, pc
+        EvmuCpuJit_emit32_(&emit, pc);
+        EVMU_CPU_JIT_EMIT_(&emit, 0x48, 0xb8);              // mov rax, EvmuCpu_jitFallThrough_
+        EvmuCpuJit_emit64_(&emit, (uintptr_t)EvmuCpu_jitFallThrough_);
+        EVMU_CPU_JIT_EMIT_(&emit, 0xff, 0xd0);              // call rax
+    }
+
+    EVMU_CPU_JIT_EMIT_(&emit, 0x31, 0xc0);                  // xor eax, eax
+
+    // Epilogue, returning the EVMU_RESULT in eax
+    for(uint8_t b = 0; b < bails; ++b) {
+        const uint32_t rel = (uint32_t)(emit.pCur - (pBails[b] + sizeof(uint32_t)));
+        memcpy(pBails[b], &rel, sizeof(rel));
+    }
+
+    EVMU_CPU_JIT_EMIT_(&emit, 0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, 0x5b, 0xc3);
+
+    // Leaving pages writable would strand every translation on them, so start over instead
+    if(!EvmuCpuJit_protect_(pEntry, pEntry + EVMU_CPU_JIT_BLOCK_MAX_, PROT_READ | PROT_EXEC)) {
+        EvmuCpuJit_reset_(pSelf);
+        return NULL;
+    }
+
+    pSelf->jit.used += (size_t)(emit.pCur - pEntry);
+
+    return pEntry;
+}
+
+#endif
@@ -0,0 +1,344 @@
+/*  Instruction-level profiler for EvmuCpu
+ *
+ *  Every retired instruction is charged to its PC, and to the node of a
+ *  calling context tree for the function or ISR it ran within. CALL,
+ *  CALLF, and CALLR descend into a child context, interrupts accepted by
+ *  the PIC descend into an ISR context, and RET/RETI climb back out.
+ *
+ *  Nothing here runs unless EvmuCpu_::pProfiler is set, which is the
+ *  only thing the CPU core checks along its hot paths.
+ */
+#include "evmu_cpu_.h"
+#include "evmu_memory_.h"
+#include <stdlib.h>
+#include <inttypes.h>
+
+#define EVMU_CPU_PROFILE_FRAME_SIZE_    24
+
+typedef struct EvmuCpuProfileEntry_ {
+    EVMU_CPU__ICACHE_BANK_  bank;
+    EvmuPc                  pc;
+    uint64_t                count;
+    EvmuCycles              cycles;
+} EvmuCpuProfileEntry_;
+
+static void EvmuCpu_profileClear_(EvmuCpuProfile_* pProfile) {
+    memset(pProfile, 0, sizeof(EvmuCpuProfile_));
+
+    // Root context stands in for whatever was running when profiling started
+    pProfile->nodes[0].tag     = EVMU_CPU__ICACHE_TAG_INVALID_;
+    pProfile->nodes[0].parent  = EVMU_CPU__PROFILE_NODE_NONE_;
+    pProfile->nodes[0].child   = EVMU_CPU__PROFILE_NODE_NONE_;
+    pProfile->nodes[0].sibling = EVMU_CPU__PROFILE_NODE_NONE_;
+    pProfile->nodes[0].irq     = EVMU_IRQ_COUNT;
+    pProfile->nodeCount        = 1;
+}
+
+static void EvmuCpu_profileEnter_(EvmuCpuProfile_* pProfile, uint32_t tag, GblBool isr, EVMU_IRQ irq) {
+    EvmuCpuProfileNode_* pParent = &pProfile->nodes[pProfile->current];
+    uint16_t             n;
+
+    if(pProfile->untracked) {
+        ++pProfile->untracked;
+        return;
+    }
+
+    for(n = pParent->child; n != EVMU_CPU__PROFILE_NODE_NONE_; n = pProfile->nodes[n].sibling)
+        if(pProfile->nodes[n].tag == tag && pProfile->nodes[n].isr == isr)
+            break;
+
+    if(n == EVMU_CPU__PROFILE_NODE_NONE_) {
+        // Out of contexts (ie: deep recursion), keep charging the caller until it returns
+        if(pProfile->nodeCount == EVMU_CPU__PROFILE_NODES_) {
+            pProfile->untracked = 1;
+            return;
+        }
+
+        n = pProfile->nodeCount++;
+
+        EvmuCpuProfileNode_* pNode = &pProfile->nodes[n];
+        pNode->tag     = tag;
+        pNode->parent  = pProfile->current;
+        pNode->child   = EVMU_CPU__PROFILE_NODE_NONE_;
+        pNode->sibling = pParent->child;
+        pNode->irq     = isr? irq : pParent->irq;
+        pNode->isr     = isr;
+        pParent->child = n;
+    }
+
+    ++pProfile->nodes[n].calls;
+    pProfile->current = n;
+}
+
+static void EvmuCpu_profileLeave_(EvmuCpuProfile_* pProfile) {
+    if(pProfile->untracked)
+        --pProfile->untracked;
+    // Returning out of the root just means profiling started within a callee
+    else if(pProfile->current)
+        pProfile->current = pProfile->nodes[pProfile->current].parent;
+}
+
+void EvmuCpu__profileInstr_(EvmuCpu_*                    pSelf,
+                            EVMU_CPU__ICACHE_BANK_       bank,
+                            EvmuPc                       pc,
+                            const EvmuInstructionFormat* pFormat)
+{
+    EvmuCpuProfile_*     pProfile = pSelf->pProfiler;
+    EvmuCpuProfileNode_* pNode    = &pProfile->nodes[pProfile->current];
+
+    ++pProfile->counts[bank][pc];
+    pProfile->cycles[bank][pc] += pFormat->cc;
+    pNode->cycles              += pFormat->cc;
+
+    if(pNode->irq != EVMU_IRQ_COUNT)
+        pProfile->irqCycles[pNode->irq] += pFormat->cc;
+
+    // Already executed, so the PC is now the callee for a call
+    switch(pFormat->opcode) {
+    case EVMU_OPCODE_CALL:
+    case EVMU_OPCODE_CALLF:
+    case EVMU_OPCODE_CALLR:
+        EvmuCpu_profileEnter_(pProfile, EVMU_CPU__ICACHE_TAG_(bank, pSelf->pc), GBL_FALSE, EVMU_IRQ_COUNT);
+        break;
+    case EVMU_OPCODE_RET:
+    case EVMU_OPCODE_RETI:
+        EvmuCpu_profileLeave_(pProfile);
+        break;
+    default: break;
+    }
+}
+
+void EvmuCpu__profileIrq_(EvmuCpu_* pSelf, EVMU_IRQ irq) {
+    EvmuCpuProfile_*             pProfile = pSelf->pProfiler;
+    const EVMU_CPU__ICACHE_BANK_ bank     = (pSelf->pMemory->pExt == pSelf->pMemory->rom)?
+                                                EVMU_CPU__ICACHE_BANK_ROM_ : EVMU_CPU__ICACHE_BANK_FLASH_;
+
+    ++pProfile->irqCounts[irq];
+    EvmuCpu_profileEnter_(pProfile, EVMU_CPU__ICACHE_TAG_(bank, pSelf->pc), GBL_TRUE, irq);
+}
+
+EVMU_EXPORT GblBool EvmuCpu_profiling(const EvmuCpu* pSelf) {
+    return EVMU_CPU_(pSelf)->pProfiler != NULL;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuCpu_setProfiling(EvmuCpu* pSelf, GblBool enabled) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuCpu_* pSelf_ = EVMU_CPU_(pSelf);
+
+    if(enabled && !pSelf_->pProfile) {
+        pSelf_->pProfile = malloc(sizeof(EvmuCpuProfile_));
+
+        GBL_CTX_VERIFY(pSelf_->pProfile,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to allocate CPU profile!");
+
+        EvmuCpu_profileClear_(pSelf_->pProfile);
+    }
+
+    pSelf_->pProfiler = enabled? pSelf_->pProfile : NULL;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT void EvmuCpu_clearProfile(EvmuCpu* pSelf) {
+    EvmuCpu_* pSelf_ = EVMU_CPU_(pSelf);
+
+    if(pSelf_->pProfile)
+        EvmuCpu_profileClear_(pSelf_->pProfile);
+}
+
+EVMU_EXPORT uint64_t EvmuCpu_profileCount(const EvmuCpu* pSelf, EvmuPc pc) {
+    const EvmuCpuProfile_* pProfile = EVMU_CPU_(pSelf)->pProfile;
+    uint64_t               count    = 0;
+
+    if(pProfile)
+        for(size_t b = 0; b < EVMU_CPU__ICACHE_BANK_COUNT_; ++b)
+            count += pProfile->counts[b][pc];
+
+    return count;
+}
+
+EVMU_EXPORT EvmuCycles EvmuCpu_profileCycles(const EvmuCpu* pSelf, EvmuPc pc) {
+    const EvmuCpuProfile_* pProfile = EVMU_CPU_(pSelf)->pProfile;
+    EvmuCycles             cycles   = 0;
+
+    if(pProfile)
+        for(size_t b = 0; b < EVMU_CPU__ICACHE_BANK_COUNT_; ++b)
+            cycles += pProfile->cycles[b][pc];
+
+    return cycles;
+}
+
+EVMU_EXPORT EvmuCycles EvmuCpu_profileIrqCycles(const EvmuCpu* pSelf, EVMU_IRQ irq) {
+    const EvmuCpuProfile_* pProfile = EVMU_CPU_(pSelf)->pProfile;
+
+    return (pProfile && irq < EVMU_IRQ_COUNT)? pProfile->irqCycles[irq] : 0;
+}
+
+static const char* EvmuCpu_profileBankName_(EVMU_CPU__ICACHE_BANK_ bank) {
+    return bank == EVMU_CPU__ICACHE_BANK_ROM_? "rom" : "flash";
+}
+
+static const char* EvmuCpu_profileFrame_(const EvmuCpuProfileNode_* pNode,
+                                         char                       buffer[EVMU_CPU_PROFILE_FRAME_SIZE_])
+{
+    if(pNode->tag == EVMU_CPU__ICACHE_TAG_INVALID_)
+        snprintf(buffer, EVMU_CPU_PROFILE_FRAME_SIZE_, "root");
+    else if(pNode->isr)
+        snprintf(buffer, EVMU_CPU_PROFILE_FRAME_SIZE_, "isr%u", pNode->irq);
+    else
+        snprintf(buffer, EVMU_CPU_PROFILE_FRAME_SIZE_, "%s:0x%04x",
+                 EvmuCpu_profileBankName_(pNode->tag >> 16), pNode->tag & 0xffff);
+
+    return buffer;
+}
+
+static int EvmuCpu_profileEntryCompare_(const void* pLhs, const void* pRhs) {
+    const EvmuCpuProfileEntry_* pA = pLhs;
+    const EvmuCpuProfileEntry_* pB = pRhs;
+
+    return (pA->cycles < pB->cycles) - (pA->cycles > pB->cycles);
+}
+
+static EVMU_RESULT EvmuCpu_writeFlat_(const EvmuCpuProfile_* pProfile, GblStringBuffer* pBuffer) {
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuCpuProfileEntry_* pEntries = NULL;
+    size_t                count    = 0;
+    EvmuCycles            total    = 0;
+
+    for(size_t b = 0; b < EVMU_CPU__ICACHE_BANK_COUNT_; ++b)
+        for(size_t pc = 0; pc <= UINT16_MAX; ++pc)
+            if(pProfile->counts[b][pc]) {
+                ++count;
+                total += pProfile->cycles[b][pc];
+            }
+
+    pEntries = malloc(sizeof(EvmuCpuProfileEntry_) * (count? count : 1));
+    GBL_CTX_VERIFY(pEntries,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "Failed to allocate profile table!");
+
+    count = 0;
+    for(size_t b = 0; b < EVMU_CPU__ICACHE_BANK_COUNT_; ++b)
+        for(size_t pc = 0; pc <= UINT16_MAX; ++pc)
+            if(pProfile->counts[b][pc])
+                pEntries[count++] = (EvmuCpuProfileEntry_) {
+                    .bank   = b,
+                    .pc     = pc,
+                    .count  = pProfile->counts[b][pc],
+                    .cycles = pProfile->cycles[b][pc]
+                };
+
+    qsort(pEntries, count, sizeof(EvmuCpuProfileEntry_), EvmuCpu_profileEntryCompare_);
+
+    GblStringBuffer_appendPrintf(pBuffer, "%-5s %-6s %12s %14s %7s\n",
+                                 "bank", "pc", "count", "cycles", "%");
+
+    for(size_t e = 0; e < count; ++e)
+        GblStringBuffer_appendPrintf(pBuffer, "%-5s 0x%04x %12" PRIu64 " %14" PRIu64 " %7.3f\n",
+                                     EvmuCpu_profileBankName_(pEntries[e].bank),
+                                     pEntries[e].pc,
+                                     pEntries[e].count,
+                                     pEntries[e].cycles,
+                                     100.0 * pEntries[e].cycles / total);
+
+    for(size_t i = 0; i < EVMU_IRQ_COUNT; ++i)
+        if(pProfile->irqCounts[i])
+            GblStringBuffer_appendPrintf(pBuffer, "isr%-2zu %-6s %12" PRIu64 " %14" PRIu64 " %7.3f\n",
+                                         i, "-",
+                                         pProfile->irqCounts[i],
+                                         pProfile->irqCycles[i],
+                                         100.0 * pProfile->irqCycles[i] / (total? total : 1));
+
+    free(pEntries);
+
+    GBL_CTX_END();
+}
+
+static void EvmuCpu_writeCallGraph_(const EvmuCpuProfile_* pProfile, GblStringBuffer* pBuffer) {
+    char caller[EVMU_CPU_PROFILE_FRAME_SIZE_];
+    char callee[EVMU_CPU_PROFILE_FRAME_SIZE_];
+
+    GblStringBuffer_appendPrintf(pBuffer, "%-16s %-16s %12s\n", "caller", "callee", "calls");
+
+    // The same edge shows up once per calling context, so merge them into its first occurrence
+    for(uint16_t n = 1; n < pProfile->nodeCount; ++n) {
+        const EvmuCpuProfileNode_* pNode   = &pProfile->nodes[n];
+        const uint32_t             from    = pProfile->nodes[pNode->parent].tag;
+        GblBool                    visited = GBL_FALSE;
+        uint64_t                   calls   = 0;
+
+        for(uint16_t m = 1; m < n && !visited; ++m)
+            visited = pProfile->nodes[m].tag == pNode->tag &&
+                      pProfile->nodes[m].isr == pNode->isr &&
+                      pProfile->nodes[pProfile->nodes[m].parent].tag == from;
+
+        if(visited) continue;
+
+        for(uint16_t m = n; m < pProfile->nodeCount; ++m)
+            if(pProfile->nodes[m].tag == pNode->tag &&
+               pProfile->nodes[m].isr == pNode->isr &&
+               pProfile->nodes[pProfile->nodes[m].parent].tag == from)
+                calls += pProfile->nodes[m].calls;
+
+        GblStringBuffer_appendPrintf(pBuffer, "%-16s %-16s %12" PRIu64 "\n",
+                                     EvmuCpu_profileFrame_(&pProfile->nodes[pNode->parent], caller),
+                                     EvmuCpu_profileFrame_(pNode, callee),
+                                     calls);
+    }
+}
+
+static void EvmuCpu_writeCollapsed_(const EvmuCpuProfile_* pProfile, GblStringBuffer* pBuffer) {
+    char     frame[EVMU_CPU_PROFILE_FRAME_SIZE_];
+    uint16_t stack[EVMU_CPU__PROFILE_NODES_];
+
+    for(uint16_t n = 0; n < pProfile->nodeCount; ++n) {
+        if(!pProfile->nodes[n].cycles) continue;
+
+        size_t depth = 0;
+        for(uint16_t s = n; s != EVMU_CPU__PROFILE_NODE_NONE_; s = pProfile->nodes[s].parent)
+            stack[depth++] = s;
+
+        while(depth--)
+            GblStringBuffer_appendPrintf(pBuffer, depth? "%s;" : "%s",
+                                         EvmuCpu_profileFrame_(&pProfile->nodes[stack[depth]], frame));
+
+        GblStringBuffer_appendPrintf(pBuffer, " %" PRIu64 "\n", pProfile->nodes[n].cycles);
+    }
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuCpu_writeProfile(const EvmuCpu*          pSelf,
+                                             EVMU_CPU_PROFILE_FORMAT format,
+                                             GblStringBuffer*        pBuffer)
+{
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pBuffer);
+    GBL_CTX_VERIFY_ARG(format < EVMU_CPU_PROFILE_FORMAT_COUNT);
+
+    const EvmuCpuProfile_* pProfile = EVMU_CPU_(pSelf)->pProfile;
+
+    GBL_CTX_VERIFY(pProfile,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "Profiling has never been enabled!");
+
+    switch(format) {
+    case EVMU_CPU_PROFILE_FORMAT_FLAT:
+        GBL_CTX_VERIFY_CALL(EvmuCpu_writeFlat_(pProfile, pBuffer));
+        break;
+    case EVMU_CPU_PROFILE_FORMAT_CALL_GRAPH:
+        EvmuCpu_writeCallGraph_(pProfile, pBuffer);
+        break;
+    case EVMU_CPU_PROFILE_FORMAT_COLLAPSED:
+        EvmuCpu_writeCollapsed_(pProfile, pBuffer);
+        break;
+    default: break;
+    }
+
+    GBL_CTX_END();
+}
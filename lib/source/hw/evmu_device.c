@@ -23,16 +23,115 @@
 #include "evmu_pic_.h"
 #include "evmu_flash_.h"
 #include "../fs/evmu_fat_.h"
+#include "../types/evmu_type_.h"
+#include "../types/evmu_journal_.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef EVMU_TYPE__THREADS_
+#   define EVMU_DEVICE__THREAD_LOCAL_   _Thread_local
+#else
+#   define EVMU_DEVICE__THREAD_LOCAL_
+#endif
+
+#define EVMU_DEVICE__ARENA_ALIGN_(bytes)    (((bytes) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+#define EVMU_DEVICE__ARENA_SIZE_            (EVMU_DEVICE__ARENA_ALIGN_(sizeof(EvmuMemoryRom_)) + \
+                                             EVMU_DEVICE__ARENA_ALIGN_(sizeof(EvmuCpuBlock_) * EVMU_CPU__BLOCK_CACHE_SIZE_))
+
+// EVMU_DEVICE_CREATE flags for the next device constructed on this thread
+static EVMU_DEVICE__THREAD_LOCAL_ GblFlags     createFlags_ = EVMU_DEVICE_CREATE_DEFAULT;
+// Device whose peripherals are being constructed on this thread
+static EVMU_DEVICE__THREAD_LOCAL_ EvmuDevice_* pConstructing_ = NULL;
+
+void* EvmuDevice__arenaAlloc_(size_t bytes) {
+    EvmuDevice_* pDevice = pConstructing_;
+
+    bytes = EVMU_DEVICE__ARENA_ALIGN_(bytes);
+
+    if(!pDevice || !pDevice->pArena || pDevice->arenaUsed + bytes > EVMU_DEVICE__ARENA_SIZE_)
+        return NULL;
+
+    void* pBytes = &pDevice->pArena[pDevice->arenaUsed];
+    pDevice->arenaUsed += bytes;
+
+    return pBytes;
+}
 
 EVMU_EXPORT EvmuDevice* EvmuDevice_create(void) {
     return GBL_NEW(EvmuDevice);
 }
 
+EVMU_EXPORT EvmuDevice* EvmuDevice_createExt(GblFlags flags) {
+    createFlags_ = flags;
+    EvmuDevice* pDevice = GBL_NEW(EvmuDevice);
+    createFlags_ = EVMU_DEVICE_CREATE_DEFAULT;
+
+    return pDevice;
+}
+
 EVMU_EXPORT GblRefCount EvmuDevice_unref(EvmuDevice* pSelf) {
     return GBL_UNREF(pSelf);
 }
 
+EVMU_EXPORT EvmuDevice* EvmuDevice_clone(const EvmuDevice* pSelf) {
+    EvmuDevice* pClone = NULL;
+    uint8_t*    pCore  = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    // Folding pending PSW flags while saving is the only change made to the source
+    EvmuDevice_* pSelf_ = EVMU_DEVICE_(pSelf);
+
+    pCore = malloc(EvmuDevice__coreStateSize_(pSelf_));
+    GBL_CTX_VERIFY(pCore,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuDevice_clone(): failed to allocate state!");
+
+    // Flash is about to be overwritten, so there's nothing worth formatting
+    pClone = EvmuDevice_createExt(EVMU_DEVICE_CREATE_NO_FORMAT |
+                                  EVMU_DEVICE_CREATE_NO_LOG    |
+                                  (pSelf_->pArena? EVMU_DEVICE_CREATE_ARENA : 0));
+
+    GBL_CTX_VERIFY(pClone,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuDevice_clone(): failed to create device!");
+
+    EvmuDevice_* pClone_ = EVMU_DEVICE_(pClone);
+
+    GBL_CTX_VERIFY_CALL(EvmuMemory__shareRom_(pClone_->pMemory, pSelf_->pMemory));
+    pClone_->pRom->eBiosType         = pSelf_->pRom->eBiosType;
+    pClone_->pRom->bSetupSkipEnabled = pSelf_->pRom->bSetupSkipEnabled;
+
+    memcpy(pClone_->pMemory->ram,  pSelf_->pMemory->ram,  sizeof(pSelf_->pMemory->ram));
+    memcpy(pClone_->pMemory->xram, pSelf_->pMemory->xram, sizeof(pSelf_->pMemory->xram));
+    memcpy(pClone_->pMemory->wram, pSelf_->pMemory->wram, sizeof(pSelf_->pMemory->wram));
+    memcpy(pClone_->pFlash->pStorage->pData,
+           pSelf_->pFlash->pStorage->pData,
+           pSelf_->pFlash->pStorage->size);
+
+    EvmuDevice__saveCoreState_(pSelf_, pCore);
+    EvmuDevice__loadCoreState_(pClone_, pCore);
+
+    GBL_CTX_VERIFY_CALL(EvmuCpu_setExecMode(pClone->pCpu, EvmuCpu_execMode(pSelf->pCpu)));
+
+    GBL_CTX_END_BLOCK();
+    free(pCore);
+
+    // A half-initialized clone is no use to anyone
+    if(!GBL_RESULT_SUCCESS(GBL_CTX_RESULT()) && pClone) {
+        GBL_UNREF(pClone);
+        pClone = NULL;
+    }
+
+    return pClone;
+}
+
 static GBL_RESULT EvmuDevice_constructor_(GblObject* pSelf) {
+    EvmuDevice_* pPrevious = pConstructing_;
+    const GblFlags flags   = createFlags_;
+
     GBL_CTX_BEGIN(pSelf);
 
     EvmuDevice* pDevice = EVMU_DEVICE(pSelf);
@@ -41,6 +140,17 @@ static GBL_RESULT EvmuDevice_constructor_(GblObject* pSelf) {
     // Call parent constructor
     GBL_INSTANCE_VCALL_DEFAULT(GblObject, pFnConstructor, pSelf);
 
+    // Peripherals draw from the arena as they're constructed, falling back to the heap without one
+    if(flags & EVMU_DEVICE_CREATE_ARENA) {
+        pSelf_->pArena = calloc(1, EVMU_DEVICE__ARENA_SIZE_);
+        GBL_CTX_VERIFY(pSelf_->pArena,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to allocate device arena!");
+    }
+
+    pConstructing_ = pSelf_;
+    createFlags_   = EVMU_DEVICE_CREATE_DEFAULT;
+
     // Create peripherals
     pDevice->pMemory  = GBL_NEW(EvmuMemory,
                                 "parent", pSelf);
@@ -105,12 +215,18 @@ static GBL_RESULT EvmuDevice_constructor_(GblObject* pSelf) {
     pSelf_->pFat->pMemory     = pSelf_->pMemory;
 
     //!\todo move this to EvmuFat
-    GBL_CTX_CALL(EvmuFat_format(pDevice->pFat, NULL));
-    EvmuFat_log(pDevice->pFat);
+    if(!(flags & EVMU_DEVICE_CREATE_NO_FORMAT)) {
+        GBL_CTX_CALL(EvmuFat_format(pDevice->pFat, NULL));
+
+        if(!(flags & EVMU_DEVICE_CREATE_NO_LOG))
+            EvmuFat_log(pDevice->pFat);
+    }
 
     GBL_CTX_VERIFY_CALL(EvmuIBehavior_reset(EVMU_IBEHAVIOR(pSelf)));
 
-    GBL_CTX_END();
+    GBL_CTX_END_BLOCK();
+    pConstructing_ = pPrevious;
+    return GBL_CTX_RESULT();
 }
 
 static GBL_RESULT EvmuDevice_destructor_(GblBox* pSelf) {
@@ -131,31 +247,78 @@ static GBL_RESULT EvmuDevice_destructor_(GblBox* pSelf) {
     GBL_UNREF(pDevice->pFlash);
     GBL_UNREF(pDevice->pFat);
 
+    // Only once every peripheral carved out of it is gone
+    free(EVMU_DEVICE_(pDevice)->pArena);
+    free(EVMU_DEVICE_(pDevice)->pHashShadow);
+
     GBL_INSTANCE_VCALL_DEFAULT(GblObject, base.pFnDestructor, pSelf);
     GBL_CTX_END();
 }
 
+// Nanoseconds until the LCD's next physical refresh, matching the microsecond ticks EvmuLcd is updated with
+static EvmuTicks EvmuDevice_lcdRefreshPeriod_(const EvmuDevice* pSelf) {
+    return EvmuLcd_refreshRateTicks(pSelf->pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR * 1000;
+}
+
+void EvmuDevice__resetEvents_(EvmuDevice_* pSelf_) {
+    EvmuDevice* pSelf = EVMU_DEVICE_PUBLIC_(pSelf_);
+
+    pSelf_->scheduler.now = 0;
+    pSelf_->scheduler.deadlines[EVMU_DEVICE__EVENT_BASE_TIMER_]  = EVMU_TIMERS__BASE_TIMER_TICK_;
+    pSelf_->scheduler.deadlines[EVMU_DEVICE__EVENT_LCD_REFRESH_] = EvmuDevice_lcdRefreshPeriod_(pSelf);
+}
+
+void EvmuDevice__runEvents_(EvmuDevice_* pSelf_) {
+    EvmuDevice*     pSelf      = EVMU_DEVICE_PUBLIC_(pSelf_);
+    EvmuScheduler_* pScheduler = &pSelf_->scheduler;
+
+    // Deadlines advance by whole periods so rounding never accumulates
+    while(pScheduler->deadlines[EVMU_DEVICE__EVENT_BASE_TIMER_] <= pScheduler->now) {
+        EvmuTimers__baseTimerTick_(pSelf_->pTimers);
+        pScheduler->deadlines[EVMU_DEVICE__EVENT_BASE_TIMER_] += EVMU_TIMERS__BASE_TIMER_TICK_;
+    }
+
+    while(pScheduler->deadlines[EVMU_DEVICE__EVENT_LCD_REFRESH_] <= pScheduler->now) {
+        const EvmuTicks period = EvmuDevice_lcdRefreshPeriod_(pSelf);
+
+        EvmuIBehavior_update(EVMU_IBEHAVIOR(pSelf->pLcd), period / 1000);
+        pScheduler->deadlines[EVMU_DEVICE__EVENT_LCD_REFRESH_] += period;
+    }
+}
+
 static GBL_RESULT EvmuDevice_reset_(EvmuIBehavior* pIBehavior) {
     GBL_CTX_BEGIN(NULL);
+
+    if(EVMU_DEVICE_(pIBehavior)->pJournal)
+        EvmuJournal__reset_(EVMU_DEVICE_(pIBehavior)->pJournal);
+
     GBL_INSTANCE_VCALL_DEFAULT(EvmuIBehavior, pFnReset, pIBehavior);
+    EvmuDevice__resetEvents_(EVMU_DEVICE_(pIBehavior));
     //EvmuPic_raiseIrq(EVMU_DEVICE(pIBehavior)->pPic, EVMU_IRQ_RESET);
     GBL_CTX_END();
 }
 
+EvmuTicks EvmuDevice__scaleTicks_(const EvmuDevice* pDevice, EvmuTicks ticks) {
+    if(pDevice->pGamepad->slowMotion)
+        ticks /= VMU_TRIGGER_SPEED_FACTOR;
+    if(pDevice->pGamepad->fastForward)
+        ticks *= VMU_TRIGGER_SPEED_FACTOR;
+
+    return ticks;
+}
+
 static GBL_RESULT EvmuDevice_update_(EvmuIBehavior* pIBehavior, EvmuTicks ticks) {
     GBL_CTX_BEGIN(NULL);
 
     EvmuDevice*  pSelf  = EVMU_DEVICE(pIBehavior);
 
+    if(EVMU_DEVICE_(pSelf)->pJournal)
+        EvmuJournal__update_(EVMU_DEVICE_(pSelf)->pJournal, ticks);
+
     // fuck the base implementation, do it manually
     //GBL_INSTANCE_VCALL_DEFAULT(EvmuIBehavior, pFnUpdate, pSelf, ticks);
 
-    if(pSelf->pGamepad->slowMotion)
-        ticks /= VMU_TRIGGER_SPEED_FACTOR;
-    if(pSelf->pGamepad->fastForward)
-        ticks *= VMU_TRIGGER_SPEED_FACTOR;
-
-    EvmuIBehavior_update(EVMU_IBEHAVIOR(pSelf->pCpu), ticks);
+    EvmuIBehavior_update(EVMU_IBEHAVIOR(pSelf->pCpu), EvmuDevice__scaleTicks_(pSelf, ticks));
 
     GBL_CTX_END();
 }
@@ -194,6 +357,24 @@ EVMU_EXPORT EvmuPeripheral* EvmuDevice_findPeripheral(const EvmuDevice* pSelf, c
     return EVMU_PERIPHERAL(GblObject_findChildByName(GBL_OBJECT(pSelf), pName));
 }
 
+EVMU_EXPORT EvmuCycles EvmuDevice_runUntil(EvmuDevice*   pSelf,
+                                           EvmuCycles    maxCycles,
+                                           EvmuStopMask  stopMask,
+                                           EvmuStopMask* pReason)
+{
+    if(EVMU_DEVICE_(pSelf)->pJournal)
+        EvmuJournal__runUntil_(EVMU_DEVICE_(pSelf)->pJournal, maxCycles, stopMask);
+
+    // Button edges only ever come from the host between calls, so one poll sees all of them
+    EvmuIBehavior_update(EVMU_IBEHAVIOR(pSelf->pGamepad), 0);
+
+    EvmuCycles elapsed = 0;
+
+    EvmuCpu__run_(EVMU_DEVICE_(pSelf)->pCpu, UINT64_MAX, maxCycles, stopMask, pReason, &elapsed);
+
+    return elapsed;
+}
+
 static GBL_RESULT EvmuDeviceClass_init_(GblClass* pClass, const void* pData, GblContext* pCtx) {
     GBL_UNUSED(pData);
     GBL_CTX_BEGIN(pCtx);
@@ -207,7 +388,7 @@ static GBL_RESULT EvmuDeviceClass_init_(GblClass* pClass, const void* pData, Gbl
 }
 
 EVMU_EXPORT GblType EvmuDevice_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     static GblTypeInterfaceMapEntry ifaceEntries[] = {
         {
@@ -224,17 +405,14 @@ EVMU_EXPORT GblType EvmuDevice_type(void) {
         .pInterfaceMap        = ifaceEntries
     };
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         ifaceEntries[0].interfaceType = EVMU_IBEHAVIOR_TYPE;
 
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuDevice"),
                                       GBL_OBJECT_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
@@ -22,9 +22,24 @@ GBL_FORWARD_DECLARE_STRUCT(EvmuRom_);
 GBL_FORWARD_DECLARE_STRUCT(EvmuPic_);
 GBL_FORWARD_DECLARE_STRUCT(EvmuFlash_);
 GBL_FORWARD_DECLARE_STRUCT(EvmuFat_);
+GBL_FORWARD_DECLARE_STRUCT(EvmuJournal_);
+
+// Peripheral events which fire at a known point in master time instead of being polled
+typedef enum EVMU_DEVICE__EVENT_ {
+    EVMU_DEVICE__EVENT_BASE_TIMER_,     // 0.1s base timer tick (every 5th is the 0.5s tick)
+    EVMU_DEVICE__EVENT_LCD_REFRESH_,    // Physical LCD refresh period elapsed
+    EVMU_DEVICE__EVENT_COUNT_
+} EVMU_DEVICE__EVENT_;
+
+// Integer master timeline shared by the CPU and every scheduled peripheral
+typedef struct EvmuScheduler_ {
+    EvmuTicks       now;                                    // nanoseconds since reset
+    EvmuTicks       deadlines[EVMU_DEVICE__EVENT_COUNT_];   // absolute time of each event's next firing
+} EvmuScheduler_;
 
 typedef struct EvmuDevice_ {
     EvmuTicks       remainingTicks;
+    EvmuScheduler_  scheduler;
 
     EvmuCpu_*       pCpu;
     EvmuMemory_*    pMemory;
@@ -38,6 +53,14 @@ typedef struct EvmuDevice_ {
     EvmuPic_*       pPic;
     EvmuFlash_*     pFlash;
     EvmuFat_*       pFat;
+
+    uint8_t*        pArena;     // block peripheral buffers are carved from, with EVMU_DEVICE_CREATE_ARENA
+    size_t          arenaUsed;
+
+    EvmuJournal_*   pJournal;   // attached EvmuJournal, which clears this upon destruction
+
+    uint64_t*       pHashShadow;    // memory as of the last EvmuDevice_stateHash(), allocated by it
+    uint64_t        hash;           // of pHashShadow, without the PC
 /*
 
     */
@@ -61,6 +84,35 @@ typedef struct EvmuDevice_ {
 
 } EvmuDevice_;
 
+// Restarts the master timeline, scheduling every event's first firing
+void      EvmuDevice__resetEvents_(GBL_SELF)                  GBL_NOEXCEPT;
+// Fires every event whose deadline has passed and schedules its next firing
+void      EvmuDevice__runEvents_  (GBL_SELF)                  GBL_NOEXCEPT;
+
+// Stretches or shrinks an update's duration by the gamepad's slow-motion and fast-forward triggers
+EvmuTicks EvmuDevice__scaleTicks_ (const EvmuDevice* pDevice,
+                                   EvmuTicks         ticks)   GBL_NOEXCEPT;
+
+/* Save state without RAM, XRAM, WRAM, or flash contents, which EvmuRewind
+   tracks page by page instead. Trusted input, so nothing is validated. */
+size_t    EvmuDevice__coreStateSize_(GBL_CSELF)                        GBL_NOEXCEPT;
+uint8_t*  EvmuDevice__saveCoreState_(GBL_SELF, uint8_t* pOut)          GBL_NOEXCEPT;
+void      EvmuDevice__loadCoreState_(GBL_SELF, const uint8_t* pIn)     GBL_NOEXCEPT;
+
+/* Carves zeroed memory out of the arena of the device being constructed on
+   this thread, for peripherals to call from their own construction. Returns
+   NULL when that device has no arena, so callers fall back to the heap. */
+void*     EvmuDevice__arenaAlloc_ (size_t bytes)              GBL_NOEXCEPT;
+
+// Returns whichever comes first: the given time or the next scheduled event
+EVMU_INLINE EvmuTicks EvmuDevice__nextDeadline_(GBL_CSELF, EvmuTicks limit) GBL_NOEXCEPT {
+    for(size_t e = 0; e < EVMU_DEVICE__EVENT_COUNT_; ++e)
+        if(pSelf->scheduler.deadlines[e] < limit)
+            limit = pSelf->scheduler.deadlines[e];
+
+    return limit;
+}
+
 #define DEV_(dev) dev->pPrivate
 
 #define DEV_MEMBER_(dev, member) DEV_(dev)->member
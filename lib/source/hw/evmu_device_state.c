@@ -0,0 +1,670 @@
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_sfr.h>
+#include <evmu/hw/evmu_isa.h>
+#include "evmu_device_.h"
+#include "evmu_memory_.h"
+#include "evmu_cpu_.h"
+#include "evmu_clock_.h"
+#include "evmu_lcd_.h"
+#include "evmu_buzzer_.h"
+#include "evmu_gamepad_.h"
+#include "evmu_timers_.h"
+#include "evmu_pic_.h"
+#include "evmu_flash_.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Save states are a header followed by a sequence of tagged chunks, one per
+   block of hardware. Every value is stored little-endian at a fixed width, so
+   states are portable between hosts. Loaders skip chunks they don't recognize,
+   which leaves room for adding more without bumping the version. */
+#define EVMU_DEVICE__STATE_MAGIC_           EVMU_DEVICE__STATE_TAG_('E', 'V', 'M', 'S')
+#define EVMU_DEVICE__STATE_HEADER_SIZE_     12  // magic, version, chunk count, total size
+#define EVMU_DEVICE__STATE_CHUNK_HEADER_    8   // tag, payload size
+
+#define EVMU_DEVICE__STATE_TAG_(a, b, c, d) ((uint32_t)(a)       | (uint32_t)(b) << 8 | \
+                                             (uint32_t)(c) << 16 | (uint32_t)(d) << 24)
+
+static uint8_t* EvmuDevice_put8_(uint8_t* pOut, uint8_t value) {
+    *pOut = value;
+    return pOut + 1;
+}
+
+static uint8_t* EvmuDevice_put16_(uint8_t* pOut, uint16_t value) {
+    pOut[0] = value;
+    pOut[1] = value >> 8;
+    return pOut + 2;
+}
+
+static uint8_t* EvmuDevice_put32_(uint8_t* pOut, uint32_t value) {
+    pOut = EvmuDevice_put16_(pOut, value);
+    return EvmuDevice_put16_(pOut, value >> 16);
+}
+
+static uint8_t* EvmuDevice_put64_(uint8_t* pOut, uint64_t value) {
+    pOut = EvmuDevice_put32_(pOut, value);
+    return EvmuDevice_put32_(pOut, value >> 32);
+}
+
+static uint8_t* EvmuDevice_putBytes_(uint8_t* pOut, const void* pBytes, size_t count) {
+    memcpy(pOut, pBytes, count);
+    return pOut + count;
+}
+
+static uint8_t EvmuDevice_get8_(const uint8_t** ppIn) {
+    return *(*ppIn)++;
+}
+
+static uint16_t EvmuDevice_get16_(const uint8_t** ppIn) {
+    const uint16_t value = (*ppIn)[0] | (*ppIn)[1] << 8;
+    *ppIn += 2;
+    return value;
+}
+
+static uint32_t EvmuDevice_get32_(const uint8_t** ppIn) {
+    const uint32_t low = EvmuDevice_get16_(ppIn);
+    return low | (uint32_t)EvmuDevice_get16_(ppIn) << 16;
+}
+
+static uint64_t EvmuDevice_get64_(const uint8_t** ppIn) {
+    const uint64_t low = EvmuDevice_get32_(ppIn);
+    return low | (uint64_t)EvmuDevice_get32_(ppIn) << 32;
+}
+
+static void EvmuDevice_getBytes_(const uint8_t** ppIn, void* pBytes, size_t count) {
+    memcpy(pBytes, *ppIn, count);
+    *ppIn += count;
+}
+
+// Master timeline and every scheduled peripheral event
+#define EVMU_DEVICE__STATE_DEVICE_SIZE_ (8 + 8 * EVMU_DEVICE__EVENT_COUNT_ + 8)
+
+static size_t EvmuDevice_deviceSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_DEVICE_SIZE_;
+}
+
+static uint8_t* EvmuDevice_saveDevice_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    pOut = EvmuDevice_put64_(pOut, pSelf_->scheduler.now);
+    for(size_t e = 0; e < EVMU_DEVICE__EVENT_COUNT_; ++e)
+        pOut = EvmuDevice_put64_(pOut, pSelf_->scheduler.deadlines[e]);
+    return EvmuDevice_put64_(pOut, pSelf_->remainingTicks);
+}
+
+static void EvmuDevice_loadDevice_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    pSelf_->scheduler.now = EvmuDevice_get64_(&pIn);
+    for(size_t e = 0; e < EVMU_DEVICE__EVENT_COUNT_; ++e)
+        pSelf_->scheduler.deadlines[e] = EvmuDevice_get64_(&pIn);
+    pSelf_->remainingTicks = EvmuDevice_get64_(&pIn);
+}
+
+// Internal RAM, SFRs, XRAM, WRAM, and which banks each bus currently maps
+#define EVMU_DEVICE__STATE_MEMORY_SIZE_ (sizeof(((EvmuMemory_*)NULL)->ram)  + \
+                                         sizeof(((EvmuMemory_*)NULL)->sfr)  + \
+                                         sizeof(((EvmuMemory_*)NULL)->xram) + \
+                                         sizeof(((EvmuMemory_*)NULL)->wram) + 3)
+
+static size_t EvmuDevice_memorySize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_MEMORY_SIZE_;
+}
+
+// Which banks each bus currently maps, rebuilding the maps and resetting derived state on load
+static uint8_t* EvmuDevice_saveMemoryMap_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuMemory_* pMemory = pSelf_->pMemory;
+
+    pOut = EvmuDevice_put8_(pOut, pMemory->pExt != pMemory->rom);
+    pOut = EvmuDevice_put8_(pOut, pMemory->pIntMap[EVMU_MEMORY__INT_SEGMENT_GP1_] != pMemory->ram[0]);
+    return EvmuDevice_put8_(pOut, (pMemory->pIntMap[EVMU_MEMORY__INT_SEGMENT_XRAM_] - pMemory->xram[0]) /
+                                  EVMU_ADDRESS_SEGMENT_XRAM_SIZE);
+}
+
+static void EvmuDevice_loadMemoryMap_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuMemory_* pMemory = pSelf_->pMemory;
+    EvmuMemory*  pPublic = EVMU_MEMORY_PUBLIC_(pMemory);
+
+    pMemory->pExt = EvmuDevice_get8_(&pIn)? pSelf_->pFlash->pStorage->pData : pMemory->rom;
+
+    const uint8_t ramBank  = EvmuDevice_get8_(&pIn) & 1;
+    const uint8_t xramBank = EvmuDevice_get8_(&pIn) % EVMU_ADDRESS_SEGMENT_XRAM_BANKS;
+
+    pMemory->pIntMap[EVMU_MEMORY__INT_SEGMENT_GP1_]  = pMemory->ram[ramBank];
+    pMemory->pIntMap[EVMU_MEMORY__INT_SEGMENT_GP2_]  = &pMemory->ram[ramBank][EVMU_MEMORY__INT_SEGMENT_SIZE_];
+    pMemory->pIntMap[EVMU_MEMORY__INT_SEGMENT_SFR_]  = pMemory->sfr;
+    pMemory->pIntMap[EVMU_MEMORY__INT_SEGMENT_XRAM_] = pMemory->xram[xramBank];
+
+    memset(&pMemory->flags, 0, sizeof(EvmuMemoryLazyFlags_));
+
+    pPublic->ramChanged  = GBL_TRUE;
+    pPublic->sfrChanged  = GBL_TRUE;
+    pPublic->xramChanged = GBL_TRUE;
+    pPublic->wramChanged = GBL_TRUE;
+}
+
+static uint8_t* EvmuDevice_saveMemory_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuMemory_* pMemory = pSelf_->pMemory;
+
+    // Pending flags are folded into the PSW, so loading needs nothing else to recreate them
+    EvmuMemory__syncPsw_(pMemory);
+
+    pOut = EvmuDevice_putBytes_(pOut, pMemory->ram,  sizeof(pMemory->ram));
+    pOut = EvmuDevice_putBytes_(pOut, pMemory->sfr,  sizeof(pMemory->sfr));
+    pOut = EvmuDevice_putBytes_(pOut, pMemory->xram, sizeof(pMemory->xram));
+    pOut = EvmuDevice_putBytes_(pOut, pMemory->wram, sizeof(pMemory->wram));
+    return EvmuDevice_saveMemoryMap_(pSelf_, pOut);
+}
+
+static void EvmuDevice_loadMemory_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuMemory_* pMemory = pSelf_->pMemory;
+
+    EvmuDevice_getBytes_(&pIn, pMemory->ram,  sizeof(pMemory->ram));
+    EvmuDevice_getBytes_(&pIn, pMemory->sfr,  sizeof(pMemory->sfr));
+    EvmuDevice_getBytes_(&pIn, pMemory->xram, sizeof(pMemory->xram));
+    EvmuDevice_getBytes_(&pIn, pMemory->wram, sizeof(pMemory->wram));
+    EvmuDevice_loadMemoryMap_(pSelf_, pIn);
+}
+
+// PC, instruction being executed, and halt toggles
+#define EVMU_DEVICE__STATE_CPU_SIZE_    (2 + 2 + 1 + EVMU_INSTRUCTION_BYTE_MAX)
+
+static size_t EvmuDevice_cpuSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_CPU_SIZE_;
+}
+
+static uint8_t* EvmuDevice_saveCpu_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuCpu_* pCpu    = pSelf_->pCpu;
+    EvmuCpu*  pPublic = EVMU_CPU_PUBLIC_(pCpu);
+
+    pOut = EvmuDevice_put16_(pOut, pCpu->pc);
+    pOut = EvmuDevice_put8_(pOut, pPublic->halted);
+    pOut = EvmuDevice_put8_(pOut, pPublic->haltAfterNext);
+    pOut = EvmuDevice_put8_(pOut, pCpu->curInstr.encoded.byteCount);
+    return EvmuDevice_putBytes_(pOut, pCpu->curInstr.encoded.bytes, EVMU_INSTRUCTION_BYTE_MAX);
+}
+
+static void EvmuDevice_loadCpu_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuCpu_* pCpu    = pSelf_->pCpu;
+    EvmuCpu*  pPublic = EVMU_CPU_PUBLIC_(pCpu);
+
+    pCpu->pc               = EvmuDevice_get16_(&pIn);
+    pPublic->halted        = EvmuDevice_get8_(&pIn);
+    pPublic->haltAfterNext = EvmuDevice_get8_(&pIn);
+    pPublic->pcChanged     = GBL_TRUE;
+
+    // Only the encoding is stored, it decodes the same way it did when it was saved
+    memset(&pCpu->curInstr, 0, sizeof(pCpu->curInstr));
+    pCpu->curInstr.encoded.byteCount = EvmuDevice_get8_(&pIn);
+    EvmuDevice_getBytes_(&pIn, pCpu->curInstr.encoded.bytes, EVMU_INSTRUCTION_BYTE_MAX);
+    pCpu->curInstr.pFormat = EvmuIsa_format(pCpu->curInstr.encoded.bytes[EVMU_INSTRUCTION_BYTE_OPCODE]);
+    EvmuIsa_decode(&pCpu->curInstr.encoded, &pCpu->curInstr.decoded);
+
+    // Program memory was replaced wholesale
+    EvmuCpu__flushCache_(pCpu);
+}
+
+// Timer 0, timer 1, and the base timer's counters
+#define EVMU_DEVICE__STATE_TIMERS_SIZE_ (4 * 4 + 4 * 2 + 3)
+
+static size_t EvmuDevice_timersSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_TIMERS_SIZE_;
+}
+
+static uint8_t* EvmuDevice_saveTimers_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuTimers_* pTimers = pSelf_->pTimers;
+
+    pOut = EvmuDevice_put32_(pOut, pTimers->timer0.base.tl);
+    pOut = EvmuDevice_put32_(pOut, pTimers->timer0.base.th);
+    pOut = EvmuDevice_put32_(pOut, pTimers->timer0.tbase);
+    pOut = EvmuDevice_put32_(pOut, pTimers->timer0.tscale);
+    pOut = EvmuDevice_put32_(pOut, pTimers->timer1.base.tl);
+    pOut = EvmuDevice_put32_(pOut, pTimers->timer1.base.th);
+    pOut = EvmuDevice_put8_(pOut, pTimers->baseTimer.ticks);
+    pOut = EvmuDevice_put8_(pOut, pTimers->baseTimer.tl);
+    return EvmuDevice_put8_(pOut, pTimers->baseTimer.th);
+}
+
+static void EvmuDevice_loadTimers_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuTimers_* pTimers = pSelf_->pTimers;
+
+    pTimers->timer0.base.tl  = (int32_t)EvmuDevice_get32_(&pIn);
+    pTimers->timer0.base.th  = (int32_t)EvmuDevice_get32_(&pIn);
+    pTimers->timer0.tbase    = (int32_t)EvmuDevice_get32_(&pIn);
+    pTimers->timer0.tscale   = (int32_t)EvmuDevice_get32_(&pIn);
+    pTimers->timer1.base.tl  = (int32_t)EvmuDevice_get32_(&pIn);
+    pTimers->timer1.base.th  = (int32_t)EvmuDevice_get32_(&pIn);
+    pTimers->baseTimer.ticks = EvmuDevice_get8_(&pIn);
+    pTimers->baseTimer.tl    = EvmuDevice_get8_(&pIn);
+    pTimers->baseTimer.th    = EvmuDevice_get8_(&pIn);
+}
+
+// Requested and in-service interrupts
+#define EVMU_DEVICE__STATE_PIC_SIZE_    (2 + 2 * EVMU_IRQ_PRIORITY_COUNT + 2)
+
+static size_t EvmuDevice_picSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_PIC_SIZE_;
+}
+
+static uint8_t* EvmuDevice_savePic_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuPic_* pPic = pSelf_->pPic;
+
+    pOut = EvmuDevice_put16_(pOut, pPic->intReq);
+    for(size_t p = 0; p < EVMU_IRQ_PRIORITY_COUNT; ++p)
+        pOut = EvmuDevice_put16_(pOut, pPic->intStack[p]);
+    pOut = EvmuDevice_put8_(pOut, pPic->processThisInstr);
+    return EvmuDevice_put8_(pOut, pPic->prevIntPriority);
+}
+
+static void EvmuDevice_loadPic_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuPic_* pPic = pSelf_->pPic;
+
+    pPic->intReq = EvmuDevice_get16_(&pIn);
+    for(size_t p = 0; p < EVMU_IRQ_PRIORITY_COUNT; ++p)
+        pPic->intStack[p] = EvmuDevice_get16_(&pIn);
+    pPic->processThisInstr = EvmuDevice_get8_(&pIn);
+    pPic->prevIntPriority  = EvmuDevice_get8_(&pIn);
+}
+
+// Pixel buffer with any ghosting still fading, icons, and refresh progress
+#define EVMU_DEVICE__STATE_LCD_SIZE_    (4 * EVMU_LCD_PIXEL_HEIGHT * EVMU_LCD_PIXEL_WIDTH + 4 + 8)
+
+static size_t EvmuDevice_lcdSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_LCD_SIZE_;
+}
+
+static uint8_t* EvmuDevice_saveLcd_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuLcd_* pLcd = pSelf_->pLcd;
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            pOut = EvmuDevice_put32_(pOut, pLcd->pixelBuffer[y][x]);
+
+    pOut = EvmuDevice_put32_(pOut, pLcd->icons);
+    return EvmuDevice_put64_(pOut, pLcd->refreshElapsed);
+}
+
+static void EvmuDevice_loadLcd_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuLcd_* pLcd = pSelf_->pLcd;
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            pLcd->pixelBuffer[y][x] = (int32_t)EvmuDevice_get32_(&pIn);
+
+    pLcd->icons          = EvmuDevice_get32_(&pIn);
+    pLcd->refreshElapsed = EvmuDevice_get64_(&pIn);
+    pLcd->fadingRows     = 0;
+    EvmuLcd__invalidate_(pLcd);
+
+    EVMU_LCD_PUBLIC(pLcd)->screenChanged = GBL_TRUE;
+}
+
+// Tone being played along with the PCM generated for it
+#define EVMU_DEVICE__STATE_BUZZER_SIZE_ (1 + 1 + 2 + 1 + 4 + 4 + EVMU_BUZZER_PCM_BUFFER_SIZE)
+
+static size_t EvmuDevice_buzzerSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_BUZZER_SIZE_;
+}
+
+static uint8_t* EvmuDevice_saveBuzzer_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuBuzzer_* pBuzzer = pSelf_->pBuzzer;
+
+    pOut = EvmuDevice_put8_(pOut, pBuzzer->enabled);
+    pOut = EvmuDevice_put8_(pOut, pBuzzer->active);
+    pOut = EvmuDevice_put16_(pOut, pBuzzer->tonePeriod);
+    pOut = EvmuDevice_put8_(pOut, pBuzzer->toneInvPulseLength);
+    pOut = EvmuDevice_put32_(pOut, pBuzzer->pcmSamples);
+    pOut = EvmuDevice_put32_(pOut, pBuzzer->pcmFrequency);
+    return EvmuDevice_putBytes_(pOut, pBuzzer->pcmBuffer, EVMU_BUZZER_PCM_BUFFER_SIZE);
+}
+
+static void EvmuDevice_loadBuzzer_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuBuzzer_* pBuzzer = pSelf_->pBuzzer;
+
+    pBuzzer->enabled            = EvmuDevice_get8_(&pIn);
+    pBuzzer->active             = EvmuDevice_get8_(&pIn);
+    pBuzzer->tonePeriod         = EvmuDevice_get16_(&pIn);
+    pBuzzer->toneInvPulseLength = EvmuDevice_get8_(&pIn);
+    pBuzzer->pcmSamples         = EvmuDevice_get32_(&pIn);
+    pBuzzer->pcmFrequency       = EvmuDevice_get32_(&pIn);
+    EvmuDevice_getBytes_(&pIn, pBuzzer->pcmBuffer, EVMU_BUZZER_PCM_BUFFER_SIZE);
+
+    EVMU_BUZZER_PUBLIC_(pBuzzer)->pcmChanged = GBL_TRUE;
+}
+
+// Configuration and progress of every oscillator and derived clock signal
+#define EVMU_DEVICE__STATE_CLOCK_SIGNAL_SIZE_   (8 * 5 + 1 + 1)
+
+static size_t EvmuDevice_clockSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_CLOCK_SIGNAL_SIZE_ * EVMU_CLOCK_SIGNAL_COUNT;
+}
+
+static uint8_t* EvmuDevice_saveClock_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    for(size_t s = 0; s < EVMU_CLOCK_SIGNAL_COUNT; ++s) {
+        const EvmuClockSignal_* pSignal = &pSelf_->pClock->signals[s];
+
+        pOut = EvmuDevice_put64_(pOut, pSignal->hz);
+        pOut = EvmuDevice_put64_(pOut, pSignal->halfCycleTime);
+        pOut = EvmuDevice_put64_(pOut, pSignal->stabilizationHalfCycles);
+        pOut = EvmuDevice_put64_(pOut, pSignal->halfCyclesTotal);
+        pOut = EvmuDevice_put64_(pOut, pSignal->timeRemainder);
+        pOut = EvmuDevice_put8_(pOut, pSignal->active);
+        pOut = EvmuDevice_put8_(pOut, pSignal->wave);
+    }
+
+    return pOut;
+}
+
+static void EvmuDevice_loadClock_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    for(size_t s = 0; s < EVMU_CLOCK_SIGNAL_COUNT; ++s) {
+        EvmuClockSignal_* pSignal = &pSelf_->pClock->signals[s];
+
+        pSignal->hz                      = EvmuDevice_get64_(&pIn);
+        pSignal->halfCycleTime           = EvmuDevice_get64_(&pIn);
+        pSignal->stabilizationHalfCycles = EvmuDevice_get64_(&pIn);
+        pSignal->halfCyclesTotal         = EvmuDevice_get64_(&pIn);
+        pSignal->timeRemainder           = EvmuDevice_get64_(&pIn);
+        pSignal->active                  = EvmuDevice_get8_(&pIn);
+        pSignal->wave                    = EvmuDevice_get8_(&pIn);
+    }
+}
+
+// Flash contents along with any unlock/program sequence in progress
+static size_t EvmuDevice_flashSize_(const EvmuDevice_* pSelf_) {
+    return 1 + 1 + 4 + pSelf_->pFlash->pStorage->size;
+}
+
+static uint8_t* EvmuDevice_saveFlash_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    EvmuFlash_* pFlash = pSelf_->pFlash;
+
+    pOut = EvmuDevice_put8_(pOut, pFlash->prgState);
+    pOut = EvmuDevice_put8_(pOut, pFlash->prgBytes);
+    pOut = EvmuDevice_put32_(pOut, pFlash->pStorage->size);
+    return EvmuDevice_putBytes_(pOut, pFlash->pStorage->pData, pFlash->pStorage->size);
+}
+
+static void EvmuDevice_loadFlash_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuFlash_* pFlash = pSelf_->pFlash;
+
+    pFlash->prgState = EvmuDevice_get8_(&pIn);
+    pFlash->prgBytes = EvmuDevice_get8_(&pIn);
+
+    // Size was already checked against the device's, when verifying the chunk size
+    EvmuDevice_get32_(&pIn);
+    EvmuDevice_getBytes_(&pIn, pFlash->pStorage->pData, pFlash->pStorage->size);
+    EvmuFlash__markDirty_(pFlash, 0, pFlash->pStorage->size);
+
+    EVMU_FLASH_PUBLIC(pFlash)->dataChanged             = GBL_TRUE;
+    EVMU_MEMORY_PUBLIC_(pSelf_->pMemory)->flashChanged = GBL_TRUE;
+}
+
+// Buttons held when the state was saved, so replaying from it sees the same input
+#define EVMU_DEVICE__STATE_GAMEPAD_SIZE_    (2 + 2)
+
+static size_t EvmuDevice_gamepadSize_(const EvmuDevice_* pSelf_) {
+    GBL_UNUSED(pSelf_);
+    return EVMU_DEVICE__STATE_GAMEPAD_SIZE_;
+}
+
+static uint8_t* EvmuDevice_saveGamepad_(EvmuDevice_* pSelf_, uint8_t* pOut) {
+    pOut = EvmuDevice_put16_(pOut, EvmuGamepad__buttons_(EVMU_DEVICE_PUBLIC_(pSelf_)->pGamepad));
+    return EvmuDevice_put16_(pOut, 0);  // reserved for turbo counters, which aren't emulated yet
+}
+
+static void EvmuDevice_loadGamepad_(EvmuDevice_* pSelf_, const uint8_t* pIn) {
+    EvmuGamepad__setButtons_(EVMU_DEVICE_PUBLIC_(pSelf_)->pGamepad, EvmuDevice_get16_(&pIn));
+}
+
+// One block of hardware within a save state
+typedef struct EvmuDeviceStateChunk_ {
+    uint32_t tag;
+    size_t   (*pFnSize)(const EvmuDevice_* pSelf_);
+    uint8_t* (*pFnSave)(EvmuDevice_* pSelf_, uint8_t* pOut);
+    void     (*pFnLoad)(EvmuDevice_* pSelf_, const uint8_t* pIn);
+    GblBool  bulk;      // holds RAM or flash contents, which core states leave out
+} EvmuDeviceStateChunk_;
+
+static const EvmuDeviceStateChunk_ chunks_[] = {
+    { EVMU_DEVICE__STATE_TAG_('D', 'E', 'V', ' '), EvmuDevice_deviceSize_,  EvmuDevice_saveDevice_,  EvmuDevice_loadDevice_,  GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('M', 'E', 'M', ' '), EvmuDevice_memorySize_,  EvmuDevice_saveMemory_,  EvmuDevice_loadMemory_,  GBL_TRUE  },
+    { EVMU_DEVICE__STATE_TAG_('C', 'P', 'U', ' '), EvmuDevice_cpuSize_,     EvmuDevice_saveCpu_,     EvmuDevice_loadCpu_,     GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('T', 'M', 'R', ' '), EvmuDevice_timersSize_,  EvmuDevice_saveTimers_,  EvmuDevice_loadTimers_,  GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('P', 'I', 'C', ' '), EvmuDevice_picSize_,     EvmuDevice_savePic_,     EvmuDevice_loadPic_,     GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('L', 'C', 'D', ' '), EvmuDevice_lcdSize_,     EvmuDevice_saveLcd_,     EvmuDevice_loadLcd_,     GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('B', 'U', 'Z', 'Z'), EvmuDevice_buzzerSize_,  EvmuDevice_saveBuzzer_,  EvmuDevice_loadBuzzer_,  GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('C', 'L', 'K', ' '), EvmuDevice_clockSize_,   EvmuDevice_saveClock_,   EvmuDevice_loadClock_,   GBL_FALSE },
+    { EVMU_DEVICE__STATE_TAG_('F', 'L', 'S', 'H'), EvmuDevice_flashSize_,   EvmuDevice_saveFlash_,   EvmuDevice_loadFlash_,   GBL_TRUE  },
+    { EVMU_DEVICE__STATE_TAG_('P', 'A', 'D', ' '), EvmuDevice_gamepadSize_, EvmuDevice_saveGamepad_, EvmuDevice_loadGamepad_, GBL_FALSE }
+};
+
+EVMU_EXPORT size_t EvmuDevice_stateSize(const EvmuDevice* pSelf) {
+    const EvmuDevice_* pSelf_ = EVMU_DEVICE_(pSelf);
+    size_t             size   = EVMU_DEVICE__STATE_HEADER_SIZE_;
+
+    for(size_t c = 0; c < GBL_COUNT_OF(chunks_); ++c)
+        size += EVMU_DEVICE__STATE_CHUNK_HEADER_ + chunks_[c].pFnSize(pSelf_);
+
+    return size;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuDevice_saveState(const EvmuDevice* pSelf, void* pBuffer, size_t size) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pBuffer);
+
+    const size_t required = EvmuDevice_stateSize(pSelf);
+
+    GBL_CTX_VERIFY(size >= required,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "EvmuDevice_saveState(): buffer of %zu bytes can't hold %zu byte state!",
+                   size, required);
+
+    // Only pending PSW flags get folded in, which doesn't change anything observable
+    EvmuDevice_* pSelf_ = EVMU_DEVICE_(pSelf);
+    uint8_t*     pOut   = pBuffer;
+
+    pOut = EvmuDevice_put32_(pOut, EVMU_DEVICE__STATE_MAGIC_);
+    pOut = EvmuDevice_put16_(pOut, EVMU_DEVICE_STATE_VERSION);
+    pOut = EvmuDevice_put16_(pOut, GBL_COUNT_OF(chunks_));
+    pOut = EvmuDevice_put32_(pOut, required);
+
+    for(size_t c = 0; c < GBL_COUNT_OF(chunks_); ++c) {
+        pOut = EvmuDevice_put32_(pOut, chunks_[c].tag);
+        pOut = EvmuDevice_put32_(pOut, chunks_[c].pFnSize(pSelf_));
+        pOut = chunks_[c].pFnSave(pSelf_, pOut);
+    }
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuDevice_loadState(EvmuDevice* pSelf, const void* pBuffer, size_t size) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pBuffer);
+
+    EvmuDevice_*   pSelf_ = EVMU_DEVICE_(pSelf);
+    const uint8_t* pIn    = pBuffer;
+    const uint8_t* pFound[GBL_COUNT_OF(chunks_)] = { NULL };
+
+    GBL_CTX_VERIFY(size >= EVMU_DEVICE__STATE_HEADER_SIZE_ &&
+                   EvmuDevice_get32_(&pIn) == EVMU_DEVICE__STATE_MAGIC_,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuDevice_loadState(): not a save state!");
+
+    const uint16_t version = EvmuDevice_get16_(&pIn);
+    const uint16_t count   = EvmuDevice_get16_(&pIn);
+    const uint32_t total   = EvmuDevice_get32_(&pIn);
+
+    GBL_CTX_VERIFY(version >= 1 && version <= EVMU_DEVICE_STATE_VERSION,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuDevice_loadState(): unsupported version %u!",
+                   version);
+
+    GBL_CTX_VERIFY(total <= size,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuDevice_loadState(): truncated state of %zu/%u bytes!",
+                   size, total);
+
+    // Every chunk is located and checked up-front, so nothing is applied from a bad state
+    for(uint16_t c = 0; c < count; ++c) {
+        GBL_CTX_VERIFY((size_t)(pIn - (const uint8_t*)pBuffer) + EVMU_DEVICE__STATE_CHUNK_HEADER_ <= total,
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "EvmuDevice_loadState(): chunk %u header out of bounds!",
+                       c);
+
+        const uint32_t tag   = EvmuDevice_get32_(&pIn);
+        const uint32_t bytes = EvmuDevice_get32_(&pIn);
+
+        GBL_CTX_VERIFY((size_t)(pIn - (const uint8_t*)pBuffer) + bytes <= total,
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "EvmuDevice_loadState(): chunk %u payload out of bounds!",
+                       c);
+
+        for(size_t k = 0; k < GBL_COUNT_OF(chunks_); ++k) {
+            if(chunks_[k].tag != tag) continue;
+
+            GBL_CTX_VERIFY(bytes == chunks_[k].pFnSize(pSelf_),
+                           GBL_RESULT_ERROR_INVALID_ARG,
+                           "EvmuDevice_loadState(): chunk %u is %u bytes, expected %zu!",
+                           c, bytes, chunks_[k].pFnSize(pSelf_));
+
+            pFound[k] = pIn;
+        }
+
+        pIn += bytes;
+    }
+
+    for(size_t k = 0; k < GBL_COUNT_OF(chunks_); ++k)
+        GBL_CTX_VERIFY(pFound[k],
+                       GBL_RESULT_ERROR_INVALID_ARG,
+                       "EvmuDevice_loadState(): missing chunk %zu!",
+                       k);
+
+    for(size_t k = 0; k < GBL_COUNT_OF(chunks_); ++k)
+        chunks_[k].pFnLoad(pSelf_, pFound[k]);
+
+    GBL_CTX_END();
+}
+
+// SFRs, bank mappings, and flash programming sequence, standing in for the bulk chunks
+#define EVMU_DEVICE__STATE_CORE_EXTRA_  (sizeof(((EvmuMemory_*)NULL)->sfr) + 3 + 1 + 1)
+
+size_t EvmuDevice__coreStateSize_(const EvmuDevice_* pSelf) {
+    size_t size = EVMU_DEVICE__STATE_CORE_EXTRA_;
+
+    for(size_t c = 0; c < GBL_COUNT_OF(chunks_); ++c)
+        if(!chunks_[c].bulk)
+            size += chunks_[c].pFnSize(pSelf);
+
+    return size;
+}
+
+uint8_t* EvmuDevice__saveCoreState_(EvmuDevice_* pSelf, uint8_t* pOut) {
+    EvmuMemory__syncPsw_(pSelf->pMemory);
+
+    pOut = EvmuDevice_putBytes_(pOut, pSelf->pMemory->sfr, sizeof(pSelf->pMemory->sfr));
+    pOut = EvmuDevice_saveMemoryMap_(pSelf, pOut);
+    pOut = EvmuDevice_put8_(pOut, pSelf->pFlash->prgState);
+    pOut = EvmuDevice_put8_(pOut, pSelf->pFlash->prgBytes);
+
+    for(size_t c = 0; c < GBL_COUNT_OF(chunks_); ++c)
+        if(!chunks_[c].bulk)
+            pOut = chunks_[c].pFnSave(pSelf, pOut);
+
+    return pOut;
+}
+
+void EvmuDevice__loadCoreState_(EvmuDevice_* pSelf, const uint8_t* pIn) {
+    EvmuDevice_getBytes_(&pIn, pSelf->pMemory->sfr, sizeof(pSelf->pMemory->sfr));
+    EvmuDevice_loadMemoryMap_(pSelf, pIn);
+    pIn += 3;
+    pSelf->pFlash->prgState = EvmuDevice_get8_(&pIn);
+    pSelf->pFlash->prgBytes = EvmuDevice_get8_(&pIn);
+
+    for(size_t c = 0; c < GBL_COUNT_OF(chunks_); ++c) {
+        if(chunks_[c].bulk) continue;
+
+        chunks_[c].pFnLoad(pSelf, pIn);
+        pIn += chunks_[c].pFnSize(pSelf);
+    }
+}
+
+/* The state hash is a XOR over every 64-bit word of RAM, SFRs, and XRAM, each
+   mixed with its position, so a changed word is swapped out of it by XORing
+   its old contribution back out. Memory gets written by handlers, inline fast
+   paths, and peripherals poking SFRs directly, so rather than hooking every
+   write, changed words are found by comparing against a copy taken last time,
+   which costs the same 128 compares no matter how long ago that was. */
+#define EVMU_DEVICE__HASH_RAM_WORDS_    (sizeof(((EvmuMemory_*)0)->ram)  / sizeof(uint64_t))
+#define EVMU_DEVICE__HASH_SFR_WORDS_    (sizeof(((EvmuMemory_*)0)->sfr)  / sizeof(uint64_t))
+#define EVMU_DEVICE__HASH_XRAM_WORDS_   (sizeof(((EvmuMemory_*)0)->xram) / sizeof(uint64_t))
+#define EVMU_DEVICE__HASH_WORDS_        (EVMU_DEVICE__HASH_RAM_WORDS_ + \
+                                         EVMU_DEVICE__HASH_SFR_WORDS_ + \
+                                         EVMU_DEVICE__HASH_XRAM_WORDS_)
+
+// SplitMix64 finalizer, keyed by the word's position
+static uint64_t EvmuDevice_hashMix_(uint64_t index, uint64_t value) {
+    uint64_t z = value + (index + 1) * 0x9e3779b97f4a7c15ull;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+    return z ^ (z >> 31);
+}
+
+static const EvmuWord* EvmuDevice_hashWord_(const EvmuMemory_* pMemory, size_t word) {
+    if(word < EVMU_DEVICE__HASH_RAM_WORDS_)
+        return &pMemory->ram[0][0] + word * sizeof(uint64_t);
+
+    word -= EVMU_DEVICE__HASH_RAM_WORDS_;
+
+    if(word < EVMU_DEVICE__HASH_SFR_WORDS_)
+        return &pMemory->sfr[0] + word * sizeof(uint64_t);
+
+    return &pMemory->xram[0][0] + (word - EVMU_DEVICE__HASH_SFR_WORDS_) * sizeof(uint64_t);
+}
+
+EVMU_EXPORT uint64_t EvmuDevice_stateHash(EvmuDevice* pSelf) {
+    EvmuDevice_* pSelf_ = EVMU_DEVICE_(pSelf);
+
+    if(!pSelf_->pHashShadow) {
+        GBL_CTX_BEGIN(NULL);
+
+        pSelf_->pHashShadow = calloc(EVMU_DEVICE__HASH_WORDS_, sizeof(uint64_t));
+
+        GBL_CTX_VERIFY(pSelf_->pHashShadow,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "EvmuDevice_stateHash(): failed to allocate shadow memory!");
+
+        // Start out hashing all-zero memory, which the first diff corrects
+        pSelf_->hash = 0;
+        for(size_t w = 0; w < EVMU_DEVICE__HASH_WORDS_; ++w)
+            pSelf_->hash ^= EvmuDevice_hashMix_(w, 0);
+
+        GBL_CTX_END_BLOCK();
+
+        if(!pSelf_->pHashShadow) return 0;
+    }
+
+    // Pending flags belong in PSW before anybody compares it
+    EvmuMemory__syncPsw_(pSelf_->pMemory);
+
+    for(size_t w = 0; w < EVMU_DEVICE__HASH_WORDS_; ++w) {
+        uint64_t word;
+        memcpy(&word, EvmuDevice_hashWord_(pSelf_->pMemory, w), sizeof(uint64_t));
+
+        if(word != pSelf_->pHashShadow[w]) {
+            pSelf_->hash ^= EvmuDevice_hashMix_(w, pSelf_->pHashShadow[w]) ^
+                            EvmuDevice_hashMix_(w, word);
+            pSelf_->pHashShadow[w] = word;
+        }
+    }
+
+    return pSelf_->hash ^ EvmuDevice_hashMix_(EVMU_DEVICE__HASH_WORDS_, pSelf_->pCpu->pc);
+}
@@ -3,6 +3,9 @@
 #include <evmu/hw/evmu_device.h>
 #include <evmu/hw/evmu_address_space.h>
 #include "evmu_flash_.h"
+#include "evmu_device_.h"
+#include "evmu_cpu_.h"
+#include "../types/evmu_type_.h"
 
 EVMU_EXPORT EvmuAddress EvmuFlash_programAddress(EVMU_FLASH_PROGRAM_STATE state) {
     static const EvmuAddress prgAddressLut[] = {
@@ -139,6 +142,17 @@ static EVMU_RESULT EvmuFlash_writeBytes_(EvmuFlash*  pSelf,
         GBL_CTX_VERIFY_LAST_RECORD();
     }
 
+    // Note the pages which were touched for incremental snapshots
+    EvmuFlash__markDirty_(pSelf_, address, *pBytes);
+
+    // Drop any predecoded instructions which were just overwritten
+    EvmuDevice* pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+    if(pDevice && EVMU_DEVICE_(pDevice)->pCpu)
+        EvmuCpu__invalidateCache_(EVMU_DEVICE_(pDevice)->pCpu,
+                                  EVMU_CPU__ICACHE_BANK_FLASH_,
+                                  address,
+                                  *pBytes);
+
     // Flag the data as having been changed
     pSelf->dataChanged = GBL_TRUE;
 
@@ -185,7 +199,7 @@ static GBL_RESULT EvmuFlashClass_init_(GblClass* pClass, const void* pUd, GblCon
 }
 
 EVMU_EXPORT GblType EvmuFlash_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     static const GblTypeInfo info = {
         .pFnClassInit        = EvmuFlashClass_init_,
@@ -195,13 +209,12 @@ EVMU_EXPORT GblType EvmuFlash_type(void) {
         .instancePrivateSize = sizeof(EvmuFlash_)
     };
 
-    if(type == GBL_INVALID_TYPE) {
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuFlash"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-
-    }
+    );
 
     return type;
 }
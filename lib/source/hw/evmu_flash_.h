@@ -8,6 +8,9 @@
 #define EVMU_FLASH_(instance)   ((EvmuFlash_*)GBL_INSTANCE_PRIVATE(instance, EVMU_FLASH_TYPE))
 #define EVMU_FLASH_PUBLIC(priv) ((EvmuFlash*)GBL_INSTANCE_PUBLIC(priv, EVMU_FLASH_TYPE))
 
+#define EVMU_FLASH__PAGE_SIZE_  EVMU_FLASH_PROGRAM_BYTE_COUNT               // Granularity of dirty tracking
+#define EVMU_FLASH__PAGE_COUNT_ (EVMU_FLASH_SIZE / EVMU_FLASH__PAGE_SIZE_)
+
 GBL_DECLS_BEGIN
 
 //Flash controller for VMU (note actual flash blocks are stored within device)
@@ -15,8 +18,19 @@ GBL_DECLARE_STRUCT(EvmuFlash_) {
     EVMU_FLASH_PROGRAM_STATE prgState;
     uint8_t                  prgBytes;
     GblByteArray*            pStorage;
+    uint64_t                 dirty[EVMU_FLASH__PAGE_COUNT_ / 64]; // pages written since last cleared
 };
 
+// Flags every page overlapping the given range as having been written
+EVMU_INLINE void EvmuFlash__markDirty_(EvmuFlash_* pSelf, size_t address, size_t bytes) GBL_NOEXCEPT {
+    if(!bytes || address >= EVMU_FLASH_SIZE) return;
+
+    const size_t last = (address + bytes < EVMU_FLASH_SIZE? address + bytes : EVMU_FLASH_SIZE) - 1;
+
+    for(size_t p = address / EVMU_FLASH__PAGE_SIZE_; p <= last / EVMU_FLASH__PAGE_SIZE_; ++p)
+        pSelf->dirty[p / 64] |= (uint64_t)1 << (p % 64);
+}
+
 GBL_DECLS_END
 
 #endif // EVMU_FLASH__H
@@ -4,6 +4,8 @@
 #include "evmu_gamepad_.h"
 #include "evmu_memory_.h"
 #include "../types/evmu_peripheral_.h"
+#include "../types/evmu_type_.h"
+#include "../types/evmu_journal_.h"
 #include <gimbal/meta/signals/gimbal_marshal.h>
 
 
@@ -26,10 +28,40 @@ EvmuWord EvmuGamepad__port3Value_(const EvmuGamepad_* pSelf_) {
             (!pSelf->sleep << EVMU_SFR_P3_SLEEP_POS));
 }
 
+uint16_t EvmuGamepad__buttons_(const EvmuGamepad* pSelf) {
+    return pSelf->up          << 0  | pSelf->down       << 1  |
+           pSelf->left        << 2  | pSelf->right      << 3  |
+           pSelf->a           << 4  | pSelf->b          << 5  |
+           pSelf->mode        << 6  | pSelf->sleep      << 7  |
+           pSelf->turboA      << 8  | pSelf->turboB     << 9  |
+           pSelf->fastForward << 10 | pSelf->slowMotion << 11;
+}
+
+void EvmuGamepad__setButtons_(EvmuGamepad* pSelf, uint16_t buttons) {
+    pSelf->up          = buttons >> 0  & 1;
+    pSelf->down        = buttons >> 1  & 1;
+    pSelf->left        = buttons >> 2  & 1;
+    pSelf->right       = buttons >> 3  & 1;
+    pSelf->a           = buttons >> 4  & 1;
+    pSelf->b           = buttons >> 5  & 1;
+    pSelf->mode        = buttons >> 6  & 1;
+    pSelf->sleep       = buttons >> 7  & 1;
+    pSelf->turboA      = buttons >> 8  & 1;
+    pSelf->turboB      = buttons >> 9  & 1;
+    pSelf->fastForward = buttons >> 10 & 1;
+    pSelf->slowMotion  = buttons >> 11 & 1;
+}
+
 static EVMU_RESULT EvmuGamepad_pollButtons_(EvmuGamepad* pSelf) {
     GBL_CTX_BEGIN(NULL);
 
-    EvmuGamepad_* pSelf_ = EVMU_GAMEPAD_(pSelf);
+    EvmuGamepad_* pSelf_  = EVMU_GAMEPAD_(pSelf);
+    EvmuDevice*   pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+
+    // Journaled as the buttons are sampled, replacing them with the recorded ones upon replay
+    if(pDevice && EVMU_DEVICE_(pDevice)->pJournal)
+        EvmuJournal__pollButtons_(EVMU_DEVICE_(pDevice)->pJournal, pSelf);
+
     const EvmuWord p3    = EvmuGamepad__port3Value_(pSelf_);
     const EvmuWord p3Int = pSelf_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_P3INT)];
 
@@ -44,7 +76,7 @@ static EVMU_RESULT EvmuGamepad_pollButtons_(EvmuGamepad* pSelf) {
             // Check if interrupt should be handled
             if(p3Int & EVMU_SFR_P3INT_P30INT_MASK) {
                 // Submit IRQ to PIC
-                EvmuPic_raiseIrq(EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf))->pPic, EVMU_IRQ_P3);
+                EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_P3);
             }
         }
     }
@@ -90,12 +122,27 @@ static EVMU_RESULT EvmuGamepad_EvmuIBehavior_reset_(EvmuIBehavior* pIBehav) {
     GBL_CTX_END();
 }
 
+static EvmuWord EvmuGamepad_readPort3_(EvmuMemory* pMemory, EvmuAddress address, void* pClosure) {
+    GBL_UNUSED(pMemory, address);
+    return EvmuGamepad__port3Value_(pClosure);
+}
+
 static GBL_RESULT EvmuGamepad_GblObject_constructed_(GblObject* pSelf) {
     GBL_CTX_BEGIN(NULL);
 
     GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.pFnConstructed, pSelf);
     GblObject_setName(pSelf, EVMU_GAMEPAD_NAME);
 
+    EvmuDevice* pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+
+    if(pDevice && pDevice->pMemory) {
+        const EvmuMemoryHandler port3 = {
+            EvmuGamepad_readPort3_, EvmuMemory__writeDirect_, EVMU_GAMEPAD_(pSelf)
+        };
+
+        GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, EVMU_ADDRESS_SFR_P3, &port3, NULL));
+    }
+
     GBL_CTX_END();
 }
 
@@ -122,7 +169,7 @@ static GBL_RESULT EvmuGamepadClass_init_(GblClass* pClass, const void* pUd, GblC
 }
 
 EVMU_EXPORT GblType EvmuGamepad_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuGamepadClass),
@@ -131,15 +178,12 @@ EVMU_EXPORT GblType EvmuGamepad_type(void) {
         .instancePrivateSize    = sizeof(EvmuGamepad_)
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuGamepad"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
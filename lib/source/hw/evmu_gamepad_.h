@@ -36,6 +36,10 @@ GBL_DECLARE_STRUCT(EvmuGamepad_) {
 
 EvmuWord EvmuGamepad__port3Value_(const EvmuGamepad_* pSelf_);
 
+// Every button packed into one value, from up at bit 0 through slowMotion at bit 11
+uint16_t EvmuGamepad__buttons_   (const EvmuGamepad* pSelf);
+void     EvmuGamepad__setButtons_(EvmuGamepad* pSelf, uint16_t buttons);
+
 GBL_DECLS_END
 
 #endif // EVMU_GAMEPAD__H
@@ -1,12 +1,45 @@
 #include "hw/evmu_lcd_.h"
 #include "hw/evmu_device_.h"
 #include "hw/evmu_memory_.h"
+#include "../types/evmu_type_.h"
 #include <evmu/hw/evmu_address_space.h>
 #include <gimbal/meta/signals/gimbal_marshal.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define EVMU_LCD__AVX2_
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define EVMU_LCD__SSE2_
+#endif
 
 #define EVMU_LCD_REFRESH_TICKS_83HZ_     12
 #define EVMU_LCD_REFRESH_TICKS_166HZ_    6
 
+// Frames are handed between threads with atomics wherever they're available
+#ifdef EVMU_TYPE__THREADS_
+#   define EVMU_LCD__LOAD_(pValue)              atomic_load_explicit(pValue, memory_order_acquire)
+#   define EVMU_LCD__STORE_(pValue, value)      atomic_store_explicit(pValue, value, memory_order_release)
+#   define EVMU_LCD__EXCHANGE_(pValue, value)   atomic_exchange_explicit(pValue, value, memory_order_acq_rel)
+#else
+#   define EVMU_LCD__LOAD_(pValue)              (*(pValue))
+#   define EVMU_LCD__STORE_(pValue, value)      (*(pValue) = (value))
+#   define EVMU_LCD__EXCHANGE_(pValue, value)   EvmuLcd_exchange_(pValue, value)
+
+static uint8_t EvmuLcd_exchange_(uint8_t* pValue, uint8_t value) {
+    const uint8_t prev = *pValue;
+    *pValue = value;
+    return prev;
+}
+#endif
+
+// What ghostRow_() did to a row
+#define EVMU_LCD__ROW_CHANGED_           0x1
+#define EVMU_LCD__ROW_FADING_            0x2
+
 // 6 bytes per row (8 bits per byte) = 48 bits per row
 // rows are in groups of 2
 // after each group of 2, next row starts after 4 bytes
@@ -68,62 +101,188 @@ GBL_INLINE void xramBitFromRowCol_(int x, int y, unsigned* bank, int* addr, unsi
     *bit = 7-x%8;
 }
 
-static void updateLcdBuffer_(EvmuLcd* pLcd) {
-    EvmuLcd_* pLcd_ = EVMU_LCD_(pLcd);
-
-    unsigned char *sfr = pLcd_->pMemory->sfr;
-    unsigned char (*xram)[0x80] = pLcd_->pMemory->xram;
-      int y, x, b=0, p=0;
-
-    const int pixelDelta = pLcd->ghostingEnabled? 1 : EVMU_LCD_GHOSTING_FRAMES;
+void EvmuLcd__invalidate_(EvmuLcd_* pSelf_) {
+    pSelf_->scroll = -1;
+}
 
-    p = sfr[0x22];
+// Where the top row of the screen starts within XRAM, as scrolled by STAD
+static void visibleStart_(int scroll, int* pBank, int* pOffset) {
+    int p = scroll;
     if(p>=0x83)
         p -= 0x83;
-    b = (p>>6);
-    p = (p&0x3f)*2;
-    for(y=0; y<32; y++) {
-        for(x=0; x<48; ) {
-            unsigned value = xram[b][p++];
-            for(int i = 7; i >= 0; --i) {
-                int prevVal = pLcd_->pixelBuffer[y][x];
-                if(prevVal == -1) {
-                    pLcd_->pixelBuffer[y][x] = 0;
-                    pLcd->screenChanged = GBL_TRUE;
-                }
+    *pBank   = (p>>6);
+    *pOffset = (p&0x3f)*2;
+}
 
-                if((value>>(unsigned)i)&0x1) {
-                    pLcd_->pixelBuffer[y][x] += pixelDelta;
-                    if(pLcd_->pixelBuffer[y][x] > EVMU_LCD_GHOSTING_FRAMES)
-                        pLcd_->pixelBuffer[y][x] = EVMU_LCD_GHOSTING_FRAMES;
+// Copies the next screen row's bytes, advancing along the layout of xramAddrLut_ and wrapping across banks
+static uint64_t visibleRow_(unsigned char (*xram)[0x80], int* pBank, int* pOffset, unsigned char* pBytes) {
+    int      b       = *pBank;
+    int      p       = *pOffset;
+    uint64_t rowBits = 0;
+
+    for(int x=0; x<6; ++x) {
+        rowBits |= EVMU_LCD__XRAM_ROW_BIT_(b, p);
+        pBytes[x] = xram[b][p++];
+
+        if((p&0xf)>=12)
+            p+=4;
+        if(p>=128) {
+            b++;
+            p-=128;
+        }
+        if(b==2 && p>=6) {
+            b = 0;
+            p -= 6;
+        }
+    }
 
+    *pBank   = b;
+    *pOffset = p;
+    return rowBits;
+}
 
-                } else {
-                    pLcd_->pixelBuffer[y][x] -= pixelDelta;
-                    if(pLcd_->pixelBuffer[y][x] < 0)
-                        pLcd_->pixelBuffer[y][x] = 0;
-                }
+// Steps a row's pixels one refresh towards the bits of its XRAM bytes, saturating at 0 and EVMU_LCD_GHOSTING_FRAMES
+static unsigned ghostRow_(int* pRow, const unsigned char* pBytes, int delta) {
+#if defined(EVMU_LCD__AVX2_)
+    // One byte expands to all 8 lanes
+    const __m256i bits = _mm256_setr_epi32(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi32(EVMU_LCD_GHOSTING_FRAMES);
+    const __m256i up   = _mm256_set1_epi32(delta);
+    const __m256i down = _mm256_set1_epi32(-delta);
+    __m256i       same = _mm256_cmpeq_epi32(zero, zero);
+    __m256i       done = same;
+
+    for(int c = 0; c < EVMU_LCD_PIXEL_WIDTH / 8; ++c) {
+        __m256i* pLanes = (__m256i*)&pRow[c * 8];
+
+        const __m256i prev = _mm256_loadu_si256(pLanes);
+        const __m256i on   = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(pBytes[c]), bits), bits);
+
+        // Uninitialized pixels (-1) start out from white
+        __m256i next = _mm256_add_epi32(_mm256_max_epi32(prev, zero), _mm256_blendv_epi8(down, up, on));
+        next = _mm256_min_epi32(_mm256_max_epi32(next, zero), full);
+
+        _mm256_storeu_si256(pLanes, next);
+        same = _mm256_and_si256(same, _mm256_cmpeq_epi32(next, prev));
+        done = _mm256_and_si256(done, _mm256_cmpeq_epi32(next, _mm256_and_si256(on, full)));
+    }
 
-                if(pLcd_->pixelBuffer[y][x] != prevVal)
-                    pLcd->screenChanged = GBL_TRUE;
+    return (_mm256_movemask_epi8(same) != -1? EVMU_LCD__ROW_CHANGED_ : 0) |
+           (_mm256_movemask_epi8(done) != -1? EVMU_LCD__ROW_FADING_  : 0);
 
-                x++;
-            }
+#elif defined(EVMU_LCD__SSE2_)
+    // One byte expands to two groups of 4 lanes, clamped with compares as SSE2 has no 32-bit min/max
+    const __m128i bits[2] = {
+        _mm_setr_epi32(0x80, 0x40, 0x20, 0x10),
+        _mm_setr_epi32(0x08, 0x04, 0x02, 0x01)
+    };
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi32(EVMU_LCD_GHOSTING_FRAMES);
+    const __m128i up   = _mm_set1_epi32(delta);
+    const __m128i down = _mm_set1_epi32(-delta);
+    __m128i       same = _mm_cmpeq_epi32(zero, zero);
+    __m128i       done = same;
 
-            if((p&0xf)>=12)
-                p+=4;
-            if(p>=128) {
-                b++;
-                p-=128;
-            }
-            if(b==2 && p>=6) {
-                b = 0;
-                p -= 6;
-            }
+    for(int c = 0; c < EVMU_LCD_PIXEL_WIDTH / 8; ++c) {
+        const __m128i byte = _mm_set1_epi32(pBytes[c]);
+
+        for(int h = 0; h < 2; ++h) {
+            __m128i* pLanes = (__m128i*)&pRow[c * 8 + h * 4];
+
+            const __m128i prev = _mm_loadu_si128(pLanes);
+            const __m128i on   = _mm_cmpeq_epi32(_mm_and_si128(byte, bits[h]), bits[h]);
+
+            // Uninitialized pixels (-1) start out from white
+            __m128i next = _mm_and_si128(prev, _mm_cmpgt_epi32(prev, zero));
+            next = _mm_add_epi32(next, _mm_or_si128(_mm_and_si128(on, up), _mm_andnot_si128(on, down)));
+            next = _mm_and_si128(next, _mm_cmpgt_epi32(next, zero));
 
+            const __m128i over = _mm_cmpgt_epi32(next, full);
+            next = _mm_or_si128(_mm_and_si128(over, full), _mm_andnot_si128(over, next));
+
+            _mm_storeu_si128(pLanes, next);
+            same = _mm_and_si128(same, _mm_cmpeq_epi32(next, prev));
+            done = _mm_and_si128(done, _mm_cmpeq_epi32(next, _mm_and_si128(on, full)));
+        }
+    }
+
+    return (_mm_movemask_epi8(same) != 0xffff? EVMU_LCD__ROW_CHANGED_ : 0) |
+           (_mm_movemask_epi8(done) != 0xffff? EVMU_LCD__ROW_FADING_  : 0);
+
+#else
+    unsigned row = 0;
+
+    for(int x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x) {
+        const int prevVal = pRow[x];
+        int       value   = prevVal < 0? 0 : prevVal;   // uninitialized pixels start out from white
+
+        if((pBytes[x/8]>>(unsigned)(7-x%8))&0x1) {
+            value += delta;
+            if(value >= EVMU_LCD_GHOSTING_FRAMES)
+                value = EVMU_LCD_GHOSTING_FRAMES;
+            else
+                row |= EVMU_LCD__ROW_FADING_;
+        } else {
+            value -= delta;
+            if(value <= 0)
+                value = 0;
+            else
+                row |= EVMU_LCD__ROW_FADING_;
         }
+
+        if(value != prevVal)
+            row |= EVMU_LCD__ROW_CHANGED_;
+
+        pRow[x] = value;
+    }
+
+    return row;
+#endif
+}
+
+// Redraws only rows whose XRAM was written since the last refresh or which are still fading
+static void updateLcdRows_(EvmuLcd* pLcd) {
+    EvmuLcd_* pLcd_ = EVMU_LCD_(pLcd);
+
+    const int pixelDelta = pLcd->ghostingEnabled? 1 : EVMU_LCD_GHOSTING_FRAMES;
+
+    int b, p;
+    visibleStart_(pLcd_->scroll, &b, &p);
+
+    for(int y=0; y<32; y++) {
+        unsigned char  bytes[6];
+        const uint64_t rowBits = visibleRow_(pLcd_->pMemory->xram, &b, &p, bytes);
+
+        if(!(pLcd_->dirtyRows & rowBits) && !(pLcd_->fadingRows & (UINT32_C(1) << y)))
+            continue;
+
+        const unsigned row = ghostRow_(pLcd_->pixelBuffer[y], bytes, pixelDelta);
+
+        if(row & EVMU_LCD__ROW_CHANGED_)
+            pLcd->screenChanged = GBL_TRUE;
+
+        if(row & EVMU_LCD__ROW_FADING_)
+            pLcd_->fadingRows |= UINT32_C(1) << y;
+        else
+            pLcd_->fadingRows &= ~(UINT32_C(1) << y);
     }
 
+    pLcd_->dirtyRows = 0;
+}
+
+static void updateLcdBuffer_(EvmuLcd* pLcd) {
+    EvmuLcd_* pLcd_ = EVMU_LCD_(pLcd);
+
+    // Scrolling moves every row, the same as writing all of them
+    if(pLcd_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_STAD)] != pLcd_->scroll) {
+        pLcd_->scroll    = pLcd_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_STAD)];
+        pLcd_->dirtyRows = UINT64_MAX;
+    }
+
+    if(pLcd_->dirtyRows || pLcd_->fadingRows)
+        updateLcdRows_(pLcd);
+
     EVMU_LCD_ICONS activeIcons = 0;
     FOREACH_ICON_BIT_(bit, index, EVMU_LCD_ICONS_ALL) {
         const GblBool value = !!(pLcd_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SEGMENT_XRAM_BASE)+index+1]
@@ -156,6 +315,8 @@ EVMU_EXPORT void EvmuLcd_setPixel(EvmuLcd* pSelf, size_t x, size_t y, GblBool on
             pSelf_->pMemory->xram[bank][addr] &= ~(0x1<<bit);
         }
 
+        pSelf_->dirtyRows |= EVMU_LCD__XRAM_ROW_BIT_(bank, addr);
+
         pSelf->screenChanged = GBL_TRUE;
     }
 }
@@ -174,9 +335,15 @@ EVMU_EXPORT GblBool EvmuLcd_pixel(const EvmuLcd* pSelf, size_t x, size_t y) {
 
 }
 
+// Never-drawn pixels are -1, and loaded states can hold anything, so both read as in range
+static int clampSample_(int sample) {
+    return sample < 0? 0 :
+           sample > EVMU_LCD_GHOSTING_FRAMES? EVMU_LCD_GHOSTING_FRAMES : sample;
+}
+
 static float samplePixel_(const EvmuLcd* pSelf, size_t x, size_t y) {
     EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
-    const uint8_t sample = pSelf_->pixelBuffer[y][x];
+    const int sample = clampSample_(pSelf_->pixelBuffer[y][x]);
 
     int samples = 20;
     float avg = sample*samples;
@@ -186,14 +353,14 @@ static float samplePixel_(const EvmuLcd* pSelf, size_t x, size_t y) {
         // above
         if(y > 0) {
             // top left
-            if(x > 0) avg += pSelf_->pixelBuffer[y-1][x-1];
+            if(x > 0) avg += clampSample_(pSelf_->pixelBuffer[y-1][x-1]);
             else avg += sample;
 
             // top middle
-            avg += pSelf_->pixelBuffer[y-1][x];
+            avg += clampSample_(pSelf_->pixelBuffer[y-1][x]);
 
             // top right
-            if(x < EVMU_LCD_PIXEL_WIDTH-1) avg += pSelf_->pixelBuffer[y-1][x+1];
+            if(x < EVMU_LCD_PIXEL_WIDTH-1) avg += clampSample_(pSelf_->pixelBuffer[y-1][x+1]);
             else avg += sample;
 
         } else avg += sample * 3;
@@ -202,26 +369,26 @@ static float samplePixel_(const EvmuLcd* pSelf, size_t x, size_t y) {
         // below
         if(y < EVMU_LCD_PIXEL_HEIGHT-1) {
             // bottom left
-            if(x > 0) avg += pSelf_->pixelBuffer[y+1][x-1];
+            if(x > 0) avg += clampSample_(pSelf_->pixelBuffer[y+1][x-1]);
             else avg += sample;
 
             // bottom middle
-            avg += pSelf_->pixelBuffer[y+1][x];
+            avg += clampSample_(pSelf_->pixelBuffer[y+1][x]);
 
             // bottom right
-            if(x < EVMU_LCD_PIXEL_WIDTH-1) avg += pSelf_->pixelBuffer[y+1][x+1];
+            if(x < EVMU_LCD_PIXEL_WIDTH-1) avg += clampSample_(pSelf_->pixelBuffer[y+1][x+1]);
             else avg += sample;
 
         } else avg += sample * 3;
         samples += 3;
 
         // left
-        if(x > 0) avg += pSelf_->pixelBuffer[y][x-1];
+        if(x > 0) avg += clampSample_(pSelf_->pixelBuffer[y][x-1]);
         else avg += sample;
         ++samples;
 
         // right
-        if(x < EVMU_LCD_PIXEL_WIDTH-1) avg += pSelf_->pixelBuffer[y][x+1];
+        if(x < EVMU_LCD_PIXEL_WIDTH-1) avg += clampSample_(pSelf_->pixelBuffer[y][x+1]);
         else avg += sample;
         ++samples;
     }
@@ -239,6 +406,204 @@ EVMU_EXPORT uint8_t EvmuLcd_decoratedPixel(const EvmuLcd* pSelf, size_t x, size_
     return pSelf->invertColors? white : 255 - white;
 }
 
+#ifdef EVMU_LCD__SSE2_
+// How many of a pixel's 8 neighbors are off the screen, which samplePixel_() replaces with the pixel itself
+static int missingNeighbors_(size_t x, size_t y) {
+    int missing = 0;
+
+    if(y == 0 || y == EVMU_LCD_PIXEL_HEIGHT-1)
+        missing += 3;
+    if(x == 0 || x == EVMU_LCD_PIXEL_WIDTH-1)
+        missing += missing? 2 : 3;
+
+    return missing;
+}
+#endif
+
+EVMU_EXPORT void EvmuLcd_decoratedFrame(const EvmuLcd* pSelf, uint8_t* pPixels) {
+    GBL_ASSERT(pPixels);
+
+#ifdef EVMU_LCD__SSE2_
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    /* Neighbors come from a zero-padded copy, with the center weighted up for each one
+       off the screen instead. Every sum is a small integer, so the float math rounds
+       exactly like samplePixel_(), 4 pixels at a time. */
+    float neighbors[EVMU_LCD_PIXEL_HEIGHT+2][EVMU_LCD_PIXEL_WIDTH+8] = { 0 };
+
+    if(pSelf->filterEnabled)
+        for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+            for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+                neighbors[y+1][x+4] = (float)clampSample_(pSelf_->pixelBuffer[y][x]);
+
+    const __m128  samples = _mm_set1_ps(pSelf->filterEnabled? 28.0f : 20.0f);
+    const __m128  frames  = _mm_set1_ps((float)EVMU_LCD_GHOSTING_FRAMES);
+    const __m128  scale   = _mm_set1_ps(255.0f);
+    const __m128i bytes   = _mm_set1_epi32(0xff);
+    const __m128i zero    = _mm_setzero_si128();
+    const __m128i full    = _mm_set1_epi32(EVMU_LCD_GHOSTING_FRAMES);
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y) {
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; x += 4) {
+            float weights[4];
+            for(size_t l = 0; l < 4; ++l)
+                weights[l] = 20.0f + (pSelf->filterEnabled? missingNeighbors_(x+l, y) : 0);
+
+            // The center is clamped with compares, same as clampSample_()
+            __m128i       center = _mm_loadu_si128((const __m128i*)&pSelf_->pixelBuffer[y][x]);
+            center = _mm_and_si128(center, _mm_cmpgt_epi32(center, zero));
+            const __m128i over   = _mm_cmpgt_epi32(center, full);
+            center = _mm_or_si128(_mm_and_si128(over, full), _mm_andnot_si128(over, center));
+            __m128 avg = _mm_mul_ps(_mm_cvtepi32_ps(center), _mm_loadu_ps(weights));
+
+            if(pSelf->filterEnabled) {
+                for(size_t r = 0; r < 3; ++r) {
+                    avg = _mm_add_ps(avg, _mm_loadu_ps(&neighbors[y+r][x+3]));
+                    if(r != 1)
+                        avg = _mm_add_ps(avg, _mm_loadu_ps(&neighbors[y+r][x+4]));
+                    avg = _mm_add_ps(avg, _mm_loadu_ps(&neighbors[y+r][x+5]));
+                }
+            }
+
+            avg = _mm_mul_ps(_mm_div_ps(_mm_div_ps(avg, samples), frames), scale);
+
+            __m128i white = _mm_cvttps_epi32(avg);
+            if(!pSelf->invertColors)
+                white = _mm_sub_epi32(bytes, white);
+
+            white = _mm_packs_epi32(white, white);
+            const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(white, white));
+            memcpy(&pPixels[y * EVMU_LCD_PIXEL_WIDTH + x], &packed, 4);
+        }
+    }
+#else
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            pPixels[y * EVMU_LCD_PIXEL_WIDTH + x] = EvmuLcd_decoratedPixel(pSelf, x, y);
+#endif
+}
+
+// 8x8 glyphs for each icon, in the order of their EVMU_LCD_ICONS bits
+static const uint8_t iconGlyphs_[EVMU_LCD_ICON_COUNT][EVMU_LCD_ICON_ROWS] = {
+    { 0x7e, 0x42, 0x5a, 0x42, 0x5a, 0x42, 0x7e, 0x00 },    // file
+    { 0xff, 0x81, 0xbd, 0xa5, 0xa5, 0xbd, 0x81, 0xff },    // game
+    { 0x3c, 0x42, 0x91, 0x91, 0x9d, 0x81, 0x42, 0x3c },    // clock
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x00 }     // flash
+};
+
+// Whether a pixel of the icon row beneath the screen is black, with each icon centered in a quarter of it
+static GblBool iconPixel_(EVMU_LCD_ICONS icons, size_t x, size_t y) {
+    const size_t cell = EVMU_LCD_PIXEL_WIDTH / EVMU_LCD_ICON_COUNT;
+    const size_t icon = x / cell;
+    const size_t col  = x % cell - (cell - 8) / 2;
+
+    if(!(icons & GBL_BIT_MASK(1, icon)) || col >= 8)
+        return GBL_FALSE;
+
+    return (iconGlyphs_[icon][y] >> (7 - col)) & 0x1;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuLcd_copyFramebuffer(const EvmuLcd* pSelf,
+                                                EVMU_LCD_FORMAT format,
+                                                void*           pDst,
+                                                size_t          stride)
+{
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    const EVMU_LCD_FORMAT pixels = format & ~EVMU_LCD_FORMAT_ICONS;
+    const size_t          bytes  = pixels == EVMU_LCD_FORMAT_1BPP?  EVMU_LCD_PIXEL_WIDTH / 8 :
+                                   pixels == EVMU_LCD_FORMAT_GRAY8? EVMU_LCD_PIXEL_WIDTH :
+                                                                    EVMU_LCD_PIXEL_WIDTH * 4;
+    const size_t          rows   = EVMU_LCD_PIXEL_HEIGHT +
+                                   ((format & EVMU_LCD_FORMAT_ICONS)? EVMU_LCD_ICON_ROWS : 0);
+
+    GBL_CTX_VERIFY_POINTER(pDst);
+    GBL_CTX_VERIFY(pixels < EVMU_LCD_FORMAT_COUNT,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "Invalid LCD framebuffer format: [%x]", format);
+
+    if(!stride) stride = bytes;
+
+    GBL_CTX_VERIFY(stride >= bytes,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "LCD framebuffer stride too small: [%zu < %zu]", stride, bytes);
+
+    const EVMU_LCD_ICONS icons = EvmuLcd_icons(pSelf);
+
+    if(pixels == EVMU_LCD_FORMAT_1BPP) {
+        // Rows are walked from wherever STAD starts the screen, same as refreshes draw them
+        int bank, offset;
+        visibleStart_(pSelf_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_STAD)], &bank, &offset);
+
+        for(size_t y = 0; y < rows; ++y) {
+            uint8_t* pRow = (uint8_t*)pDst + y * stride;
+
+            if(y < EVMU_LCD_PIXEL_HEIGHT) {
+                visibleRow_(pSelf_->pMemory->xram, &bank, &offset, pRow);
+            } else {
+                memset(pRow, 0, bytes);
+                for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+                    if(iconPixel_(icons, x, y - EVMU_LCD_PIXEL_HEIGHT))
+                        pRow[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    } else {
+        uint8_t       screen[EVMU_LCD_PIXEL_HEIGHT][EVMU_LCD_PIXEL_WIDTH];
+        const uint8_t black = pSelf->invertColors? 255 : 0;
+
+        EvmuLcd_decoratedFrame(pSelf, &screen[0][0]);
+
+        for(size_t y = 0; y < rows; ++y) {
+            uint8_t* pRow = (uint8_t*)pDst + y * stride;
+
+            for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x) {
+                const uint8_t gray = y < EVMU_LCD_PIXEL_HEIGHT? screen[y][x] :
+                                     iconPixel_(icons, x, y - EVMU_LCD_PIXEL_HEIGHT)? black : 255 - black;
+
+                if(pixels == EVMU_LCD_FORMAT_GRAY8) {
+                    pRow[x] = gray;
+                } else {
+                    pRow[x * 4 + 0] = gray;
+                    pRow[x * 4 + 1] = gray;
+                    pRow[x * 4 + 2] = gray;
+                    pRow[x * 4 + 3] = 0xff;
+                }
+            }
+        }
+    }
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT void EvmuLcd_publishFrame(EvmuLcd* pSelf) {
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    EvmuLcd_decoratedFrame(pSelf, &pSelf_->frames[pSelf_->backFrame][0][0]);
+
+    // Swapped in as ready, taking back whichever was ready before, acquired or not
+    pSelf_->backFrame = EVMU_LCD__EXCHANGE_(&pSelf_->readyFrame, pSelf_->backFrame | EVMU_LCD__FRAME_FRESH_) &
+                        ~EVMU_LCD__FRAME_FRESH_;
+    pSelf_->framesPublished = GBL_TRUE;
+}
+
+EVMU_EXPORT const uint8_t* EvmuLcd_acquireFrame(EvmuLcd* pSelf) {
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    if(!EVMU_LCD__LOAD_(&pSelf_->framesEnabled))
+        EVMU_LCD__STORE_(&pSelf_->framesEnabled, GBL_TRUE);
+
+    // Trades the held frame for the ready one, only if something newer was published since
+    if(EVMU_LCD__LOAD_(&pSelf_->readyFrame) & EVMU_LCD__FRAME_FRESH_) {
+        pSelf_->frontFrame    = EVMU_LCD__EXCHANGE_(&pSelf_->readyFrame, pSelf_->frontFrame) &
+                                ~EVMU_LCD__FRAME_FRESH_;
+        pSelf_->frameAcquired = GBL_TRUE;
+    }
+
+    return pSelf_->frameAcquired? &pSelf_->frames[pSelf_->frontFrame][0][0] : NULL;
+}
+
 EVMU_EXPORT GblFlags EvmuLcd_icons(const EvmuLcd* pSelf) {
     EVMU_LCD_ICONS icons = 0;
     EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
@@ -352,6 +717,111 @@ EVMU_EXPORT void EvmuLcd_drawLogo(const EvmuLcd* pSelf) {
 
 }
 
+// Mixes the next word into a frame hash, by way of splitmix64's finalizer
+static uint64_t hashMix_(uint64_t hash, uint64_t value) {
+    hash = (hash ^ value) * UINT64_C(0xbf58476d1ce4e5b9);
+    return hash ^ (hash >> 31);
+}
+
+// Hashes the XRAM shown on screen from the given scroll offset, a row at a time
+static uint64_t hashXram_(const EvmuLcd_* pSelf_, int scroll) {
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+
+    int b, p;
+    visibleStart_(scroll, &b, &p);
+
+    for(int y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y) {
+        unsigned char bytes[6];
+        uint64_t      row = 0;
+
+        visibleRow_(pSelf_->pMemory->xram, &b, &p, bytes);
+
+        for(int c = 0; c < 6; ++c)
+            row = row << 8 | bytes[c];
+
+        hash = hashMix_(hash, row);
+    }
+
+    return hash;
+}
+
+// Finishes a frame hash with everything else visible: the icons and whether the screen is on at all
+static uint64_t hashFrame_(const EvmuLcd* pSelf, uint64_t xramHash) {
+    return hashMix_(xramHash, EvmuLcd_icons(pSelf) | (uint64_t)EvmuLcd_screenEnabled(pSelf) << 8);
+}
+
+// Appends the current frame's hash, only rehashing XRAM if it was written or scrolled since the last one
+static GBL_RESULT EvmuLcd_logHash_(EvmuLcd* pSelf) {
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    if(pSelf_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_STAD)] != pSelf_->scroll || pSelf_->dirtyRows) {
+        pSelf_->scroll    = pSelf_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_STAD)];
+        pSelf_->xramHash  = hashXram_(pSelf_, pSelf_->scroll);
+        pSelf_->dirtyRows = 0;
+    }
+
+    if(pSelf_->hashCount == pSelf_->hashCapacity) {
+        const size_t capacity = pSelf_->hashCapacity? pSelf_->hashCapacity * 2 : 1024;
+        uint64_t*    pHashes  = realloc(pSelf_->pHashes, sizeof(uint64_t) * capacity);
+
+        GBL_CTX_VERIFY(pHashes,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "Failed to grow LCD hash log to %zu frames!",
+                       capacity);
+
+        pSelf_->pHashes      = pHashes;
+        pSelf_->hashCapacity = capacity;
+    }
+
+    pSelf_->pHashes[pSelf_->hashCount++] = hashFrame_(pSelf, pSelf_->xramHash);
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT GblBool EvmuLcd_hashLogging(const EvmuLcd* pSelf) {
+    return EVMU_LCD_(pSelf)->hashLogging;
+}
+
+EVMU_EXPORT void EvmuLcd_setHashLogging(EvmuLcd* pSelf, GblBool enabled) {
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    if(pSelf_->hashLogging != enabled) {
+        pSelf_->hashLogging = enabled;
+        // Whichever path takes over starts from scratch, as the other consumed the dirty rows
+        pSelf_->fadingRows  = 0;
+        EvmuLcd__invalidate_(pSelf_);
+    }
+}
+
+EVMU_EXPORT void EvmuLcd_clearHashLog(EvmuLcd* pSelf) {
+    EVMU_LCD_(pSelf)->hashCount = 0;
+}
+
+EVMU_EXPORT const uint64_t* EvmuLcd_hashLog(const EvmuLcd* pSelf, size_t* pCount) {
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    if(pCount) *pCount = pSelf_->hashCount;
+    return pSelf_->pHashes;
+}
+
+EVMU_EXPORT size_t EvmuLcd_compareHashLog(const EvmuLcd* pSelf, const uint64_t* pGolden, size_t count) {
+    EvmuLcd_* pSelf_ = EVMU_LCD_(pSelf);
+
+    const size_t common = count < pSelf_->hashCount? count : pSelf_->hashCount;
+
+    for(size_t f = 0; f < common; ++f)
+        if(pSelf_->pHashes[f] != pGolden[f])
+            return f;
+
+    return count == pSelf_->hashCount? GBL_NPOS : common;
+}
+
+EVMU_EXPORT uint64_t EvmuLcd_frameHash(const EvmuLcd* pSelf) {
+    return hashFrame_(pSelf, hashXram_(EVMU_LCD_(pSelf), EVMU_LCD_(pSelf)->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_STAD)]));
+}
+
 static GBL_RESULT EvmuLcd_refreshScreen_(EvmuLcd* pSelf) {
     GBL_CTX_BEGIN(NULL);
 
@@ -429,12 +899,65 @@ static GBL_RESULT EvmuLcd_GblObject_setProperty_(GblObject* pObject, const GblPr
     GBL_CTX_END();
 }
 
+static EvmuWord EvmuLcd_readVccr_(EvmuMemory* pMemory, EvmuAddress address, void* pClosure) {
+    GBL_UNUSED(pMemory, address, pClosure);
+    return 0xff;    // write-only
+}
+
+static EVMU_RESULT EvmuLcd_writeVccr_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) {
+    EvmuWord* pVccr = &EVMU_MEMORY_(pMemory)->sfr[EVMU_SFR_OFFSET(address)];
+
+    //if true, toggling LCD on, false off
+    if((*pVccr&EVMU_SFR_VCCR_VCCR7_MASK) ^ (value&EVMU_SFR_VCCR_VCCR7_MASK))
+        EvmuLcd_setScreenEnabled(pClosure, (value&EVMU_SFR_VCCR_VCCR7_MASK));
+
+    *pVccr = value;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static EVMU_RESULT EvmuLcd_writeXram_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) {
+    EvmuMemory_* pMemory_ = EVMU_MEMORY_(pMemory);
+    EvmuWord*    pData    = &pMemory_->pIntMap[address / EVMU_MEMORY__INT_SEGMENT_SIZE_]
+                                               [address % EVMU_MEMORY__INT_SEGMENT_SIZE_];
+
+    if(*pData != value) {
+        if(!(pMemory_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VCCR)] & 0x40))
+            EVMU_LCD(pClosure)->screenChanged = GBL_TRUE;
+
+        const size_t bank = (pMemory_->pIntMap[EVMU_MEMORY__INT_SEGMENT_XRAM_] - pMemory_->xram[0]) /
+                            EVMU_ADDRESS_SEGMENT_XRAM_SIZE;
+        EVMU_LCD_(pClosure)->dirtyRows |=
+                EVMU_LCD__XRAM_ROW_BIT_(bank, address % EVMU_MEMORY__INT_SEGMENT_SIZE_);
+    }
+
+    *pData = value;
+
+    return GBL_RESULT_SUCCESS;
+}
+
 static GBL_RESULT EvmuLcd_GblObject_constructed_(GblObject* pSelf) {
     GBL_CTX_BEGIN(NULL);
 
     GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.pFnConstructed, pSelf);
     GblObject_setName(pSelf, EVMU_LCD_NAME);
 
+    EvmuDevice* pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+
+    if(pDevice && pDevice->pMemory) {
+        const EvmuMemoryHandler vccr = {
+            EvmuLcd_readVccr_,       EvmuLcd_writeVccr_, pSelf
+        };
+        const EvmuMemoryHandler xram = {
+            EvmuMemory__readDirect_, EvmuLcd_writeXram_, pSelf
+        };
+
+        GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, EVMU_ADDRESS_SFR_VCCR, &vccr, NULL));
+
+        for(EvmuAddress a = EVMU_ADDRESS_SEGMENT_XRAM_BASE; a <= EVMU_ADDRESS_SEGMENT_XRAM_END; ++a)
+            GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, a, &xram, NULL));
+    }
+
     GBL_CTX_END();
 }
 
@@ -455,12 +978,21 @@ static GBL_RESULT EvmuLcd_IBehavior_update_(EvmuIBehavior* pSelf, EvmuTicks tick
     GblBool screenChanged = GBL_FALSE;
     while(pLcd_->refreshElapsed >= refreshTicks) {
         pLcd_->refreshElapsed -= refreshTicks;
+
+        if(pLcd_->hashLogging) {
+            GBL_CTX_VERIFY_CALL(EvmuLcd_logHash_(pLcd));
+            continue;
+        }
+
         updateLcdBuffer_(pLcd);
         if(pLcd->screenChanged) {
             screenChanged = GBL_TRUE;
         }
     }
 
+    if((screenChanged || !pLcd_->framesPublished) && EVMU_LCD__LOAD_(&pLcd_->framesEnabled))
+        EvmuLcd_publishFrame(pLcd);
+
     if(screenChanged)
         GBL_INSTANCE_VCALL(EvmuLcd, pFnRefreshScreen, pLcd);
 
@@ -478,6 +1010,17 @@ static GBL_RESULT EvmuLcd_IBehavior_reset_(EvmuIBehavior* pSelf) {
     memset(pLcd_->pixelBuffer, -1, sizeof(int)*EVMU_LCD_PIXEL_WIDTH *EVMU_LCD_PIXEL_HEIGHT);
     pLcd->screenChanged = GBL_TRUE;
     pLcd_->icons = EVMU_LCD_ICON_GAME;
+    pLcd_->fadingRows = 0;
+    EvmuLcd__invalidate_(pLcd_);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuLcd_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+    free(EVMU_LCD_(pBox)->pHashes);
+    GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.base.pFnDestructor, pBox);
 
     GBL_CTX_END();
 }
@@ -490,6 +1033,11 @@ static GBL_RESULT EvmuLcd_init_(GblInstance* pInstance, GblContext* pCtx) {
 
     GblObject_setName(GBL_OBJECT(pInstance), EVMU_LCD_NAME);
     pSelf->screenRefreshDivisor = EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+    EvmuLcd__invalidate_(EVMU_LCD_(pSelf));
+
+    EVMU_LCD_(pSelf)->backFrame  = 0;
+    EVMU_LCD_(pSelf)->readyFrame = 1;
+    EVMU_LCD_(pSelf)->frontFrame = 2;
 
     GBL_CTX_END();
 }
@@ -519,6 +1067,7 @@ static GBL_RESULT EvmuLcdClass_init_(GblClass* pClass, const void* pUd, GblConte
                                        GBL_FLAGS_TYPE));
     }
 
+    GBL_BOX_CLASS(pClass)       ->pFnDestructor    = EvmuLcd_GblBox_destructor_;
     GBL_OBJECT_CLASS(pClass)    ->pFnConstructed   = EvmuLcd_GblObject_constructed_;
     GBL_OBJECT_CLASS(pClass)    ->pFnProperty      = EvmuLcd_GblObject_property_;
     GBL_OBJECT_CLASS(pClass)    ->pFnSetProperty   = EvmuLcd_GblObject_setProperty_;
@@ -530,7 +1079,7 @@ static GBL_RESULT EvmuLcdClass_init_(GblClass* pClass, const void* pUd, GblConte
 }
 
 EVMU_EXPORT GblType EvmuLcd_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuLcdClass),
@@ -540,15 +1089,12 @@ EVMU_EXPORT GblType EvmuLcd_type(void) {
         .pFnInstanceInit        = EvmuLcd_init_
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuLcd"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
@@ -2,10 +2,18 @@
 #define EVMU_LCD__H
 
 #include <evmu/hw/evmu_lcd.h>
+#include "../types/evmu_type_.h"
 
 #define EVMU_LCD_(instance)         ((EvmuLcd_*)GBL_INSTANCE_PRIVATE(instance, EVMU_LCD_TYPE))
 #define EVMU_LCD_PUBLIC(instance)   ((EvmuLcd*)GBL_INSTANCE_PUBLIC(instance, EVMU_LCD_TYPE))
 
+// Set on EvmuLcd_::readyFrame from being published until it's acquired
+#define EVMU_LCD__FRAME_FRESH_  0x80
+
+// Bit within EvmuLcd_::dirtyRows for a byte of an XRAM bank, whose rows are 6 bytes in pairs of 16
+#define EVMU_LCD__XRAM_ROW_BIT_(bank, offset) \
+    (UINT64_C(1) << ((bank) * 16 + ((offset) >> 4) * 2 + (((offset) & 0xf) >= 6)))
+
 GBL_DECLS_BEGIN
 
 GBL_FORWARD_DECLARE_STRUCT(EvmuMemory_);
@@ -15,8 +23,27 @@ GBL_DECLARE_STRUCT(EvmuLcd_) {
     EVMU_LCD_ICONS  icons;
     EvmuTicks       refreshElapsed;
     EvmuMemory_*    pMemory;
+    uint64_t        dirtyRows;  // XRAM rows written since the last refresh, by EVMU_LCD__XRAM_ROW_BIT_()
+    uint32_t        fadingRows; // screen rows with pixels still ghosting towards their XRAM bits
+    int             scroll;     // STAD the screen was last drawn from, or -1 to redraw all of it
+    // EVMU_LCD_FORMAT_GRAY8 screens, triple buffered between the emulation thread and a reader
+    uint8_t                     frames[3][EVMU_LCD_PIXEL_HEIGHT][EVMU_LCD_PIXEL_WIDTH];
+    uint8_t                     backFrame;          // being rendered by the emulation thread
+    EVMU_TYPE__ATOMIC_ uint8_t  readyFrame;         // last published, with EVMU_LCD__FRAME_FRESH_
+    uint8_t                     frontFrame;         // held by the reader
+    EVMU_TYPE__ATOMIC_ GblBool  framesEnabled;      // set by the reader's first acquire
+    GblBool                     framesPublished;
+    GblBool                     frameAcquired;
+    uint64_t*                   pHashes;            // one per refresh while hash logging
+    size_t                      hashCount;
+    size_t                      hashCapacity;
+    uint64_t                    xramHash;           // of the visible XRAM as of the last logged refresh
+    GblBool                     hashLogging;
 };
 
+// Redraws the whole screen upon the next refresh, for when XRAM changed behind the write handlers
+void EvmuLcd__invalidate_(EvmuLcd_* pSelf_) GBL_NOEXCEPT;
+
 GBL_DECLS_END
 
 #endif // EVMU_LCD__H
@@ -2,22 +2,18 @@
 #include <evmu/hw/evmu_sfr.h>
 #include "evmu_memory_.h"
 #include "evmu_device_.h"
-#include "evmu_buzzer_.h"
 #include "evmu_timers_.h"
-#include "evmu_gamepad_.h"
 #include "evmu_rom_.h"
+#include "../types/evmu_type_.h"
 #include <gimbal/utils/gimbal_date_time.h>
+#include <stdlib.h>
 
 EVMU_EXPORT EvmuAddress EvmuMemory_indirectAddress(const EvmuMemory* pSelf, uint8_t mode) {
     EvmuAddress value = 0;
     GBL_CTX_BEGIN(pSelf);
 
     GBL_CTX_VERIFY(mode <= 3, GBL_RESULT_ERROR_OUT_OF_RANGE, "Invalid indirection mode: [%x]", mode);
-    value = (EvmuMemory_readData(pSelf,
-                mode |
-                ((EvmuMemory_viewData(pSelf, EVMU_ADDRESS_SFR_PSW) &
-                  (EVMU_SFR_PSW_IRBK0_MASK|EVMU_SFR_PSW_IRBK1_MASK)) >> 0x1u)) //Bits 2-3 come from PSW
-   | (mode&0x2)<<0x7u); //MSB of pointer is bit 1 from instruction
+    value = EvmuMemory__indirectAddress_(EVMU_MEMORY_(pSelf), mode);
 
     GBL_CTX_END_BLOCK();
     return value;
@@ -30,90 +26,30 @@ EVMU_EXPORT EvmuAddress EvmuMemory_indirectAddress(const EvmuMemory* pSelf, uint
  * meaning a SET1 could be setting more than just 1 bit.
  */
 EVMU_EXPORT EvmuWord EvmuMemory_readDataLatch(const EvmuMemory* pSelf, EvmuAddress addr) {
-    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pSelf);
-    switch(addr) {
-    case EVMU_ADDRESS_SFR_T1L:
-    case EVMU_ADDRESS_SFR_T1H:
-    case EVMU_ADDRESS_SFR_P1:
-    case EVMU_ADDRESS_SFR_P3:
-    case EVMU_ADDRESS_SFR_P7:
-        return pSelf_->pIntMap[addr/VMU_MEM_SEG_SIZE][addr%VMU_MEM_SEG_SIZE];
-    default:
-        return EvmuMemory_readData(pSelf, addr); //fall through to memory for non-latch data
-    }
+    EvmuWord value = 0;
+    GBL_CTX_BEGIN(pSelf);
+
+    GBL_CTX_VERIFY(addr/EVMU_MEMORY__INT_SEGMENT_SIZE_ < EVMU_MEMORY__INT_SEGMENT_COUNT_,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "Out-of-range read attempted: [%x]", addr);
+
+    value = EvmuMemory__readDataLatch_(EVMU_MEMORY_(pSelf), addr);
+
+    GBL_CTX_END_BLOCK();
+    return value;
 }
 
 EVMU_EXPORT EvmuWord EvmuMemory_readData(const EvmuMemory* pSelf, EvmuAddress addr) {
     EvmuWord value = 0;
     GBL_CTX_BEGIN(pSelf);
 
-    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pSelf);
-    EvmuDevice*  pDev   = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
-    EvmuDevice_* pDev_  = EVMU_DEVICE_(pDev);
-
-    //Write out other DNE SFR register bits to return 1s for H regions.
-
-    //CHECK IF WRITE-ONLY REGISTER:
-    switch(addr) {
-    case EVMU_ADDRESS_SFR_P1DDR:
-    case EVMU_ADDRESS_SFR_P1FCR:
-    case EVMU_ADDRESS_SFR_P3DDR:
-    case EVMU_ADDRESS_SFR_MCR:
-    case EVMU_ADDRESS_SFR_VCCR:
-        //_gyLog(GY_DEBUG_WARNING, "MEMORY[%x]: READ from WRITE-ONLY register!", addr);
-        value = 0xff;    //Return (hopefully hardware-accurate) bullshit.
-        GBL_CTX_DONE();
-    }
+    GBL_CTX_VERIFY(addr/EVMU_MEMORY__INT_SEGMENT_SIZE_ < EVMU_MEMORY__INT_SEGMENT_COUNT_,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "Out-of-range read attempted: [%x]", addr);
 
-    switch(addr) {
-    case EVMU_ADDRESS_SFR_VTRBF: { //Reading from separate working memory
-        value = pSelf_->wram[0x1ff&((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]<<8)
-                                   | pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])];
-        //must auto-increment pointer if VSEL_INCE is set
-        if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VSEL)] & EVMU_SFR_VSEL_INCE_MASK) {
-#if 0
-            const uint16_t vrmad = ((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]<<8) |
-                                    pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)]) + 1;
-
-            pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)] = vrmad & 0xff;
-            pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)] = (vrmad >> 8) & 0x1;
-
-#else
-            //check for 8-bit overflow after incrementing VRMAD1
-            if(!++pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])
-                //carry 9th bit to VRMAD2
-                pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)] ^= 1;
-        #endif
-        }
-        GBL_CTX_DONE();
-    }
-    case EVMU_ADDRESS_SFR_T0L:
-        value = pDev_->pTimers->timer0.base.tl; GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_T0H:
-        value = pDev_->pTimers->timer0.base.th; GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_T1L:
-        value = pDev_->pTimers->timer1.base.tl; GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_T1H:
-        value = pDev_->pTimers->timer1.base.th; GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_VRMAD2:
-        value = 0xfe|(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]&0x1);
-        GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_P1:
-        value = 0; GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_P3:
-        value = EvmuGamepad__port3Value_(pDev_->pGamepad);
-        GBL_CTX_DONE();
-    case EVMU_ADDRESS_SFR_P7:
-        value = 0xf0|(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_P7)]);
-        GBL_CTX_DONE();
-    default: {
-        GBL_CTX_VERIFY(addr/EVMU_MEMORY__INT_SEGMENT_SIZE_ < EVMU_MEMORY__INT_SEGMENT_COUNT_,
-                       GBL_RESULT_ERROR_OUT_OF_RANGE,
-                       "Out-of-range read attempted: [%x]", addr);
-        value = pSelf_->pIntMap[addr/VMU_MEM_SEG_SIZE][addr%VMU_MEM_SEG_SIZE];
-    }
-        GBL_CTX_END_BLOCK();
-    }
+    value = EvmuMemory__readData_(EVMU_MEMORY_(pSelf), addr);
+
+    GBL_CTX_END_BLOCK();
     return value;
 }
 
@@ -134,158 +70,280 @@ EVMU_EXPORT EvmuWord EvmuMemory_viewData(const EvmuMemory* pSelf, EvmuAddress ad
 EVMU_EXPORT EVMU_RESULT EvmuMemory_writeData(EvmuMemory* pSelf, EvmuAddress addr, EvmuWord val) {
     GBL_CTX_BEGIN(pSelf);
 
-    EvmuMemory_* pSelf_  = EVMU_MEMORY_(pSelf);
-    EvmuDevice*  pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
-    EvmuDevice_* pDev_   = EVMU_DEVICE_(pDevice);
+    GBL_CTX_VERIFY(addr/EVMU_MEMORY__INT_SEGMENT_SIZE_ < EVMU_MEMORY__INT_SEGMENT_COUNT_,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "Out-of-range write attempted: %x to %x",
+                   addr, val);
+
+    GBL_CTX_VERIFY(addr != EVMU_ADDRESS_SFR_XBNK || val <= 2,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "[XRAM]: Attempted to set invalid bank. [%u]", val);
 
-    //Check for SFRs with side-effects
-    switch(addr) {
-    case EVMU_ADDRESS_SFR_ACC: {
-        if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_ACC)] != val) {
-            //pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_ACC)] &= ~SFR_PSW_P_MASK|getParity(val);
-            pSelf_->sfr[0x01] = (pSelf_->sfr[0x01]&0xfe)|gblParity(val);
-        }
-        break;
+    GBL_CTX_VERIFY_CALL(EvmuMemory__writeData_(EVMU_MEMORY_(pSelf), addr, val));
+
+    GBL_CTX_END();
+}
+
+EvmuWord EvmuMemory__readDirect_(EvmuMemory* pMemory, EvmuAddress addr, void* pClosure) {
+    GBL_UNUSED(pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    return pSelf_->pIntMap[addr / EVMU_MEMORY__INT_SEGMENT_SIZE_]
+                          [addr % EVMU_MEMORY__INT_SEGMENT_SIZE_];
+}
+
+EVMU_RESULT EvmuMemory__writeDirect_(EvmuMemory* pMemory, EvmuAddress addr, EvmuWord val, void* pClosure) {
+    GBL_UNUSED(pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    pSelf_->pIntMap[addr / EVMU_MEMORY__INT_SEGMENT_SIZE_]
+                   [addr % EVMU_MEMORY__INT_SEGMENT_SIZE_] = val;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static EvmuWord EvmuMemory_readWriteOnly_(EvmuMemory* pMemory, EvmuAddress addr, void* pClosure) {
+    GBL_UNUSED(pMemory, addr, pClosure);
+    //_gyLog(GY_DEBUG_WARNING, "MEMORY[%x]: READ from WRITE-ONLY register!", addr);
+    return 0xff;    //Return (hopefully hardware-accurate) bullshit.
+}
+
+static EvmuWord EvmuMemory_readVtrbf_(EvmuMemory* pMemory, EvmuAddress addr, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    //Reading from separate working memory
+    const EvmuWord value = pSelf_->wram[0x1ff&((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]<<8)
+                                              | pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])];
+    //must auto-increment pointer if VSEL_INCE is set
+    if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VSEL)] & EVMU_SFR_VSEL_INCE_MASK) {
+        //check for 8-bit overflow after incrementing VRMAD1
+        if(!++pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])
+            //carry 9th bit to VRMAD2
+            pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)] ^= 1;
     }
-    case EVMU_ADDRESS_SFR_VTRBF: //Writing to separate working memory
-        pSelf_->wram[0x1ff & ((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]<<8)
-                           | pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])] = val;
-        //must auto-increment pointer if VSEL_INCE is set
-        if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VSEL)]&EVMU_SFR_VSEL_INCE_MASK) {
-        #if 1
-            //check for 8-bit overflow after incrementing VRMAD1
-            if(!++pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])
-                //carry 9th bit to VRMAD2
-                pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)] ^= 1;
-#else
-            const uint16_t vrmad = ((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]<<8) |
-                                    pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)]) + 1;
-
-            pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)] = vrmad & 0xff;
-            pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)] = (vrmad >> 8) & 0x1;
-
-#endif
-        }
-        GBL_CTX_DONE();
-        break;
-    case EVMU_ADDRESS_SFR_EXT: {
-#if 1
-        //changing CPU mode (change imem between BIOS in rom and APP in flash)
-        const EvmuWord mode = val & 0x1;
-        if((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_EXT)]&0x1) != mode) {
-            const EvmuAddress pc = EvmuCpu_pc(pDevice->pCpu);
+    return value;
+}
 
-            //next instr must be JMPF, do it now, since imem is changing
-            //if(pc > 0xfffd || pSelf_->pExt[pc] != OPCODE_JMPF) {
-               // GBL_CTX_WARN("Attempt to change EXT ROM source at invalid PC or without JMPF!");
-           // } else {
-            if(pSelf_->pExt[pc] == EVMU_OPCODE_JMPF) {
+static EVMU_RESULT EvmuMemory_writeVtrbf_(EvmuMemory* pMemory, EvmuAddress addr, EvmuWord val, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    //Writing to separate working memory
+    pSelf_->wram[0x1ff & ((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]<<8)
+                       | pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])] = val;
+    //must auto-increment pointer if VSEL_INCE is set
+    if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VSEL)]&EVMU_SFR_VSEL_INCE_MASK) {
+        //check for 8-bit overflow after incrementing VRMAD1
+        if(!++pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD1)])
+            //carry 9th bit to VRMAD2
+            pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)] ^= 1;
+    }
 
+    return GBL_RESULT_SUCCESS;
+}
 
-                EvmuCpu_setPc(pDevice->pCpu, (pSelf_->pExt[pc+1]<<8) | pSelf_->pExt[pc+2]);
-            }
+static EvmuWord EvmuMemory_readVrmad2_(EvmuMemory* pMemory, EvmuAddress addr, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    return 0xfe|(EVMU_MEMORY_(pMemory)->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VRMAD2)]&0x1);
+}
 
-            if(!mode) pSelf_->pExt = pSelf_->rom;
-            else pSelf_->pExt = pSelf_->pFlash->pStorage->pData;
-        }
-        break;
-#endif
+static EvmuWord EvmuMemory_readP7_(EvmuMemory* pMemory, EvmuAddress addr, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    return 0xf0|(EVMU_MEMORY_(pMemory)->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_P7)]);
+}
+
+static EVMU_RESULT EvmuMemory_writeAcc_(EvmuMemory* pMemory, EvmuAddress addr, EvmuWord val, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    // PSW.P is only recomputed once PSW is observed
+    if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_ACC)] != val) {
+        pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_ACC)] = val;
+        pSelf_->flags.parity = GBL_TRUE;
     }
-    case EVMU_ADDRESS_SFR_XBNK:{ //changing XRAM bank
-        if( pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_XBNK)] != val /*&&
-                !(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VCCR)] &
-                  0x40)*/) {
-            GBL_CTX_VERIFY(val <= 2,
-                           GBL_RESULT_ERROR_OUT_OF_RANGE,
-                           "[XRAM]: Attempted to set invalid bank. [%u]", val);
-            pSelf_->pIntMap[VMU_MEM_SEG_XRAM] = pSelf_->xram[val];
-        }
-        break;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static EvmuWord EvmuMemory_readPsw_(EvmuMemory* pMemory, EvmuAddress addr, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    EvmuMemory__syncPsw_(pSelf_);
+
+    return pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)];
+}
+
+static EVMU_RESULT EvmuMemory_writePsw_(EvmuMemory* pMemory, EvmuAddress addr, EvmuWord val, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    unsigned char psw = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)];
+    //Check if changing RAM bank
+    if((psw&EVMU_SFR_PSW_RAMBK0_MASK) != (val&EVMU_SFR_PSW_RAMBK0_MASK)) {
+        unsigned newIndex = (val&EVMU_SFR_PSW_RAMBK0_MASK)>>EVMU_SFR_PSW_RAMBK0_POS;
+        GBL_ASSERT(newIndex == 0 || newIndex == 1);
+        pSelf_->pIntMap[VMU_MEM_SEG_GP1] = pSelf_->ram[newIndex];
+        pSelf_->pIntMap[VMU_MEM_SEG_GP2] = &pSelf_->ram[newIndex][VMU_MEM_SEG_SIZE];
     }
-    case EVMU_ADDRESS_SFR_PSW: {
-        unsigned char psw = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)];
-        //Check if changing RAM bank
-        if((psw&EVMU_SFR_PSW_RAMBK0_MASK) != (val&EVMU_SFR_PSW_RAMBK0_MASK)) {
-            unsigned newIndex = (val&EVMU_SFR_PSW_RAMBK0_MASK)>>EVMU_SFR_PSW_RAMBK0_POS;
-            GBL_ASSERT(newIndex == 0 || newIndex == 1);
-            pSelf_->pIntMap[VMU_MEM_SEG_GP1] = pSelf_->ram[newIndex];
-            pSelf_->pIntMap[VMU_MEM_SEG_GP2] = &pSelf_->ram[newIndex][VMU_MEM_SEG_SIZE];
-        }
-        break;
+
+    // Explicit writes supersede any flags still pending
+    pSelf_->flags.op     = EVMU_MEMORY__ALU_OP_NONE_;
+    pSelf_->flags.parity = GBL_FALSE;
+
+    pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)] = val;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static EVMU_RESULT EvmuMemory_writeExt_(EvmuMemory* pMemory, EvmuAddress addr, EvmuWord val, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    //changing CPU mode (change imem between BIOS in rom and APP in flash)
+    const EvmuWord mode = val & 0x1;
+    if((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_EXT)]&0x1) != mode) {
+        EvmuCpu*          pCpu = EVMU_CPU_PUBLIC_(pSelf_->pCpu);
+        const EvmuAddress pc   = EvmuCpu_pc(pCpu);
+
+        //next instr must be JMPF, do it now, since imem is changing
+        if(pSelf_->pExt[pc] == EVMU_OPCODE_JMPF)
+            EvmuCpu__advancePc_(pSelf_->pCpu, (pSelf_->pExt[pc+1]<<8) | pSelf_->pExt[pc+2]);
+
+        // Cached instructions are tagged by bank, so nothing needs flushing here
+        if(!mode) pSelf_->pExt = pSelf_->rom;
+        else pSelf_->pExt = pSelf_->pFlash->pStorage->pData;
     }
-    case EVMU_ADDRESS_SFR_T0PRR:
-        pDev_->pTimers->timer0.tscale = 256 - val;
-        pDev_->pTimers->timer0.tbase  = 0;
-        break;
-    case EVMU_ADDRESS_SFR_T0CNT:
-        if(!(val&EVMU_SFR_T0CNT_P0LRUN_MASK))
-            pDev_->pTimers->timer0.base.tl = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)];
-        if(!(val&EVMU_SFR_T0CNT_P0HRUN_MASK))
-            pDev_->pTimers->timer0.base.th = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)];
-        break;
-    case EVMU_ADDRESS_SFR_T0LR:
-        if(!(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_P0LRUN_MASK))
-            pDev_->pTimers->timer0.base.tl = val;
-        break;
-    case EVMU_ADDRESS_SFR_T0HR:
-        if(!(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_P0HRUN_MASK))
-            pDev_->pTimers->timer0.base.th = val;
-        break;
-    case EVMU_ADDRESS_SFR_T1CNT:
-        if(!(val&EVMU_SFR_T1CNT_T1LRUN_MASK))
-            pDev_->pTimers->timer1.base.tl = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)];
-        if(!(val&EVMU_SFR_T1CNT_T1HRUN_MASK))
-            pDev_->pTimers->timer1.base.th = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)];
-        break;
-    case EVMU_ADDRESS_SFR_T1LR:
-        if(!(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)]&EVMU_SFR_T1CNT_T1LRUN_MASK))
-            pDev_->pTimers->timer1.base.tl = val;
-        break;
-    case EVMU_ADDRESS_SFR_T1HR:
-        if(!(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)]&EVMU_SFR_T1CNT_T1HRUN_MASK))
-            pDev_->pTimers->timer1.base.th = val;
-        break;
-    case EVMU_ADDRESS_SFR_P3DDR:
-        //if((pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_EXT)]&EVMU_SFR_EXT_MASK) == EVMU_SFR_EXT_USER) {
-         //   _gyLog(GY_DEBUG_WARNING, "MEMORY WRITE: Attempted to write to P3DDR register which is not allowed in user mode!");
-        //}
-        break;
-    case EVMU_ADDRESS_SFR_SCON0:
-        break;
-    case EVMU_ADDRESS_SFR_SCON1:
-        break;
-    case EVMU_ADDRESS_SFR_VCCR: {
-        int prevVal = pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VCCR)];
-        //if true, toggling LCD on, false off
-        if((prevVal&EVMU_SFR_VCCR_VCCR7_MASK) ^ (val&EVMU_SFR_VCCR_VCCR7_MASK)) {
-            EvmuLcd_setScreenEnabled(pDevice->pLcd, (val&EVMU_SFR_VCCR_VCCR7_MASK));
-        }
+
+    pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_EXT)] = val;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+static EVMU_RESULT EvmuMemory_writeXbnk_(EvmuMemory* pMemory, EvmuAddress addr, EvmuWord val, void* pClosure) {
+    GBL_UNUSED(addr, pClosure);
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pMemory);
+
+    //changing XRAM bank
+    if(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_XBNK)] != val) {
+        if(val > 2) return GBL_RESULT_ERROR_OUT_OF_RANGE;
+        pSelf_->pIntMap[VMU_MEM_SEG_XRAM] = pSelf_->xram[val];
     }
-    case EVMU_ADDRESS_SFR_PCON:
-     //   GBL_CTX_VERBOSE("PCON: %x", val);
-    default: break;
+
+    pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_XBNK)] = val;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuMemory_setHandler(EvmuMemory*              pSelf,
+                                              EvmuAddress              address,
+                                              const EvmuMemoryHandler* pHandler,
+                                              EvmuMemoryHandler*       pPrevious)
+{
+    GBL_CTX_BEGIN(pSelf);
+
+    EvmuMemory_* pSelf_ = EVMU_MEMORY_(pSelf);
+
+    GBL_CTX_VERIFY(address/EVMU_MEMORY__INT_SEGMENT_SIZE_ < EVMU_MEMORY__INT_SEGMENT_COUNT_,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "Attempted to install handler for out-of-range address: [%x]", address);
+
+    GBL_CTX_VERIFY(!pHandler || (pHandler->pFnRead && pHandler->pFnWrite),
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "Handler for [%x] must service both reads and writes", address);
+
+    if(pPrevious)
+        *pPrevious = pSelf_->handlers[address];
+
+    const GblBool wasDirect = EvmuMemory__isDirect_(pSelf_, address);
+
+    if(pHandler) {
+        pSelf_->handlers[address] = *pHandler;
+    } else {
+        pSelf_->handlers[address].pFnRead  = EvmuMemory__readDirect_;
+        pSelf_->handlers[address].pFnWrite = EvmuMemory__writeDirect_;
+        pSelf_->handlers[address].pClosure = NULL;
     }
 
+    /* Recompiled blocks only ever inline accesses to handler-free RAM, so nothing
+       else (such as the SFR handlers installed during construction) needs a flush. */
+    if(pSelf_->pCpu && address <= EVMU_ADDRESS_SEGMENT_RAM_END &&
+       wasDirect != EvmuMemory__isDirect_(pSelf_, address))
+        EvmuCpu__flushCache_(pSelf_->pCpu);
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EvmuMemoryHandler EvmuMemory_handler(const EvmuMemory* pSelf, EvmuAddress addr) {
+    EvmuMemoryHandler handler = { 0 };
+
+    GBL_CTX_BEGIN(pSelf);
+
     GBL_CTX_VERIFY(addr/EVMU_MEMORY__INT_SEGMENT_SIZE_ < EVMU_MEMORY__INT_SEGMENT_COUNT_,
                    GBL_RESULT_ERROR_OUT_OF_RANGE,
-                   "Out-of-range write attempted: %x to %x",
-                   addr, val);
+                   "Out-of-range handler requested: [%x]", addr);
 
+    handler = EVMU_MEMORY_(pSelf)->handlers[addr];
 
-    if((addr >= EVMU_ADDRESS_SEGMENT_XRAM_BASE && addr <= EVMU_ADDRESS_SEGMENT_XRAM_END) &&
-            !(pSelf_->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_VCCR)] &
-                              0x40)) {
-        if(pSelf_->pIntMap[addr/VMU_MEM_SEG_SIZE][addr%VMU_MEM_SEG_SIZE] != val) {
-            pDevice->pLcd->screenChanged = GBL_TRUE;
-        }
-    }
+    GBL_CTX_END_BLOCK();
+    return handler;
+}
 
-    //do actual memory write
-    pSelf_->pIntMap[addr/VMU_MEM_SEG_SIZE][addr%VMU_MEM_SEG_SIZE] = val;
+static void EvmuMemory_releaseRom_(EvmuMemoryRom_* pImage) {
+    if(pImage && !--pImage->refCount && !pImage->arena)
+        free(pImage);
+}
 
-    EvmuBuzzer__memorySink_(EVMU_BUZZER_(pDevice->pBuzzer), addr, val);
+EVMU_RESULT EvmuMemory__ownRom_(EvmuMemory_* pSelf) {
+    if(pSelf->pRomImage->refCount == 1)
+        return GBL_RESULT_SUCCESS;
 
-    GBL_CTX_END();
+    EvmuMemoryRom_* pImage = malloc(sizeof(EvmuMemoryRom_));
+
+    if(!pImage)
+        return GBL_RESULT_ERROR_MEM_ALLOC;
+
+    pImage->refCount = 1;
+    memcpy(pImage->bytes, pSelf->pRomImage->bytes, sizeof(pImage->bytes));
+
+    if(pSelf->pExt == pSelf->rom)
+        pSelf->pExt = pImage->bytes;
+
+    EvmuMemory_releaseRom_(pSelf->pRomImage);
+
+    pSelf->pRomImage = pImage;
+    pSelf->rom       = pImage->bytes;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+EVMU_RESULT EvmuMemory__shareRom_(EvmuMemory_* pSelf, EvmuMemory_* pSource) {
+    // An arena image dies with its device, which a sharer could outlive
+    if(pSelf->pRomImage->arena || pSource->pRomImage->arena) {
+        const EVMU_RESULT result = EvmuMemory__ownRom_(pSelf);
+
+        if(result != GBL_RESULT_SUCCESS)
+            return result;
+
+        memcpy(pSelf->rom, pSource->rom, EVMU_ROM_SIZE);
+    } else {
+        ++pSource->pRomImage->refCount;
+
+        if(pSelf->pExt == pSelf->rom)
+            pSelf->pExt = pSource->rom;
+
+        EvmuMemory_releaseRom_(pSelf->pRomImage);
+
+        pSelf->pRomImage = pSource->pRomImage;
+        pSelf->rom       = pSource->rom;
+    }
+
+    // Same addresses, different contents
+    if(pSelf->pCpu)
+        EvmuCpu__flushCache_(pSelf->pCpu);
+
+    return GBL_RESULT_SUCCESS;
 }
 
 EVMU_EXPORT EvmuWord EvmuMemory_readProgram(const EvmuMemory* pSelf, EvmuAddress addr) {
@@ -361,8 +419,22 @@ EVMU_EXPORT EVMU_RESULT EvmuMemory_writeProgram(EvmuMemory* pSelf,
                        "[EXT]: Invalid ROM write address. [%x]", addr);
     }
 
+    if(pSelf_->pExt == pSelf_->rom)
+        GBL_CTX_VERIFY_CALL(EvmuMemory__ownRom_(pSelf_));
+
     pSelf_->pExt[addr] = value;
 
+    if(pSelf_->pExt != pSelf_->rom)
+        EvmuFlash__markDirty_(pSelf_->pFlash, addr, 1);
+
+    if(pSelf_->pCpu)
+        EvmuCpu__invalidateCache_(pSelf_->pCpu,
+                                  pSelf_->pExt == pSelf_->rom?
+                                      EVMU_CPU__ICACHE_BANK_ROM_ :
+                                      EVMU_CPU__ICACHE_BANK_FLASH_,
+                                  addr,
+                                  1);
+
     GBL_CTX_END();
 }
 
@@ -467,12 +539,52 @@ static GBL_RESULT EvmuMemory_constructor_(GblObject* pSelf) {
     GBL_CTX_BEGIN(NULL);
     GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.pFnConstructor, pSelf);
 
+    EvmuMemory*  pMemory  = EVMU_MEMORY(pSelf);
+    EvmuMemory_* pMemory_ = EVMU_MEMORY_(pMemory);
+
     GblObject_setName(pSelf, EVMU_MEMORY_NAME);
+
+    pMemory_->pRomImage = EvmuDevice__arenaAlloc_(sizeof(EvmuMemoryRom_));
+
+    if(pMemory_->pRomImage)
+        pMemory_->pRomImage->arena = GBL_TRUE;
+    else
+        pMemory_->pRomImage = calloc(1, sizeof(EvmuMemoryRom_));
+
+    GBL_CTX_VERIFY(pMemory_->pRomImage,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "Failed to allocate BIOS image!");
+
+    pMemory_->pRomImage->refCount = 1;
+    pMemory_->rom                 = pMemory_->pRomImage->bytes;
+
+    // Everything starts out direct, other peripherals install their own handlers
+    for(EvmuAddress a = 0; a < GBL_COUNT_OF(pMemory_->handlers); ++a)
+        EvmuMemory_setHandler(pMemory, a, NULL, NULL);
+
+    static const struct {
+        EvmuAddress       address;
+        EvmuMemoryHandler handler;
+    } handlers[] = {
+        { EVMU_ADDRESS_SFR_ACC,    { EvmuMemory__readDirect_,    EvmuMemory_writeAcc_      } },
+        { EVMU_ADDRESS_SFR_PSW,    { EvmuMemory_readPsw_,        EvmuMemory_writePsw_      } },
+        { EVMU_ADDRESS_SFR_EXT,    { EvmuMemory__readDirect_,    EvmuMemory_writeExt_      } },
+        { EVMU_ADDRESS_SFR_XBNK,   { EvmuMemory__readDirect_,    EvmuMemory_writeXbnk_     } },
+        { EVMU_ADDRESS_SFR_VTRBF,  { EvmuMemory_readVtrbf_,      EvmuMemory_writeVtrbf_    } },
+        { EVMU_ADDRESS_SFR_VRMAD2, { EvmuMemory_readVrmad2_,     EvmuMemory__writeDirect_  } },
+        { EVMU_ADDRESS_SFR_P7,     { EvmuMemory_readP7_,         EvmuMemory__writeDirect_  } },
+        { EVMU_ADDRESS_SFR_P3DDR,  { EvmuMemory_readWriteOnly_,  EvmuMemory__writeDirect_  } },
+        { EVMU_ADDRESS_SFR_MCR,    { EvmuMemory_readWriteOnly_,  EvmuMemory__writeDirect_  } }
+    };
+
+    for(size_t h = 0; h < GBL_COUNT_OF(handlers); ++h)
+        EvmuMemory_setHandler(pMemory, handlers[h].address, &handlers[h].handler, NULL);
     GBL_CTX_END();
 }
 
 static GBL_RESULT EvmuMemory_destructor_(GblBox* pSelf) {
     GBL_CTX_BEGIN(NULL);
+    EvmuMemory_releaseRom_(EVMU_MEMORY_(pSelf)->pRomImage);
     GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.base.pFnDestructor, pSelf);
     GBL_CTX_END();
 }
@@ -508,6 +620,7 @@ static GBL_RESULT EvmuMemory_reset_(EvmuIBehavior* pSelf) {
     memset(pDevice_->pMemory->sfr, 0, EVMU_ADDRESS_SEGMENT_SFR_SIZE);
     memset(pDevice_->pMemory->wram, 0, EVMU_WRAM_SIZE);
     memset(pDevice_->pMemory->xram, 0, EVMU_ADDRESS_SEGMENT_XRAM_SIZE*EVMU_ADDRESS_SEGMENT_XRAM_BANKS);
+    memset(&pDevice_->pMemory->flags, 0, sizeof(EvmuMemoryLazyFlags_));
 
 
     pDevice_->pMemory->pIntMap[VMU_MEM_SEG_XRAM]       = pDevice_->pMemory->xram[EVMU_XRAM_BANK_LCD_TOP];
@@ -598,7 +711,7 @@ static GBL_RESULT EvmuMemoryClass_init_(GblClass* pClass, const void* pData, Gbl
 }
 
 GBL_EXPORT GblType EvmuMemory_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .pFnClassInit          = EvmuMemoryClass_init_,
@@ -607,15 +720,12 @@ GBL_EXPORT GblType EvmuMemory_type(void) {
         .instancePrivateSize   = sizeof(EvmuMemory_)
     };
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuMemory"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
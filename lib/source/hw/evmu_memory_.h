@@ -12,6 +12,7 @@
 #include <evmu/hw/evmu_rom.h>
 #include "evmu_cpu_.h"
 #include "evmu_flash_.h"
+#include "../types/evmu_type_.h"
 
 #define EVMU_MEMORY_(instance)      ((EvmuMemory_*)GBL_INSTANCE_PRIVATE(instance, EVMU_MEMORY_TYPE))
 #define EVMU_MEMORY_PUBLIC_(priv)   ((EvmuMemory*)GBL_INSTANCE_PUBLIC(priv, EVMU_MEMORY_TYPE))
@@ -30,6 +31,30 @@ typedef enum EVMU_MEMORY__INT_SEGMENT_ {
     EVMU_MEMORY__INT_SEGMENT_COUNT_
 } EVMU_MEMORY__INT_SEGMENT_;
 
+// Arithmetic operation whose PSW flags have yet to be materialized
+typedef enum EVMU_MEMORY__ALU_OP_ {
+    EVMU_MEMORY__ALU_OP_NONE_,
+    EVMU_MEMORY__ALU_OP_ADD_,
+    EVMU_MEMORY__ALU_OP_SUB_
+} EVMU_MEMORY__ALU_OP_;
+
+/* PSW state which is only folded back into the SFR once something
+   actually observes it, rather than on every ACC write and ALU op. */
+typedef struct EvmuMemoryLazyFlags_ {
+    uint8_t  op;        // EVMU_MEMORY__ALU_OP_ of the last ADD/ADDC/SUB/SUBC
+    EvmuWord a;         // ACC going into it
+    EvmuWord b;         // other operand
+    EvmuWord c;         // carry in
+    GblBool  parity;    // ACC has changed since PSW.P was last computed
+} EvmuMemoryLazyFlags_;
+
+// BIOS image, shared between a device and its clones until one of them writes to it
+typedef struct EvmuMemoryRom_ {
+    EVMU_TYPE__ATOMIC_ size_t refCount;
+    GblBool                   arena;    // carved from its device's arena, so never shared or freed
+    EvmuWord                  bytes[EVMU_ROM_SIZE];
+} EvmuMemoryRom_;
+
 typedef struct EvmuMemory_ {
     EvmuCpu_*   pCpu;
     EvmuFlash_* pFlash;
@@ -40,7 +65,8 @@ typedef struct EvmuMemory_ {
     EvmuWord  xram    [EVMU_ADDRESS_SEGMENT_XRAM_BANKS][EVMU_ADDRESS_SEGMENT_XRAM_SIZE]; //VRAM
 
     // External Memory BUS
-    EvmuWord  rom     [EVMU_ROM_SIZE];
+    EvmuMemoryRom_* pRomImage;
+    EvmuWord*       rom;    // pRomImage->bytes
 
     // Extra Working RAM
     EvmuWord  wram    [EVMU_WRAM_SIZE];
@@ -49,8 +75,139 @@ typedef struct EvmuMemory_ {
     EvmuWord* pIntMap [EVMU_MEMORY__INT_SEGMENT_COUNT_];                //contiguous RAM address space
     // Memory-Map for current external BUS address space
     EvmuWord* pExt;
+
+    // Per-address dispatch for the internal BUS, built once at construction
+    EvmuMemoryHandler handlers[EVMU_MEMORY__INT_SEGMENT_COUNT_ * EVMU_MEMORY__INT_SEGMENT_SIZE_];
+
+    // CY, AC, OV, and P which are pending in PSW
+    EvmuMemoryLazyFlags_ flags;
 } EvmuMemory_;
 
+// Gives the device its own copy of the BIOS image if it's shared, before writing to it
+EVMU_RESULT EvmuMemory__ownRom_  (GBL_SELF)                             GBL_NOEXCEPT;
+// Switches over to sharing the source's BIOS image, or copies it when either lives in an arena
+EVMU_RESULT EvmuMemory__shareRom_(GBL_SELF, EvmuMemory_* pSource)       GBL_NOEXCEPT;
+
+// Default handlers for addresses without side-effects, accessed straight through pIntMap
+EvmuWord    EvmuMemory__readDirect_ (EvmuMemory* pMemory, EvmuAddress address, void* pClosure)                 GBL_NOEXCEPT;
+EVMU_RESULT EvmuMemory__writeDirect_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) GBL_NOEXCEPT;
+
+/* Internal fast-path accessors used by the CPU core. Unlike the public API, they
+   neither open a call record nor look up the device, and trust the address to be
+   on the internal bus, so callers are responsible for any validation. */
+EVMU_INLINE GblBool EvmuMemory__isDirect_(GBL_CSELF, EvmuAddress address) GBL_NOEXCEPT {
+    return pSelf->handlers[address].pFnRead  == EvmuMemory__readDirect_ &&
+           pSelf->handlers[address].pFnWrite == EvmuMemory__writeDirect_;
+}
+
+EVMU_INLINE EvmuWord EvmuMemory__readData_(GBL_CSELF, EvmuAddress address) GBL_NOEXCEPT {
+    const EvmuMemoryHandler* pHandler = &pSelf->handlers[address];
+
+    if(pHandler->pFnRead != EvmuMemory__readDirect_)
+        return pHandler->pFnRead(EVMU_MEMORY_PUBLIC_(pSelf), address, pHandler->pClosure);
+
+    return pSelf->pIntMap[address / EVMU_MEMORY__INT_SEGMENT_SIZE_]
+                         [address % EVMU_MEMORY__INT_SEGMENT_SIZE_];
+}
+
+EVMU_INLINE EvmuWord EvmuMemory__readDataLatch_(GBL_CSELF, EvmuAddress address) GBL_NOEXCEPT {
+    switch(address) {
+    case EVMU_ADDRESS_SFR_T1L:
+    case EVMU_ADDRESS_SFR_T1H:
+    case EVMU_ADDRESS_SFR_P1:
+    case EVMU_ADDRESS_SFR_P3:
+    case EVMU_ADDRESS_SFR_P7:
+        return pSelf->sfr[EVMU_SFR_OFFSET(address)];
+    default:
+        return EvmuMemory__readData_(pSelf, address);
+    }
+}
+
+EVMU_INLINE EVMU_RESULT EvmuMemory__writeData_(GBL_SELF, EvmuAddress address, EvmuWord value) GBL_NOEXCEPT {
+    const EvmuMemoryHandler* pHandler = &pSelf->handlers[address];
+
+    if(pHandler->pFnWrite != EvmuMemory__writeDirect_)
+        return pHandler->pFnWrite(EVMU_MEMORY_PUBLIC_(pSelf), address, value, pHandler->pClosure);
+
+    pSelf->pIntMap[address / EVMU_MEMORY__INT_SEGMENT_SIZE_]
+                  [address % EVMU_MEMORY__INT_SEGMENT_SIZE_] = value;
+
+    return GBL_RESULT_SUCCESS;
+}
+
+// Records an ALU op's operands in place of computing its CY, AC, and OV flags
+EVMU_INLINE void EvmuMemory__deferFlags_(GBL_SELF,
+                                         EVMU_MEMORY__ALU_OP_ op,
+                                         EvmuWord a, EvmuWord b, EvmuWord c) GBL_NOEXCEPT {
+    pSelf->flags.op = op;
+    pSelf->flags.a  = a;
+    pSelf->flags.b  = b;
+    pSelf->flags.c  = c;
+}
+
+// Current PSW.CY, without materializing the rest of the pending flags
+EVMU_INLINE EvmuWord EvmuMemory__carry_(GBL_CSELF) GBL_NOEXCEPT {
+    const int a = pSelf->flags.a, b = pSelf->flags.b, c = pSelf->flags.c;
+
+    switch(pSelf->flags.op) {
+    case EVMU_MEMORY__ALU_OP_ADD_: return a+b+c>255;
+    case EVMU_MEMORY__ALU_OP_SUB_: return a-b-c<0;
+    default:
+        return (pSelf->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)] & EVMU_SFR_PSW_CY_MASK)
+                >> EVMU_SFR_PSW_CY_POS;
+    }
+}
+
+// Folds any pending flags into the PSW SFR, which must happen before it is observed
+EVMU_INLINE void EvmuMemory__syncPsw_(GBL_SELF) GBL_NOEXCEPT {
+    EvmuWord* pPsw = &pSelf->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)];
+
+    if(pSelf->flags.op != EVMU_MEMORY__ALU_OP_NONE_) {
+        const int a = pSelf->flags.a, b = pSelf->flags.b, c = pSelf->flags.c;
+        GblBool   cy, ac, ov;
+
+        if(pSelf->flags.op == EVMU_MEMORY__ALU_OP_ADD_) {
+            cy = a+b+c>255;
+            ac = (a&15)+((b+c)&15)>15;
+            ov = (0x80&(~a^(b+c))&((b+c)^(a+(b+c)))) != 0;
+        } else {
+            cy = a-b-c<0;
+            ac = (a&15)-(b&15)-c<0;
+            ov = (int8_t)(a^(b+c)) < 0 && (int8_t)((b+c)^(a-(b+c))) >= 0;
+        }
+
+        *pPsw = (*pPsw & ~(EVMU_SFR_PSW_CY_MASK|EVMU_SFR_PSW_AC_MASK|EVMU_SFR_PSW_OV_MASK)) |
+                (cy? EVMU_SFR_PSW_CY_MASK : 0) |
+                (ac? EVMU_SFR_PSW_AC_MASK : 0) |
+                (ov? EVMU_SFR_PSW_OV_MASK : 0);
+
+        pSelf->flags.op = EVMU_MEMORY__ALU_OP_NONE_;
+    }
+
+    if(pSelf->flags.parity) {
+        *pPsw = (*pPsw & ~EVMU_SFR_PSW_P_MASK) |
+                gblParity(pSelf->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_ACC)]);
+
+        pSelf->flags.parity = GBL_FALSE;
+    }
+}
+
+EVMU_INLINE EvmuAddress EvmuMemory__indirectAddress_(GBL_CSELF, uint8_t mode) GBL_NOEXCEPT {
+    return EvmuMemory__readData_(pSelf,
+                                 mode |
+                                 ((pSelf->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PSW)] &
+                                   (EVMU_SFR_PSW_IRBK0_MASK|EVMU_SFR_PSW_IRBK1_MASK)) >> 0x1u)) //Bits 2-3 come from PSW
+           | (mode&0x2)<<0x7u; //MSB of pointer is bit 1 from instruction
+}
+
+EVMU_INLINE void EvmuMemory__pushStack_(GBL_SELF, EvmuWord value) GBL_NOEXCEPT {
+    pSelf->ram[0][++pSelf->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_SP)]] = value;
+}
+
+EVMU_INLINE EvmuWord EvmuMemory__popStack_(GBL_SELF) GBL_NOEXCEPT {
+    return pSelf->ram[0][pSelf->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_SP)]--];
+}
+
 GBL_DECLS_END
 
 #undef GBL_SELF_TYPE
@@ -5,6 +5,7 @@
 #include "evmu_memory_.h"
 #include "evmu_device_.h"
 #include "../types/evmu_peripheral_.h"
+#include "../types/evmu_type_.h"
 
 const static EvmuAddress isrAddrLut_[EVMU_IRQ_COUNT] = {
     EVMU_ISR_ADDR_RESET,
@@ -117,7 +118,7 @@ GblBool EvmuPic__retiInstruction(EvmuPic_* pSelf_) {
 
     EvmuAddress r = EvmuMemory_popStack(pMemory) << 8u;
     r |= EvmuMemory_popStack(pMemory);
-    EvmuCpu_setPc(pDevice->pCpu, r);
+    EvmuCpu__advancePc_(EVMU_CPU_(pDevice->pCpu), r);
     pSelf_->processThisInstr = 0;
     for(int p = EVMU_IRQ_PRIORITY_HIGHEST; p >= EVMU_IRQ_PRIORITY_LOW; --p) {
         if(pSelf_->intStack[p]) {
@@ -149,7 +150,9 @@ static int EvmuPic__checkInterrupt_(EvmuPic_* pSelf_, EVMU_IRQ_PRIORITY p) {
                                 EVMU_ADDRESS_SFR_PCON,
                                 EvmuMemory_readData(pMemory,
                                                    EVMU_ADDRESS_SFR_PCON) & ~EVMU_SFR_PCON_HALT_MASK);
-            EvmuCpu_setPc(pDevice->pCpu, EvmuPic_isrAddress((EVMU_IRQ)i));   //jump to ISR address
+            EvmuCpu__advancePc_(EVMU_CPU_(pDevice->pCpu), EvmuPic_isrAddress((EVMU_IRQ)i));   //jump to ISR address
+            if(EVMU_CPU_(pDevice->pCpu)->pProfiler)
+                EvmuCpu__profileIrq_(EVMU_CPU_(pDevice->pCpu), (EVMU_IRQ)i);
             return 1;
         }
 
@@ -242,7 +245,7 @@ static GBL_RESULT EvmuPicClass_init_(GblClass* pClass, const void* pUd, GblConte
 }
 
 EVMU_EXPORT GblType EvmuPic_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuPicClass),
@@ -251,15 +254,12 @@ EVMU_EXPORT GblType EvmuPic_type(void) {
         .instancePrivateSize    = sizeof(EvmuPic_)
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuPic"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
@@ -2,6 +2,8 @@
 #include "evmu_memory_.h"
 #include "evmu_device_.h"
 #include "../fs/evmu_fat_.h"
+#include "../types/evmu_type_.h"
+#include "../types/evmu_journal_.h"
 #include <gimbal/utils/gimbal_date_time.h>
 
 EVMU_EXPORT GblBool EvmuRom_biosActive(const EvmuRom* pSelf) {
@@ -23,16 +25,10 @@ EVMU_EXPORT EVMU_BIOS_MODE EvmuRom_biosMode(const EvmuRom* pSelf) {
 
 }
 
-EVMU_EXPORT EVMU_RESULT EvmuRom_setDateTime(EvmuRom* pSelf, const GblDateTime* pDateTime) {
-    GBL_CTX_BEGIN(NULL);
-
-    EvmuRom_* pSelf_ = EVMU_ROM_(pSelf);
+// Firmware's own clock ticks, which replay reproduces by itself rather than from the journal
+static void EvmuRom_writeDateTime_(EvmuRom_* pSelf_, const GblDateTime* pDateTime) {
     EvmuMemory_* pMemory = pSelf_->pMemory;
 
-    GBL_CTX_VERIFY_ARG(pDateTime);
-    GBL_CTX_VERIFY(GblDateTime_isValid(pDateTime),
-                   GBL_RESULT_ERROR_INVALID_DATE_TIME);
-
     pMemory->ram[0][EVMU_ADDRESS_SYSTEM_YEAR_MSB_BCD]  = GBL_BCD_BYTE_PACK(pDateTime->date.year / 100);
     pMemory->ram[0][EVMU_ADDRESS_SYSTEM_YEAR_LSB_BCD]  = GBL_BCD_BYTE_PACK(pDateTime->date.year % 100);
     pMemory->ram[0][EVMU_ADDRESS_SYSTEM_MONTH_BCD]     = GBL_BCD_BYTE_PACK(pDateTime->date.month + 1);
@@ -50,6 +46,24 @@ EVMU_EXPORT EVMU_RESULT EvmuRom_setDateTime(EvmuRom* pSelf, const GblDateTime* p
     pMemory->ram[0][EVMU_ADDRESS_SYSTEM_HALF_SEC]      = 0;
     pMemory->ram[0][EVMU_ADDRESS_SYSTEM_LEAP_YEAR]     = GblDate_isLeapYear(pDateTime->date.year);
     pMemory->ram[0][EVMU_ADDRESS_SYSTEM_DATE_SET]      = 0xff;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuRom_setDateTime(EvmuRom* pSelf, const GblDateTime* pDateTime) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_ARG(pDateTime);
+
+    EvmuDevice* pDevice  = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+    GblDateTime dateTime = *pDateTime;
+
+    // Comes from the host, so it's journaled, or replaced with what was journaled
+    if(pDevice && EVMU_DEVICE_(pDevice)->pJournal)
+        EvmuJournal__dateTime_(EVMU_DEVICE_(pDevice)->pJournal, &dateTime);
+
+    GBL_CTX_VERIFY(GblDateTime_isValid(&dateTime),
+                   GBL_RESULT_ERROR_INVALID_DATE_TIME);
+
+    EvmuRom_writeDateTime_(EVMU_ROM_(pSelf), &dateTime);
 
     GBL_CTX_END();
 }
@@ -115,6 +129,7 @@ EVMU_EXPORT EVMU_RESULT EvmuRom_unloadBios(EvmuRom* pSelf) {
 
     EvmuRom_* pSelf_ = EVMU_ROM_(pSelf);
     memset(pSelf_->pMemory->rom, 0, sizeof(EvmuWord) * EVMU_ROM_SIZE);
+    EvmuCpu__flushCache_(pSelf_->pMemory->pCpu);
     pSelf_->eBiosType = EVMU_BIOS_TYPE_EMULATED;
 
     EVMU_LOG_POP(1);
@@ -147,6 +162,8 @@ static void biosWriteFlashRom_(EvmuRom_* pSelf_) {
             const uint16_t flashAddr = (a&~0xff)|((a+i)&0xff);
             pDevice_->pFlash->pStorage->pData[flashAddr] = pDevice_->pMemory->ram[1][i+0x80];
         }
+        EvmuFlash__markDirty_(pDevice_->pFlash, a & ~0xff, 0x100);
+        EvmuCpu__invalidateCache_(pDevice_->pCpu, EVMU_CPU__ICACHE_BANK_FLASH_, (uint16_t)(a & ~0xff), 0x100);
     }
 }
 
@@ -164,20 +181,29 @@ EVMU_EXPORT EVMU_RESULT EvmuRom_loadBios_(EvmuRom* pSelf, const char* path) {
         return 0;
     }
 
+    if(!GBL_RESULT_SUCCESS(EvmuMemory__ownRom_(pSelf_->pMemory))) {
+        EVMU_LOG_ERROR("Could not allocate BIOS image!");
+        EVMU_LOG_POP(1);
+        fclose(file);
+        return GBL_RESULT_ERROR_MEM_ALLOC;
+    }
+
     //Clear ROM
-    memset(pSelf_->pMemory->rom, 0, sizeof(pSelf_->pMemory->rom));
+    memset(pSelf_->pMemory->rom, 0, EVMU_ROM_SIZE);
 
     size_t bytesRead   = 0;
     size_t bytesTotal  = 0;
 
-    while(bytesTotal < sizeof(pSelf_->pMemory->rom)) {
-        if((bytesRead = fread(pSelf_->pMemory->rom+bytesTotal, 1, sizeof(pSelf_->pMemory->rom)-bytesTotal, file))) {
+    while(bytesTotal < EVMU_ROM_SIZE) {
+        if((bytesRead = fread(pSelf_->pMemory->rom+bytesTotal, 1, EVMU_ROM_SIZE-bytesTotal, file))) {
             bytesTotal += bytesRead;
         } else break;
     }
 
     fclose(file);
 
+    EvmuCpu__flushCache_(pSelf_->pMemory->pCpu);
+
     EVMU_LOG_VERBOSE("Read %d bytes.", bytesTotal);
 
     GBL_ASSERT(bytesTotal >= 0);
@@ -242,7 +268,7 @@ static EVMU_RESULT EvmuRom_callBios_(EvmuRom* pSelf, EvmuAddress pc, EvmuAddress
     case EVMU_BIOS_SUBROUTINE_TIMER_EX: //timer_ex fm_prd_ex(ORG 0130H)
         if(!((pDevice_->pMemory->ram[0][EVMU_ADDRESS_SYSTEM_HALF_SEC]^=1)&1)) {
             GblDateTime curTime;
-            EvmuRom_setDateTime(pSelf, GblDateTime_addSeconds(EvmuRom_dateTime(pSelf, &curTime), 1));
+            EvmuRom_writeDateTime_(pSelf_, GblDateTime_addSeconds(EvmuRom_dateTime(pSelf, &curTime), 1));
         }
         *pRetPc = 0x139;
         break;
@@ -332,7 +358,7 @@ static GBL_RESULT EvmuRomClass_init_(GblClass* pClass, const void* pUd, GblConte
 }
 
 EVMU_EXPORT GblType EvmuRom_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuRomClass),
@@ -341,15 +367,12 @@ EVMU_EXPORT GblType EvmuRom_type(void) {
         .instancePrivateSize    = sizeof(EvmuRom_)
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuRom"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
@@ -4,130 +4,134 @@
 #include "evmu_device_.h"
 #include "evmu_buzzer_.h"
 #include <gyro_vmu_device.h>
+#include "../types/evmu_type_.h"
 
-static void EvmuTimers_updateBaseTimer_(EvmuTimers* pSelf) {
-    EvmuTimers_* pSelf_  = EVMU_TIMERS_(pSelf);
+void EvmuTimers__baseTimerTick_(EvmuTimers_* pSelf_) {
     EvmuMemory_* pMemory = pSelf_->pMemory;
-    EvmuDevice*  pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
-
-    EvmuWord btcr = EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_BTCR);
+    EvmuDevice*  pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(EVMU_TIMERS_PUBLIC_(pSelf_)));
 
     if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] & EVMU_SFR_BTCR_OP_CTRL_MASK) {
-#if 1
         //hard-coded to generate interrupt every 0.5s by VMU
-        const double tCyc = EvmuCpu_secsPerInstruction(pDevice->pCpu);
-
-        pSelf_->baseTimer.tBaseDeltaTime += tCyc;
-        pSelf_->baseTimer.tBase1DeltaTime += tCyc;
-        if(pSelf_->baseTimer.tBase1DeltaTime >= 0.1f) { //call this many cycles 0.1s...
-            pSelf_->baseTimer.tBase1DeltaTime -= 0.1f;
-            pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] |= EVMU_SFR_BTCR_INT1_SRC_MASK;
-            if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] & EVMU_SFR_BTCR_INT1_REQ_EN_MASK)
-                EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_EXT_INT3_TBASE);
-        }
+        pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] |= EVMU_SFR_BTCR_INT1_SRC_MASK;
+        if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] & EVMU_SFR_BTCR_INT1_REQ_EN_MASK)
+            EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_EXT_INT3_TBASE);
 
-        if(pSelf_->baseTimer.tBaseDeltaTime >= 0.5f) { //call this many cycles 0.5s...
-            pSelf_->baseTimer.tBaseDeltaTime -= 0.5f;
+        if(++pSelf_->baseTimer.ticks >= EVMU_TIMERS__BASE_TIMER_INT0_TICKS_) {
+            pSelf_->baseTimer.ticks = 0;
             pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] |= EVMU_SFR_BTCR_INT0_SRC_MASK;
             if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_BTCR)] & EVMU_SFR_BTCR_INT0_REQ_EN_MASK)
                 EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_EXT_INT3_TBASE);
         }
-#else
-     const EvmuCycles cycles =  EvmuCpu_cyclesPerInstruction(pDevice->pCpu);
+    }
+}
+
+/* Advances an 8-bit counter, reloading it on every overflow. Returns how many
+   times it overflowed, which is more than once when skipping ahead in HALT. */
+static unsigned EvmuTimers_count8_(int* pCounter, EvmuWord reload, unsigned counts) {
+    const unsigned period    = 256 - reload;
+    unsigned       value     = (unsigned)*pCounter + counts;
+    unsigned       overflows = 0;
+
+    if(value >= 256) {
+        const unsigned excess = value - 256;
 
-     if(btcr & EVMU_SFR_BTCR_INT0_CYCLE_CTRL_MASK)
-         pSelf_->baseTimer.th += cycles;
-     else if(pSelf_->baseTimer.tl & 0x100)
-         pSelf_->baseTimer.th += cycles;
+        overflows = 1 + excess / period;
+        value     = reload + excess % period;
+    }
 
+    *pCounter = (int)value;
+    return overflows;
+}
 
-#endif
+// EvmuTimers_count8_() for a high and low byte chained together into a 16-bit counter
+static unsigned EvmuTimers_count16_(int*     pHigh,
+                                    int*     pLow,
+                                    EvmuWord reloadHigh,
+                                    EvmuWord reloadLow,
+                                    unsigned counts)
+{
+    const unsigned reload    = (unsigned)reloadHigh << 8 | reloadLow;
+    const unsigned period    = 0x10000 - reload;
+    unsigned       value     = ((unsigned)*pHigh << 8 | (unsigned)*pLow) + counts;
+    unsigned       overflows = 0;
+
+    if(value >= 0x10000) {
+        const unsigned excess = value - 0x10000;
+
+        overflows = 1 + excess / period;
+        value     = reload + excess % period;
     }
+
+    *pHigh = (int)(value >> 8);
+    *pLow  = (int)(value & 0xff);
+    return overflows;
 }
 
-static void EvmuTimers_updateTimer0_(EvmuTimers* pSelf) {
+static void EvmuTimers_updateTimer0_(EvmuTimers* pSelf, int cy) {
     EvmuTimers_* pSelf_  = EVMU_TIMERS_(pSelf);
     EvmuMemory_* pMemory = pSelf_->pMemory;
     EvmuDevice*  pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
 
-    int cy = EvmuCpu_cyclesPerInstruction(pDevice->pCpu);
-
     /* Timer 0 */
     //T0H overflow or interrupts enabled
-       // if(sfr[0x10] & 0xc0) {
     if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&(EVMU_SFR_T0CNT_P0HRUN_MASK|EVMU_SFR_T0CNT_P0LRUN_MASK)) {
-        int c0=0;
-
         //find out how many times greater t0base is than t0scale
-        if((pSelf_->timer0.tbase += cy) >= pSelf_->timer0.tscale)
-            do c0++;
-            while((pSelf_->timer0.tbase -= pSelf_->timer0.tscale) >= pSelf_->timer0.tscale);
+        pSelf_->timer0.tbase += cy;
+
+        const unsigned c0 = (unsigned)(pSelf_->timer0.tbase / pSelf_->timer0.tscale);
+        pSelf_->timer0.tbase %= pSelf_->timer0.tscale;
 
-    //c0*= 4;
-            //only update if t0base > t0scale
+        //only update if t0base > t0scale
         if(c0)  {
             //16-bit counter and both T0L and T0H are in run state
             if((pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&(EVMU_SFR_T0CNT_P0LONG_MASK|EVMU_SFR_T0CNT_P0LRUN_MASK|EVMU_SFR_T0CNT_P0HRUN_MASK))
                     == (EVMU_SFR_T0CNT_P0LONG_MASK|EVMU_SFR_T0CNT_P0LRUN_MASK|EVMU_SFR_T0CNT_P0HRUN_MASK))
             {
-                pSelf_->timer0.base.tl += c0;
-                if(pSelf_->timer0.base.tl >= 256) {
-                    pSelf_->timer0.base.tl -= 256;
-                    if(++pSelf_->timer0.base.th >= 256) {
-                        pSelf_->timer0.base.th -= 256;
-                        if((pSelf_->timer0.base.tl += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)] )>= 256) {
-                            pSelf_->timer0.base.tl -= 256;
-                            if((pSelf_->timer0.base.th += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)]) >= 256) {
-                                pSelf_->timer0.base.tl = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)];
-                                pSelf_->timer0.base.th = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)];
-                            }
-                        }
-                        //set overflow flags for both T0L and T0H
-                        pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] |= EVMU_SFR_T0CNT_P0HOVF_MASK|EVMU_SFR_T0CNT_T0LOVF_MASK;
-                        //if T0H interrupts are enabled
-                        if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_T0HIE_MASK)
-                            EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T0H);
-                    }
+                if(EvmuTimers_count16_(&pSelf_->timer0.base.th,
+                                       &pSelf_->timer0.base.tl,
+                                       pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)],
+                                       pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)],
+                                       c0))
+                {
+                    //set overflow flags for both T0L and T0H
+                    pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] |= EVMU_SFR_T0CNT_P0HOVF_MASK|EVMU_SFR_T0CNT_T0LOVF_MASK;
+                    //if T0H interrupts are enabled
+                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_T0HIE_MASK)
+                        EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T0H);
                 }
 
             } else {
                 //Update T0L as 8-bit
-                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] & EVMU_SFR_T0CNT_P0LRUN_MASK) {
-                    pSelf_->timer0.base.tl += c0;
-                    if(pSelf_->timer0.base.tl >= 256) {
-                        pSelf_->timer0.base.tl -= 256;
-                        if((pSelf_->timer0.base.tl += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)]) >= 256)
-                            pSelf_->timer0.base.tl = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)];
-                        pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] |= EVMU_SFR_T0CNT_T0LOVF_MASK;
-                        if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_T0LIE_MASK)
-                            EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_EXT_INT2_T0L);
-                    }
+                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] & EVMU_SFR_T0CNT_P0LRUN_MASK &&
+                   EvmuTimers_count8_(&pSelf_->timer0.base.tl,
+                                      pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)],
+                                      c0))
+                {
+                    pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] |= EVMU_SFR_T0CNT_T0LOVF_MASK;
+                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_T0LIE_MASK)
+                        EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_EXT_INT2_T0L);
                 }
 
                 //Update T0H as 8-bit
-                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] & EVMU_SFR_T0CNT_P0HRUN_MASK) {
-                    pSelf_->timer0.base.th += c0;
-                    if(pSelf_->timer0.base.th >= 256) {
-                        pSelf_->timer0.base.th -= 256;
-                        if((pSelf_->timer0.base.th += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)]) >= 256)
-                            pSelf_->timer0.base.th = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)];
-                        pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] |= EVMU_SFR_T0CNT_P0HOVF_MASK;
-                        if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_T0HIE_MASK)
-                            EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T0H);
-                    }
+                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] & EVMU_SFR_T0CNT_P0HRUN_MASK &&
+                   EvmuTimers_count8_(&pSelf_->timer0.base.th,
+                                      pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)],
+                                      c0))
+                {
+                    pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)] |= EVMU_SFR_T0CNT_P0HOVF_MASK;
+                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_T0HIE_MASK)
+                        EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T0H);
                 }
             }
         }
     }
 }
 
-static void EvmuTimers_updateTimer1_(EvmuTimers* pSelf) {
+static void EvmuTimers_updateTimer1_(EvmuTimers* pSelf, int cy) {
     EvmuTimers_* pSelf_ = EVMU_TIMERS_(pSelf);
     EvmuMemory_* pMemory = pSelf_->pMemory;
     EvmuDevice*  pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
 
-    const int cy = EvmuCpu_cyclesPerInstruction(pDevice->pCpu);
-
     //Interrupts enabled for T1H or overflow on T1H
     if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & (EVMU_SFR_T1CNT_T1HRUN_MASK|EVMU_SFR_T1CNT_T1LRUN_MASK)) {
 
@@ -135,61 +139,92 @@ static void EvmuTimers_updateTimer1_(EvmuTimers* pSelf) {
         if((pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & (EVMU_SFR_T1CNT_T1LONG_MASK|EVMU_SFR_T1CNT_T1HRUN_MASK|EVMU_SFR_T1CNT_T1LRUN_MASK)) ==
                 (EVMU_SFR_T1CNT_T1LONG_MASK|EVMU_SFR_T1CNT_T1HRUN_MASK|EVMU_SFR_T1CNT_T1LRUN_MASK))
         {
-            pSelf_->timer1.base.tl += cy;
-            if(pSelf_->timer1.base.tl >= 256) {
-                pSelf_->timer1.base.tl -= 256;
-                if(++pSelf_->timer1.base.th >= 256) {
-                    pSelf_->timer1.base.th -= 256;
-                    if((pSelf_->timer1.base.tl += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)]) >= 256) {
-                        pSelf_->timer1.base.tl -= 256;
-                        if((pSelf_->timer1.base.th += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)]) >= 256) {
-                            pSelf_->timer1.base.tl = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)];
-                            pSelf_->timer1.base.th = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)];
-                        }
-                    }
-                    pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] |= (EVMU_SFR_T1CNT_T1HOVF_MASK|EVMU_SFR_T1CNT_T1LONG_MASK);
-                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1HIE_MASK)
-                        EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T1);
-                }
+            if(EvmuTimers_count16_(&pSelf_->timer1.base.th,
+                                   &pSelf_->timer1.base.tl,
+                                   pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)],
+                                   pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)],
+                                   (unsigned)cy))
+            {
+                pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] |= (EVMU_SFR_T1CNT_T1HOVF_MASK|EVMU_SFR_T1CNT_T1LONG_MASK);
+                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1HIE_MASK)
+                    EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T1);
             }
         } else {
             //If T1L is running as 8-bit timer
-            if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1LRUN_MASK) {
-                pSelf_->timer1.base.tl += cy;
-                if(pSelf_->timer1.base.tl >= 256) {
-                    pSelf_->timer1.base.tl -= 256;
-                    if((pSelf_->timer1.base.tl += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)]) >= 256)
-                        pSelf_->timer1.base.tl = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)];
-
-                    pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] |= EVMU_SFR_T1CNT_T1LOVF_MASK;
+            if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1LRUN_MASK &&
+               EvmuTimers_count8_(&pSelf_->timer1.base.tl,
+                                  pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)],
+                                  (unsigned)cy))
+            {
+                pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] |= EVMU_SFR_T1CNT_T1LOVF_MASK;
 
-                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1LONG_MASK)
-                        EvmuBuzzer__timer1Mode1Reload_(pSelf_->pBuzzer);
+                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1LONG_MASK)
+                    EvmuBuzzer__timer1Mode1Reload_(pSelf_->pBuzzer);
 
-                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1LIE_MASK)
-                        EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T1);
-                }
+                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1LIE_MASK)
+                    EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T1);
             }
             //If T1H is running as 8-bit timer
-            if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1HRUN_MASK) {
-                pSelf_->timer1.base.th += cy;
-                if(pSelf_->timer1.base.th >= 256) {
-                    pSelf_->timer1.base.th -= 256;
-                    if((pSelf_->timer1.base.th += pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)]) >= 256)
-                        pSelf_->timer1.base.th = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)];
-                    pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] |= EVMU_SFR_T1CNT_T1HOVF_MASK;
-                    if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1HIE_MASK)
-                        EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T1);
-                }
+            if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1HRUN_MASK &&
+               EvmuTimers_count8_(&pSelf_->timer1.base.th,
+                                  pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)],
+                                  (unsigned)cy))
+            {
+                pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] |= EVMU_SFR_T1CNT_T1HOVF_MASK;
+                if(pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)] & EVMU_SFR_T1CNT_T1HIE_MASK)
+                    EvmuPic_raiseIrq(pDevice->pPic, EVMU_IRQ_T1);
             }
         }
     }
 }
 
 EVMU_EXPORT void EvmuTimers_update(EvmuTimers* pSelf) {
-    EvmuTimers_updateBaseTimer_(pSelf);
-    EvmuTimers_updateTimer0_(pSelf);
-    EvmuTimers_updateTimer1_(pSelf);
+    EvmuDevice* pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+
+    EvmuTimers__advance_(EVMU_TIMERS_(pSelf), EvmuCpu_cyclesPerInstruction(pDevice->pCpu));
+}
+
+void EvmuTimers__advance_(EvmuTimers_* pSelf_, EvmuCycles cycles) {
+    EvmuTimers* pSelf = EVMU_TIMERS_PUBLIC_(pSelf_);
+
+    EvmuTimers_updateTimer0_(pSelf, (int)cycles);
+    EvmuTimers_updateTimer1_(pSelf, (int)cycles);
+}
+
+EvmuCycles EvmuTimers__cyclesUntilOverflow_(const EvmuTimers_* pSelf_) {
+    const EvmuMemory_* pMemory = pSelf_->pMemory;
+    const EvmuWord     t0cnt   = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)];
+    const EvmuWord     t1cnt   = pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)];
+    const EvmuWord     t0Long  = EVMU_SFR_T0CNT_P0LONG_MASK|EVMU_SFR_T0CNT_P0LRUN_MASK|EVMU_SFR_T0CNT_P0HRUN_MASK;
+    const EvmuWord     t1Long  = EVMU_SFR_T1CNT_T1LONG_MASK|EVMU_SFR_T1CNT_T1LRUN_MASK|EVMU_SFR_T1CNT_T1HRUN_MASK;
+    EvmuCycles         cycles  = UINT64_MAX;
+
+    /* Mirrors updateTimer0_/updateTimer1_: in 16-bit mode the high byte only moves
+       when the low byte wraps, so the low byte's overflow always comes first. */
+    if(t0cnt & (EVMU_SFR_T0CNT_P0LRUN_MASK|EVMU_SFR_T0CNT_P0HRUN_MASK)) {
+        int counts = 256;
+
+        if(t0cnt & EVMU_SFR_T0CNT_P0LRUN_MASK)
+            counts = 256 - pSelf_->timer0.base.tl;
+        if((t0cnt & t0Long) != t0Long && (t0cnt & EVMU_SFR_T0CNT_P0HRUN_MASK) &&
+           256 - pSelf_->timer0.base.th < counts)
+            counts = 256 - pSelf_->timer0.base.th;
+
+        // Timer 0 counts once every tscale cycles, tbase of which have already elapsed
+        const int64_t until = (int64_t)counts * pSelf_->timer0.tscale - pSelf_->timer0.tbase;
+
+        // Never wrap around to an enormous skip, even if tbase somehow got ahead
+        cycles = until > 0? (EvmuCycles)until : 1;
+    }
+
+    if(t1cnt & EVMU_SFR_T1CNT_T1LRUN_MASK &&
+       (EvmuCycles)(256 - pSelf_->timer1.base.tl) < cycles)
+        cycles = 256 - pSelf_->timer1.base.tl;
+    if((t1cnt & t1Long) != t1Long && (t1cnt & EVMU_SFR_T1CNT_T1HRUN_MASK) &&
+       (EvmuCycles)(256 - pSelf_->timer1.base.th) < cycles)
+        cycles = 256 - pSelf_->timer1.base.th;
+
+    return cycles? cycles : 1;
 }
 
 EVMU_EXPORT EVMU_TIMER1_MODE EvmuTimers_timer1Mode(const EvmuTimers* pSelf) {
@@ -199,12 +234,102 @@ EVMU_EXPORT EVMU_TIMER1_MODE EvmuTimers_timer1Mode(const EvmuTimers* pSelf) {
             &(EVMU_SFR_T1CNT_T1LONG_MASK|EVMU_SFR_T1CNT_ELDT1C_MASK))>>EVMU_SFR_T1CNT_ELDT1C_POS;
 }
 
+static EvmuWord EvmuTimers_readCounter_(EvmuMemory* pMemory, EvmuAddress address, void* pClosure) {
+    GBL_UNUSED(pMemory);
+    EvmuTimers_* pSelf_ = pClosure;
+
+    switch(address) {
+    case EVMU_ADDRESS_SFR_T0L: return pSelf_->timer0.base.tl;
+    case EVMU_ADDRESS_SFR_T0H: return pSelf_->timer0.base.th;
+    case EVMU_ADDRESS_SFR_T1L: return pSelf_->timer1.base.tl;
+    case EVMU_ADDRESS_SFR_T1H: return pSelf_->timer1.base.th;
+    default: GBL_ASSERT(GBL_FALSE); return 0;
+    }
+}
+
+static EVMU_RESULT EvmuTimers_writeControl_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) {
+    EvmuTimers_* pSelf_ = pClosure;
+    EvmuWord*    pSfr   = EVMU_MEMORY_(pMemory)->sfr;
+
+    switch(address) {
+    case EVMU_ADDRESS_SFR_T0PRR:
+        pSelf_->timer0.tscale = 256 - value;
+        pSelf_->timer0.tbase  = 0;
+        break;
+    case EVMU_ADDRESS_SFR_T0CNT:
+        if(!(value&EVMU_SFR_T0CNT_P0LRUN_MASK))
+            pSelf_->timer0.base.tl = pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0LR)];
+        if(!(value&EVMU_SFR_T0CNT_P0HRUN_MASK))
+            pSelf_->timer0.base.th = pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0HR)];
+        break;
+    case EVMU_ADDRESS_SFR_T0LR:
+        if(!(pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_P0LRUN_MASK))
+            pSelf_->timer0.base.tl = value;
+        break;
+    case EVMU_ADDRESS_SFR_T0HR:
+        if(!(pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T0CNT)]&EVMU_SFR_T0CNT_P0HRUN_MASK))
+            pSelf_->timer0.base.th = value;
+        break;
+    case EVMU_ADDRESS_SFR_T1CNT:
+        if(!(value&EVMU_SFR_T1CNT_T1LRUN_MASK))
+            pSelf_->timer1.base.tl = pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1LR)];
+        if(!(value&EVMU_SFR_T1CNT_T1HRUN_MASK))
+            pSelf_->timer1.base.th = pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1HR)];
+        break;
+    case EVMU_ADDRESS_SFR_T1LR:
+        if(!(pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)]&EVMU_SFR_T1CNT_T1LRUN_MASK))
+            pSelf_->timer1.base.tl = value;
+        break;
+    case EVMU_ADDRESS_SFR_T1HR:
+        if(!(pSfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_T1CNT)]&EVMU_SFR_T1CNT_T1HRUN_MASK))
+            pSelf_->timer1.base.th = value;
+        break;
+    default: break;
+    }
+
+    pSfr[EVMU_SFR_OFFSET(address)] = value;
+
+    // Timer 1 doubles as the buzzer's PWM source
+    if(pSelf_->pBuzzer)
+        EvmuBuzzer__memorySink_(pSelf_->pBuzzer, address, value);
+
+    return GBL_RESULT_SUCCESS;
+}
+
 static GBL_RESULT EvmuTimers_GblObject_constructed_(GblObject* pSelf) {
     GBL_CTX_BEGIN(NULL);
 
     GBL_INSTANCE_VCALL_DEFAULT(EvmuPeripheral, base.pFnConstructed, pSelf);
     GblObject_setName(pSelf, EVMU_TIMERS_NAME);
 
+    EvmuTimers_* pSelf_  = EVMU_TIMERS_(pSelf);
+    EvmuDevice*  pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pSelf));
+
+    if(pDevice && pDevice->pMemory) {
+        const EvmuMemoryHandler counter = {
+            EvmuTimers_readCounter_, EvmuMemory__writeDirect_, pSelf_
+        };
+        const EvmuMemoryHandler control = {
+            EvmuMemory__readDirect_, EvmuTimers_writeControl_, pSelf_
+        };
+        const EvmuAddress counters[] = {
+            EVMU_ADDRESS_SFR_T0L, EVMU_ADDRESS_SFR_T0H,
+            EVMU_ADDRESS_SFR_T1L, EVMU_ADDRESS_SFR_T1H
+        };
+        const EvmuAddress controls[] = {
+            EVMU_ADDRESS_SFR_T0PRR, EVMU_ADDRESS_SFR_T0CNT,
+            EVMU_ADDRESS_SFR_T0LR,  EVMU_ADDRESS_SFR_T0HR,
+            EVMU_ADDRESS_SFR_T1CNT, EVMU_ADDRESS_SFR_T1LR,
+            EVMU_ADDRESS_SFR_T1HR
+        };
+
+        for(size_t r = 0; r < GBL_COUNT_OF(counters); ++r)
+            GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, counters[r], &counter, NULL));
+
+        for(size_t r = 0; r < GBL_COUNT_OF(controls); ++r)
+            GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pDevice->pMemory, controls[r], &control, NULL));
+    }
+
     GBL_CTX_END();
 }
 
@@ -249,7 +374,7 @@ static GBL_RESULT EvmuTimersClass_init_(GblClass* pClass, const void* pUd, GblCo
 }
 
 EVMU_EXPORT GblType EvmuTimers_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     const static GblTypeInfo info = {
         .classSize              = sizeof(EvmuTimersClass),
@@ -258,15 +383,12 @@ EVMU_EXPORT GblType EvmuTimers_type(void) {
         .instancePrivateSize    = sizeof(EvmuTimers_)
     };
 
-    if(!GblType_verify(type)) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuTimers"),
                                       EVMU_PERIPHERAL_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
 
     return type;
 }
@@ -26,9 +26,11 @@ GBL_DECLARE_STRUCT(EvmuTimer1) {
     EvmuTimer base;
 };
 
+#define EVMU_TIMERS__BASE_TIMER_TICK_       100000000   // 0.1s base timer period, in nanoseconds
+#define EVMU_TIMERS__BASE_TIMER_INT0_TICKS_ 5           // 0.1s ticks per 0.5s base timer interrupt
+
 GBL_DECLARE_STRUCT(EvmuBaseTimer) {
-    float tBaseDeltaTime;
-    float tBase1DeltaTime;
+    uint8_t ticks;      // 0.1s ticks elapsed towards the next 0.5s interrupt
     uint8_t tl;
     uint8_t th;
 };
@@ -41,6 +43,13 @@ GBL_DECLARE_STRUCT(EvmuTimers_) {
     EvmuBaseTimer baseTimer;
 };
 
+// Steps timers 0 and 1 by an arbitrary number of elapsed cycles at once (ie: a whole basic block)
+void       EvmuTimers__advance_            (EvmuTimers_* pSelf_, EvmuCycles cycles) GBL_NOEXCEPT;
+// Lower bound on cycles until timer 0 or 1 next overflows, which can be skipped with one advance while halted
+EvmuCycles EvmuTimers__cyclesUntilOverflow_(const EvmuTimers_* pSelf_)              GBL_NOEXCEPT;
+// Scheduled every EVMU_TIMERS__BASE_TIMER_TICK_ nanoseconds of master time
+void       EvmuTimers__baseTimerTick_      (EvmuTimers_* pSelf_)                    GBL_NOEXCEPT;
+
 GBL_DECLS_END
 
 #endif // EVMU_TIMERS__H
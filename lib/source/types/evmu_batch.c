@@ -0,0 +1,374 @@
+#include <evmu/types/evmu_batch.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_sfr.h>
+#include "evmu_batch_.h"
+#include "../hw/evmu_device_.h"
+#include "../hw/evmu_cpu_.h"
+#include "../hw/evmu_memory_.h"
+#include "../hw/evmu_clock_.h"
+#include "../hw/evmu_pic_.h"
+#include "../hw/evmu_timers_.h"
+#include "evmu_journal_.h"
+#include "evmu_type_.h"
+#include <stdlib.h>
+#include <string.h>
+
+EVMU_EXPORT EvmuBatch* EvmuBatch_create(void) {
+    return GBL_NEW(EvmuBatch);
+}
+
+EVMU_EXPORT GblRefCount EvmuBatch_unref(EvmuBatch* pSelf) {
+    return GBL_UNREF(pSelf);
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuBatch_addLane(EvmuBatch* pSelf, EvmuDevice* pDevice) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pDevice);
+    GBL_CTX_VERIFY_ARG(!GblObject_parent(GBL_OBJECT(pDevice)));
+
+    GblObject_addChild(GBL_OBJECT(pSelf), GBL_OBJECT(pDevice));
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuBatch_removeLane(EvmuBatch* pSelf, EvmuDevice* pDevice) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pDevice);
+
+    const GblBool removed = GblObject_removeChild(GBL_OBJECT(pSelf), GBL_OBJECT(pDevice));
+
+    GBL_CTX_VERIFY(removed,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuBatch_removeLane(): attempt to remove non-lane device!");
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT size_t EvmuBatch_laneCount(const EvmuBatch* pSelf) {
+    size_t count = 0;
+    for(GblObject* pIter = GblObject_childFirst(GBL_OBJECT(pSelf));
+        pIter;
+        pIter = GblObject_siblingNext(pIter))
+    {
+        if(GBL_INSTANCE_CHECK(pIter, EvmuDevice)) ++count;
+    }
+    return count;
+}
+
+EVMU_EXPORT EvmuDevice* EvmuBatch_lane(const EvmuBatch* pSelf, size_t index) {
+    size_t count = 0;
+    for(GblObject* pIter = GblObject_childFirst(GBL_OBJECT(pSelf));
+        pIter;
+        pIter = GblObject_siblingNext(pIter))
+    {
+        if(GBL_INSTANCE_CHECK(pIter, EvmuDevice) && count++ == index)
+            return EVMU_DEVICE(pIter);
+    }
+    return NULL;
+}
+
+EVMU_EXPORT void EvmuBatch_stats(const EvmuBatch* pSelf, EvmuBatchStats* pStats) {
+    *pStats = EVMU_BATCH_(pSelf)->stats;
+}
+
+EVMU_EXPORT void EvmuBatch_clearStats(EvmuBatch* pSelf) {
+    memset(&EVMU_BATCH_(pSelf)->stats, 0, sizeof(EvmuBatchStats));
+}
+
+// Grows every lane array to hold at least the given number of lanes
+static GblBool EvmuBatch_reserve_(EvmuBatch_* pSelf_, size_t lanes) {
+    if(lanes <= pSelf_->capacity) return GBL_TRUE;
+
+    // Laid out widest first, so every array stays aligned
+    uint8_t* pBlock = malloc(lanes * (sizeof(EvmuDevice_*) +
+                                      sizeof(EvmuTicks)   * 3 +
+                                      sizeof(EVMU_RESULT) +
+                                      sizeof(uint32_t)    * 4 +
+                                      sizeof(uint8_t)));
+    if(!pBlock) return GBL_FALSE;
+
+    free(pSelf_->pBlock);
+
+    pSelf_->pBlock     = pBlock;
+    pSelf_->capacity   = lanes;
+    pSelf_->ppDevices  = (EvmuDevice_**)pBlock; pBlock += lanes * sizeof(EvmuDevice_*);
+    pSelf_->pEnds      = (EvmuTicks*)pBlock;    pBlock += lanes * sizeof(EvmuTicks);
+    pSelf_->pDeadlines = (EvmuTicks*)pBlock;    pBlock += lanes * sizeof(EvmuTicks);
+    pSelf_->pTCycs     = (EvmuTicks*)pBlock;    pBlock += lanes * sizeof(EvmuTicks);
+    pSelf_->pResults   = (EVMU_RESULT*)pBlock;  pBlock += lanes * sizeof(EVMU_RESULT);
+    pSelf_->pTags      = (uint32_t*)pBlock;     pBlock += lanes * sizeof(uint32_t);
+    pSelf_->pGroups    = (uint32_t*)pBlock;     pBlock += lanes * sizeof(uint32_t);
+    pSelf_->pSeen      = (uint32_t*)pBlock;     pBlock += lanes * sizeof(uint32_t);
+    pSelf_->pOrder     = (uint32_t*)pBlock;     pBlock += lanes * sizeof(uint32_t);
+    pSelf_->pStates    = pBlock;
+
+    return GBL_TRUE;
+}
+
+/* Fires a lane's peripheral events until it has an instruction to step before its
+   next deadline, returning GBL_FALSE once it has reached the end of the update. */
+static GblBool EvmuBatch_prepareLane_(EvmuBatch_* pSelf_, size_t lane) {
+    EvmuDevice_* pDevice_ = pSelf_->ppDevices[lane];
+
+    for(;;) {
+        if(pSelf_->pStates[lane] == EVMU_BATCH__LANE_EVENTS_) {
+            if(pDevice_->scheduler.now >= pSelf_->pEnds[lane]) {
+                pSelf_->pStates[lane] = EVMU_BATCH__LANE_DONE_;
+                return GBL_FALSE;
+            }
+
+            pSelf_->pDeadlines[lane] = EvmuDevice__nextDeadline_(pDevice_, pSelf_->pEnds[lane]);
+            pSelf_->pStates[lane]    = EVMU_BATCH__LANE_STEPPING_;
+        }
+
+        if(pDevice_->scheduler.now < pSelf_->pDeadlines[lane])
+            return GBL_TRUE;
+
+        EvmuDevice__runEvents_(pDevice_);
+        pSelf_->pStates[lane] = EVMU_BATCH__LANE_EVENTS_;
+    }
+}
+
+// Steps a lane's cycle-counting timers and master time past whatever it just spent its cycles on
+static void EvmuBatch_advanceLane_(EvmuBatch_* pSelf_, size_t lane, EvmuCycles cycles) {
+    EvmuDevice_* pDevice_ = pSelf_->ppDevices[lane];
+
+    EvmuTimers__advance_(pDevice_->pTimers, cycles);
+    pDevice_->scheduler.now += cycles * pSelf_->pTCycs[lane];
+}
+
+// Sorts the stepping lanes by tag, keeping them in lane order within each tag
+static void EvmuBatch_sortLanes_(EvmuBatch_* pSelf_, size_t count) {
+    uint32_t* pOrder = pSelf_->pOrder;
+
+    for(size_t o = 1; o < count; ++o) {
+        const uint32_t lane = pOrder[o];
+        const uint32_t tag  = pSelf_->pTags[lane];
+        size_t         i    = o;
+
+        for(; i && pSelf_->pTags[pOrder[i - 1]] > tag; --i)
+            pOrder[i] = pOrder[i - 1];
+
+        pOrder[i] = lane;
+    }
+}
+
+// Counts the groups from last step whose lanes are now headed to more than one PC
+static void EvmuBatch_countDivergences_(EvmuBatch_* pSelf_, size_t count) {
+    for(size_t o = 0; o < count; ++o) {
+        const uint32_t group = pSelf_->pGroups[pSelf_->pOrder[o]];
+
+        if(group != EVMU_BATCH__GROUP_NONE_)
+            pSelf_->pSeen[group] = EVMU_CPU__ICACHE_TAG_INVALID_;
+    }
+
+    for(size_t o = 0; o < count; ++o) {
+        const uint32_t lane  = pSelf_->pOrder[o];
+        const uint32_t group = pSelf_->pGroups[lane];
+
+        if(group == EVMU_BATCH__GROUP_NONE_) continue;
+
+        uint32_t* pSeen = &pSelf_->pSeen[group];
+
+        if(*pSeen == EVMU_BATCH__TAG_SPLIT_) continue;
+
+        if(*pSeen == EVMU_CPU__ICACHE_TAG_INVALID_) {
+            *pSeen = pSelf_->pTags[lane];
+        } else if(*pSeen != pSelf_->pTags[lane]) {
+            *pSeen = EVMU_BATCH__TAG_SPLIT_;
+            ++pSelf_->stats.divergences;
+        }
+    }
+}
+
+/* Executes one instruction on every lane in each group of lanes sharing a tag.
+   Each group is fetched and decoded once, then handed to every lane whose
+   program memory holds the same bytes. A lane whose instruction fails keeps
+   its result and is done, returning how many lanes failed. */
+static size_t EvmuBatch_runGroups_(EvmuBatch_* pSelf_, size_t count) {
+    size_t failed = 0;
+
+    for(size_t o = 0; o < count; ) {
+        const uint32_t      leader  = pSelf_->pOrder[o];
+        const uint32_t      tag     = pSelf_->pTags[leader];
+        EvmuCpuICacheEntry_ shared;
+        GblBool             fetched = GBL_FALSE;
+
+        ++pSelf_->stats.groups;
+
+        for(; o < count && pSelf_->pTags[pSelf_->pOrder[o]] == tag; ++o) {
+            const uint32_t lane  = pSelf_->pOrder[o];
+            EvmuCpu_*      pCpu_ = pSelf_->ppDevices[lane]->pCpu;
+            EvmuCycles     cycles;
+            EVMU_RESULT    result;
+
+            if(!EvmuCpu__builtinFetch_(pCpu_)) {
+                EvmuCpu* pCpu = EVMU_CPU_PUBLIC_(pCpu_);
+
+                result = EVMU_CPU_GET_CLASS(pCpu)->pFnRunNext(pCpu);
+                cycles = EvmuCpu_cyclesPerInstruction(pCpu);
+            } else {
+                if(fetched && !memcmp(&pCpu_->pMemory->pExt[pCpu_->pc],
+                                      shared.encoded.bytes,
+                                      shared.pFormat->bytes))
+                {
+                    ++pSelf_->stats.sharedDecodes;
+                } else {
+                    // Copied out, since executing may invalidate the fetching lane's cache line
+                    shared  = *EvmuCpu__fetch_(pCpu_);
+                    fetched = GBL_TRUE;
+                }
+
+                result = EvmuCpu__runDecoded_(pCpu_, &shared);
+                cycles = shared.pFormat->cc;
+            }
+
+            pSelf_->pGroups[lane] = leader;
+            ++pSelf_->stats.instructions;
+
+            // A failed instruction still took its cycles, like it does when updated on its own
+            EvmuBatch_advanceLane_(pSelf_, lane, cycles);
+
+            if(!GBL_RESULT_SUCCESS(result)) {
+                pSelf_->pResults[lane] = result;
+                pSelf_->pStates[lane]  = EVMU_BATCH__LANE_DONE_;
+                ++failed;
+            }
+        }
+    }
+
+    return failed;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuBatch_update(EvmuBatch* pSelf, EvmuTicks ticks) {
+    GBL_CTX_BEGIN(pSelf);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuBatch_*  pSelf_ = EVMU_BATCH_(pSelf);
+    const size_t lanes  = EvmuBatch_laneCount(pSelf);
+    size_t       count  = 0;
+
+    GBL_CTX_VERIFY(EvmuBatch_reserve_(pSelf_, lanes),
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuBatch_update(): failed to allocate %zu lanes!",
+                   lanes);
+
+    // Same setup each lane would get from being updated on its own
+    for(GblObject* pIter = GblObject_childFirst(GBL_OBJECT(pSelf));
+        pIter;
+        pIter = GblObject_siblingNext(pIter))
+    {
+        if(!GBL_INSTANCE_CHECK(pIter, EvmuDevice)) continue;
+
+        EvmuDevice*     pDevice  = EVMU_DEVICE(pIter);
+        EvmuDevice_*    pDevice_ = EVMU_DEVICE_(pDevice);
+        const EvmuTicks scaled   = EvmuDevice__scaleTicks_(pDevice, ticks);
+
+        if(pDevice_->pJournal)
+            EvmuJournal__update_(pDevice_->pJournal, ticks);
+
+        EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice->pGamepad), scaled);
+        EvmuCpu__checkPcSignal_(pDevice_->pCpu);
+
+        pSelf_->ppDevices[count] = pDevice_;
+        pSelf_->pEnds[count]     = pDevice_->scheduler.now + scaled;
+        pSelf_->pResults[count]  = GBL_RESULT_SUCCESS;
+        pSelf_->pGroups[count]   = EVMU_BATCH__GROUP_NONE_;
+        pSelf_->pStates[count]   = EVMU_BATCH__LANE_EVENTS_;
+        ++count;
+    }
+
+    for(size_t active = count; active; ) {
+        size_t stepping = 0;
+
+        for(size_t l = 0; l < count; ++l) {
+            if(pSelf_->pStates[l] == EVMU_BATCH__LANE_DONE_) continue;
+
+            if(!EvmuBatch_prepareLane_(pSelf_, l)) {
+                --active;
+                continue;
+            }
+
+            EvmuDevice_* pDevice_ = pSelf_->ppDevices[l];
+
+            pSelf_->pTCycs[l] = EvmuClock__systemTCyc_(pDevice_->pClock);
+
+            EvmuPic_update(EVMU_PIC_PUBLIC_(pDevice_->pPic));
+
+            // Halted lanes idle on their own, only running lanes are grouped
+            if(pDevice_->pMemory->sfr[EVMU_SFR_OFFSET(EVMU_ADDRESS_SFR_PCON)] & EVMU_SFR_PCON_HALT_MASK) {
+                pSelf_->pGroups[l] = EVMU_BATCH__GROUP_NONE_;
+                EvmuBatch_advanceLane_(pSelf_, l, EvmuCpu__haltCycles_(pDevice_->pCpu,
+                                                                       pSelf_->pDeadlines[l],
+                                                                       UINT64_MAX));
+            } else {
+                pSelf_->pTags[l]           = EVMU_CPU__ICACHE_TAG_(EvmuCpu__cacheBank_(pDevice_->pCpu),
+                                                                   pDevice_->pCpu->pc);
+                pSelf_->pOrder[stepping++] = l;
+            }
+        }
+
+        EvmuBatch_sortLanes_(pSelf_, stepping);
+        EvmuBatch_countDivergences_(pSelf_, stepping);
+        active -= EvmuBatch_runGroups_(pSelf_, stepping);
+    }
+
+    // Reported in lane order, after every other lane has still been stepped to the end
+    for(size_t l = 0; l < count; ++l)
+        GBL_CTX_VERIFY(GBL_RESULT_SUCCESS(pSelf_->pResults[l]),
+                       pSelf_->pResults[l],
+                       "EvmuBatch_update(): lane %zu failed to update!",
+                       l);
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuBatch_IBehavior_update_(EvmuIBehavior* pIBehavior, EvmuTicks ticks) {
+    return EvmuBatch_update(EVMU_BATCH(pIBehavior), ticks);
+}
+
+static GBL_RESULT EvmuBatch_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+    free(EVMU_BATCH_(pBox)->pBlock);
+    GBL_INSTANCE_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuBatchClass_init_(GblClass* pClass, const void* pUd, GblContext* pCtx) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_BOX_CLASS(pClass)       ->pFnDestructor = EvmuBatch_GblBox_destructor_;
+    EVMU_IBEHAVIOR_CLASS(pClass)->pFnUpdate     = EvmuBatch_IBehavior_update_;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT GblType EvmuBatch_type(void) {
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
+
+    static GblTypeInterfaceMapEntry ifaceEntries[] = {
+        {
+            .classOffset   = offsetof(EvmuBatchClass, EvmuIBehaviorImpl)
+        }
+    };
+
+    static const GblTypeInfo info = {
+        .pFnClassInit        = EvmuBatchClass_init_,
+        .classSize           = sizeof(EvmuBatchClass),
+        .instanceSize        = sizeof(EvmuBatch),
+        .instancePrivateSize = sizeof(EvmuBatch_),
+        .interfaceCount      = 1,
+        .pInterfaceMap       = ifaceEntries
+    };
+
+    EVMU_TYPE__REGISTER_(type,
+        ifaceEntries[0].interfaceType = EVMU_IBEHAVIOR_TYPE;
+
+        type = GblType_registerStatic(GblQuark_internStringStatic("EvmuBatch"),
+                                      GBL_OBJECT_TYPE,
+                                      &info,
+                                      GBL_TYPE_FLAG_TYPEINFO_STATIC);
+    );
+    return type;
+}
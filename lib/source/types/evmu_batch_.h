@@ -0,0 +1,49 @@
+#ifndef EVMU_BATCH__H
+#define EVMU_BATCH__H
+
+#include <evmu/types/evmu_batch.h>
+
+#define EVMU_BATCH_(instance)       ((EvmuBatch_*)GBL_INSTANCE_PRIVATE(instance, EVMU_BATCH_TYPE))
+#define EVMU_BATCH_PUBLIC_(priv)    ((EvmuBatch*)GBL_INSTANCE_PUBLIC(priv, EVMU_BATCH_TYPE))
+
+#define EVMU_BATCH__GROUP_NONE_     0xffffffff  //!< Lane wasn't executing an instruction last step
+#define EVMU_BATCH__TAG_SPLIT_      0xfffffffe  //!< Previous group's lanes were already seen at different PCs
+
+#define GBL_SELF_TYPE EvmuBatch_
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(EvmuDevice_);
+
+// Where a lane is within the same loop EvmuCpu runs for a regular update
+typedef enum EVMU_BATCH__LANE_ {
+    EVMU_BATCH__LANE_EVENTS_,       // needs its next event deadline, or is finished if it's at its end
+    EVMU_BATCH__LANE_STEPPING_,     // stepping instructions until its event deadline
+    EVMU_BATCH__LANE_DONE_          // reached the end of the update, or failed before it
+} EVMU_BATCH__LANE_;
+
+/* Per-lane stepping state, kept as parallel arrays carved from one allocation,
+   so each pass over the lanes only touches the field it's interested in. */
+typedef struct EvmuBatch_ {
+    size_t          capacity;       // lanes every array has room for
+    void*           pBlock;         // allocation backing every array
+
+    EvmuDevice_**   ppDevices;
+    EvmuTicks*      pEnds;          // master time each lane is being updated until
+    EvmuTicks*      pDeadlines;     // master time of each lane's next peripheral event
+    EvmuTicks*      pTCycs;         // each lane's cycle time, sampled as it began its step
+    EVMU_RESULT*    pResults;       // how each lane's update went, which stops stepping at its first failure
+    uint32_t*       pTags;          // bank + PC each stepping lane is about to execute
+    uint32_t*       pGroups;        // lane which led each lane's group last step
+    uint32_t*       pSeen;          // tag first seen this step from each previous group
+    uint32_t*       pOrder;         // stepping lanes, sorted by tag
+    uint8_t*        pStates;        // EVMU_BATCH__LANE_
+
+    EvmuBatchStats  stats;
+} EvmuBatch_;
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // EVMU_BATCH__H
@@ -1,6 +1,15 @@
 #include <evmu/types/evmu_emulator.h>
 #include <evmu/hw/evmu_device.h>
 #include <gimbal/utils/gimbal_version.h>
+#include "evmu_emulator_.h"
+#include "evmu_type_.h"
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#   include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#   include <unistd.h>
+#endif
 
 EVMU_EXPORT GblVersion EvmuEmulator_version(void) {
     return GBL_VERSION_MAKE(EVMU_VERSION_MAJOR, EVMU_VERSION_MINOR, EVMU_VERSION_PATCH);
@@ -91,6 +100,260 @@ EVMU_EXPORT GblBool EvmuEmulator_foreachDevice(const EvmuEmulator* pSelf, EvmuEm
 }
 
 
+static size_t EvmuEmulator_coreCount_(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#elif defined(__unix__) || defined(__APPLE__)
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0? (size_t)count : 1;
+#else
+    return 1;
+#endif
+}
+
+#ifdef EVMU_EMULATOR__THREADS_
+// Claims jobs from the worker's own queue first, then steals whatever is left in the others
+static void EvmuEmulator_runJobs_(EvmuEmulatorPool_* pPool, size_t worker) {
+    for(size_t q = 0; q < pPool->workerCount; ++q) {
+        EvmuEmulatorQueue_* pQueue = &pPool->pQueues[(worker + q) % pPool->workerCount];
+        size_t              j;
+
+        while((j = atomic_fetch_add_explicit(&pQueue->next, 1, memory_order_relaxed)) < pQueue->end) {
+            EvmuEmulatorJob_* pJob = &pPool->pJobs[j];
+
+            // Each thread keeps its own libGimbal call record, so only the result is carried back
+            pJob->result = EvmuIBehavior_update(EVMU_IBEHAVIOR(pJob->pDevice), pPool->ticks);
+        }
+    }
+}
+
+typedef struct EvmuEmulatorWorker_ {
+    EvmuEmulatorPool_* pPool;
+    size_t             index;
+} EvmuEmulatorWorker_;
+
+static int EvmuEmulator_worker_(void* pArg) {
+    EvmuEmulatorWorker_ worker = *(EvmuEmulatorWorker_*)pArg;
+    EvmuEmulatorPool_*  pPool  = worker.pPool;
+    uint64_t            seen   = 0;
+
+    free(pArg);
+
+    mtx_lock(&pPool->lock);
+
+    for(;;) {
+        while(!pPool->quit && pPool->generation == seen)
+            cnd_wait(&pPool->start, &pPool->lock);
+
+        if(pPool->quit) break;
+
+        seen = pPool->generation;
+        mtx_unlock(&pPool->lock);
+
+        EvmuEmulator_runJobs_(pPool, worker.index);
+
+        mtx_lock(&pPool->lock);
+        if(!--pPool->busy)
+            cnd_signal(&pPool->done);
+    }
+
+    mtx_unlock(&pPool->lock);
+
+    return 0;
+}
+
+static void EvmuEmulator_stopPool_(EvmuEmulator_* pSelf) {
+    EvmuEmulatorPool_* pPool = pSelf->pPool;
+
+    if(!pPool) return;
+
+    mtx_lock(&pPool->lock);
+    pPool->quit = GBL_TRUE;
+    cnd_broadcast(&pPool->start);
+    mtx_unlock(&pPool->lock);
+
+    for(size_t t = 0; t < pPool->workerCount - 1; ++t)
+        thrd_join(pPool->pThreads[t], NULL);
+
+    cnd_destroy(&pPool->done);
+    cnd_destroy(&pPool->start);
+    mtx_destroy(&pPool->lock);
+    free(pPool->pQueues);
+    free(pPool->pThreads);
+    free(pPool);
+
+    pSelf->pPool = NULL;
+}
+
+// Spawns workerCount - 1 threads, settling for however many could actually be started
+static EvmuEmulatorPool_* EvmuEmulator_startPool_(size_t workerCount) {
+    EvmuEmulatorPool_* pPool = calloc(1, sizeof(EvmuEmulatorPool_));
+
+    if(!pPool) return NULL;
+
+    pPool->pThreads = malloc(sizeof(thrd_t) * (workerCount - 1));
+    pPool->pQueues  = calloc(workerCount, sizeof(EvmuEmulatorQueue_));
+
+    if(!pPool->pThreads || !pPool->pQueues ||
+       mtx_init(&pPool->lock, mtx_plain) != thrd_success)
+    {
+        free(pPool->pQueues);
+        free(pPool->pThreads);
+        free(pPool);
+        return NULL;
+    }
+
+    cnd_init(&pPool->start);
+    cnd_init(&pPool->done);
+
+    pPool->workerCount = 1;
+
+    while(pPool->workerCount < workerCount) {
+        EvmuEmulatorWorker_* pWorker = malloc(sizeof(EvmuEmulatorWorker_));
+
+        if(!pWorker) break;
+
+        pWorker->pPool = pPool;
+        pWorker->index = pPool->workerCount;
+
+        if(thrd_create(&pPool->pThreads[pPool->workerCount - 1],
+                       EvmuEmulator_worker_,
+                       pWorker) != thrd_success)
+        {
+            free(pWorker);
+            break;
+        }
+
+        ++pPool->workerCount;
+    }
+
+    return pPool;
+}
+
+// Splits the jobs evenly between workers, runs them, and waits on every last one
+static void EvmuEmulator_runPool_(EvmuEmulatorPool_* pPool, EvmuEmulatorJob_* pJobs, size_t count, EvmuTicks ticks) {
+    for(size_t w = 0; w < pPool->workerCount; ++w) {
+        atomic_store_explicit(&pPool->pQueues[w].next, count * w / pPool->workerCount, memory_order_relaxed);
+        pPool->pQueues[w].end = count * (w + 1) / pPool->workerCount;
+    }
+
+    mtx_lock(&pPool->lock);
+    pPool->pJobs = pJobs;
+    pPool->ticks = ticks;
+    pPool->busy  = pPool->workerCount - 1;
+    ++pPool->generation;
+    cnd_broadcast(&pPool->start);
+    mtx_unlock(&pPool->lock);
+
+    EvmuEmulator_runJobs_(pPool, 0);
+
+    mtx_lock(&pPool->lock);
+    while(pPool->busy)
+        cnd_wait(&pPool->done, &pPool->lock);
+    mtx_unlock(&pPool->lock);
+}
+#endif
+
+static GblBool EvmuEmulator_collectJob_(const EvmuEmulator* pSelf, EvmuDevice* pDevice, void* pClosure) {
+    EvmuEmulator_* pSelf_ = EVMU_EMULATOR_(pSelf);
+    size_t*        pCount = pClosure;
+
+    pSelf_->pJobs[(*pCount)++] = (EvmuEmulatorJob_) {
+        .pDevice = pDevice,
+        .result  = GBL_RESULT_SUCCESS
+    };
+
+    return GBL_FALSE;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuEmulator_update(EvmuEmulator* pSelf, EvmuTicks ticks) {
+    GBL_CTX_BEGIN(pSelf);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuEmulator_* pSelf_  = EVMU_EMULATOR_(pSelf);
+    const size_t   devices = EvmuEmulator_deviceCount(pSelf);
+    size_t         count   = 0;
+
+    if(devices > pSelf_->jobCapacity) {
+        EvmuEmulatorJob_* pJobs = realloc(pSelf_->pJobs, sizeof(EvmuEmulatorJob_) * devices);
+
+        GBL_CTX_VERIFY(pJobs,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "EvmuEmulator_update(): failed to allocate jobs for %zu devices!",
+                       devices);
+
+        pSelf_->pJobs       = pJobs;
+        pSelf_->jobCapacity = devices;
+    }
+
+    EvmuEmulator_foreachDevice(pSelf, EvmuEmulator_collectJob_, &count);
+
+#ifdef EVMU_EMULATOR__THREADS_
+    const size_t threads = EvmuEmulator_threadCount(pSelf);
+
+    if(count > 1 && threads > 1) {
+        if(!pSelf_->pPool)
+            pSelf_->pPool = EvmuEmulator_startPool_(threads);
+
+        if(pSelf_->pPool)
+            EvmuEmulator_runPool_(pSelf_->pPool, pSelf_->pJobs, count, ticks);
+    }
+
+    if(!pSelf_->pPool || count <= 1 || threads <= 1)
+#endif
+    for(size_t d = 0; d < count; ++d)
+        pSelf_->pJobs[d].result = EvmuIBehavior_update(EVMU_IBEHAVIOR(pSelf_->pJobs[d].pDevice), ticks);
+
+    // Any other behaviors, such as an EvmuBatch of devices, are still updated in order on this thread
+    for(GblObject* pIter = GblObject_childFirst(GBL_OBJECT(pSelf));
+        pIter;
+        pIter = GblObject_siblingNext(pIter))
+    {
+        if(!GBL_INSTANCE_CHECK(pIter, EvmuDevice) && GBL_INSTANCE_CHECK(pIter, EvmuIBehavior))
+            GBL_CTX_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pIter), ticks));
+    }
+
+    // Reported in device order, regardless of which thread finished first
+    for(size_t d = 0; d < count; ++d)
+        GBL_CTX_VERIFY(GBL_RESULT_SUCCESS(pSelf_->pJobs[d].result),
+                       pSelf_->pJobs[d].result,
+                       "EvmuEmulator_update(): device %zu failed to update!",
+                       d);
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT size_t EvmuEmulator_threadCount(const EvmuEmulator* pSelf) {
+    const size_t requested = EVMU_EMULATOR_(pSelf)->threadCount;
+
+    return requested? requested : EvmuEmulator_coreCount_();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuEmulator_setThreadCount(EvmuEmulator* pSelf, size_t count) {
+    GBL_CTX_BEGIN(pSelf);
+
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuEmulator_* pSelf_ = EVMU_EMULATOR_(pSelf);
+
+    if(count != pSelf_->threadCount) {
+#ifdef EVMU_EMULATOR__THREADS_
+        // Restarted with the new size by the next update that needs it
+        EvmuEmulator_stopPool_(pSelf_);
+#endif
+        pSelf_->threadCount = count;
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuEmulator_IBehavior_update_(EvmuIBehavior* pIBehavior, EvmuTicks ticks) {
+    return EvmuEmulator_update(EVMU_EMULATOR(pIBehavior), ticks);
+}
+
 static GBL_RESULT EvmuEmulator_GblModule_unload_(GblModule* pModule) {
     GBL_CTX_BEGIN(NULL);
     GBL_CTX_END();
@@ -103,6 +366,10 @@ static GBL_RESULT EvmuEmulator_GblModule_load_(GblModule* pModule) {
 
 static GBL_RESULT EvmuEmulator_GblBox_destructor_(GblBox* pBox) {
     GBL_CTX_BEGIN(NULL);
+#ifdef EVMU_EMULATOR__THREADS_
+    EvmuEmulator_stopPool_(EVMU_EMULATOR_(pBox));
+#endif
+    free(EVMU_EMULATOR_(pBox)->pJobs);
     GBL_INSTANCE_VCALL_DEFAULT(GblModule, base.base.base.pFnDestructor, pBox);
     GBL_CTX_END();
 }
@@ -123,15 +390,16 @@ static GBL_RESULT EvmuEmulator_init_(GblInstance* pInstance, GblContext* pCtx) {
 static GBL_RESULT EvmuEmulatorClass_init_(GblClass* pClass, const void* pUd, GblContext* pctx) {
     GBL_CTX_BEGIN(NULL);
 
-    GBL_BOX_CLASS(pClass)   ->pFnDestructor = EvmuEmulator_GblBox_destructor_;
-    GBL_MODULE_CLASS(pClass)->pFnLoad       = EvmuEmulator_GblModule_load_;
-    GBL_MODULE_CLASS(pClass)->pFnUnload     = EvmuEmulator_GblModule_unload_;
+    GBL_BOX_CLASS(pClass)       ->pFnDestructor = EvmuEmulator_GblBox_destructor_;
+    GBL_MODULE_CLASS(pClass)    ->pFnLoad       = EvmuEmulator_GblModule_load_;
+    GBL_MODULE_CLASS(pClass)    ->pFnUnload     = EvmuEmulator_GblModule_unload_;
+    EVMU_IBEHAVIOR_CLASS(pClass)->pFnUpdate     = EvmuEmulator_IBehavior_update_;
 
     GBL_CTX_END();
 }
 
 EVMU_EXPORT GblType EvmuEmulator_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     static GblTypeInterfaceMapEntry ifaceEntries[] = {
         {
@@ -140,22 +408,23 @@ EVMU_EXPORT GblType EvmuEmulator_type(void) {
     };
 
     static const GblTypeInfo info = {
-        .pFnClassInit    = EvmuEmulatorClass_init_,
-        .classSize       = sizeof(EvmuEmulatorClass),
-        .pFnInstanceInit = EvmuEmulator_init_,
-        .instanceSize    = sizeof(EvmuEmulator),
-        .interfaceCount  = 1,
-        .pInterfaceMap   = ifaceEntries
+        .pFnClassInit        = EvmuEmulatorClass_init_,
+        .classSize           = sizeof(EvmuEmulatorClass),
+        .pFnInstanceInit     = EvmuEmulator_init_,
+        .instanceSize        = sizeof(EvmuEmulator),
+        .instancePrivateSize = sizeof(EvmuEmulator_),
+        .interfaceCount      = 1,
+        .pInterfaceMap       = ifaceEntries
     };
 
-    if(type == GBL_INVALID_TYPE) {
+    EVMU_TYPE__REGISTER_(type,
         ifaceEntries[0].interfaceType = EVMU_IBEHAVIOR_TYPE;
 
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuEmulator"),
                                       GBL_MODULE_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-    }
+    );
     return type;
 }
 
@@ -1,6 +1,7 @@
 #include <gimbal/meta/instances/gimbal_instance.h>
 #include <evmu/types/evmu_ibehavior.h>
 #include <evmu/types/evmu_emulator.h>
+#include "evmu_type_.h"
 
 static GBL_RESULT EvmuIBehavior_reset_(EvmuIBehavior* pSelf) {
     GBL_CTX_BEGIN(NULL);
@@ -107,12 +108,11 @@ GBL_EXPORT GBL_RESULT EvmuIBehavior_update(EvmuIBehavior* pSelf, EvmuTicks ticks
 }
 
 GBL_EXPORT GblType EvmuIBehavior_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     static GblType dependencies[1];
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         dependencies[0] = GBL_OBJECT_TYPE;
 
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuIBehavior"),
@@ -124,9 +124,6 @@ GBL_EXPORT GblType EvmuIBehavior_type(void) {
                                           .pDependencies    = dependencies
                                      },
                                      GBL_TYPE_FLAGS_NONE);
-        GBL_CTX_VERIFY_LAST_RECORD();
-
-        GBL_CTX_END_BLOCK();
-    }
+    );
     return type;
 }
@@ -0,0 +1,711 @@
+#include <evmu/types/evmu_journal.h>
+#include <evmu/hw/evmu_device.h>
+#include "evmu_journal_.h"
+#include "../hw/evmu_device_.h"
+#include "../hw/evmu_gamepad_.h"
+#include "../hw/evmu_memory_.h"
+#include "../hw/evmu_cpu_.h"
+#include "evmu_type_.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Saved journals are a header, the starting save state, every event at a fixed
+   width, then a CRC of all of that, all little-endian like save states themselves. */
+#define EVMU_JOURNAL__MAGIC_        0x4a4d5645  // "EVMJ"
+#define EVMU_JOURNAL__HEADER_SIZE_  20          // magic, version, state size, event count (64-bit)
+#define EVMU_JOURNAL__EVENT_SIZE_   18          // time, value, type, mask
+#define EVMU_JOURNAL__CRC_SIZE_     4
+
+EVMU_EXPORT EvmuJournal* EvmuJournal_create(EvmuDevice* pDevice) {
+    EvmuJournal* pSelf = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pDevice);
+    GBL_CTX_VERIFY(!EVMU_DEVICE_(pDevice)->pJournal,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_create(): device already has a journal attached!");
+
+    pSelf = GBL_NEW(EvmuJournal);
+
+    EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+    pSelf_->pDevice = GBL_REF(pDevice);
+
+    EVMU_DEVICE_(pDevice)->pJournal = pSelf_;
+
+    GBL_CTX_END_BLOCK();
+    return pSelf;
+}
+
+EVMU_EXPORT GblRefCount EvmuJournal_unref(EvmuJournal* pSelf) {
+    return GBL_UNREF(pSelf);
+}
+
+EVMU_EXPORT EvmuDevice* EvmuJournal_device(const EvmuJournal* pSelf) {
+    return EVMU_JOURNAL_(pSelf)->pDevice;
+}
+
+EVMU_EXPORT EVMU_JOURNAL_MODE EvmuJournal_mode(const EvmuJournal* pSelf) {
+    return EVMU_JOURNAL_(pSelf)->mode;
+}
+
+EVMU_EXPORT size_t EvmuJournal_count(const EvmuJournal* pSelf) {
+    return EVMU_JOURNAL_(pSelf)->count;
+}
+
+EVMU_EXPORT EVMU_JOURNAL_EVENT EvmuJournal_event(const EvmuJournal* pSelf, size_t index) {
+    const EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    return index < pSelf_->count? pSelf_->pEvents[index].type : EVMU_JOURNAL_EVENT_COUNT;
+}
+
+static EvmuTicks EvmuJournal_now_(const EvmuJournal_* pSelf_) {
+    return EVMU_DEVICE_(pSelf_->pDevice)->scheduler.now;
+}
+
+// Running out of memory ends the recording early rather than failing the device mid-update
+static void EvmuJournal_append_(EvmuJournal_* pSelf_, uint8_t type, uint64_t value, uint8_t mask) {
+    if(pSelf_->count == pSelf_->capacity) {
+        const size_t       capacity = pSelf_->capacity? pSelf_->capacity * 2 : 256;
+        EvmuJournalEvent_* pEvents  = realloc(pSelf_->pEvents, sizeof(EvmuJournalEvent_) * capacity);
+
+        if(!pEvents) {
+            pSelf_->mode = EVMU_JOURNAL_MODE_IDLE;
+            return;
+        }
+
+        pSelf_->pEvents  = pEvents;
+        pSelf_->capacity = capacity;
+    }
+
+    pSelf_->pEvents[pSelf_->count++] = (EvmuJournalEvent_) {
+        .time  = EvmuJournal_now_(pSelf_),
+        .value = value,
+        .type  = type,
+        .mask  = mask
+    };
+}
+
+// Returns the next event to play back if it's of the given type, flagging it if it's out of place
+static const EvmuJournalEvent_* EvmuJournal_next_(EvmuJournal_* pSelf_, uint8_t type) {
+    if(pSelf_->cursor >= pSelf_->count || pSelf_->pEvents[pSelf_->cursor].type != type)
+        return NULL;
+
+    const EvmuJournalEvent_* pEvent = &pSelf_->pEvents[pSelf_->cursor++];
+
+    if(pEvent->time != EvmuJournal_now_(pSelf_))
+        pSelf_->diverged = GBL_TRUE;
+
+    return pEvent;
+}
+
+void EvmuJournal__update_(EvmuJournal_* pSelf, EvmuTicks ticks) {
+    if(pSelf->mode == EVMU_JOURNAL_MODE_RECORDING)
+        EvmuJournal_append_(pSelf, EVMU_JOURNAL_EVENT_UPDATE, ticks, 0);
+}
+
+void EvmuJournal__runUntil_(EvmuJournal_* pSelf, EvmuCycles maxCycles, uint8_t stopMask) {
+    if(pSelf->mode == EVMU_JOURNAL_MODE_RECORDING)
+        EvmuJournal_append_(pSelf, EVMU_JOURNAL_EVENT_RUN, maxCycles, stopMask);
+}
+
+void EvmuJournal__reset_(EvmuJournal_* pSelf) {
+    if(pSelf->mode == EVMU_JOURNAL_MODE_RECORDING)
+        EvmuJournal_append_(pSelf, EVMU_JOURNAL_EVENT_RESET, 0, 0);
+}
+
+void EvmuJournal__pollButtons_(EvmuJournal_* pSelf, EvmuGamepad* pGamepad) {
+    if(pSelf->mode == EVMU_JOURNAL_MODE_RECORDING) {
+        const uint16_t buttons = EvmuGamepad__buttons_(pGamepad);
+
+        if(buttons != pSelf->buttons) {
+            EvmuJournal_append_(pSelf, EVMU_JOURNAL_EVENT_BUTTONS, buttons, 0);
+            pSelf->buttons = buttons;
+        }
+
+    } else if(pSelf->mode == EVMU_JOURNAL_MODE_REPLAYING) {
+        const EvmuJournalEvent_* pEvent = EvmuJournal_next_(pSelf, EVMU_JOURNAL_EVENT_BUTTONS);
+
+        if(pEvent)
+            pSelf->buttons = pEvent->value;
+
+        // Whatever input back-ends did this poll is overridden
+        EvmuGamepad__setButtons_(pGamepad, pSelf->buttons);
+    }
+}
+
+void EvmuJournal__dateTime_(EvmuJournal_* pSelf, GblDateTime* pDateTime) {
+    if(pSelf->mode == EVMU_JOURNAL_MODE_RECORDING) {
+        EvmuJournal_append_(pSelf,
+                            EVMU_JOURNAL_EVENT_DATE_TIME,
+                            (uint64_t)(uint16_t)pDateTime->date.year << 40 |
+                            (uint64_t)pDateTime->date.month          << 32 |
+                            (uint64_t)pDateTime->date.day            << 24 |
+                            (uint64_t)pDateTime->time.hours          << 16 |
+                            (uint64_t)pDateTime->time.minutes        << 8  |
+                            (uint64_t)pDateTime->time.seconds,
+                            0);
+
+    } else if(pSelf->mode == EVMU_JOURNAL_MODE_REPLAYING) {
+        const EvmuJournalEvent_* pEvent = EvmuJournal_next_(pSelf, EVMU_JOURNAL_EVENT_DATE_TIME);
+
+        // Set somewhere it wasn't while recording, such as from the host clock upon reset
+        if(!pEvent) {
+            pSelf->diverged = GBL_TRUE;
+            return;
+        }
+
+        pDateTime->date.year    = (int16_t)(pEvent->value >> 40);
+        pDateTime->date.month   = pEvent->value >> 32 & 0xff;
+        pDateTime->date.day     = pEvent->value >> 24 & 0xff;
+        pDateTime->time.hours   = pEvent->value >> 16 & 0xff;
+        pDateTime->time.minutes = pEvent->value >> 8  & 0xff;
+        pDateTime->time.seconds = pEvent->value       & 0xff;
+    }
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_record(EvmuJournal* pSelf) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf_->mode != EVMU_JOURNAL_MODE_REPLAYING,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_record(): cannot record while replaying!");
+
+    const size_t size = EvmuDevice_stateSize(pSelf_->pDevice);
+
+    if(size != pSelf_->startSize) {
+        uint8_t* pStart = realloc(pSelf_->pStart, size);
+
+        GBL_CTX_VERIFY(pStart,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "EvmuJournal_record(): failed to allocate starting state!");
+
+        pSelf_->pStart    = pStart;
+        pSelf_->startSize = size;
+    }
+
+    GBL_CTX_VERIFY_CALL(EvmuDevice_saveState(pSelf_->pDevice, pSelf_->pStart, size));
+
+    pSelf_->count    = 0;
+    pSelf_->cursor   = 0;
+    pSelf_->buttons  = EvmuGamepad__buttons_(pSelf_->pDevice->pGamepad);
+    pSelf_->diverged = GBL_FALSE;
+    pSelf_->mode     = EVMU_JOURNAL_MODE_RECORDING;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_stop(EvmuJournal* pSelf) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EVMU_JOURNAL_(pSelf)->mode = EVMU_JOURNAL_MODE_IDLE;
+
+    GBL_CTX_END();
+}
+
+// Restores the starting snapshot and readies the journal to feed its events back
+static EVMU_RESULT EvmuJournal_begin_(EvmuJournal_* pSelf_) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_CTX_VERIFY_CALL(EvmuDevice_loadState(pSelf_->pDevice, pSelf_->pStart, pSelf_->startSize));
+
+    pSelf_->cursor   = 0;
+    pSelf_->buttons  = EvmuGamepad__buttons_(pSelf_->pDevice->pGamepad);
+    pSelf_->diverged = GBL_FALSE;
+    pSelf_->mode     = EVMU_JOURNAL_MODE_REPLAYING;
+
+    GBL_CTX_END();
+}
+
+// Plays back the event at the cursor, along with any nested events it consumes
+static void EvmuJournal_play_(EvmuJournal_* pSelf_) {
+    const EvmuJournalEvent_* pEvent  = &pSelf_->pEvents[pSelf_->cursor];
+    EvmuDevice*              pDevice = pSelf_->pDevice;
+
+    if(pEvent->time != EvmuJournal_now_(pSelf_)) {
+        pSelf_->diverged = GBL_TRUE;
+        return;
+    }
+
+    switch(pEvent->type) {
+    case EVMU_JOURNAL_EVENT_UPDATE:
+        ++pSelf_->cursor;
+        EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), pEvent->value);
+        break;
+    case EVMU_JOURNAL_EVENT_RUN:
+        ++pSelf_->cursor;
+        EvmuDevice_runUntil(pDevice, pEvent->value, pEvent->mask, NULL);
+        break;
+    case EVMU_JOURNAL_EVENT_RESET:
+        ++pSelf_->cursor;
+        EvmuIBehavior_reset(EVMU_IBEHAVIOR(pDevice));
+        break;
+    case EVMU_JOURNAL_EVENT_DATE_TIME: {
+        // Consumed by the hook within, which substitutes the recorded value
+        GblDateTime dateTime;
+        EvmuRom_setDateTime(pDevice->pRom, EvmuRom_dateTime(pDevice->pRom, &dateTime));
+        break;
+    }
+    default:
+        // Buttons only ever change within a poll, which the event before it should have made
+        pSelf_->diverged = GBL_TRUE;
+        break;
+    }
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_replay(EvmuJournal* pSelf) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf_->mode == EVMU_JOURNAL_MODE_IDLE && pSelf_->pStart,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_replay(): nothing recorded, or still recording!");
+
+    GBL_CTX_VERIFY_CALL(EvmuJournal_begin_(pSelf_));
+
+    while(pSelf_->cursor < pSelf_->count && !pSelf_->diverged)
+        EvmuJournal_play_(pSelf_);
+
+    pSelf_->mode = EVMU_JOURNAL_MODE_IDLE;
+
+    GBL_CTX_VERIFY(!pSelf_->diverged,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_replay(): diverged from the recording at event %zu of %zu!",
+                   pSelf_->cursor, pSelf_->count);
+
+    GBL_CTX_END();
+}
+
+// One device's progress through an event being played back a step at a time
+typedef struct EvmuJournalStep_ {
+    const EvmuJournalEvent_* pEvent;
+    EvmuTicks                end;       // master time an update runs until
+    EvmuCycles               elapsed;   // cycles a run has taken so far
+    GblBool                  done;
+} EvmuJournalStep_;
+
+/* Plays back everything the event at the cursor does before its first
+   instruction, or the whole thing if it doesn't run any. Mirrors what
+   EvmuDevice's update and EvmuDevice_runUntil() do up to EvmuCpu__run_(). */
+static void EvmuJournal_stepBegin_(EvmuJournal_* pSelf_, EvmuJournalStep_* pStep) {
+    EvmuDevice*  pDevice  = pSelf_->pDevice;
+    EvmuDevice_* pDevice_ = EVMU_DEVICE_(pDevice);
+
+    memset(pStep, 0, sizeof(EvmuJournalStep_));
+    pStep->pEvent = &pSelf_->pEvents[pSelf_->cursor];
+
+    switch(pStep->pEvent->type) {
+    case EVMU_JOURNAL_EVENT_UPDATE: {
+        const EvmuTicks ticks = EvmuDevice__scaleTicks_(pDevice, pStep->pEvent->value);
+
+        ++pSelf_->cursor;
+        EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice->pGamepad), ticks);
+
+        pStep->end  = pDevice_->scheduler.now + ticks;
+        pStep->done = !ticks;
+        break;
+    }
+    case EVMU_JOURNAL_EVENT_RUN:
+        ++pSelf_->cursor;
+        EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice->pGamepad), 0);
+
+        pStep->done = !pStep->pEvent->value;
+        break;
+    default:
+        EvmuJournal_play_(pSelf_);
+        pStep->done = GBL_TRUE;
+        break;
+    }
+}
+
+// Runs a single instruction, or basic block outside of the interpreter, of the event begun
+static void EvmuJournal_stepNext_(EvmuJournal_* pSelf_, EvmuJournalStep_* pStep) {
+    EvmuDevice_* pDevice_ = EVMU_DEVICE_(pSelf_->pDevice);
+    EvmuStopMask reason   = EVMU_DEVICE_STOP_NONE;
+    EvmuCycles   cycles   = 0;
+
+    if(pStep->done) return;
+
+    // Updates end at a failed instruction too, just like the update being played back did
+    if(pStep->pEvent->type == EVMU_JOURNAL_EVENT_UPDATE) {
+        EvmuCpu__run_(pDevice_->pCpu, pStep->end, 1, EVMU_DEVICE_STOP_NONE, &reason, NULL);
+        pStep->done = reason || pDevice_->scheduler.now >= pStep->end;
+    } else {
+        EvmuCpu__run_(pDevice_->pCpu, UINT64_MAX, 1, pStep->pEvent->mask, &reason, &cycles);
+        pStep->elapsed += cycles;
+        pStep->done     = reason || pStep->elapsed >= pStep->pEvent->value;
+    }
+}
+
+static GblBool EvmuJournal_same_(EvmuDevice* pDevice, EvmuDevice* pOther) {
+    return EVMU_DEVICE_(pDevice)->scheduler.now == EVMU_DEVICE_(pOther)->scheduler.now &&
+           EvmuDevice_stateHash(pDevice) == EvmuDevice_stateHash(pOther);
+}
+
+// Fills in where two devices which just stopped matching now differ
+static void EvmuJournal_differ_(EvmuDevice* pDevice, EvmuDevice* pOther, EvmuJournalDivergence* pDivergence) {
+    const EvmuMemory_* pMem   = EVMU_DEVICE_(pDevice)->pMemory;
+    const EvmuMemory_* pOMem  = EVMU_DEVICE_(pOther)->pMemory;
+
+    pDivergence->diverged   = GBL_TRUE;
+    pDivergence->pcAfter[0] = EVMU_DEVICE_(pDevice)->pCpu->pc;
+    pDivergence->pcAfter[1] = EVMU_DEVICE_(pOther)->pCpu->pc;
+    pDivergence->address    = EVMU_JOURNAL_ADDRESS_NONE;
+    pDivergence->bank       = 0;
+
+    for(size_t b = 0; b < EVMU_ADDRESS_SEGMENT_RAM_BANKS; ++b)
+        for(size_t o = 0; o < EVMU_ADDRESS_SEGMENT_RAM_SIZE; ++o)
+            if(pMem->ram[b][o] != pOMem->ram[b][o]) {
+                pDivergence->address = o;
+                pDivergence->bank    = b;
+                return;
+            }
+
+    for(size_t o = 0; o < EVMU_ADDRESS_SEGMENT_SFR_SIZE; ++o)
+        if(pMem->sfr[o] != pOMem->sfr[o]) {
+            pDivergence->address = EVMU_ADDRESS_SEGMENT_SFR_BASE + o;
+            return;
+        }
+
+    for(size_t b = 0; b < EVMU_ADDRESS_SEGMENT_XRAM_BANKS; ++b)
+        for(size_t o = 0; o < EVMU_ADDRESS_SEGMENT_XRAM_SIZE; ++o)
+            if(pMem->xram[b][o] != pOMem->xram[b][o]) {
+                pDivergence->address = EVMU_XRAM_ADDRESS(o);
+                pDivergence->bank    = b;
+                return;
+            }
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_bisect(EvmuJournal*           pSelf,
+                                           EvmuDevice*            pOther,
+                                           EvmuJournalDivergence* pDivergence)
+{
+    EvmuJournal* pShadow = NULL;
+    uint8_t*     pStates = NULL;
+
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pOther);
+    GBL_CTX_VERIFY_POINTER(pDivergence);
+
+    EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf_->mode == EVMU_JOURNAL_MODE_IDLE && pSelf_->pStart,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_bisect(): nothing recorded, or still recording!");
+
+    GBL_CTX_VERIFY(pOther != pSelf_->pDevice,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuJournal_bisect(): cannot bisect a device against itself!");
+
+    memset(pDivergence, 0, sizeof(EvmuJournalDivergence));
+    pDivergence->address = EVMU_JOURNAL_ADDRESS_NONE;
+
+    // The other device replays through a journal of its own, borrowing this one's events
+    pShadow = EvmuJournal_create(pOther);
+
+    GBL_CTX_VERIFY(pShadow,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_bisect(): other device already has a journal attached!");
+
+    EvmuJournal_* pShadow_ = EVMU_JOURNAL_(pShadow);
+
+    pShadow_->pStart    = pSelf_->pStart;
+    pShadow_->startSize = pSelf_->startSize;
+    pShadow_->pEvents   = pSelf_->pEvents;
+    pShadow_->count     = pSelf_->count;
+
+    EvmuJournal_* pJournals[2] = { pSelf_, pShadow_ };
+    EvmuDevice*   pDevices[2]  = { pSelf_->pDevice, pOther };
+    const size_t  sizes[2]     = { EvmuDevice_stateSize(pDevices[0]), EvmuDevice_stateSize(pDevices[1]) };
+
+    // Where each device was before the current event, to go back and step through it
+    pStates = malloc(sizes[0] + sizes[1]);
+
+    GBL_CTX_VERIFY(pStates,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuJournal_bisect(): failed to allocate save states!");
+
+    uint8_t* const pSaved[2] = { pStates, pStates + sizes[0] };
+
+    for(size_t d = 0; d < 2; ++d)
+        GBL_CTX_VERIFY_CALL(EvmuJournal_begin_(pJournals[d]));
+
+    while(pSelf_->cursor < pSelf_->count && !pSelf_->diverged && !pShadow_->diverged) {
+        const size_t   event      = pSelf_->cursor;
+        const uint16_t buttons[2] = { pSelf_->buttons, pShadow_->buttons };
+
+        for(size_t d = 0; d < 2; ++d) {
+            GBL_CTX_VERIFY_CALL(EvmuDevice_saveState(pDevices[d], pSaved[d], sizes[d]));
+            EvmuJournal_play_(pJournals[d]);
+        }
+
+        if(pSelf_->cursor == pShadow_->cursor && EvmuJournal_same_(pDevices[0], pDevices[1]))
+            continue;
+
+        // Go back to before the event and find the first step after which they differ
+        EvmuJournalStep_ steps[2];
+
+        for(size_t d = 0; d < 2; ++d) {
+            GBL_CTX_VERIFY_CALL(EvmuDevice_loadState(pDevices[d], pSaved[d], sizes[d]));
+            pJournals[d]->cursor   = event;
+            pJournals[d]->buttons  = buttons[d];
+            pJournals[d]->diverged = GBL_FALSE;
+        }
+
+        pDivergence->event = event;
+        pDivergence->time  = EVMU_DEVICE_(pDevices[0])->scheduler.now;
+        pDivergence->pc    = EVMU_DEVICE_(pDevices[0])->pCpu->pc;
+
+        for(size_t d = 0; d < 2; ++d)
+            EvmuJournal_stepBegin_(pJournals[d], &steps[d]);
+
+        while(EvmuJournal_same_(pDevices[0], pDevices[1]) && !(steps[0].done && steps[1].done)) {
+            ++pDivergence->step;
+            pDivergence->time = EVMU_DEVICE_(pDevices[0])->scheduler.now;
+            pDivergence->pc   = EVMU_DEVICE_(pDevices[0])->pCpu->pc;
+
+            for(size_t d = 0; d < 2; ++d)
+                EvmuJournal_stepNext_(pJournals[d], &steps[d]);
+        }
+
+        /* Should stepping match all the way through, the event as a whole is to blame,
+           such as when one device consumed nested events the other didn't. */
+        EvmuJournal_differ_(pDevices[0], pDevices[1], pDivergence);
+        break;
+    }
+
+    GBL_CTX_VERIFY(pDivergence->diverged || (!pSelf_->diverged && !pShadow_->diverged),
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_bisect(): both devices diverged from the recording at event %zu of %zu!",
+                   pSelf_->cursor, pSelf_->count);
+
+    GBL_CTX_END_BLOCK();
+
+    if(pShadow) {
+        // Borrowed, so not the shadow's to free
+        EVMU_JOURNAL_(pShadow)->pStart  = NULL;
+        EVMU_JOURNAL_(pShadow)->pEvents = NULL;
+
+        EVMU_JOURNAL_(pSelf)->mode = EVMU_JOURNAL_MODE_IDLE;
+        EvmuJournal_unref(pShadow);
+    }
+
+    free(pStates);
+
+    return GBL_CTX_RESULT();
+}
+
+static uint8_t* EvmuJournal_put_(uint8_t* pOut, uint64_t value, size_t bytes) {
+    for(size_t b = 0; b < bytes; ++b)
+        *pOut++ = value >> (b * 8);
+
+    return pOut;
+}
+
+static uint64_t EvmuJournal_get_(const uint8_t** ppIn, size_t bytes) {
+    uint64_t value = 0;
+
+    for(size_t b = 0; b < bytes; ++b)
+        value |= (uint64_t)*(*ppIn)++ << (b * 8);
+
+    return value;
+}
+
+EVMU_EXPORT size_t EvmuJournal_saveSize(const EvmuJournal* pSelf) {
+    const EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    return EvmuJournal_eventOffset(pSelf, pSelf_->count) + EVMU_JOURNAL__CRC_SIZE_;
+}
+
+EVMU_EXPORT size_t EvmuJournal_eventOffset(const EvmuJournal* pSelf, size_t index) {
+    const EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    return EVMU_JOURNAL__HEADER_SIZE_ + pSelf_->startSize + index * EVMU_JOURNAL__EVENT_SIZE_;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_reseal(void* pBuffer, size_t size) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pBuffer);
+
+    GBL_CTX_VERIFY(size >= EVMU_JOURNAL__HEADER_SIZE_ + EVMU_JOURNAL__CRC_SIZE_,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuJournal_reseal(): %zu bytes is too small for a journal!",
+                   size);
+
+    const size_t crcOffset = size - EVMU_JOURNAL__CRC_SIZE_;
+
+    EvmuJournal_put_((uint8_t*)pBuffer + crcOffset,
+                     gblHashCrc(pBuffer, crcOffset),
+                     EVMU_JOURNAL__CRC_SIZE_);
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_save(const EvmuJournal* pSelf, void* pBuffer, size_t size) {
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pBuffer);
+
+    const EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf_->pStart,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_save(): nothing has been recorded!");
+
+    GBL_CTX_VERIFY(size >= EvmuJournal_saveSize(pSelf),
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "EvmuJournal_save(): buffer of %zu bytes is too small for %zu!",
+                   size, EvmuJournal_saveSize(pSelf));
+
+    uint8_t* pOut = pBuffer;
+
+    pOut = EvmuJournal_put_(pOut, EVMU_JOURNAL__MAGIC_,   4);
+    pOut = EvmuJournal_put_(pOut, EVMU_JOURNAL_VERSION,   4);
+    pOut = EvmuJournal_put_(pOut, pSelf_->startSize,      4);
+    pOut = EvmuJournal_put_(pOut, pSelf_->count,          8);
+
+    memcpy(pOut, pSelf_->pStart, pSelf_->startSize);
+    pOut += pSelf_->startSize;
+
+    for(size_t e = 0; e < pSelf_->count; ++e) {
+        pOut = EvmuJournal_put_(pOut, pSelf_->pEvents[e].time,  8);
+        pOut = EvmuJournal_put_(pOut, pSelf_->pEvents[e].value, 8);
+        pOut = EvmuJournal_put_(pOut, pSelf_->pEvents[e].type,  1);
+        pOut = EvmuJournal_put_(pOut, pSelf_->pEvents[e].mask,  1);
+    }
+
+    EvmuJournal_put_(pOut, gblHashCrc(pBuffer, pOut - (uint8_t*)pBuffer), EVMU_JOURNAL__CRC_SIZE_);
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuJournal_load(EvmuJournal* pSelf, const void* pBuffer, size_t size) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+    GBL_CTX_VERIFY_POINTER(pBuffer);
+
+    EvmuJournal_*  pSelf_ = EVMU_JOURNAL_(pSelf);
+    const uint8_t* pIn    = pBuffer;
+
+    GBL_CTX_VERIFY(pSelf_->mode != EVMU_JOURNAL_MODE_REPLAYING,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuJournal_load(): cannot load while replaying!");
+
+    GBL_CTX_VERIFY(size >= EVMU_JOURNAL__HEADER_SIZE_ + EVMU_JOURNAL__CRC_SIZE_,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuJournal_load(): truncated header!");
+
+    const uint32_t magic     = EvmuJournal_get_(&pIn, 4);
+    const uint32_t version   = EvmuJournal_get_(&pIn, 4);
+    const size_t   startSize = EvmuJournal_get_(&pIn, 4);
+    const uint64_t count     = EvmuJournal_get_(&pIn, 8);
+
+    GBL_CTX_VERIFY(magic == EVMU_JOURNAL__MAGIC_ && version == EVMU_JOURNAL_VERSION,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuJournal_load(): not a journal, or of unsupported version [%u]!",
+                   version);
+
+    const size_t body = size - EVMU_JOURNAL__HEADER_SIZE_ - EVMU_JOURNAL__CRC_SIZE_;
+
+    GBL_CTX_VERIFY(count <= body / EVMU_JOURNAL__EVENT_SIZE_ &&
+                   body - count * EVMU_JOURNAL__EVENT_SIZE_ >= startSize,
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuJournal_load(): truncated journal!");
+
+    // Anything after the CRC is ignored, same as extra space handed to EvmuJournal_save()
+    const size_t   crcOffset = EVMU_JOURNAL__HEADER_SIZE_ + startSize + count * EVMU_JOURNAL__EVENT_SIZE_;
+    const uint8_t* pCrc      = (const uint8_t*)pBuffer + crcOffset;
+
+    GBL_CTX_VERIFY(EvmuJournal_get_(&pCrc, EVMU_JOURNAL__CRC_SIZE_) == gblHashCrc(pBuffer, crcOffset),
+                   GBL_RESULT_ERROR_INVALID_ARG,
+                   "EvmuJournal_load(): checksum mismatch, journal is corrupt!");
+
+    uint8_t* pStart = malloc(startSize);
+
+    GBL_CTX_VERIFY(pStart,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuJournal_load(): failed to allocate starting state!");
+
+    EvmuJournalEvent_* pEvents = malloc(sizeof(EvmuJournalEvent_) * (count? count : 1));
+
+    if(!pEvents) free(pStart);
+
+    GBL_CTX_VERIFY(pEvents,
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuJournal_load(): failed to allocate %zu events!",
+                   (size_t)count);
+
+    memcpy(pStart, pIn, startSize);
+    pIn += startSize;
+
+    for(size_t e = 0; e < count; ++e) {
+        pEvents[e].time  = EvmuJournal_get_(&pIn, 8);
+        pEvents[e].value = EvmuJournal_get_(&pIn, 8);
+        pEvents[e].type  = EvmuJournal_get_(&pIn, 1);
+        pEvents[e].mask  = EvmuJournal_get_(&pIn, 1);
+    }
+
+    free(pSelf_->pStart);
+    free(pSelf_->pEvents);
+
+    pSelf_->pStart    = pStart;
+    pSelf_->startSize = startSize;
+    pSelf_->pEvents   = pEvents;
+    pSelf_->count     = count;
+    pSelf_->capacity  = count? count : 1;
+    pSelf_->cursor    = 0;
+    pSelf_->diverged  = GBL_FALSE;
+    pSelf_->mode      = EVMU_JOURNAL_MODE_IDLE;
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuJournal_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuJournal_* pSelf_ = EVMU_JOURNAL_(pBox);
+
+    free(pSelf_->pStart);
+    free(pSelf_->pEvents);
+
+    if(pSelf_->pDevice) {
+        EVMU_DEVICE_(pSelf_->pDevice)->pJournal = NULL;
+        GBL_UNREF(pSelf_->pDevice);
+    }
+
+    GBL_INSTANCE_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuJournalClass_init_(GblClass* pClass, const void* pUd, GblContext* pCtx) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_BOX_CLASS(pClass)->pFnDestructor = EvmuJournal_GblBox_destructor_;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT GblType EvmuJournal_type(void) {
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
+
+    static const GblTypeInfo info = {
+        .pFnClassInit        = EvmuJournalClass_init_,
+        .classSize           = sizeof(EvmuJournalClass),
+        .instanceSize        = sizeof(EvmuJournal),
+        .instancePrivateSize = sizeof(EvmuJournal_)
+    };
+
+    EVMU_TYPE__REGISTER_(type,
+        type = GblType_registerStatic(GblQuark_internStringStatic("EvmuJournal"),
+                                      GBL_OBJECT_TYPE,
+                                      &info,
+                                      GBL_TYPE_FLAG_TYPEINFO_STATIC);
+    );
+    return type;
+}
@@ -0,0 +1,51 @@
+#ifndef EVMU_JOURNAL__H
+#define EVMU_JOURNAL__H
+
+#include <evmu/types/evmu_journal.h>
+#include <evmu/hw/evmu_gamepad.h>
+#include <gimbal/utils/gimbal_date_time.h>
+
+#define EVMU_JOURNAL_(instance)     ((EvmuJournal_*)GBL_INSTANCE_PRIVATE(instance, EVMU_JOURNAL_TYPE))
+#define EVMU_JOURNAL_PUBLIC_(priv)  ((EvmuJournal*)GBL_INSTANCE_PUBLIC(priv, EVMU_JOURNAL_TYPE))
+
+#define GBL_SELF_TYPE EvmuJournal_
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(EvmuDevice);
+
+typedef struct EvmuJournalEvent_ {
+    EvmuTicks   time;   // device's master time when it happened
+    uint64_t    value;  // tick delta, cycle budget, button bits, or packed date and time
+    uint8_t     type;   // EVMU_JOURNAL_EVENT
+    uint8_t     mask;   // stop mask of EVMU_JOURNAL_EVENT_RUN
+} EvmuJournalEvent_;
+
+typedef struct EvmuJournal_ {
+    EvmuDevice*         pDevice;
+    EVMU_JOURNAL_MODE   mode;
+    uint8_t*            pStart;     // save state recording began from
+    size_t              startSize;
+    EvmuJournalEvent_*  pEvents;
+    size_t              count;
+    size_t              capacity;
+    size_t              cursor;     // next event to play back
+    uint16_t            buttons;    // last recorded or played back
+    GblBool             diverged;   // replay met an event where it wasn't recorded
+} EvmuJournal_;
+
+/* Hooks for the device and its peripherals, called only while a journal is
+   attached. Updates, runs, and resets are recorded, as replay issues its own. */
+void EvmuJournal__update_     (GBL_SELF, EvmuTicks ticks)                         GBL_NOEXCEPT;
+void EvmuJournal__runUntil_   (GBL_SELF, EvmuCycles maxCycles, uint8_t stopMask)  GBL_NOEXCEPT;
+void EvmuJournal__reset_      (GBL_SELF)                                          GBL_NOEXCEPT;
+// Records a change in the polled buttons, or overrides them with the recorded ones
+void EvmuJournal__pollButtons_(GBL_SELF, EvmuGamepad* pGamepad)                   GBL_NOEXCEPT;
+// Records the date and time being set, or substitutes the recorded one
+void EvmuJournal__dateTime_   (GBL_SELF, GblDateTime* pDateTime)                  GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // EVMU_JOURNAL__H
@@ -2,6 +2,7 @@
 #include <evmu/hw/evmu_device.h>
 #include "evmu_peripheral_.h"
 #include "../hw/evmu_device_.h"
+#include "evmu_type_.h"
 
 GBL_EXPORT EvmuDevice* EvmuPeripheral_device(const EvmuPeripheral* pSelf) {
     GblObject* pParent = GblObject_parent(GBL_OBJECT(pSelf));
@@ -27,7 +28,7 @@ static GBL_RESULT EvmuPeripheralClass_init(GblClass* pClass, const void* pUd, Gb
 }
 
 GBL_EXPORT GblType EvmuPeripheral_type(void) {
-    static GblType type = GBL_INVALID_TYPE;
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
 
     static GblTypeInterfaceMapEntry ifaceEntries[] = {
         {
@@ -44,16 +45,13 @@ GBL_EXPORT GblType EvmuPeripheral_type(void) {
         .pInterfaceMap        = ifaceEntries
     };
 
-    if(type == GBL_INVALID_TYPE) {
-        GBL_CTX_BEGIN(NULL);
+    EVMU_TYPE__REGISTER_(type,
         ifaceEntries[0].interfaceType = EVMU_IBEHAVIOR_TYPE;
 
         type = GblType_registerStatic(GblQuark_internStringStatic("EvmuPeripheral"),
                                       GBL_OBJECT_TYPE,
                                       &info,
                                       GBL_TYPE_FLAG_TYPEINFO_STATIC);
-        GBL_CTX_VERIFY_LAST_RECORD();
-        GBL_CTX_END_BLOCK();
-    }
+    );
     return type;
 }
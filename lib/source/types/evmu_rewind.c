@@ -0,0 +1,350 @@
+#include <evmu/types/evmu_rewind.h>
+#include <evmu/hw/evmu_device.h>
+#include "evmu_rewind_.h"
+#include "../hw/evmu_device_.h"
+#include "../hw/evmu_memory_.h"
+#include "../hw/evmu_flash_.h"
+#include "evmu_type_.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Recycled entries holding more than this many records give their memory back
+#define EVMU_REWIND__RECYCLE_RECORDS_   64
+
+EVMU_EXPORT EvmuRewind* EvmuRewind_create(EvmuDevice* pDevice, size_t capacity) {
+    EvmuRewind* pSelf = NULL;
+
+    GBL_CTX_BEGIN(NULL);
+    GBL_CTX_VERIFY_POINTER(pDevice);
+    GBL_CTX_VERIFY_ARG(capacity);
+
+    pSelf = GBL_NEW(EvmuRewind);
+
+    EvmuRewind_* pSelf_ = EVMU_REWIND_(pSelf);
+    pSelf_->pDevice  = GBL_REF(pDevice);
+    pSelf_->capacity = capacity;
+
+    GBL_CTX_END_BLOCK();
+    return pSelf;
+}
+
+EVMU_EXPORT GblRefCount EvmuRewind_unref(EvmuRewind* pSelf) {
+    return GBL_UNREF(pSelf);
+}
+
+EVMU_EXPORT EvmuDevice* EvmuRewind_device(const EvmuRewind* pSelf) {
+    return EVMU_REWIND_(pSelf)->pDevice;
+}
+
+EVMU_EXPORT size_t EvmuRewind_capacity(const EvmuRewind* pSelf) {
+    return EVMU_REWIND_(pSelf)->capacity;
+}
+
+EVMU_EXPORT size_t EvmuRewind_count(const EvmuRewind* pSelf) {
+    return EVMU_REWIND_(pSelf)->count;
+}
+
+EVMU_EXPORT size_t EvmuRewind_bytes(const EvmuRewind* pSelf) {
+    const EvmuRewind_* pSelf_ = EVMU_REWIND_(pSelf);
+    size_t             bytes  = 0;
+
+    if(pSelf_->pBase)
+        bytes += EVMU_REWIND__PAGES_ * EVMU_REWIND__PAGE_SIZE_;
+
+    if(pSelf_->pEntries) {
+        bytes += pSelf_->capacity * sizeof(EvmuRewindEntry_);
+
+        for(size_t e = 0; e < pSelf_->capacity; ++e)
+            bytes += pSelf_->pEntries[e].capacity;
+    }
+
+    return bytes;
+}
+
+EVMU_EXPORT void EvmuRewind_clear(EvmuRewind* pSelf) {
+    EvmuRewind_* pSelf_ = EVMU_REWIND_(pSelf);
+
+    pSelf_->first = 0;
+    pSelf_->count = 0;
+}
+
+// Returns where a page lives within the device, with RAM, XRAM, and WRAM ahead of flash
+static EvmuWord* EvmuRewind_page_(EvmuDevice_* pDevice_, size_t page) {
+    EvmuMemory_* pMemory = pDevice_->pMemory;
+
+    const size_t ramBankPages  = EVMU_ADDRESS_SEGMENT_RAM_SIZE  / EVMU_REWIND__PAGE_SIZE_;
+    const size_t xramBankPages = EVMU_ADDRESS_SEGMENT_XRAM_SIZE / EVMU_REWIND__PAGE_SIZE_;
+
+    if(page < EVMU_REWIND__RAM_PAGES_)
+        return &pMemory->ram[page / ramBankPages][page % ramBankPages * EVMU_REWIND__PAGE_SIZE_];
+    page -= EVMU_REWIND__RAM_PAGES_;
+
+    if(page < EVMU_REWIND__XRAM_PAGES_)
+        return &pMemory->xram[page / xramBankPages][page % xramBankPages * EVMU_REWIND__PAGE_SIZE_];
+    page -= EVMU_REWIND__XRAM_PAGES_;
+
+    if(page < EVMU_REWIND__WRAM_PAGES_)
+        return &pMemory->wram[page * EVMU_REWIND__PAGE_SIZE_];
+    page -= EVMU_REWIND__WRAM_PAGES_;
+
+    return &pDevice_->pFlash->pStorage->pData[page * EVMU_REWIND__PAGE_SIZE_];
+}
+
+static EvmuRewindEntry_* EvmuRewind_entry_(EvmuRewind_* pSelf_, size_t index) {
+    return &pSelf_->pEntries[(pSelf_->first + index) % pSelf_->capacity];
+}
+
+static GblBool EvmuRewind_grow_(EvmuRewindEntry_* pEntry, size_t size) {
+    if(size <= pEntry->capacity) return GBL_TRUE;
+
+    const size_t capacity = size + size / 2;
+    uint8_t*     pBlock   = realloc(pEntry->pBlock, capacity);
+
+    if(!pBlock) return GBL_FALSE;
+
+    pEntry->pBlock   = pBlock;
+    pEntry->capacity = capacity;
+
+    return GBL_TRUE;
+}
+
+// Appends the page's contents as of the newest snapshot to its entry, then brings the base up to date
+static GblBool EvmuRewind_record_(EvmuRewind_*      pSelf_,
+                                  EvmuRewindEntry_* pEntry,
+                                  size_t            page,
+                                  const EvmuWord*   pPage)
+{
+    const size_t offset = pSelf_->coreSize + pEntry->records * EVMU_REWIND__RECORD_SIZE_;
+
+    if(!EvmuRewind_grow_(pEntry, offset + EVMU_REWIND__RECORD_SIZE_))
+        return GBL_FALSE;
+
+    uint8_t* pRecord = &pEntry->pBlock[offset];
+    uint8_t* pBase   = &pSelf_->pBase[page * EVMU_REWIND__PAGE_SIZE_];
+
+    pRecord[0] = page & 0xff;
+    pRecord[1] = page >> 8;
+    memcpy(&pRecord[2], pBase, EVMU_REWIND__PAGE_SIZE_);
+    memcpy(pBase, pPage, EVMU_REWIND__PAGE_SIZE_);
+
+    ++pEntry->records;
+
+    return GBL_TRUE;
+}
+
+// Records every page which differs from the base into the newest entry
+static GblBool EvmuRewind_recordChanges_(EvmuRewind_* pSelf_, EvmuDevice_* pDevice_) {
+    EvmuRewindEntry_* pNewest = EvmuRewind_entry_(pSelf_, pSelf_->count - 1);
+    const uint64_t*   pDirty  = pDevice_->pFlash->dirty;
+
+    /* RAM, XRAM, and WRAM are small, but written from everywhere, including
+       JIT-compiled code, so comparing them is cheaper than tracking them. */
+    for(size_t p = 0; p < EVMU_REWIND__MEMORY_PAGES_; ++p) {
+        const EvmuWord* pPage = EvmuRewind_page_(pDevice_, p);
+
+        if(memcmp(pPage, &pSelf_->pBase[p * EVMU_REWIND__PAGE_SIZE_], EVMU_REWIND__PAGE_SIZE_) &&
+           !EvmuRewind_record_(pSelf_, pNewest, p, pPage))
+            return GBL_FALSE;
+    }
+
+    // Flash is large and rarely written, so only the pages written since the last capture are checked
+    for(size_t w = 0; w < EVMU_FLASH__PAGE_COUNT_ / 64; ++w) {
+        if(!pDirty[w]) continue;
+
+        for(size_t b = 0; b < 64; ++b) {
+            if(!(pDirty[w] >> b & 1)) continue;
+
+            const size_t    p     = EVMU_REWIND__MEMORY_PAGES_ + w * 64 + b;
+            const EvmuWord* pPage = EvmuRewind_page_(pDevice_, p);
+
+            if(memcmp(pPage, &pSelf_->pBase[p * EVMU_REWIND__PAGE_SIZE_], EVMU_REWIND__PAGE_SIZE_) &&
+               !EvmuRewind_record_(pSelf_, pNewest, p, pPage))
+                return GBL_FALSE;
+        }
+    }
+
+    return GBL_TRUE;
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuRewind_capture(EvmuRewind* pSelf) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuRewind_* pSelf_ = EVMU_REWIND_(pSelf);
+
+    GBL_CTX_VERIFY(pSelf_->pDevice && pSelf_->capacity,
+                   GBL_RESULT_ERROR_INVALID_OPERATION,
+                   "EvmuRewind_capture(): not created with a device and capacity!");
+
+    EvmuDevice_* pDevice_ = EVMU_DEVICE_(pSelf_->pDevice);
+
+    if(!pSelf_->pEntries || !pSelf_->pBase) {
+        pSelf_->coreSize = EvmuDevice__coreStateSize_(pDevice_);
+
+        if(!pSelf_->pEntries)
+            pSelf_->pEntries = calloc(pSelf_->capacity, sizeof(EvmuRewindEntry_));
+        if(!pSelf_->pBase)
+            pSelf_->pBase    = malloc(EVMU_REWIND__PAGES_ * EVMU_REWIND__PAGE_SIZE_);
+
+        GBL_CTX_VERIFY(pSelf_->pEntries && pSelf_->pBase,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "EvmuRewind_capture(): failed to allocate snapshot storage!");
+    }
+
+    if(!pSelf_->count) {
+        for(size_t p = 0; p < EVMU_REWIND__PAGES_; ++p)
+            memcpy(&pSelf_->pBase[p * EVMU_REWIND__PAGE_SIZE_],
+                   EvmuRewind_page_(pDevice_, p),
+                   EVMU_REWIND__PAGE_SIZE_);
+    } else if(!EvmuRewind_recordChanges_(pSelf_, pDevice_)) {
+        // The base is now partway between snapshots, so start over from scratch next time
+        EvmuRewind_clear(pSelf);
+
+        GBL_CTX_VERIFY(GBL_FALSE,
+                       GBL_RESULT_ERROR_MEM_ALLOC,
+                       "EvmuRewind_capture(): failed to grow snapshot, dropped history!");
+    }
+
+    memset(pDevice_->pFlash->dirty, 0, sizeof(pDevice_->pFlash->dirty));
+
+    // Make room by dropping the oldest, whose records only led up to it
+    if(pSelf_->count == pSelf_->capacity) {
+        pSelf_->first = (pSelf_->first + 1) % pSelf_->capacity;
+        --pSelf_->count;
+    }
+
+    EvmuRewindEntry_* pEntry = EvmuRewind_entry_(pSelf_, pSelf_->count);
+
+    if(pEntry->records > EVMU_REWIND__RECYCLE_RECORDS_) {
+        free(pEntry->pBlock);
+        pEntry->pBlock   = NULL;
+        pEntry->capacity = 0;
+    }
+
+    pEntry->records = 0;
+
+    GBL_CTX_VERIFY(EvmuRewind_grow_(pEntry, pSelf_->coreSize),
+                   GBL_RESULT_ERROR_MEM_ALLOC,
+                   "EvmuRewind_capture(): failed to allocate snapshot!");
+
+    EvmuDevice__saveCoreState_(pDevice_, pEntry->pBlock);
+    ++pSelf_->count;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT EVMU_RESULT EvmuRewind_restore(EvmuRewind* pSelf, size_t age) {
+    GBL_CTX_BEGIN(pSelf);
+    GBL_CTX_VERIFY_POINTER(pSelf);
+
+    EvmuRewind_* pSelf_ = EVMU_REWIND_(pSelf);
+
+    GBL_CTX_VERIFY(age < pSelf_->count,
+                   GBL_RESULT_ERROR_OUT_OF_RANGE,
+                   "EvmuRewind_restore(): snapshot %zu is beyond the %zu held!",
+                   age, pSelf_->count);
+
+    EvmuDevice_* pDevice_     = EVMU_DEVICE_(pSelf_->pDevice);
+    uint64_t*    pDirty       = pDevice_->pFlash->dirty;
+    const size_t target       = pSelf_->count - 1 - age;
+    GblBool      flashChanged = GBL_FALSE;
+
+    // Everything since the newest snapshot is undone by going back to the base
+    for(size_t p = 0; p < EVMU_REWIND__MEMORY_PAGES_; ++p)
+        memcpy(EvmuRewind_page_(pDevice_, p),
+               &pSelf_->pBase[p * EVMU_REWIND__PAGE_SIZE_],
+               EVMU_REWIND__PAGE_SIZE_);
+
+    for(size_t w = 0; w < EVMU_FLASH__PAGE_COUNT_ / 64; ++w) {
+        if(!pDirty[w]) continue;
+
+        for(size_t b = 0; b < 64; ++b) {
+            if(!(pDirty[w] >> b & 1)) continue;
+
+            const size_t p = EVMU_REWIND__MEMORY_PAGES_ + w * 64 + b;
+
+            memcpy(EvmuRewind_page_(pDevice_, p),
+                   &pSelf_->pBase[p * EVMU_REWIND__PAGE_SIZE_],
+                   EVMU_REWIND__PAGE_SIZE_);
+        }
+
+        pDirty[w]    = 0;
+        flashChanged = GBL_TRUE;
+    }
+
+    // Then each older snapshot's records step both the device and base back one at a time
+    for(size_t e = pSelf_->count - 1; e-- > target; ) {
+        EvmuRewindEntry_* pEntry = EvmuRewind_entry_(pSelf_, e);
+
+        for(size_t r = 0; r < pEntry->records; ++r) {
+            const uint8_t* pRecord = &pEntry->pBlock[pSelf_->coreSize + r * EVMU_REWIND__RECORD_SIZE_];
+            const size_t   p       = pRecord[0] | pRecord[1] << 8;
+
+            memcpy(EvmuRewind_page_(pDevice_, p), &pRecord[2], EVMU_REWIND__PAGE_SIZE_);
+            memcpy(&pSelf_->pBase[p * EVMU_REWIND__PAGE_SIZE_], &pRecord[2], EVMU_REWIND__PAGE_SIZE_);
+
+            if(p >= EVMU_REWIND__MEMORY_PAGES_)
+                flashChanged = GBL_TRUE;
+        }
+
+        pEntry->records = 0;
+    }
+
+    EvmuDevice__loadCoreState_(pDevice_, EvmuRewind_entry_(pSelf_, target)->pBlock);
+
+    // Anything newer branched off from a future that no longer happens
+    pSelf_->count = target + 1;
+
+    if(flashChanged) {
+        EVMU_FLASH_PUBLIC(pDevice_->pFlash)->dataChanged     = GBL_TRUE;
+        EVMU_MEMORY_PUBLIC_(pDevice_->pMemory)->flashChanged = GBL_TRUE;
+    }
+
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuRewind_GblBox_destructor_(GblBox* pBox) {
+    GBL_CTX_BEGIN(NULL);
+
+    EvmuRewind_* pSelf_ = EVMU_REWIND_(pBox);
+
+    if(pSelf_->pEntries)
+        for(size_t e = 0; e < pSelf_->capacity; ++e)
+            free(pSelf_->pEntries[e].pBlock);
+
+    free(pSelf_->pEntries);
+    free(pSelf_->pBase);
+
+    if(pSelf_->pDevice)
+        GBL_UNREF(pSelf_->pDevice);
+
+    GBL_INSTANCE_VCALL_DEFAULT(GblObject, base.pFnDestructor, pBox);
+    GBL_CTX_END();
+}
+
+static GBL_RESULT EvmuRewindClass_init_(GblClass* pClass, const void* pUd, GblContext* pCtx) {
+    GBL_CTX_BEGIN(NULL);
+
+    GBL_BOX_CLASS(pClass)->pFnDestructor = EvmuRewind_GblBox_destructor_;
+
+    GBL_CTX_END();
+}
+
+EVMU_EXPORT GblType EvmuRewind_type(void) {
+    static EVMU_TYPE__ATOMIC_ GblType type = GBL_INVALID_TYPE;
+
+    static const GblTypeInfo info = {
+        .pFnClassInit        = EvmuRewindClass_init_,
+        .classSize           = sizeof(EvmuRewindClass),
+        .instanceSize        = sizeof(EvmuRewind),
+        .instancePrivateSize = sizeof(EvmuRewind_)
+    };
+
+    EVMU_TYPE__REGISTER_(type,
+        type = GblType_registerStatic(GblQuark_internStringStatic("EvmuRewind"),
+                                      GBL_OBJECT_TYPE,
+                                      &info,
+                                      GBL_TYPE_FLAG_TYPEINFO_STATIC);
+    );
+    return type;
+}
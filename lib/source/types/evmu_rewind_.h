@@ -0,0 +1,48 @@
+#ifndef EVMU_REWIND__H
+#define EVMU_REWIND__H
+
+#include <evmu/types/evmu_rewind.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <evmu/hw/evmu_wram.h>
+#include "../hw/evmu_flash_.h"
+
+#define EVMU_REWIND_(instance)      ((EvmuRewind_*)GBL_INSTANCE_PRIVATE(instance, EVMU_REWIND_TYPE))
+#define EVMU_REWIND_PUBLIC_(priv)   ((EvmuRewind*)GBL_INSTANCE_PUBLIC(priv, EVMU_REWIND_TYPE))
+
+#define EVMU_REWIND__PAGE_SIZE_     EVMU_FLASH__PAGE_SIZE_
+#define EVMU_REWIND__RAM_PAGES_     (EVMU_ADDRESS_SEGMENT_RAM_BANKS * EVMU_ADDRESS_SEGMENT_RAM_SIZE / EVMU_REWIND__PAGE_SIZE_)
+#define EVMU_REWIND__XRAM_PAGES_    (EVMU_ADDRESS_SEGMENT_XRAM_BANKS * EVMU_ADDRESS_SEGMENT_XRAM_SIZE / EVMU_REWIND__PAGE_SIZE_)
+#define EVMU_REWIND__WRAM_PAGES_    (EVMU_WRAM_SIZE / EVMU_REWIND__PAGE_SIZE_)
+#define EVMU_REWIND__MEMORY_PAGES_  (EVMU_REWIND__RAM_PAGES_ + EVMU_REWIND__XRAM_PAGES_ + EVMU_REWIND__WRAM_PAGES_)
+#define EVMU_REWIND__PAGES_         (EVMU_REWIND__MEMORY_PAGES_ + EVMU_FLASH__PAGE_COUNT_)
+#define EVMU_REWIND__RECORD_SIZE_   (2 + EVMU_REWIND__PAGE_SIZE_)  // page index, then its contents
+
+#define GBL_SELF_TYPE EvmuRewind_
+
+GBL_DECLS_BEGIN
+
+GBL_FORWARD_DECLARE_STRUCT(EvmuDevice);
+
+/* A snapshot's core state, followed by a record for every page which changed
+   between it and the next newer snapshot, holding the page's older contents. */
+typedef struct EvmuRewindEntry_ {
+    uint8_t*    pBlock;
+    size_t      capacity;   // bytes allocated for pBlock, reused as the ring wraps
+    size_t      records;    // pages recorded after the core state
+} EvmuRewindEntry_;
+
+typedef struct EvmuRewind_ {
+    EvmuDevice*         pDevice;
+    size_t              coreSize;   // bytes of core state heading every entry
+    uint8_t*            pBase;      // every page, as of the newest snapshot
+    EvmuRewindEntry_*   pEntries;
+    size_t              capacity;
+    size_t              first;      // oldest entry within the ring
+    size_t              count;
+} EvmuRewind_;
+
+GBL_DECLS_END
+
+#undef GBL_SELF_TYPE
+
+#endif // EVMU_REWIND__H
@@ -0,0 +1,27 @@
+#include "evmu_type_.h"
+
+#ifdef EVMU_TYPE__THREADS_
+#include <threads.h>
+
+static once_flag lockOnce_ = ONCE_FLAG_INIT;
+static mtx_t     lock_;
+
+static void EvmuType_initLock_(void) {
+    mtx_init(&lock_, mtx_plain | mtx_recursive);
+}
+
+void EvmuType__lock_(void) {
+    call_once(&lockOnce_, EvmuType_initLock_);
+    mtx_lock(&lock_);
+}
+
+void EvmuType__unlock_(void) {
+    mtx_unlock(&lock_);
+}
+
+#else
+
+void EvmuType__lock_(void) {}
+void EvmuType__unlock_(void) {}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef EVMU_TYPE__H
+#define EVMU_TYPE__H
+
+#include <evmu/evmu_api.h>
+
+/* Types register themselves upon first use, which can come from several
+   threads at once, each stepping its own device. The cached GblType is
+   published atomically, keeping lookups a single load, while registering
+   happens under one recursive lock, since a type registers its parent
+   and interfaces from within its own registration. */
+#if !defined(__STDC_NO_THREADS__) && !defined(__STDC_NO_ATOMICS__)
+#   define EVMU_TYPE__THREADS_
+#   include <stdatomic.h>
+#   define EVMU_TYPE__ATOMIC_   _Atomic
+#else
+#   define EVMU_TYPE__ATOMIC_
+#endif
+
+/* Runs the statements registering a type the first time its _type() function
+   is called, double-checking the cached GblType under the lock, and verifying
+   that registration left no error behind:
+
+       EVMU_TYPE__REGISTER_(type,
+           type = GblType_registerStatic(...);
+       );
+*/
+#define EVMU_TYPE__REGISTER_(type, ...)             \
+    do {                                            \
+        if(type == GBL_INVALID_TYPE) {              \
+            EvmuType__lock_();                      \
+                                                    \
+            if(type == GBL_INVALID_TYPE) {          \
+                GBL_CTX_BEGIN(NULL);                \
+                __VA_ARGS__                         \
+                GBL_CTX_VERIFY_LAST_RECORD();       \
+                GBL_CTX_END_BLOCK();                \
+            }                                       \
+                                                    \
+            EvmuType__unlock_();                    \
+        }                                           \
+    } while(0)
+
+GBL_DECLS_BEGIN
+
+void EvmuType__lock_  (void) GBL_NOEXCEPT;
+void EvmuType__unlock_(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif // EVMU_TYPE__H
@@ -0,0 +1,20 @@
+#ifndef EVMU_BATCH_TEST_SUITE_H
+#define EVMU_BATCH_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define EVMU_BATCH_TEST_SUITE_TYPE                (GBL_TYPEOF(EvmuBatchTestSuite))
+#define EVMU_BATCH_TEST_SUITE(instance)           (GBL_INSTANCE_CAST(instance, EvmuBatchTestSuite))
+#define EVMU_BATCH_TEST_SUITE_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuBatchTestSuite))
+#define EVMU_BATCH_TEST_SUITE_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuBatchTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (EvmuBatchTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(EvmuBatchTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType EvmuBatchTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef EVMU_DEVICE_TEST_SUITE_H
+#define EVMU_DEVICE_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define EVMU_DEVICE_TEST_SUITE_TYPE                (GBL_TYPEOF(EvmuDeviceTestSuite))
+#define EVMU_DEVICE_TEST_SUITE(instance)           (GBL_INSTANCE_CAST(instance, EvmuDeviceTestSuite))
+#define EVMU_DEVICE_TEST_SUITE_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuDeviceTestSuite))
+#define EVMU_DEVICE_TEST_SUITE_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuDeviceTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (EvmuDeviceTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(EvmuDeviceTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType EvmuDeviceTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
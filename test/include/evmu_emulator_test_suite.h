@@ -0,0 +1,20 @@
+#ifndef EVMU_EMULATOR_TEST_SUITE_H
+#define EVMU_EMULATOR_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define EVMU_EMULATOR_TEST_SUITE_TYPE                (GBL_TYPEOF(EvmuEmulatorTestSuite))
+#define EVMU_EMULATOR_TEST_SUITE(instance)           (GBL_INSTANCE_CAST(instance, EvmuEmulatorTestSuite))
+#define EVMU_EMULATOR_TEST_SUITE_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuEmulatorTestSuite))
+#define EVMU_EMULATOR_TEST_SUITE_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuEmulatorTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (EvmuEmulatorTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(EvmuEmulatorTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType EvmuEmulatorTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef EVMU_JOURNAL_TEST_SUITE_H
+#define EVMU_JOURNAL_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define EVMU_JOURNAL_TEST_SUITE_TYPE                (GBL_TYPEOF(EvmuJournalTestSuite))
+#define EVMU_JOURNAL_TEST_SUITE(instance)           (GBL_INSTANCE_CAST(instance, EvmuJournalTestSuite))
+#define EVMU_JOURNAL_TEST_SUITE_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuJournalTestSuite))
+#define EVMU_JOURNAL_TEST_SUITE_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuJournalTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (EvmuJournalTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(EvmuJournalTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType EvmuJournalTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
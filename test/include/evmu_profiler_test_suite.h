@@ -0,0 +1,20 @@
+#ifndef EVMU_PROFILER_TEST_SUITE_H
+#define EVMU_PROFILER_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define EVMU_PROFILER_TEST_SUITE_TYPE                (GBL_TYPEOF(EvmuProfilerTestSuite))
+#define EVMU_PROFILER_TEST_SUITE(instance)           (GBL_INSTANCE_CAST(instance, EvmuProfilerTestSuite))
+#define EVMU_PROFILER_TEST_SUITE_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuProfilerTestSuite))
+#define EVMU_PROFILER_TEST_SUITE_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuProfilerTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (EvmuProfilerTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(EvmuProfilerTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType EvmuProfilerTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef EVMU_REWIND_TEST_SUITE_H
+#define EVMU_REWIND_TEST_SUITE_H
+
+#include <gimbal/test/gimbal_test_suite.h>
+
+#define EVMU_REWIND_TEST_SUITE_TYPE                (GBL_TYPEOF(EvmuRewindTestSuite))
+#define EVMU_REWIND_TEST_SUITE(instance)           (GBL_INSTANCE_CAST(instance, EvmuRewindTestSuite))
+#define EVMU_REWIND_TEST_SUITE_CLASS(klass)        (GBL_CLASS_CAST(klass, EvmuRewindTestSuite))
+#define EVMU_REWIND_TEST_SUITE_GET_CLASS(instance) (GBL_INSTANCE_GET_CLASS(instance, EvmuRewindTestSuite))
+
+GBL_DECLS_BEGIN
+
+GBL_CLASS_DERIVE_EMPTY   (EvmuRewindTestSuite, GblTestSuite)
+GBL_INSTANCE_DERIVE_EMPTY(EvmuRewindTestSuite, GblTestSuite)
+
+GBL_EXPORT GblType EvmuRewindTestSuite_type(void) GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
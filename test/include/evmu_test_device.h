@@ -0,0 +1,34 @@
+#ifndef EVMU_TEST_DEVICE_H
+#define EVMU_TEST_DEVICE_H
+
+#include <evmu/hw/evmu_device.h>
+
+GBL_DECLS_BEGIN
+
+// Copies a program into the current program source at the given address
+void        EvmuTestDevice_writeProgram (EvmuDevice*        pDevice,
+                                         EvmuAddress        base,
+                                         const EvmuWord*    pProgram,
+                                         size_t             bytes)    GBL_NOEXCEPT;
+
+// Creates a device running the given program from the top of flash, NULL if the exec mode is unavailable
+EvmuDevice* EvmuTestDevice_create       (EVMU_CPU_EXEC_MODE mode,
+                                         const EvmuWord*    pProgram,
+                                         size_t             bytes)    GBL_NOEXCEPT;
+
+// Loads "loop: CALLF sub; BR loop; sub: NOP; RET", with the subroutine at 0x10
+void        EvmuTestDevice_loadCallLoop (EvmuDevice* pDevice)         GBL_NOEXCEPT;
+
+/* Loads the workload shared by the stress, state, rewind, and journal tests: a
+   counting loop which differs per seed, keeping RAM and the flags busy, and
+   running in the interpreter for even seeds and through basic blocks for odd ones. */
+void        EvmuTestDevice_loadWorkload (EvmuDevice* pDevice,
+                                         size_t      seed)            GBL_NOEXCEPT;
+
+// Updates the device the given number of times, 50000 ticks at a time, stopping at the first failure
+EVMU_RESULT EvmuTestDevice_run          (EvmuDevice* pDevice,
+                                         size_t      slices)          GBL_NOEXCEPT;
+
+GBL_DECLS_END
+
+#endif
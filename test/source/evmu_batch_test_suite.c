@@ -0,0 +1,213 @@
+#include "evmu_batch_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <evmu/types/evmu_batch.h>
+#include <evmu/types/evmu_journal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GBL_TEST_SUITE_SELF EvmuBatchTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuBatch* pBatch;      // emptied of lanes again by each case
+};
+
+GBL_TEST_INIT() {
+    pFixture->pBatch = EvmuBatch_create();
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    EvmuBatch_unref(pFixture->pBatch);
+    GBL_TEST_CASE_END;
+}
+
+#define EVMU_BATCH_TEST_SUITE_LANES_ 8
+
+// Loads a program shared by every lane, which branches on the lane's own input at 0x20
+static void EvmuBatchTestSuite_setup_(EvmuDevice* pDevice, size_t lane) {
+    // MOV #40, 0x10; loop: LD 0x20; AND #1; BZ odd; INC 0x12; BR next;
+    // odd: INC 0x13; next: LD 0x20; ROL; ST 0x20; DBNZ 0x10, loop; BR $
+    const EvmuWord program[] = {
+        0x22, 0x10, 0x28,
+        0x02, 0x20,
+        0xe1, 0x01,
+        0x80, 0x04,
+        0x62, 0x12,
+        0x01, 0x02,
+        0x62, 0x13,
+        0x02, 0x20,
+        0xe0,
+        0x12, 0x20,
+        0x52, 0x10, 0xec,
+        0x01, 0xfe
+    };
+
+    EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+    EvmuTestDevice_writeProgram(pDevice, 0x0000, program, sizeof(program));
+
+    EvmuMemory_writeData(pDevice->pMemory, 0x20, (EvmuWord)(0x5a ^ lane * 37));
+    EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+}
+
+#define EVMU_BATCH_TEST_SUITE_FAULT_ 0x30    // lanes with this set fail every instruction
+
+static EVMU_RESULT (*EvmuBatchTestSuite_pFnExecute_)(EvmuCpu*, const EvmuDecodedInstruction*);
+
+static EVMU_RESULT EvmuBatchTestSuite_execute_(EvmuCpu* pCpu, const EvmuDecodedInstruction* pInstr) {
+    EvmuDevice* pDevice = EvmuPeripheral_device(EVMU_PERIPHERAL(pCpu));
+
+    if(EvmuMemory_readData(pDevice->pMemory, EVMU_BATCH_TEST_SUITE_FAULT_))
+        return GBL_RESULT_ERROR_INVALID_OPERATION;
+
+    return EvmuBatchTestSuite_pFnExecute_(pCpu, pInstr);
+}
+
+GBL_TEST_CASE(lockstep) {
+    EvmuBatch*     pBatch = pFixture->pBatch;
+    EvmuDevice*    lanes [EVMU_BATCH_TEST_SUITE_LANES_];
+    EvmuDevice*    scalar[EVMU_BATCH_TEST_SUITE_LANES_];
+    EvmuBatchStats stats;
+
+    for(GblSize l = 0; l < EVMU_BATCH_TEST_SUITE_LANES_; ++l) {
+        lanes[l]  = GBL_OBJECT_NEW(EvmuDevice);
+        scalar[l] = GBL_OBJECT_NEW(EvmuDevice);
+        EvmuBatchTestSuite_setup_(lanes[l],  l);
+        EvmuBatchTestSuite_setup_(scalar[l], l);
+        GBL_TEST_CALL(EvmuBatch_addLane(pBatch, lanes[l]));
+    }
+
+    GBL_TEST_COMPARE(EvmuBatch_laneCount(pBatch), EVMU_BATCH_TEST_SUITE_LANES_);
+    GBL_TEST_COMPARE(EvmuBatch_lane(pBatch, 3), lanes[3]);
+
+    // Lanes stepped in lockstep must end up exactly where stepping each on its own does
+    for(GblSize s = 0; s < 20; ++s) {
+        GBL_TEST_CALL(EvmuBatch_update(pBatch, 50000000));
+
+        for(GblSize l = 0; l < EVMU_BATCH_TEST_SUITE_LANES_; ++l)
+            GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(scalar[l]), 50000000));
+    }
+
+    for(GblSize l = 0; l < EVMU_BATCH_TEST_SUITE_LANES_; ++l) {
+        GBL_TEST_COMPARE(EvmuCpu_pc(lanes[l]->pCpu), 0x0017);
+        GBL_TEST_COMPARE(EvmuCpu_pc(lanes[l]->pCpu), EvmuCpu_pc(scalar[l]->pCpu));
+        GBL_TEST_COMPARE(EvmuMemory_readData(lanes[l]->pMemory, 0x12) +
+                         EvmuMemory_readData(lanes[l]->pMemory, 0x13), 40);
+
+        for(EvmuAddress a = 0; a < EVMU_ADDRESS_SEGMENT_SFR_BASE; ++a)
+            GBL_TEST_COMPARE(EvmuMemory_readData(lanes[l]->pMemory, a),
+                             EvmuMemory_readData(scalar[l]->pMemory, a));
+
+        GBL_TEST_COMPARE(EvmuMemory_readData(lanes[l]->pMemory, EVMU_ADDRESS_SFR_ACC),
+                         EvmuMemory_readData(scalar[l]->pMemory, EVMU_ADDRESS_SFR_ACC));
+        GBL_TEST_COMPARE(EvmuMemory_readData(lanes[l]->pMemory, EVMU_ADDRESS_SFR_PSW),
+                         EvmuMemory_readData(scalar[l]->pMemory, EVMU_ADDRESS_SFR_PSW));
+        GBL_TEST_COMPARE(EvmuMemory_readData(lanes[l]->pMemory, EVMU_ADDRESS_SFR_T0L),
+                         EvmuMemory_readData(scalar[l]->pMemory, EVMU_ADDRESS_SFR_T0L));
+    }
+
+    // Lanes split apart on their inputs' bits, sharing decodes wherever they agree
+    EvmuBatch_stats(pBatch, &stats);
+    GBL_TEST_VERIFY(stats.divergences > 0);
+    GBL_TEST_VERIFY(stats.sharedDecodes > 0);
+    GBL_TEST_VERIFY(stats.groups < stats.instructions);
+
+    EvmuBatch_clearStats(pBatch);
+    EvmuBatch_stats(pBatch, &stats);
+    GBL_TEST_COMPARE(stats.instructions, 0);
+
+    for(GblSize l = 0; l < EVMU_BATCH_TEST_SUITE_LANES_; ++l) {
+        GBL_TEST_CALL(EvmuBatch_removeLane(pBatch, lanes[l]));
+        GBL_BOX_UNREF(lanes[l]);
+        GBL_BOX_UNREF(scalar[l]);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(journal) {
+    EvmuBatch*   pBatch   = pFixture->pBatch;
+    EvmuDevice*  pDevice  = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuJournal* pJournal = EvmuJournal_create(pDevice);
+    const size_t size     = EvmuDevice_stateSize(pDevice);
+    uint8_t*     pStates  = malloc(size * 2);
+    size_t       updates  = 0;
+
+    EvmuBatchTestSuite_setup_(pDevice, 0);
+    GBL_TEST_CALL(EvmuBatch_addLane(pBatch, pDevice));
+    GBL_TEST_CALL(EvmuJournal_record(pJournal));
+
+    // Every batch update is journaled just like updating the lane on its own
+    for(GblSize s = 0; s < 10; ++s) {
+        pDevice->pGamepad->a = (s / 3) & 1;
+        GBL_TEST_CALL(EvmuBatch_update(pBatch, 20000 + s * 1000));
+    }
+
+    GBL_TEST_CALL(EvmuJournal_stop(pJournal));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pStates, size));
+
+    for(GblSize e = 0; e < EvmuJournal_count(pJournal); ++e)
+        if(EvmuJournal_event(pJournal, e) == EVMU_JOURNAL_EVENT_UPDATE) ++updates;
+
+    GBL_TEST_COMPARE(updates, 10);
+
+    // So replaying it outside the batch lands on exactly the same state
+    GBL_TEST_CALL(EvmuBatch_removeLane(pBatch, pDevice));
+    GBL_TEST_CALL(EvmuJournal_replay(pJournal));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pStates + size, size));
+    GBL_TEST_VERIFY(memcmp(pStates, pStates + size, size) == 0);
+
+    free(pStates);
+    GBL_TEST_COMPARE(EvmuJournal_unref(pJournal), 0);
+    GBL_BOX_UNREF(pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(faults) {
+    EvmuBatch*    pBatch = pFixture->pBatch;
+    EvmuDevice*   lanes[4];
+    EvmuCpuClass* pClass;
+
+    for(GblSize l = 0; l < GBL_COUNT_OF(lanes); ++l) {
+        lanes[l] = GBL_OBJECT_NEW(EvmuDevice);
+        EvmuBatchTestSuite_setup_(lanes[l], l);
+        EvmuMemory_writeData(lanes[l]->pMemory, EVMU_BATCH_TEST_SUITE_FAULT_, l == 1 || l == 3);
+        GBL_TEST_CALL(EvmuBatch_addLane(pBatch, lanes[l]));
+    }
+
+    // Every lane shares the one class, whose execute only fails on the flagged lanes
+    pClass                         = EVMU_CPU_GET_CLASS(lanes[0]->pCpu);
+    EvmuBatchTestSuite_pFnExecute_ = pClass->pFnExecute;
+    pClass->pFnExecute             = EvmuBatchTestSuite_execute_;
+
+    // Failing lanes stop at their first instruction, without holding the others back
+    GBL_TEST_EXPECT_ERROR();
+
+    const EVMU_RESULT result = EvmuBatch_update(pBatch, 1000000000);
+
+    pClass->pFnExecute = EvmuBatchTestSuite_pFnExecute_;
+
+    GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    for(GblSize l = 0; l < GBL_COUNT_OF(lanes); ++l) {
+        if(l == 1 || l == 3) {
+            GBL_TEST_COMPARE(EvmuCpu_pc(lanes[l]->pCpu), 0x0003);
+        } else {
+            GBL_TEST_COMPARE(EvmuCpu_pc(lanes[l]->pCpu), 0x0017);
+            GBL_TEST_COMPARE(EvmuMemory_readData(lanes[l]->pMemory, 0x12) +
+                             EvmuMemory_readData(lanes[l]->pMemory, 0x13), 40);
+        }
+
+        GBL_TEST_CALL(EvmuBatch_removeLane(pBatch, lanes[l]));
+        GBL_BOX_UNREF(lanes[l]);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(lockstep,
+                  journal,
+                  faults);
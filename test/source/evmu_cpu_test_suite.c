@@ -1,10 +1,13 @@
 #include "evmu_cpu_test_suite.h"
+#include "evmu_test_device.h"
 #include <gimbal/test/gimbal_test_macros.h>
 #include <evmu/hw/evmu_device.h>
 #include <evmu/hw/evmu_isa.h>
 #include <evmu/hw/evmu_sfr.h>
 #include <evmu/hw/evmu_address_space.h>
 #include <evmu/hw/evmu_pic.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define EVMU_CPU_TEST_SUITE_(instance)  ((EvmuCpuTestSuite_*)GBL_INSTANCE_PRIVATE(instance, EVMU_CPU_TEST_SUITE_TYPE))
 
@@ -22,6 +25,15 @@ GBL_TEST_INIT() {
     pFixture->pMemory = pFixture->pDevice->pMemory;
 
     EvmuMemory_setProgramSource(pFixture->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+
+    // Lets CTest run the whole suite again under each execution backend
+    const char* pMode = getenv("EVMU_TEST_EXEC_MODE");
+
+    if(pMode && strcmp(pMode, "block") == 0)
+        GBL_TEST_CALL(EvmuCpu_setExecMode(pFixture->pCpu, EVMU_CPU_EXEC_MODE_BLOCK));
+    else if(pMode && strcmp(pMode, "jit") == 0)
+        GBL_TEST_CALL(EvmuCpu_setExecMode(pFixture->pCpu, EVMU_CPU_EXEC_MODE_JIT));
+
     GBL_TEST_CASE_END;
 }
 
@@ -30,24 +42,135 @@ GBL_TEST_FINAL() {
     GBL_TEST_CASE_END;
 }
 
+// Every execution backend available in this build
+static const EVMU_CPU_EXEC_MODE EvmuCpuTestSuite_modes_[] = {
+    EVMU_CPU_EXEC_MODE_INTERPRETER,
+    EVMU_CPU_EXEC_MODE_BLOCK,
+#ifdef EVMU_ENABLE_JIT
+    EVMU_CPU_EXEC_MODE_JIT
+#endif
+};
+
+#define EVMU_CPU_TEST_SUITE_MODE_COUNT_ (sizeof(EvmuCpuTestSuite_modes_) / sizeof(EvmuCpuTestSuite_modes_[0]))
+
+// Assembles a decoded instruction back into the bytes EvmuIsa_decode() takes apart
+static uint8_t EvmuCpuTestSuite_encode_(const EvmuDecodedInstruction* pInstr, EvmuWord* pBytes) {
+    const EvmuInstructionFormat* pFmt  = EvmuIsa_format(pInstr->opcode);
+    const EvmuOperands*          pOps  = &pInstr->operands;
+    uint32_t                     code  = 0;
+    unsigned                     shift = 0;
+
+    // Operands are packed from the last byte backwards, mirroring the decoder
+    if(EVMU_ISA_ARG_FORMAT_UNPACK(pFmt->args, EVMU_ISA_ARG1) == EVMU_ISA_ARG_TYPE_BIT_3 &&
+       EVMU_ISA_ARG_FORMAT_UNPACK(pFmt->args, EVMU_ISA_ARG2) == EVMU_ISA_ARG_TYPE_DIRECT_9)
+    {
+        if(EVMU_ISA_ARG_FORMAT_UNPACK(pFmt->args, EVMU_ISA_ARG3) == EVMU_ISA_ARG_TYPE_RELATIVE_8) {
+            code  |= (uint8_t)pOps->relative8;
+            shift += 8;
+        }
+
+        code |= (uint32_t)(pOps->direct & 0xff)      << shift;
+        code |= (uint32_t)(pOps->bit & 0x7)          << (shift + 8);
+        code |= (uint32_t)((pOps->direct >> 8) & 0x1) << (shift + 12);
+    } else {
+        for(int a = (int)EVMU_ISA_ARGC(pFmt->args) - 1; a >= 0; --a) {
+            switch(EVMU_ISA_ARG_FORMAT_UNPACK(pFmt->args, (unsigned)a)) {
+            case EVMU_ISA_ARG_TYPE_RELATIVE_8:
+                code  |= (uint32_t)(uint8_t)pOps->relative8 << shift;
+                shift += 8;
+                break;
+            case EVMU_ISA_ARG_TYPE_RELATIVE_16:
+                code  |= (uint32_t)(pOps->relative16 >> 8)  << shift;
+                code  |= (uint32_t)(pOps->relative16 & 0xff) << (shift + 8);
+                shift += 16;
+                break;
+            case EVMU_ISA_ARG_TYPE_IMMEDIATE_8:
+                code  |= (uint32_t)pOps->immediate << shift;
+                shift += 8;
+                break;
+            case EVMU_ISA_ARG_TYPE_DIRECT_9:
+                code  |= (uint32_t)(pOps->direct & 0x1ff) << shift;
+                shift += 9;
+                break;
+            case EVMU_ISA_ARG_TYPE_INDIRECT_2:
+                code  |= (uint32_t)(pOps->indirect & 0x3) << shift;
+                shift += 2;
+                break;
+            case EVMU_ISA_ARG_TYPE_ABSOLUTE_12:
+                code  |= (uint32_t)(pOps->absolute & 0x7ff)      << shift;
+                code  |= (uint32_t)((pOps->absolute >> 11) & 0x1) << (shift + 12);
+                shift += 13;
+                break;
+            case EVMU_ISA_ARG_TYPE_ABSOLUTE_16:
+                code  |= (uint32_t)pOps->absolute << shift;
+                shift += 16;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    for(uint8_t b = 0; b < pFmt->bytes; ++b)
+        pBytes[b] = (code >> (8 * (pFmt->bytes - 1 - b))) & 0xff;
+
+    pBytes[EVMU_INSTRUCTION_BYTE_OPCODE] |= pFmt->opcode;
+
+    return pFmt->bytes;
+}
+
+/* Retires a single instruction the way the fixture's exec mode would. Outside of
+   the interpreter, it's assembled just behind the PC and run as a block of its own,
+   ended by a T0L read, leaving the PC wherever EvmuCpu_execute() would have. */
+static EVMU_RESULT EvmuCpuTestSuite_execute_(GblTestSuite* pSelf, const EvmuDecodedInstruction* pInstr) {
+    GBL_CTX_BEGIN(pSelf);
+
+    EvmuCpuTestSuite_* pFixture = EVMU_CPU_TEST_SUITE_(pSelf);
+
+    // The emulated BIOS takes over anything running from ROM, so it can only be executed directly
+    if(EvmuCpu_execMode(pFixture->pCpu) == EVMU_CPU_EXEC_MODE_INTERPRETER ||
+       EvmuMemory_programSource(pFixture->pMemory) == EVMU_MEMORY_EXT_SRC_ROM)
+    {
+        GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pCpu, pInstr));
+    } else {
+        EvmuWord          code[EVMU_INSTRUCTION_BYTE_MAX + 2] = { 0 };
+        EvmuWord          saved[EVMU_INSTRUCTION_BYTE_MAX + 2];
+        const uint8_t     bytes = EvmuCpuTestSuite_encode_(pInstr, code);
+        const EvmuAddress start = (EvmuPc)(EvmuCpu_pc(pFixture->pCpu) - bytes);
+
+        code[bytes]     = EVMU_OPCODE_LD | (EVMU_ADDRESS_SFR_T0L >> 8);
+        code[bytes + 1] = EVMU_ADDRESS_SFR_T0L & 0xff;
+
+        for(uint8_t b = 0; b < bytes + 2; ++b)
+            saved[b] = EvmuMemory_readProgram(pFixture->pMemory, start + b);
+
+        EvmuTestDevice_writeProgram(pFixture->pDevice, start, code, bytes + 2);
+        EvmuCpu_setPc(pFixture->pCpu, start);
+        EvmuDevice_runUntil(pFixture->pDevice, 1, EVMU_DEVICE_STOP_NONE, NULL);
+        EvmuTestDevice_writeProgram(pFixture->pDevice, start, saved, bytes + 2);
+    }
+
+    GBL_CTX_END();
+}
+
 GBL_TEST_CASE(nop) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_NOP,
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_NOP,
+                                                  }));
     GBL_TEST_CASE_END;
 }
 
 GBL_TEST_CASE(ld) {
     EvmuMemory_writeData(pFixture->pDevice->pMemory, 0x2, 27);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_LD,
-                                            .operands = {
-                                                .direct = 0x2
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_LD,
+                                                      .operands = {
+                                                          .direct = 0x2
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pDevice->pMemory, EVMU_ADDRESS_SFR_ACC), 27);
 
@@ -59,13 +182,13 @@ GBL_TEST_CASE(ldInd) {
     const EvmuAddress ind = EvmuMemory_indirectAddress(pFixture->pMemory, 3);
 
     EvmuMemory_writeData(pFixture->pMemory, ind, 0xab);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_LD_IND,
-                                            .operands = {
-                                                .indirect = 3
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_LD_IND,
+                                                      .operands = {
+                                                          .indirect = 3
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pDevice->pMemory,
                                         EVMU_ADDRESS_SFR_ACC), 0xab);
@@ -75,13 +198,13 @@ GBL_TEST_CASE(ldInd) {
 GBL_TEST_CASE(st) {
     EvmuMemory_writeData(pFixture->pDevice->pMemory, EVMU_ADDRESS_SFR_ACC, 128);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_ST,
-                                            .operands = {
-                                                .direct = 3
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_ST,
+                                                      .operands = {
+                                                          .direct = 3
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pDevice->pMemory, 3), 128);
 
@@ -91,13 +214,13 @@ GBL_TEST_CASE(st) {
 GBL_TEST_CASE(stInd) {
     EvmuMemory_writeData(pFixture->pDevice->pMemory, EVMU_ADDRESS_SFR_ACC, 129);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_ST_IND,
-                                            .operands = {
-                                                .indirect = 2
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_ST_IND,
+                                                      .operands = {
+                                                          .indirect = 2
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory,
                                         EvmuMemory_indirectAddress(pFixture->pMemory, 2)), 129);
@@ -106,14 +229,14 @@ GBL_TEST_CASE(stInd) {
 }
 
 GBL_TEST_CASE(mov) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_MOV,
-                                            .operands = {
-                                                .direct = 4,
-                                                .immediate = 255
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_MOV,
+                                                      .operands = {
+                                                          .direct = 4,
+                                                          .immediate = 255
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pDevice->pMemory, 4), 255);
 
@@ -121,14 +244,14 @@ GBL_TEST_CASE(mov) {
 }
 
 GBL_TEST_CASE(movInd) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_MOV_IND,
-                                            .operands = {
-                                                .indirect  = 3,
-                                                .immediate = 245
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_MOV_IND,
+                                                      .operands = {
+                                                          .indirect  = 3,
+                                                          .immediate = 245
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory,
                                         EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 245);
@@ -138,13 +261,13 @@ GBL_TEST_CASE(movInd) {
 
 
 GBL_TEST_CASE(push) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_PUSH,
-                                            .operands = {
-                                                .direct = 3,
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_PUSH,
+                                                      .operands = {
+                                                          .direct = 3,
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_viewStack(pFixture->pDevice->pMemory, 0), 128);
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 1);
@@ -153,13 +276,13 @@ GBL_TEST_CASE(push) {
 }
 
 GBL_TEST_CASE(pop) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_POP,
-                                            .operands = {
-                                                .direct = 5,
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_POP,
+                                                      .operands = {
+                                                          .direct = 5,
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_viewData(pFixture->pDevice->pMemory, 5), 128);
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 0);
@@ -171,13 +294,13 @@ GBL_TEST_CASE(pop) {
 GBL_TEST_CASE(br) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BR,
-                                            .operands = {
-                                                .relative8 = 5
-                                            }
-                                         }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BR,
+                                                      .operands = {
+                                                          .relative8 = 5
+                                                      }
+                                                   }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc+5);
 
@@ -187,13 +310,13 @@ GBL_TEST_CASE(br) {
 GBL_TEST_CASE(brf) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BRF,
-                                            .operands = {
-                                                .relative16 = 0x10ab
-                                            }
-                                         }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BRF,
+                                                      .operands = {
+                                                          .relative16 = 0x10ab
+                                                      }
+                                                   }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc+0x10ab-1);
 
@@ -201,13 +324,13 @@ GBL_TEST_CASE(brf) {
 }
 
 GBL_TEST_CASE(jmp) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_JMP,
-                                            .operands = {
-                                                .absolute = 0xabc
-                                            }
-                                         }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_JMP,
+                                                      .operands = {
+                                                          .absolute = 0xabc
+                                                      }
+                                                   }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), 0x1abc);
 
@@ -216,13 +339,13 @@ GBL_TEST_CASE(jmp) {
 
 
 GBL_TEST_CASE(jmpf) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_JMPF,
-                                            .operands = {
-                                                .absolute = 0xabc
-                                            }
-                                         }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_JMPF,
+                                                      .operands = {
+                                                          .absolute = 0xabc
+                                                      }
+                                                   }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), 0xabc);
 
@@ -232,13 +355,13 @@ GBL_TEST_CASE(jmpf) {
 GBL_TEST_CASE(call) {
     EvmuCpu_setPc(pFixture->pDevice->pCpu, 0xbabe);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_CALL,
-                                            .operands = {
-                                                .absolute = 0xdead,
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_CALL,
+                                                      .operands = {
+                                                          .absolute = 0xdead,
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 2);
     GBL_TEST_COMPARE(EvmuMemory_viewStack(pFixture->pDevice->pMemory, 1), 0xbe);
@@ -252,13 +375,13 @@ GBL_TEST_CASE(call) {
 GBL_TEST_CASE(callr) {
     EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_CALLR,
-                                            .operands = {
-                                                .relative16 = 0x1f1
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_CALLR,
+                                                      .operands = {
+                                                          .relative16 = 0x1f1
+                                                      }
+                                                  }));
     pc += 0x1f1-1;
     pc %= UINT16_MAX;
 
@@ -273,13 +396,13 @@ GBL_TEST_CASE(callr) {
 GBL_TEST_CASE(callf) {
     EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_CALLF,
-                                            .operands = {
-                                                .absolute = 0x00a
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_CALLF,
+                                                      .operands = {
+                                                          .absolute = 0x00a
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 6);
     GBL_TEST_COMPARE(EvmuMemory_viewStack(pFixture->pDevice->pMemory, 1), pc&0xff);
@@ -290,23 +413,23 @@ GBL_TEST_CASE(callf) {
 }
 
 GBL_TEST_CASE(ret) {
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_RET
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_RET
+                                                  }));
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 4);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_RET
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_RET
+                                                  }));
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 2);
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pDevice->pCpu), 0xbead);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_RET
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_RET
+                                                  }));
     GBL_TEST_COMPARE(EvmuMemory_stackDepth(pFixture->pDevice->pMemory), 0);
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pDevice->pCpu), 0xbabe);
 
@@ -319,26 +442,26 @@ GBL_TEST_CASE(bei) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 44);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BEI,
-                                            .operands = {
-                                                .immediate = 44,
-                                                .relative8 = -17
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BEI,
+                                                      .operands = {
+                                                          .immediate = 44,
+                                                          .relative8 = -17
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), 0xbabe - 17);
     GBL_TEST_VERIFY(!(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK));
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 33);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BEI,
-                                            .operands = {
-                                                .immediate = 44,
-                                                .relative8 = -17
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BEI,
+                                                      .operands = {
+                                                          .immediate = 44,
+                                                          .relative8 = -17
+                                                      }
+                                                  }));
     GBL_TEST_VERIFY(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK);
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), 0xbabe - 17);
 
@@ -354,28 +477,28 @@ GBL_TEST_CASE(be) {
 
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BE,
-                                            .operands = {
-                                                .direct = 0xad,
-                                                .relative8 = 22
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BE,
+                                                      .operands = {
+                                                          .direct = 0xad,
+                                                          .relative8 = 22
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 22);
     GBL_TEST_VERIFY(!(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK));
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 60);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BE,
-                                            .operands = {
-                                                .direct = 0xad,
-                                                .relative8 = 22
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BE,
+                                                      .operands = {
+                                                          .direct = 0xad,
+                                                          .relative8 = 22
+                                                      }
+                                                  }));
     GBL_TEST_VERIFY(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK);
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 22);
 
@@ -390,28 +513,28 @@ GBL_TEST_CASE(beInd) {
 
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BE_IND,
-                                            .operands = {
-                                                .indirect = 3,
-                                                .immediate = 77,
-                                                .relative8 = -128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BE_IND,
+                                                      .operands = {
+                                                          .indirect = 3,
+                                                          .immediate = 77,
+                                                          .relative8 = -128
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc - 128);
     GBL_TEST_VERIFY(!(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK));
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BE_IND,
-                                            .operands = {
-                                                .indirect = 3,
-                                                .immediate = 78,
-                                                .relative8 = -128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BE_IND,
+                                                      .operands = {
+                                                          .indirect = 3,
+                                                          .immediate = 78,
+                                                          .relative8 = -128
+                                                      }
+                                                  }));
     GBL_TEST_VERIFY(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK);
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc - 128);
 
@@ -426,26 +549,26 @@ GBL_TEST_CASE(bnei) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 43);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BNEI,
-                                            .operands = {
-                                                .immediate = 44,
-                                                .relative8 = -17
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BNEI,
+                                                      .operands = {
+                                                          .immediate = 44,
+                                                          .relative8 = -17
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc - 17);
     GBL_TEST_VERIFY(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK);
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 44);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BNEI,
-                                            .operands = {
-                                                .immediate = 44,
-                                                .relative8 = -17
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BNEI,
+                                                      .operands = {
+                                                          .immediate = 44,
+                                                          .relative8 = -17
+                                                      }
+                                                  }));
 
     GBL_TEST_VERIFY(!(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc - 17);
@@ -462,28 +585,28 @@ GBL_TEST_CASE(bne) {
 
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BNE,
-                                            .operands = {
-                                                .direct = 0xad,
-                                                .relative8 = 22
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BNE,
+                                                      .operands = {
+                                                          .direct = 0xad,
+                                                          .relative8 = 22
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 22);
     GBL_TEST_VERIFY(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK);
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 80);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BNE,
-                                            .operands = {
-                                                .direct = 0xad,
-                                                .relative8 = 22
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BNE,
+                                                      .operands = {
+                                                          .direct = 0xad,
+                                                          .relative8 = 22
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 22);
     GBL_TEST_VERIFY(!(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK));
 
@@ -498,28 +621,28 @@ GBL_TEST_CASE(bneInd) {
 
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BNE_IND,
-                                            .operands = {
-                                                .indirect = 3,
-                                                .immediate = 77,
-                                                .relative8 = -128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BNE_IND,
+                                                      .operands = {
+                                                          .indirect = 3,
+                                                          .immediate = 77,
+                                                          .relative8 = -128
+                                                      }
+                                                  }));
 
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc - 128);
     GBL_TEST_VERIFY(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BNE_IND,
-                                            .operands = {
-                                                .indirect = 3,
-                                                .immediate = 76,
-                                                .relative8 = -128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BNE_IND,
+                                                      .operands = {
+                                                          .indirect = 3,
+                                                          .immediate = 76,
+                                                          .relative8 = -128
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc - 128);
     GBL_TEST_VERIFY(!(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_PSW) & EVMU_SFR_PSW_CY_MASK));
 
@@ -530,26 +653,26 @@ GBL_TEST_CASE(bp) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x3, 0xf8);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BP,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 7,
-                                                .relative8 = 127
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BP,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 7,
+                                                          .relative8 = 127
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BP,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 1,
-                                                .relative8 = 128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BP,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 1,
+                                                          .relative8 = 128
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
 
     GBL_TEST_CASE_END;
@@ -559,28 +682,28 @@ GBL_TEST_CASE(bpc) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x3, 0xff);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BPC,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 7,
-                                                .relative8 = 127
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BPC,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 7,
+                                                          .relative8 = 127
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x3), 0x7f);
 
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BPC,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 7,
-                                                .relative8 = 128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BPC,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 7,
+                                                          .relative8 = 128
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x3), 0x7f);
 
@@ -591,26 +714,26 @@ GBL_TEST_CASE(bn) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x3, 0x7f);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BN,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 7,
-                                                .relative8 = 127
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BN,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 7,
+                                                          .relative8 = 127
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BN,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 6,
-                                                .relative8 = 128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BN,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 6,
+                                                          .relative8 = 128
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
 
     GBL_TEST_CASE_END;
@@ -620,25 +743,25 @@ GBL_TEST_CASE(bz) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BZ,
-                                            .operands = {
-                                                .relative8 = 127
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BZ,
+                                                      .operands = {
+                                                          .relative8 = 127
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x1);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_BZ,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .bit       = 6,
-                                                .relative8 = 128
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_BZ,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .bit       = 6,
+                                                          .relative8 = 128
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 127);
 
     GBL_TEST_CASE_END;
@@ -648,24 +771,24 @@ GBL_TEST_CASE(dbnz) {
     const EvmuAddress pc = EvmuCpu_pc(pFixture->pCpu);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x3, 0x2);
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_DBNZ,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .relative8 = 11
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_DBNZ,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .relative8 = 11
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 11);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_DBNZ,
-                                            .operands = {
-                                                .direct    = 0x3,
-                                                .relative8 = 11
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_DBNZ,
+                                                      .operands = {
+                                                          .direct    = 0x3,
+                                                          .relative8 = 11
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 11);
 
     GBL_TEST_CASE_END;
@@ -677,24 +800,24 @@ GBL_TEST_CASE(dbnzInd) {
     EvmuMemory_writeData(pFixture->pMemory,
                         EvmuMemory_indirectAddress(pFixture->pMemory, 2), 0x2);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_DBNZ_IND,
-                                            .operands = {
-                                                .indirect  = 2,
-                                                .relative8 = 12
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_DBNZ_IND,
+                                                      .operands = {
+                                                          .indirect  = 2,
+                                                          .relative8 = 12
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 12);
 
-    GBL_CTX_VERIFY_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                        &(const EvmuDecodedInstruction) {
-                                            .opcode = EVMU_OPCODE_DBNZ_IND,
-                                            .operands = {
-                                                .indirect  = 2,
-                                                .relative8 = 12
-                                            }
-                                        }));
+    GBL_CTX_VERIFY_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                  &(const EvmuDecodedInstruction) {
+                                                      .opcode = EVMU_OPCODE_DBNZ_IND,
+                                                      .operands = {
+                                                          .indirect  = 2,
+                                                          .relative8 = 12
+                                                      }
+                                                  }));
     GBL_TEST_COMPARE(EvmuCpu_pc(pFixture->pCpu), pc + 12);
 
     GBL_TEST_CASE_END;
@@ -728,49 +851,49 @@ GBL_TEST_CASE(addi) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
 
     // Add immediate with no flags set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDI,
-                                      .operands = {
-                                          .immediate = 0x13
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDI,
+                                                .operands = {
+                                                    .immediate = 0x13
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x68);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
     // Add immediate with AC set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDI,
-                                      .operands = {
-                                          .immediate = 0xa
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDI,
+                                                .operands = {
+                                                    .immediate = 0xa
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x72);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     // Add immediate with AC and OV set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDI,
-                                      .operands = {
-                                          .immediate = 0xf
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDI,
+                                                .operands = {
+                                                    .immediate = 0xf
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x81);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     // Add immediate with CY and OV set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDI,
-                                      .operands = {
-                                          .immediate = 0x80
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDI,
+                                                .operands = {
+                                                    .immediate = 0x80
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
@@ -785,52 +908,52 @@ GBL_TEST_CASE(add) {
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x13);
 
     // Add direct with no flags set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x68);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
     // Add direct with AC set
     EvmuMemory_writeData(pFixture->pMemory, 0x69, 0xa);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD,
-                                      .operands = {
-                                          .direct = 0x69
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD,
+                                                .operands = {
+                                                    .direct = 0x69
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x72);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     // Add direct with AC and OV set
     EvmuMemory_writeData(pFixture->pMemory, 0x70, 0xf);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD,
-                                      .operands = {
-                                          .direct = 0x70
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD,
+                                                .operands = {
+                                                    .direct = 0x70
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x81);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     // Add direct with CY and OV set
     EvmuMemory_writeData(pFixture->pMemory, 0x71, 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD,
-                                      .operands = {
-                                          .direct = 0x71
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD,
+                                                .operands = {
+                                                    .direct = 0x71
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
@@ -844,52 +967,52 @@ GBL_TEST_CASE(addInd) {
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x13);
 
     // Add indirect with no flags set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x68);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
     // Add indirect with AC set
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xa);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x72);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     // Add indirect with AC and OV set
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xf);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x81);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     // Add indirect with CY and OV set
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADD_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADD_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
@@ -904,62 +1027,62 @@ GBL_TEST_CASE(addci) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
 
     // Addc immediate with no flags set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDCI,
-                                      .operands = {
-                                          .immediate = 0x13
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDCI,
+                                                .operands = {
+                                                    .immediate = 0x13
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x68);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
     // Addc immediate with AC set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDCI,
-                                      .operands = {
-                                          .immediate = 0xa
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDCI,
+                                                .operands = {
+                                                    .immediate = 0xa
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x72);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     // Addc immediate with AC and OV set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDCI,
-                                      .operands = {
-                                          .immediate = 0xf
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDCI,
+                                                .operands = {
+                                                    .immediate = 0xf
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x81);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     // Addc immediate with CY and OV set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDCI,
-                                      .operands = {
-                                          .immediate = 0x80
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDCI,
+                                                .operands = {
+                                                    .immediate = 0x80
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
 
     // Addc immediate with CY in
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDCI,
-                                      .operands = {
-                                          .immediate = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDCI,
+                                                .operands = {
+                                                    .immediate = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
@@ -975,65 +1098,65 @@ GBL_TEST_CASE(addc) {
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x13);
 
     // Addc with no flags set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x68);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
     // Addc with AC set
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0xa);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x72);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     // Addc with AC and OV set
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0xf);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x81);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     // Addc with CY and OV set
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
     // addc 0x68: accum: 0x1, CY = 1 => mem[0x68] = 3
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x1);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
@@ -1047,52 +1170,52 @@ GBL_TEST_CASE(addcInd) {    // ACC initial value
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x13);
 
     // Addc indirect with no flags set
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x68);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
     // Addc indirect with AC set
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xa);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x72);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     // Addc indirect with AC and OV set
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xf);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x81);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     // Addc indirect with CY and OV set
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
@@ -1100,13 +1223,13 @@ GBL_TEST_CASE(addcInd) {    // ACC initial value
 
     // Addc indirect with CY in
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x1);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ADDC_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ADDC_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
@@ -1119,24 +1242,24 @@ GBL_TEST_CASE(subi) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBI,
-                                      .operands = {
-                                          .immediate = 0xc
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBI,
+                                                .operands = {
+                                                    .immediate = 0xc
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x49);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBI,
-                                      .operands = {
-                                          .immediate = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBI,
+                                                .operands = {
+                                                    .immediate = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
@@ -1144,23 +1267,23 @@ GBL_TEST_CASE(subi) {
     GBL_TEST_CALL(clearPswFlags_(pSelf));
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBI,
-                                      .operands = {
-                                          .immediate = 0x2
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBI,
+                                                .operands = {
+                                                    .immediate = 0x2
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7e);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBI,
-                                      .operands = {
-                                          .immediate = 0x95
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBI,
+                                                .operands = {
+                                                    .immediate = 0x95
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe9);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
@@ -1173,25 +1296,25 @@ GBL_TEST_CASE(sub) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0xc);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x49);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x68);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
@@ -1200,24 +1323,24 @@ GBL_TEST_CASE(sub) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x80);
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x2);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7e);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x95);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe9);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
@@ -1230,25 +1353,25 @@ GBL_TEST_CASE(subInd) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xc);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x49);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x68);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
@@ -1257,24 +1380,24 @@ GBL_TEST_CASE(subInd) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x80);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x2);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7e);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x95);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUB_IND,
-                                      .operands = {
-                                          .indirect = 1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUB_IND,
+                                                .operands = {
+                                                    .indirect = 1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe9);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
@@ -1286,24 +1409,24 @@ GBL_TEST_CASE(subci) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBCI,
-                                      .operands = {
-                                          .immediate = 0xc
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBCI,
+                                                .operands = {
+                                                    .immediate = 0xc
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x49);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBCI,
-                                      .operands = {
-                                          .immediate = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBCI,
+                                                .operands = {
+                                                    .immediate = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
@@ -1311,23 +1434,23 @@ GBL_TEST_CASE(subci) {
     GBL_TEST_CALL(clearPswFlags_(pSelf));
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBCI,
-                                      .operands = {
-                                          .immediate = 0x2
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBCI,
+                                                .operands = {
+                                                    .immediate = 0x2
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7e);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBCI,
-                                      .operands = {
-                                          .immediate = 0x95
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBCI,
+                                                .operands = {
+                                                    .immediate = 0x95
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe9);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
@@ -1340,25 +1463,25 @@ GBL_TEST_CASE(subc) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0xc);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x49);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x68);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
@@ -1367,24 +1490,24 @@ GBL_TEST_CASE(subc) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x80);
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x2);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7e);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     EvmuMemory_writeData(pFixture->pMemory, 0x68, 0x95);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC,
-                                      .operands = {
-                                          .direct = 0x68
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC,
+                                                .operands = {
+                                                    .direct = 0x68
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe9);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
@@ -1397,25 +1520,25 @@ GBL_TEST_CASE(subcInd) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xc);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x49);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_FALSE));
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x68);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
@@ -1424,24 +1547,24 @@ GBL_TEST_CASE(subcInd) {
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x80);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x2);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7e);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_TRUE, GBL_TRUE));
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x95);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SUBC_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SUBC_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xe9);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_TRUE));
 
@@ -1455,10 +1578,10 @@ GBL_TEST_CASE(mul) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_C,   0x23);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_B,   0x52);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_MUL
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_MUL
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x7d);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_C),   0x36);
@@ -1472,10 +1595,10 @@ GBL_TEST_CASE(mul) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_C,   0x5);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_B,   0x10);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_MUL
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_MUL
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x70);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_C),   0x50);
@@ -1493,10 +1616,10 @@ GBL_TEST_CASE(div) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_C,   0x5);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_B,   0x7);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DIV
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DIV
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x11);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_C),   0x49);
@@ -1510,10 +1633,10 @@ GBL_TEST_CASE(div) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_C,   0x10);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_B,   0x0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DIV
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DIV
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_C),   0x10);
@@ -1527,23 +1650,23 @@ GBL_TEST_CASE(div) {
 GBL_TEST_CASE(andi) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0xff);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ANDI,
-                                      .operands = {
-                                          .immediate = 0x55
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ANDI,
+                                                .operands = {
+                                                    .immediate = 0x55
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x55);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ANDI,
-                                      .operands = {
-                                          .immediate = 0xaa
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ANDI,
+                                                .operands = {
+                                                    .immediate = 0xaa
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x00);
 
@@ -1554,24 +1677,24 @@ GBL_TEST_CASE(and) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0xff);
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x55);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_AND,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_AND,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x55);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xaa);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_AND,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_AND,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x00);
 
@@ -1582,24 +1705,24 @@ GBL_TEST_CASE(andInd) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0xff);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x55);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_AND_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_AND_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x55);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xaa);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_AND_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_AND_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x00);
 
@@ -1609,44 +1732,44 @@ GBL_TEST_CASE(andInd) {
 GBL_TEST_CASE(ori) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ORI,
-                                      .operands = {
-                                          .immediate = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ORI,
+                                                .operands = {
+                                                    .immediate = 0x3
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ORI,
-                                      .operands = {
-                                          .immediate = 0xc
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ORI,
+                                                .operands = {
+                                                    .immediate = 0xc
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf);
 
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ORI,
-                                      .operands = {
-                                          .immediate = 0x30
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ORI,
+                                                .operands = {
+                                                    .immediate = 0x30
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3f);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ORI,
-                                      .operands = {
-                                          .immediate = 0xc0
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ORI,
+                                                .operands = {
+                                                    .immediate = 0xc0
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
 
@@ -1657,46 +1780,46 @@ GBL_TEST_CASE(or) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x3);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xc);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x30);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3f);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xc0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
 
@@ -1707,46 +1830,46 @@ GBL_TEST_CASE(orInd) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x3);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xc);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0x30);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3f);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xc0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_OR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_OR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
 
@@ -1756,41 +1879,41 @@ GBL_TEST_CASE(orInd) {
 GBL_TEST_CASE(xori) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XORI,
-                                      .operands = {
-                                          .immediate = 0xf
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XORI,
+                                                .operands = {
+                                                    .immediate = 0xf
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XORI,
-                                      .operands = {
-                                          .immediate = 0xf0
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XORI,
+                                                .operands = {
+                                                    .immediate = 0xf0
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XORI,
-                                      .operands = {
-                                          .immediate = 0xf
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XORI,
+                                                .operands = {
+                                                    .immediate = 0xf
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XORI,
-                                      .operands = {
-                                          .immediate = 0xf0
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XORI,
+                                                .operands = {
+                                                    .immediate = 0xf0
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x00);
 
     GBL_TEST_CASE_END;
@@ -1800,44 +1923,44 @@ GBL_TEST_CASE(xor) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xf);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xf);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf0);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x00);
 
     GBL_TEST_CASE_END;
@@ -1847,44 +1970,44 @@ GBL_TEST_CASE(xorInd) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xf);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xf);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xf0);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XOR_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XOR_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x00);
 
     GBL_TEST_CASE_END;
@@ -1893,16 +2016,16 @@ GBL_TEST_CASE(xorInd) {
 GBL_TEST_CASE(rol) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x55);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROL
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROL
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xaa);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROL
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROL
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x55);
 
     GBL_TEST_CASE_END;
@@ -1912,32 +2035,32 @@ GBL_TEST_CASE(rolc) {
     clearPswFlags_(pSelf);
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x60);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROLC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROLC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xc0);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROLC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROLC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x80);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROLC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROLC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
 
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROLC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROLC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
@@ -1947,16 +2070,16 @@ GBL_TEST_CASE(rolc) {
 GBL_TEST_CASE(ror) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x1);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROR
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROR
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x80);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_ROR
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_ROR
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x40);
 
     GBL_TEST_CASE_END;
@@ -1966,32 +2089,32 @@ GBL_TEST_CASE(rorc) {
     clearPswFlags_(pSelf);
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x6);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_RORC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_RORC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x3);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_RORC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_RORC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x1);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_RORC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_RORC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x80);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_TRUE, GBL_FALSE, GBL_FALSE));
 
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_RORC
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_RORC
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xc0);
     GBL_TEST_CALL(testPswFlags_(pSelf, GBL_FALSE, GBL_FALSE, GBL_FALSE));
 
@@ -2002,34 +2125,34 @@ GBL_TEST_CASE(inc) {
     clearPswFlags_(pSelf);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_INC,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_INC,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x1);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_INC,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_INC,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0xf1);
 
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xff);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_INC,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_INC,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x0);
 
     GBL_TEST_CASE_END;
@@ -2039,38 +2162,38 @@ GBL_TEST_CASE(incInd) {
     clearPswFlags_(pSelf);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3), 0x0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_INC_IND,
-                                      .operands = {
-                                          .indirect = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_INC_IND,
+                                                .operands = {
+                                                    .indirect = 0x3
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory,
                                         EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 0x1);
 
     EvmuMemory_writeData(pFixture->pMemory,
                         EvmuMemory_indirectAddress(pFixture->pMemory, 3), 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_INC_IND,
-                                      .operands = {
-                                          .indirect = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_INC_IND,
+                                                .operands = {
+                                                    .indirect = 0x3
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory,
                                         EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 0xf1);
 
 
     EvmuMemory_writeData(pFixture->pMemory,
                         EvmuMemory_indirectAddress(pFixture->pMemory, 3), 0xff);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_INC_IND,
-                                      .operands = {
-                                          .indirect = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_INC_IND,
+                                                .operands = {
+                                                    .indirect = 0x3
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory,
                                         EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 0x0);
 
@@ -2081,34 +2204,34 @@ GBL_TEST_CASE(dec) {
     clearPswFlags_(pSelf);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x2);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DEC,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DEC,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x1);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DEC,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DEC,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0xef);
 
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DEC,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DEC,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0xff);
 
     GBL_TEST_CASE_END;
@@ -2118,34 +2241,34 @@ GBL_TEST_CASE(decInd) {
     clearPswFlags_(pSelf);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3), 0x2);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DEC_IND,
-                                      .operands = {
-                                          .indirect = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DEC_IND,
+                                                .operands = {
+                                                    .indirect = 0x3
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 0x1);
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3), 0xf0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DEC_IND,
-                                      .operands = {
-                                          .indirect = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DEC_IND,
+                                                .operands = {
+                                                    .indirect = 0x3
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 0xef);
 
 
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3), 0x0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_DEC_IND,
-                                      .operands = {
-                                          .indirect = 0x3
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_DEC_IND,
+                                                .operands = {
+                                                    .indirect = 0x3
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 3)), 0xff);
 
     GBL_TEST_CASE_END;
@@ -2155,13 +2278,13 @@ GBL_TEST_CASE(xch) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x33);
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0xff);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XCH,
-                                      .operands = {
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XCH,
+                                                .operands = {
+                                                    .direct = 0x23
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x33);
@@ -2173,13 +2296,13 @@ GBL_TEST_CASE(xchInd) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x33);
     EvmuMemory_writeData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1), 0xff);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_XCH_IND,
-                                      .operands = {
-                                          .indirect = 0x1
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_XCH_IND,
+                                                .operands = {
+                                                    .indirect = 0x1
+                                                }
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0xff);
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EvmuMemory_indirectAddress(pFixture->pMemory, 1)), 0x33);
@@ -2189,25 +2312,25 @@ GBL_TEST_CASE(xchInd) {
 
 GBL_TEST_CASE(clr1) {
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x1);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_CLR1,
-                                      .operands = {
-                                          .bit = 0x0,
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_CLR1,
+                                                .operands = {
+                                                    .bit = 0x0,
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x0);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_CLR1,
-                                      .operands = {
-                                          .bit = 0x7,
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_CLR1,
+                                                .operands = {
+                                                    .bit = 0x7,
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x00);
 
     GBL_TEST_CASE_END;
@@ -2215,25 +2338,25 @@ GBL_TEST_CASE(clr1) {
 
 GBL_TEST_CASE(set1) {
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SET1,
-                                      .operands = {
-                                          .bit = 0x0,
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SET1,
+                                                .operands = {
+                                                    .bit = 0x0,
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x1);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x00);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_SET1,
-                                      .operands = {
-                                          .bit = 0x7,
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_SET1,
+                                                .operands = {
+                                                    .bit = 0x7,
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x80);
 
     GBL_TEST_CASE_END;
@@ -2241,25 +2364,25 @@ GBL_TEST_CASE(set1) {
 
 GBL_TEST_CASE(not1) {
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_NOT1,
-                                      .operands = {
-                                          .bit = 0x0,
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_NOT1,
+                                                .operands = {
+                                                    .bit = 0x0,
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x1);
 
     EvmuMemory_writeData(pFixture->pMemory, 0x23, 0x80);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_NOT1,
-                                      .operands = {
-                                          .bit = 0x7,
-                                          .direct = 0x23
-                                      }
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_NOT1,
+                                                .operands = {
+                                                    .bit = 0x7,
+                                                    .direct = 0x23
+                                                }
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, 0x23), 0x0);
 
     GBL_TEST_CASE_END;
@@ -2273,10 +2396,10 @@ GBL_TEST_CASE(ldc) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, 0x23);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_LDC,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_LDC,
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x77);
 
@@ -2287,10 +2410,10 @@ GBL_TEST_CASE(ldc) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, 0x23);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_LDC,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_LDC,
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x33);
 
@@ -2303,10 +2426,10 @@ GBL_TEST_CASE(reti) {
 
     GBL_TEST_COMPARE(EvmuPic_irqsActiveDepth(pFixture->pDevice->pPic), 1);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_RETI,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_RETI,
+                                            }));
 
     GBL_TEST_COMPARE(EvmuPic_irqsActiveDepth(pFixture->pDevice->pPic), 0);
 
@@ -2320,10 +2443,10 @@ GBL_TEST_CASE(ldf) {
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRH, 0xab);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, 0xcd);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_LDF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_LDF,
+                                            }));
 
     GBL_TEST_COMPARE(EvmuMemory_readData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC), 0x89);
 
@@ -2342,30 +2465,30 @@ static GBL_RESULT stfUnlockToState_(GblTestSuite* pSelf, EVMU_FLASH_PROGRAM_STAT
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRH, (EVMU_FLASH_PROGRAM_STATE_0_ADDRESS & 0xff00)>>8);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, EVMU_FLASH_PROGRAM_STATE_0_ADDRESS & 0xff);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, EVMU_FLASH_PROGRAM_STATE_0_VALUE);
-        GBL_TEST_CALL(EvmuCpu_execute(pFixture->pCpu,
-                                      &(const EvmuDecodedInstruction) {
-                                          .opcode = EVMU_OPCODE_STF,
-                                      }));
+        GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                &(const EvmuDecodedInstruction) {
+                                                    .opcode = EVMU_OPCODE_STF,
+                                                }));
     }
 
     if(state >= EVMU_FLASH_PROGRAM_STATE_1) {
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRH, (EVMU_FLASH_PROGRAM_STATE_1_ADDRESS & 0xff00)>>8);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, EVMU_FLASH_PROGRAM_STATE_1_ADDRESS & 0xff);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, EVMU_FLASH_PROGRAM_STATE_1_VALUE);
-        GBL_TEST_CALL(EvmuCpu_execute(pFixture->pCpu,
-                                      &(const EvmuDecodedInstruction) {
-                                          .opcode = EVMU_OPCODE_STF,
-                                      }));
+        GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                &(const EvmuDecodedInstruction) {
+                                                    .opcode = EVMU_OPCODE_STF,
+                                                }));
     }
 
     if(state >= EVMU_FLASH_PROGRAM_STATE_2) {
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRH, (EVMU_FLASH_PROGRAM_STATE_2_ADDRESS & 0xff00)>>8);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, EVMU_FLASH_PROGRAM_STATE_2_ADDRESS & 0xff);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, EVMU_FLASH_PROGRAM_STATE_2_VALUE);
-        GBL_TEST_CALL(EvmuCpu_execute(pFixture->pCpu,
-                                      &(const EvmuDecodedInstruction) {
-                                          .opcode = EVMU_OPCODE_STF,
-                                      }));
+        GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                &(const EvmuDecodedInstruction) {
+                                                    .opcode = EVMU_OPCODE_STF,
+                                                }));
     }
 
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRH, oldTrh);
@@ -2388,60 +2511,60 @@ GBL_TEST_CASE(stf) {
     EvmuMemory_setProgramSource(pFixture->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 0x0);
 
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write without unlocking
     EvmuMemory_setProgramSource(pFixture->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write at state 0
     EvmuMemory_setProgramSource(pFixture->pMemory, EVMU_MEMORY_EXT_SRC_ROM);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_FPR, 0x1|EVMU_SFR_FPR_UNLOCK_MASK);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write at state 1
     GBL_TEST_CALL(stfUnlockToState_(pSelf, EVMU_FLASH_PROGRAM_STATE_0));
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write at state 2
     GBL_TEST_CALL(stfUnlockToState_(pSelf, EVMU_FLASH_PROGRAM_STATE_1));
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write when done but still unlocked
     GBL_TEST_CALL(stfUnlockToState_(pSelf, EVMU_FLASH_PROGRAM_STATE_2));
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write when done + unlocked but invalid start address
     GBL_TEST_CALL(stfUnlockToState_(pSelf, EVMU_FLASH_PROGRAM_STATE_2));
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_FPR, 0x1);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     // Write successfully for 128 bytes
@@ -2451,10 +2574,10 @@ GBL_TEST_CASE(stf) {
     for(GblSize b = 0; b < 128; ++b) {
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, b);
         EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, b);
-        GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                      &(const EvmuDecodedInstruction) {
-                                          .opcode = EVMU_OPCODE_STF,
-                                      }));
+        GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                                &(const EvmuDecodedInstruction) {
+                                                    .opcode = EVMU_OPCODE_STF,
+                                                }));
 
         GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+b), b);
     }
@@ -2462,15 +2585,390 @@ GBL_TEST_CASE(stf) {
     // Ensure 129th write FAILS
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_TRL, 129);
     EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_ACC, 129);
-    GBL_TEST_CALL(EvmuCpu_execute(pFixture->pDevice->pCpu,
-                                  &(const EvmuDecodedInstruction) {
-                                      .opcode = EVMU_OPCODE_STF,
-                                  }));
+    GBL_TEST_CALL(EvmuCpuTestSuite_execute_(pSelf,
+                                            &(const EvmuDecodedInstruction) {
+                                                .opcode = EVMU_OPCODE_STF,
+                                            }));
     GBL_TEST_COMPARE(EvmuMemory_readFlash(pFixture->pMemory, 0x1ab00+129), 0x76);
 
     GBL_TEST_CASE_END;
 }
 
+GBL_TEST_CASE(execModes) {
+    // MOV #200, 0x10; loop: ADD #3; ST 0x11; INC 0x12; DBNZ 0x10, loop; BR $
+    const EvmuWord program[] = {
+        0x22, 0x10, 0xc8,
+        0x81, 0x03,
+        0x12, 0x11,
+        0x62, 0x12,
+        0x52, 0x10, 0xf7,
+        0x01, 0xfe
+    };
+
+    EvmuDevice* devices[EVMU_CPU_TEST_SUITE_MODE_COUNT_] = { pFixture->pDevice };
+
+    // Run the same program through every execution backend
+    for(GblSize d = 0; d < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++d) {
+        if(!devices[d]) {
+            devices[d] = GBL_OBJECT_NEW(EvmuDevice);
+            EvmuMemory_setProgramSource(devices[d]->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+        }
+
+        GBL_TEST_CALL(EvmuCpu_setExecMode(devices[d]->pCpu, EvmuCpuTestSuite_modes_[d]));
+        GBL_TEST_COMPARE(EvmuCpu_execMode(devices[d]->pCpu), EvmuCpuTestSuite_modes_[d]);
+
+        EvmuTestDevice_writeProgram(devices[d], 0x0000, program, sizeof(program));
+
+        EvmuCpu_setPc(devices[d]->pCpu, 0x0000);
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(devices[d]), 1000000000));
+
+        GBL_TEST_COMPARE(EvmuMemory_readData(devices[d]->pMemory, 0x10), 0);
+        GBL_TEST_COMPARE(EvmuMemory_readData(devices[d]->pMemory, 0x11), 88);
+        GBL_TEST_COMPARE(EvmuMemory_readData(devices[d]->pMemory, 0x12), 200);
+        GBL_TEST_COMPARE(EvmuMemory_readData(devices[d]->pMemory, EVMU_ADDRESS_SFR_ACC), 88);
+        GBL_TEST_COMPARE(EvmuCpu_pc(devices[d]->pCpu), 0x000c);
+    }
+
+    for(GblSize d = 1; d < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++d)
+        GBL_BOX_UNREF(devices[d]);
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(icacheFlashWrite) {
+    // MOV #0x11, 0x20; BR $
+    const EvmuWord program[] = {
+        0x22, 0x20, 0x11,
+        0x01, 0xfe
+    };
+    // MOV #0x33, 0x21
+    const EvmuWord patch[] = {
+        0x22, 0x21, 0x33
+    };
+
+    for(GblSize m = 0; m < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++m) {
+        EvmuDevice* pDevice = EvmuTestDevice_create(EvmuCpuTestSuite_modes_[m], program, sizeof(program));
+        size_t      bytes   = sizeof(patch);
+
+        GBL_TEST_VERIFY(pDevice);
+        EvmuDevice_runUntil(pDevice, 1, EVMU_DEVICE_STOP_NONE, NULL);
+        GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, 0x20), 0x11);
+
+        // Patching an immediate must not run the decode cached above
+        GBL_TEST_CALL(EvmuFlash_writeByte(pDevice->pFlash, 0x0002, 0x22));
+        EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+        EvmuDevice_runUntil(pDevice, 1, EVMU_DEVICE_STOP_NONE, NULL);
+        GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, 0x20), 0x22);
+
+        // Nor may rewriting a whole instruction in one go
+        GBL_TEST_CALL(EvmuFlash_writeBytes(pDevice->pFlash, 0x0000, patch, &bytes));
+        GBL_TEST_COMPARE(bytes, sizeof(patch));
+        EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+        EvmuDevice_runUntil(pDevice, 1, EVMU_DEVICE_STOP_NONE, NULL);
+        GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, 0x21), 0x33);
+        GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, 0x20), 0x22);
+
+        GBL_BOX_UNREF(pDevice);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(icacheBankSwitch) {
+    // MOV #0x55, 0x20; BR $
+    const EvmuWord flashProgram[] = {
+        0x22, 0x20, 0x55,
+        0x01, 0xfe
+    };
+    // MOV #0x44, 0x20; BR $, falling into FM_VRF_EX, which returns to flash
+    const EvmuWord romProgram[] = {
+        0x22, 0x20, 0x44,
+        0x01, 0xfe
+    };
+    const EvmuAddress base = EVMU_BIOS_SUBROUTINE_FM_VRF_EX - 3;
+
+    for(GblSize m = 0; m < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++m) {
+        EvmuDevice* pDevice = GBL_OBJECT_NEW(EvmuDevice);
+
+        GBL_TEST_CALL(EvmuCpu_setExecMode(pDevice->pCpu, EvmuCpuTestSuite_modes_[m]));
+
+        EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_ROM);
+        EvmuTestDevice_writeProgram(pDevice, base, romProgram, sizeof(romProgram));
+        EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+        EvmuTestDevice_writeProgram(pDevice, base, flashProgram, sizeof(flashProgram));
+
+        // The same address is decoded from flash, then ROM, then flash again
+        for(GblSize pass = 0; pass < 3; ++pass) {
+            const GblBool rom = pass == 1;
+
+            EvmuMemory_writeData(pDevice->pMemory, 0x20, 0x00);
+            EvmuMemory_setProgramSource(pDevice->pMemory, rom? EVMU_MEMORY_EXT_SRC_ROM :
+                                                               EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+            EvmuCpu_setPc(pDevice->pCpu, base);
+            EvmuDevice_runUntil(pDevice, 1, EVMU_DEVICE_STOP_NONE, NULL);
+
+            GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, 0x20), rom? 0x44 : 0x55);
+        }
+
+        GBL_BOX_UNREF(pDevice);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(blockTimerReads) {
+    // NOP x4; LD T1L; ST 0x20; NOP x3; LD T1L; ST 0x21; BR $
+    const EvmuWord program[] = {
+        0x00, 0x00, 0x00, 0x00,
+        EVMU_OPCODE_LD | (EVMU_ADDRESS_SFR_T1L >> 8), EVMU_ADDRESS_SFR_T1L & 0xff,
+        0x12, 0x20,
+        0x00, 0x00, 0x00,
+        EVMU_OPCODE_LD | (EVMU_ADDRESS_SFR_T1L >> 8), EVMU_ADDRESS_SFR_T1L & 0xff,
+        0x12, 0x21,
+        0x01, 0xfe
+    };
+
+    EvmuWord samples[EVMU_CPU_TEST_SUITE_MODE_COUNT_][2];
+
+    for(GblSize m = 0; m < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++m) {
+        EvmuDevice* pDevice = EvmuTestDevice_create(EvmuCpuTestSuite_modes_[m], program, sizeof(program));
+        GBL_TEST_VERIFY(pDevice);
+
+        // T1L as a free-running 8-bit timer, ticking once per cycle
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1LR,  0x00);
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT, EVMU_SFR_T1CNT_T1LRUN_MASK);
+
+        EvmuDevice_runUntil(pDevice, 64, EVMU_DEVICE_STOP_NONE, NULL);
+
+        samples[m][0] = EvmuMemory_readData(pDevice->pMemory, 0x20);
+        samples[m][1] = EvmuMemory_readData(pDevice->pMemory, 0x21);
+
+        // Each read must see the cycles retired before it, not wherever its block started
+        GBL_TEST_VERIFY(samples[m][0] != 0x00);
+        GBL_TEST_VERIFY(samples[m][1] >  samples[m][0]);
+        GBL_TEST_COMPARE(samples[m][0], samples[0][0]);
+        GBL_TEST_COMPARE(samples[m][1], samples[0][1]);
+
+        GBL_BOX_UNREF(pDevice);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(blockTimerWrites) {
+    // NOP x4; MOV #P0LRUN, T0CNT; MOV #T1LRUN, T1CNT; NOP x3; LD T0L; ST 0x20; LD T1L; ST 0x21;
+    // MOV #0, T0CNT; MOV #0, T1CNT; BR $
+    const EvmuWord program[] = {
+        0x00, 0x00, 0x00, 0x00,
+        EVMU_OPCODE_MOV | (EVMU_ADDRESS_SFR_T0CNT >> 8), EVMU_ADDRESS_SFR_T0CNT & 0xff, EVMU_SFR_T0CNT_P0LRUN_MASK,
+        EVMU_OPCODE_MOV | (EVMU_ADDRESS_SFR_T1CNT >> 8), EVMU_ADDRESS_SFR_T1CNT & 0xff, EVMU_SFR_T1CNT_T1LRUN_MASK,
+        0x00, 0x00, 0x00,
+        EVMU_OPCODE_LD | (EVMU_ADDRESS_SFR_T0L >> 8), EVMU_ADDRESS_SFR_T0L & 0xff,
+        0x12, 0x20,
+        EVMU_OPCODE_LD | (EVMU_ADDRESS_SFR_T1L >> 8), EVMU_ADDRESS_SFR_T1L & 0xff,
+        0x12, 0x21,
+        EVMU_OPCODE_MOV | (EVMU_ADDRESS_SFR_T0CNT >> 8), EVMU_ADDRESS_SFR_T0CNT & 0xff, 0x00,
+        EVMU_OPCODE_MOV | (EVMU_ADDRESS_SFR_T1CNT >> 8), EVMU_ADDRESS_SFR_T1CNT & 0xff, 0x00,
+        0x01, 0xfe
+    };
+
+    EvmuWord samples[EVMU_CPU_TEST_SUITE_MODE_COUNT_][4];
+
+    for(GblSize m = 0; m < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++m) {
+        EvmuDevice* pDevice = EvmuTestDevice_create(EvmuCpuTestSuite_modes_[m], program, sizeof(program));
+        GBL_TEST_VERIFY(pDevice);
+
+        // Both low bytes as 8-bit timers ticking once per cycle, stopped until the program starts them
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T0PRR, 0xff);
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T0LR,  0x00);
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T0CNT, 0x00);
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1LR,  0x00);
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT, 0x00);
+
+        EvmuDevice_runUntil(pDevice, 64, EVMU_DEVICE_STOP_NONE, NULL);
+
+        samples[m][0] = EvmuMemory_readData(pDevice->pMemory, 0x20);
+        samples[m][1] = EvmuMemory_readData(pDevice->pMemory, 0x21);
+        samples[m][2] = EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T0L);
+        samples[m][3] = EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1L);
+
+        // The NOPs ahead of each start retire before the timer begins counting, and stopping reloads it
+        GBL_TEST_VERIFY(samples[m][0] != 0x00);
+        GBL_TEST_VERIFY(samples[m][1] != 0x00);
+
+        for(GblSize s = 0; s < 4; ++s)
+            GBL_TEST_COMPARE(samples[m][s], samples[0][s]);
+
+        GBL_BOX_UNREF(pDevice);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(baseTimer) {
+    EvmuDevice* devices[] = { GBL_OBJECT_NEW(EvmuDevice), GBL_OBJECT_NEW(EvmuDevice) };
+
+    for(GblSize d = 0; d < 2; ++d)
+        EvmuMemory_writeData(devices[d]->pMemory, EVMU_ADDRESS_SFR_BTCR, EVMU_SFR_BTCR_OP_CTRL_MASK);
+
+    // Master time is integral, so splitting an update can't change when the base timer fires
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(devices[0]), 490000000));
+    for(GblSize u = 0; u < 70; ++u)
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(devices[1]), 7000000));
+
+    for(GblSize d = 0; d < 2; ++d) {
+        const EvmuWord btcr = EvmuMemory_readData(devices[d]->pMemory, EVMU_ADDRESS_SFR_BTCR);
+        GBL_TEST_VERIFY(btcr & EVMU_SFR_BTCR_INT1_SRC_MASK);
+        GBL_TEST_VERIFY(!(btcr & EVMU_SFR_BTCR_INT0_SRC_MASK));
+    }
+
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(devices[0]), 20000000));
+    for(GblSize u = 0; u < 3; ++u)
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(devices[1]), 7000000));
+
+    for(GblSize d = 0; d < 2; ++d)
+        GBL_TEST_VERIFY(EvmuMemory_readData(devices[d]->pMemory, EVMU_ADDRESS_SFR_BTCR) &
+                        EVMU_SFR_BTCR_INT0_SRC_MASK);
+
+    for(GblSize d = 0; d < 2; ++d)
+        GBL_BOX_UNREF(devices[d]);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(runUntil) {
+    EvmuDevice*  pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuStopMask reason  = EVMU_DEVICE_STOP_NONE;
+
+    // T1L as an 8-bit timer, 16 cycles from overflowing, with its interrupt unmasked
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1LR,  0xf0);
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT, EVMU_SFR_T1CNT_T1LRUN_MASK |
+                                                                   EVMU_SFR_T1CNT_T1LIE_MASK);
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_IE,    EVMU_SFR_IE_IE7_MASK);
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_PCON,  EVMU_SFR_PCON_HALT_MASK);
+
+    GBL_TEST_COMPARE(EvmuDevice_runUntil(pDevice, 10, EVMU_DEVICE_STOP_IRQ, &reason), 10);
+    GBL_TEST_COMPARE(reason, EVMU_DEVICE_STOP_NONE);
+    GBL_TEST_VERIFY(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_PCON) &
+                    EVMU_SFR_PCON_HALT_MASK);
+
+    // Skips the rest of the halt in one go, waking up right on the overflow
+    GBL_TEST_COMPARE(EvmuDevice_runUntil(pDevice, 1000000, EVMU_DEVICE_STOP_IRQ, &reason), 6);
+    GBL_TEST_COMPARE(reason, EVMU_DEVICE_STOP_IRQ);
+    GBL_TEST_COMPARE(EvmuCpu_pc(pDevice->pCpu), EVMU_ISR_ADDR_T1);
+    GBL_TEST_VERIFY(!(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_PCON) &
+                      EVMU_SFR_PCON_HALT_MASK));
+
+    GBL_BOX_UNREF(pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(timerOverflows) {
+    EvmuDevice* pDevice = GBL_OBJECT_NEW(EvmuDevice);
+
+    // T1 as a 16-bit timer reloading from 0xfff0, overflowing every 16 cycles
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1HR,  0xff);
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1LR,  0xf0);
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT, EVMU_SFR_T1CNT_T1LONG_MASK |
+                                                                   EVMU_SFR_T1CNT_T1LRUN_MASK |
+                                                                   EVMU_SFR_T1CNT_T1HRUN_MASK);
+    EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_PCON,  EVMU_SFR_PCON_HALT_MASK);
+
+    // Five overflows into the halt, every one of them reloading both bytes
+    GBL_TEST_COMPARE(EvmuDevice_runUntil(pDevice, 16 * 5 + 3, EVMU_DEVICE_STOP_NONE, NULL), 16 * 5 + 3);
+    GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1H), 0xff);
+    GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1L), 0xf3);
+    GBL_TEST_VERIFY(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT) &
+                    EVMU_SFR_T1CNT_T1HOVF_MASK);
+
+    GBL_BOX_UNREF(pDevice);
+
+    // 32 NOPs; BR $
+    EvmuWord program[34] = { 0 };
+    program[32] = 0x01;
+    program[33] = 0xfe;
+
+    // An 8-bit T1L overflowing every 3 cycles wraps several times within a single block
+    for(GblSize m = 0; m < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++m) {
+        pDevice = EvmuTestDevice_create(EvmuCpuTestSuite_modes_[m], program, sizeof(program));
+        GBL_TEST_VERIFY(pDevice);
+
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1LR,  0xfd);
+        EvmuMemory_writeData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT, EVMU_SFR_T1CNT_T1LRUN_MASK);
+
+        GBL_TEST_COMPARE(EvmuDevice_runUntil(pDevice, 32, EVMU_DEVICE_STOP_NONE, NULL), 32);
+
+        // 0xfd + 32 counts: 10 overflows, then 2 counts past the reload
+        GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1L), 0xff);
+        GBL_TEST_VERIFY(EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_T1CNT) &
+                        EVMU_SFR_T1CNT_T1LOVF_MASK);
+
+        GBL_BOX_UNREF(pDevice);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+#define EVMU_CPU_TEST_SUITE_FAIL_AT_   3     // instruction runErrors fails on, counting from 1
+
+static EVMU_RESULT (*EvmuCpuTestSuite_pFnExecute_)(EvmuCpu*, const EvmuDecodedInstruction*);
+static size_t        EvmuCpuTestSuite_executed_;
+
+static EVMU_RESULT EvmuCpuTestSuite_failingExecute_(EvmuCpu* pCpu, const EvmuDecodedInstruction* pInstr) {
+    if(++EvmuCpuTestSuite_executed_ == EVMU_CPU_TEST_SUITE_FAIL_AT_)
+        return GBL_RESULT_ERROR_INVALID_OPERATION;
+
+    return EvmuCpuTestSuite_pFnExecute_(pCpu, pInstr);
+}
+
+GBL_TEST_CASE(runErrors) {
+    // NOP x6; BR $
+    const EvmuWord program[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0xfe
+    };
+
+    for(GblSize m = 0; m < EVMU_CPU_TEST_SUITE_MODE_COUNT_; ++m) {
+        EvmuDevice*   pDevice = GBL_OBJECT_NEW(EvmuDevice);
+        EvmuCpuClass* pClass  = EVMU_CPU_GET_CLASS(pDevice->pCpu);
+        EvmuStopMask  reason  = EVMU_DEVICE_STOP_NONE;
+        EVMU_RESULT   result;
+        EvmuCycles    cycles;
+
+        GBL_TEST_CALL(EvmuCpu_setExecMode(pDevice->pCpu, EvmuCpuTestSuite_modes_[m]));
+
+        EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+        EvmuTestDevice_writeProgram(pDevice, 0x0000, program, sizeof(program));
+
+        EvmuCpuTestSuite_pFnExecute_ = pClass->pFnExecute;
+        pClass->pFnExecute           = EvmuCpuTestSuite_failingExecute_;
+
+        // An update ends at the failing instruction, returning its error
+        GBL_TEST_EXPECT_ERROR();
+
+        EvmuCpuTestSuite_executed_ = 0;
+        EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+        result = EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 10000000);
+
+        // As does a run, which counts its cycles and always stops on it
+        EvmuCpuTestSuite_executed_ = 0;
+        EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+        cycles = EvmuDevice_runUntil(pDevice, 100, EVMU_DEVICE_STOP_NONE, &reason);
+
+        pClass->pFnExecute = EvmuCpuTestSuite_pFnExecute_;
+
+        GBL_TEST_COMPARE(result, GBL_RESULT_ERROR_INVALID_OPERATION);
+        GBL_CTX_CLEAR_LAST_RECORD();
+
+        GBL_TEST_COMPARE(cycles, EVMU_CPU_TEST_SUITE_FAIL_AT_);
+        GBL_TEST_COMPARE(reason, EVMU_DEVICE_STOP_ERROR);
+        GBL_TEST_COMPARE(EvmuCpu_pc(pDevice->pCpu), EVMU_CPU_TEST_SUITE_FAIL_AT_);
+
+        GBL_BOX_UNREF(pDevice);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
 GBL_TEST_REGISTER(nop,
                   ld,
                   ldInd,
@@ -2539,4 +3037,13 @@ GBL_TEST_REGISTER(nop,
                   ldc,
                   reti,
                   ldf,
-                  stf);
+                  stf,
+                  execModes,
+                  icacheFlashWrite,
+                  icacheBankSwitch,
+                  blockTimerReads,
+                  blockTimerWrites,
+                  baseTimer,
+                  runUntil,
+                  timerOverflows,
+                  runErrors);
@@ -0,0 +1,221 @@
+#include "evmu_device_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef __STDC_NO_THREADS__
+#   include <threads.h>
+#endif
+
+#define GBL_TEST_SUITE_SELF EvmuDeviceTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuDevice* pDevice;    // already part way through the workload, to be cloned
+};
+
+GBL_TEST_INIT() {
+    pFixture->pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuTestDevice_loadWorkload(pFixture->pDevice, 1);
+    GBL_TEST_CALL(EvmuTestDevice_run(pFixture->pDevice, 20));
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    GBL_BOX_UNREF(pFixture->pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(clone) {
+    EvmuDevice*  pSource = pFixture->pDevice;
+    const size_t size    = EvmuDevice_stateSize(pSource);
+    uint8_t*     pStates = malloc(size * 2);
+
+    EvmuDevice* pClone = EvmuDevice_clone(pSource);
+    GBL_TEST_VERIFY(pClone);
+
+    // A fresh clone is indistinguishable from its source, and stays that way as both run
+    GBL_TEST_CALL(EvmuDevice_saveState(pSource, pStates,        size));
+    GBL_TEST_CALL(EvmuDevice_saveState(pClone,  pStates + size, size));
+    GBL_TEST_VERIFY(memcmp(pStates, pStates + size, size) == 0);
+    GBL_TEST_COMPARE(EvmuCpu_execMode(pClone->pCpu), EvmuCpu_execMode(pSource->pCpu));
+
+    for(GblSize s = 0; s < 30; ++s) {
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pSource), 50000));
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pClone),  50000));
+    }
+
+    GBL_TEST_CALL(EvmuDevice_saveState(pSource, pStates,        size));
+    GBL_TEST_CALL(EvmuDevice_saveState(pClone,  pStates + size, size));
+    GBL_TEST_VERIFY(memcmp(pStates, pStates + size, size) == 0);
+
+    // Writes to the clone's flash and its shared ROM never reach the source
+    const EvmuWord flash = EvmuFlash_readByte(pSource->pFlash, 0x100);
+    GBL_TEST_CALL(EvmuFlash_writeByte(pClone->pFlash, 0x100, flash ^ 0xff));
+    GBL_TEST_COMPARE(EvmuFlash_readByte(pSource->pFlash, 0x100), flash);
+    GBL_TEST_COMPARE(EvmuFlash_readByte(pClone->pFlash,  0x100), flash ^ 0xff);
+
+    EvmuMemory_setProgramSource(pSource->pMemory, EVMU_MEMORY_EXT_SRC_ROM);
+    EvmuMemory_setProgramSource(pClone->pMemory,  EVMU_MEMORY_EXT_SRC_ROM);
+
+    const EvmuWord rom = EvmuMemory_readProgram(pSource->pMemory, 0x200);
+    GBL_TEST_CALL(EvmuMemory_writeProgram(pClone->pMemory, 0x200, rom ^ 0xff));
+    GBL_TEST_COMPARE(EvmuMemory_readProgram(pSource->pMemory, 0x200), rom);
+    GBL_TEST_COMPARE(EvmuMemory_readProgram(pClone->pMemory,  0x200), rom ^ 0xff);
+
+    // Nor do writes to the source made after cloning reach the clone, including to the ROM it still shares
+    EvmuDevice* pShared = EvmuDevice_clone(pSource);
+    GBL_TEST_VERIFY(pShared);
+    EvmuMemory_setProgramSource(pShared->pMemory, EVMU_MEMORY_EXT_SRC_ROM);
+
+    const EvmuWord sharedRom   = EvmuMemory_readProgram(pSource->pMemory, 0x201);
+    const EvmuWord sharedFlash = EvmuFlash_readByte(pSource->pFlash, 0x101);
+    const EvmuWord sharedRam   = EvmuMemory_readData(pSource->pMemory, 0x30);
+
+    GBL_TEST_CALL(EvmuMemory_writeProgram(pSource->pMemory, 0x201, sharedRom ^ 0xff));
+    GBL_TEST_CALL(EvmuFlash_writeByte(pSource->pFlash, 0x101, sharedFlash ^ 0xff));
+    GBL_TEST_CALL(EvmuMemory_writeData(pSource->pMemory, 0x30, sharedRam ^ 0xff));
+
+    GBL_TEST_COMPARE(EvmuMemory_readProgram(pShared->pMemory, 0x201), sharedRom);
+    GBL_TEST_COMPARE(EvmuFlash_readByte(pShared->pFlash, 0x101),      sharedFlash);
+    GBL_TEST_COMPARE(EvmuMemory_readData(pShared->pMemory, 0x30),     sharedRam);
+    GBL_TEST_COMPARE(EvmuMemory_readProgram(pSource->pMemory, 0x201), sharedRom ^ 0xff);
+
+    GBL_BOX_UNREF(pShared);
+    free(pStates);
+    GBL_BOX_UNREF(pClone);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(createExt) {
+    EvmuDevice* pDefault = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuDevice* pLight   = EvmuDevice_createExt(EVMU_DEVICE_CREATE_NO_FORMAT |
+                                                EVMU_DEVICE_CREATE_NO_LOG    |
+                                                EVMU_DEVICE_CREATE_ARENA);
+    GBL_TEST_VERIFY(pLight);
+
+    // Flash is only formatted when asked for
+    const EvmuAddress root = EVMU_FAT_BLOCK_ROOT * EVMU_FAT_BLOCK_SIZE;
+    GBL_TEST_COMPARE(EvmuFlash_readByte(pDefault->pFlash, root), EVMU_FAT_ROOT_BLOCK_FORMATTED_BYTE);
+    GBL_TEST_COMPARE(EvmuFlash_readByte(pLight->pFlash,   root), 0);
+
+    // Otherwise both run the same, including out of an arena block cache and BIOS image
+    EvmuTestDevice_loadWorkload(pDefault, 1);
+    EvmuTestDevice_loadWorkload(pLight,   1);
+
+    for(GblSize s = 0; s < 30; ++s) {
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDefault), 50000));
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLight),   50000));
+    }
+
+    GBL_TEST_COMPARE(EvmuCpu_pc(pLight->pCpu), EvmuCpu_pc(pDefault->pCpu));
+
+    for(EvmuAddress a = 0; a < EVMU_ADDRESS_SEGMENT_SFR_BASE; ++a)
+        GBL_TEST_COMPARE(EvmuMemory_readData(pLight->pMemory, a),
+                         EvmuMemory_readData(pDefault->pMemory, a));
+
+    // Clones of an arena device copy its BIOS image rather than share it
+    EvmuDevice* pClone = EvmuDevice_clone(pLight);
+    GBL_TEST_VERIFY(pClone);
+    GBL_TEST_COMPARE(EvmuDevice_unref(pLight), 0);
+
+    EvmuMemory_setProgramSource(pClone->pMemory, EVMU_MEMORY_EXT_SRC_ROM);
+    GBL_TEST_CALL(EvmuMemory_writeProgram(pClone->pMemory, 0x200, 0xa5));
+    GBL_TEST_COMPARE(EvmuMemory_readProgram(pClone->pMemory, 0x200), 0xa5);
+
+    GBL_TEST_COMPARE(EvmuDevice_unref(pClone), 0);
+    GBL_BOX_UNREF(pDefault);
+    GBL_TEST_CASE_END;
+}
+
+#define EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_ 8
+#define EVMU_DEVICE_TEST_SUITE_STRESS_SLICES_  200
+
+// What's left of a stress device once it's run and been destroyed
+typedef struct EvmuDeviceTestSuiteStress_ {
+    size_t   seed;
+    EvmuPc   pc;
+    EvmuWord ram[EVMU_ADDRESS_SEGMENT_SFR_BASE];
+    EvmuWord acc;
+    EvmuWord psw;
+} EvmuDeviceTestSuiteStress_;
+
+/* Creates, runs, and destroys a device all on the calling thread, returning how many
+   of its calls didn't report exactly what they should have. */
+static int EvmuDeviceTestSuite_stressRun_(void* pArg) {
+    EvmuDeviceTestSuiteStress_* pStress  = pArg;
+    EvmuDevice*              pDevice  = GBL_OBJECT_NEW(EvmuDevice);
+    int                      failures = 0;
+
+    EvmuTestDevice_loadWorkload(pDevice, pStress->seed);
+
+    for(GblSize s = 0; s < EVMU_DEVICE_TEST_SUITE_STRESS_SLICES_; ++s) {
+        if(!GBL_RESULT_SUCCESS(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 50000)))
+            ++failures;
+
+        // Every device fails a call of its own now and then, which must only ever be reported back to it
+        if(s % 16 == pStress->seed % 16) {
+            if(EvmuMemory_writeData(pDevice->pMemory, 0x200 + pStress->seed, 0) != GBL_RESULT_ERROR_OUT_OF_RANGE)
+                ++failures;
+
+            GBL_CTX_CLEAR_LAST_RECORD();
+        }
+    }
+
+    pStress->pc  = EvmuCpu_pc(pDevice->pCpu);
+    pStress->acc = EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_ACC);
+    pStress->psw = EvmuMemory_readData(pDevice->pMemory, EVMU_ADDRESS_SFR_PSW);
+
+    for(EvmuAddress a = 0; a < EVMU_ADDRESS_SEGMENT_SFR_BASE; ++a)
+        pStress->ram[a] = EvmuMemory_readData(pDevice->pMemory, a);
+
+    GBL_BOX_UNREF(pDevice);
+
+    return failures;
+}
+
+GBL_TEST_CASE(threadStress) {
+    EvmuDeviceTestSuiteStress_ threaded[EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_];
+    EvmuDeviceTestSuiteStress_ serial  [EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_];
+
+    for(GblSize d = 0; d < EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_; ++d)
+        threaded[d].seed = serial[d].seed = d;
+
+    GBL_TEST_EXPECT_ERROR();
+
+    // Every device lives and dies on its own thread at once, falling back to the same serial run without threads
+#ifndef __STDC_NO_THREADS__
+    thrd_t threads[EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_];
+
+    for(GblSize d = 0; d < EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_; ++d)
+        GBL_TEST_COMPARE(thrd_create(&threads[d], EvmuDeviceTestSuite_stressRun_, &threaded[d]), thrd_success);
+
+    for(GblSize d = 0; d < EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_; ++d) {
+        int failures = -1;
+        thrd_join(threads[d], &failures);
+        GBL_TEST_COMPARE(failures, 0);
+    }
+#else
+    for(GblSize d = 0; d < EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_; ++d)
+        GBL_TEST_COMPARE(EvmuDeviceTestSuite_stressRun_(&threaded[d]), 0);
+#endif
+
+    for(GblSize d = 0; d < EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_; ++d)
+        GBL_TEST_COMPARE(EvmuDeviceTestSuite_stressRun_(&serial[d]), 0);
+
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    for(GblSize d = 0; d < EVMU_DEVICE_TEST_SUITE_STRESS_DEVICES_; ++d) {
+        GBL_TEST_COMPARE(threaded[d].pc,  serial[d].pc);
+        GBL_TEST_COMPARE(threaded[d].acc, serial[d].acc);
+        GBL_TEST_COMPARE(threaded[d].psw, serial[d].psw);
+        GBL_TEST_VERIFY(memcmp(threaded[d].ram, serial[d].ram, sizeof(serial[d].ram)) == 0);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(clone,
+                  createExt,
+                  threadStress);
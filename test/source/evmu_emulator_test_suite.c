@@ -0,0 +1,95 @@
+#include "evmu_emulator_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/types/evmu_emulator.h>
+#include <evmu/types/evmu_batch.h>
+
+#define GBL_TEST_SUITE_SELF EvmuEmulatorTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuEmulator* pEmulator;
+};
+
+GBL_TEST_INIT() {
+    pFixture->pEmulator = EvmuEmulator_create();
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    EvmuEmulator_unref(pFixture->pEmulator);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(update) {
+    // MOV #n, 0x10; loop: INC 0x12; DBNZ 0x10, loop; BR $
+    const EvmuWord program[] = {
+        0x22, 0x10, 0x00,
+        0x62, 0x12,
+        0x52, 0x10, 0xfb,
+        0x01, 0xfe
+    };
+    EvmuEmulator* pEmulator = pFixture->pEmulator;
+    EvmuDevice*   devices[6];
+
+    // Each device loops a different number of times, so any crossed wires show up
+    for(GblSize d = 0; d < GBL_COUNT_OF(devices); ++d) {
+        devices[d] = EvmuTestDevice_create(EVMU_CPU_EXEC_MODE_INTERPRETER, program, sizeof(program));
+        EvmuMemory_writeProgram(devices[d]->pMemory, 2, 10 + 20 * d);
+
+        GBL_TEST_CALL(EvmuEmulator_addDevice(pEmulator, devices[d]));
+    }
+
+    GBL_TEST_CALL(EvmuEmulator_setThreadCount(pEmulator, 4));
+    GBL_TEST_COMPARE(EvmuEmulator_threadCount(pEmulator), 4);
+    GBL_TEST_CALL(EvmuEmulator_update(pEmulator, 1000000000));
+
+    for(GblSize d = 0; d < GBL_COUNT_OF(devices); ++d) {
+        GBL_TEST_COMPARE(EvmuMemory_readData(devices[d]->pMemory, 0x12), 10 + 20 * d);
+        GBL_TEST_COMPARE(EvmuCpu_pc(devices[d]->pCpu), 0x0008);
+    }
+
+    for(GblSize d = 0; d < GBL_COUNT_OF(devices); ++d) {
+        GBL_TEST_CALL(EvmuEmulator_removeDevice(pEmulator, devices[d]));
+        GBL_BOX_UNREF(devices[d]);
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(children) {
+    // MOV #40, 0x10; loop: INC 0x12; DBNZ 0x10, loop; BR $
+    const EvmuWord program[] = {
+        0x22, 0x10, 0x28,
+        0x62, 0x12,
+        0x52, 0x10, 0xfb,
+        0x01, 0xfe
+    };
+    EvmuEmulator* pEmulator = pFixture->pEmulator;
+    EvmuBatch*    pBatch    = EvmuBatch_create();
+    EvmuDevice*   pDevice   = EvmuTestDevice_create(EVMU_CPU_EXEC_MODE_INTERPRETER, program, sizeof(program));
+    EvmuDevice*   pLane     = EvmuTestDevice_create(EVMU_CPU_EXEC_MODE_INTERPRETER, program, sizeof(program));
+
+    GBL_TEST_CALL(EvmuEmulator_addDevice(pEmulator, pDevice));
+    GBL_TEST_CALL(EvmuBatch_addLane(pBatch, pLane));
+    GblObject_addChild(GBL_OBJECT(pEmulator), GBL_OBJECT(pBatch));
+
+    // Behaviors which aren't devices are stepped right along with them
+    GBL_TEST_COMPARE(EvmuEmulator_deviceCount(pEmulator), 1);
+    GBL_TEST_CALL(EvmuEmulator_update(pEmulator, 1000000000));
+
+    GBL_TEST_COMPARE(EvmuMemory_readData(pDevice->pMemory, 0x12), 40);
+    GBL_TEST_COMPARE(EvmuMemory_readData(pLane->pMemory,   0x12), 40);
+    GBL_TEST_COMPARE(EvmuCpu_pc(pLane->pCpu), EvmuCpu_pc(pDevice->pCpu));
+
+    GBL_TEST_VERIFY(GblObject_removeChild(GBL_OBJECT(pEmulator), GBL_OBJECT(pBatch)));
+    GBL_TEST_CALL(EvmuEmulator_removeDevice(pEmulator, pDevice));
+    GBL_TEST_CALL(EvmuBatch_removeLane(pBatch, pLane));
+    GBL_BOX_UNREF(pLane);
+    GBL_BOX_UNREF(pDevice);
+    EvmuBatch_unref(pBatch);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(update,
+                  children);
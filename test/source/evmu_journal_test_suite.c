@@ -0,0 +1,225 @@
+#include "evmu_journal_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <evmu/types/evmu_journal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GBL_TEST_SUITE_SELF EvmuJournalTestSuite
+
+#define EVMU_JOURNAL_TEST_SUITE_TIME_MSB_   7   // last byte of an event's little-endian time
+
+GBL_TEST_FIXTURE {
+    EvmuDevice* pDevice;    // already part way through the workload
+};
+
+GBL_TEST_INIT() {
+    pFixture->pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuTestDevice_loadWorkload(pFixture->pDevice, 2);
+    GBL_TEST_CALL(EvmuTestDevice_run(pFixture->pDevice, 20));
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    GBL_BOX_UNREF(pFixture->pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(replay) {
+    EvmuDevice*  pDevice  = pFixture->pDevice;
+    EvmuDevice*  pOther   = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuJournal* pJournal = EvmuJournal_create(pDevice);
+    const size_t size     = EvmuDevice_stateSize(pDevice);
+    uint8_t*     pStates  = malloc(size * 2);
+
+    GBL_TEST_CALL(EvmuJournal_record(pJournal));
+    GBL_TEST_COMPARE(EvmuJournal_mode(pJournal), EVMU_JOURNAL_MODE_RECORDING);
+
+    // Varying updates, button presses, a date change, and a run to the next event
+    for(GblSize s = 0; s < 40; ++s) {
+        pDevice->pGamepad->a    = (s / 4) & 1;
+        pDevice->pGamepad->left = (s / 7) & 1;
+
+        if(s == 10) {
+            GblDateTime dateTime;
+            GBL_TEST_CALL(EvmuRom_setDateTime(pDevice->pRom,
+                                              GblDateTime_addSeconds(EvmuRom_dateTime(pDevice->pRom, &dateTime),
+                                                                     3600)));
+        }
+
+        if(s == 20)
+            EvmuDevice_runUntil(pDevice, 5000, EVMU_DEVICE_STOP_EVENT, NULL);
+
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 20000 + s * 1000));
+    }
+
+    GBL_TEST_CALL(EvmuJournal_stop(pJournal));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pStates, size));
+    GBL_TEST_COMPARE(EvmuJournal_event(pJournal, 0), EVMU_JOURNAL_EVENT_UPDATE);
+    GBL_TEST_COMPARE(EvmuJournal_event(pJournal, EvmuJournal_count(pJournal)), EVMU_JOURNAL_EVENT_COUNT);
+
+    // Replaying lands on exactly the same state, ignoring whatever the buttons are now
+    pDevice->pGamepad->b = 1;
+    GBL_TEST_CALL(EvmuJournal_replay(pJournal));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pStates + size, size));
+    GBL_TEST_VERIFY(memcmp(pStates, pStates + size, size) == 0);
+
+    // As does replaying a saved journal on another device
+    const size_t journalSize = EvmuJournal_saveSize(pJournal);
+    uint8_t*     pSaved      = malloc(journalSize);
+    EvmuJournal* pOtherLog   = EvmuJournal_create(pOther);
+
+    GBL_TEST_CALL(EvmuJournal_save(pJournal, pSaved, journalSize));
+    GBL_TEST_CALL(EvmuJournal_load(pOtherLog, pSaved, journalSize));
+    GBL_TEST_COMPARE(EvmuJournal_count(pOtherLog), EvmuJournal_count(pJournal));
+    GBL_TEST_CALL(EvmuJournal_replay(pOtherLog));
+    GBL_TEST_CALL(EvmuDevice_saveState(pOther, pStates + size, size));
+    GBL_TEST_VERIFY(memcmp(pStates, pStates + size, size) == 0);
+
+    // An event found at a different time than recorded fails the replay
+    GBL_TEST_EXPECT_ERROR();
+
+    const size_t last = EvmuJournal_count(pJournal) - 1;
+
+    pSaved[EvmuJournal_eventOffset(pJournal, last) + EVMU_JOURNAL_TEST_SUITE_TIME_MSB_] ^= 0x80;
+    GBL_TEST_CALL(EvmuJournal_reseal(pSaved, journalSize));
+    GBL_TEST_CALL(EvmuJournal_load(pOtherLog, pSaved, journalSize));
+    GBL_TEST_COMPARE(EvmuJournal_replay(pOtherLog), GBL_RESULT_ERROR_INVALID_OPERATION);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(EvmuJournal_load(pOtherLog, pSaved, journalSize - 1), GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    free(pSaved);
+    free(pStates);
+    GBL_TEST_COMPARE(EvmuJournal_unref(pOtherLog), 0);
+    GBL_TEST_COMPARE(EvmuJournal_unref(pJournal), 0);
+    GBL_BOX_UNREF(pOther);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(badChecksum) {
+    EvmuDevice*  pDevice  = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuJournal* pJournal = EvmuJournal_create(pFixture->pDevice);
+    EvmuJournal* pOther   = EvmuJournal_create(pDevice);
+
+    GBL_TEST_CALL(EvmuJournal_record(pJournal));
+    GBL_TEST_CALL(EvmuTestDevice_run(pFixture->pDevice, 4));
+    GBL_TEST_CALL(EvmuJournal_stop(pJournal));
+    GBL_TEST_VERIFY(EvmuJournal_count(pJournal) > 0);
+
+    const size_t size   = EvmuJournal_saveSize(pJournal);
+    uint8_t*     pSaved = malloc(size);
+
+    GBL_TEST_VERIFY(pSaved);
+    GBL_TEST_CALL(EvmuJournal_save(pJournal, pSaved, size));
+    GBL_TEST_CALL(EvmuJournal_load(pOther, pSaved, size));
+
+    // A flipped bit anywhere in the state, the events, or the checksum itself is caught up front
+    const size_t offsets[] = {
+        EvmuJournal_eventOffset(pJournal, 0) - 1,
+        EvmuJournal_eventOffset(pJournal, 0),
+        size - 1
+    };
+
+    GBL_TEST_EXPECT_ERROR();
+
+    for(size_t o = 0; o < GBL_COUNT_OF(offsets); ++o) {
+        pSaved[offsets[o]] ^= 0x01;
+        GBL_TEST_COMPARE(EvmuJournal_load(pOther, pSaved, size), GBL_RESULT_ERROR_INVALID_ARG);
+        GBL_CTX_CLEAR_LAST_RECORD();
+        pSaved[offsets[o]] ^= 0x01;
+    }
+
+    // Leaving what was loaded before in place
+    GBL_TEST_COMPARE(EvmuJournal_count(pOther), EvmuJournal_count(pJournal));
+    GBL_TEST_COMPARE(EvmuJournal_mode(pOther), EVMU_JOURNAL_MODE_IDLE);
+
+    free(pSaved);
+    GBL_TEST_COMPARE(EvmuJournal_unref(pOther), 0);
+    GBL_TEST_COMPARE(EvmuJournal_unref(pJournal), 0);
+    GBL_BOX_UNREF(pDevice);
+    GBL_TEST_CASE_END;
+}
+
+static EvmuWord EvmuJournalTestSuite_skipRead_(EvmuMemory* pMemory, EvmuAddress address, void* pClosure) {
+    const EvmuMemoryHandler* pPrevious = pClosure;
+    return pPrevious->pFnRead(pMemory, address, pPrevious->pClosure);
+}
+
+// Skips a count, so the device stops matching one without the handler
+static EVMU_RESULT EvmuJournalTestSuite_skipWrite_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) {
+    const EvmuMemoryHandler* pPrevious = pClosure;
+    return pPrevious->pFnWrite(pMemory, address, value == 30? 31 : value, pPrevious->pClosure);
+}
+
+GBL_TEST_CASE(bisect) {
+    EvmuDevice*           pDevice  = pFixture->pDevice;
+    EvmuDevice*           pOther   = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuJournal*          pJournal = EvmuJournal_create(pDevice);
+    EvmuJournalDivergence divergence;
+    EvmuMemoryHandler     previous;
+    EvmuMemoryHandler     handler  = {
+        EvmuJournalTestSuite_skipRead_,
+        EvmuJournalTestSuite_skipWrite_,
+        &previous
+    };
+
+    GBL_TEST_CALL(EvmuJournal_record(pJournal));
+
+    for(GblSize s = 0; s < 40; ++s) {
+        pDevice->pGamepad->a = (s / 4) & 1;
+
+        if(s == 20)
+            EvmuDevice_runUntil(pDevice, 50, EVMU_DEVICE_STOP_NONE, NULL);
+
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 5000000));
+    }
+
+    GBL_TEST_CALL(EvmuJournal_stop(pJournal));
+
+    // Incrementally updated hashes match one taken from scratch
+    const uint64_t hash   = EvmuDevice_stateHash(pDevice);
+    EvmuDevice*    pClone = EvmuDevice_clone(pDevice);
+
+    GBL_TEST_COMPARE(EvmuDevice_stateHash(pDevice), hash);
+    GBL_TEST_COMPARE(EvmuDevice_stateHash(pClone), hash);
+    GBL_TEST_VERIFY(EvmuDevice_stateHash(pOther) != hash);
+    GBL_BOX_UNREF(pClone);
+
+    // Interpreting and running basic blocks never part ways
+    GBL_TEST_CALL(EvmuCpu_setExecMode(pOther->pCpu, EVMU_CPU_EXEC_MODE_BLOCK));
+    GBL_TEST_CALL(EvmuJournal_bisect(pJournal, pOther, &divergence));
+    GBL_TEST_VERIFY(!divergence.diverged);
+    GBL_TEST_COMPARE(divergence.address, EVMU_JOURNAL_ADDRESS_NONE);
+    GBL_TEST_COMPARE(EvmuDevice_stateHash(pOther), EvmuDevice_stateHash(pDevice));
+    GBL_TEST_COMPARE(EvmuJournal_mode(pJournal), EVMU_JOURNAL_MODE_IDLE);
+
+    // Skipping a count is pinned on the INC responsible and the address it left different
+    GBL_TEST_CALL(EvmuCpu_setExecMode(pOther->pCpu, EVMU_CPU_EXEC_MODE_INTERPRETER));
+    GBL_TEST_CALL(EvmuMemory_setHandler(pOther->pMemory, 0x12, &handler, &previous));
+    GBL_TEST_CALL(EvmuJournal_bisect(pJournal, pOther, &divergence));
+    GBL_TEST_VERIFY(divergence.diverged);
+    GBL_TEST_VERIFY(divergence.event < EvmuJournal_count(pJournal));
+    GBL_TEST_VERIFY(divergence.step > 0);
+    GBL_TEST_COMPARE(divergence.pc, 0x0007);
+    GBL_TEST_COMPARE(divergence.pcAfter[0], divergence.pcAfter[1]);
+    GBL_TEST_COMPARE(divergence.address, 0x12);
+    GBL_TEST_COMPARE(divergence.bank, 0);
+
+    // Nor can a device be bisected against itself
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(EvmuJournal_bisect(pJournal, pDevice, &divergence), GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(EvmuJournal_unref(pJournal), 0);
+    GBL_BOX_UNREF(pOther);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(replay,
+                  badChecksum,
+                  bisect);
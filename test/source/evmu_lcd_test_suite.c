@@ -0,0 +1,361 @@
+#include "evmu_lcd_test_suite.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_lcd.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <string.h>
+#ifndef __STDC_NO_THREADS__
+#   include <threads.h>
+#   include <stdatomic.h>
+#endif
+
+#define GBL_TEST_SUITE_SELF EvmuLcdTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuDevice* pDevice;
+    EvmuLcd*    pLcd;
+    EvmuMemory* pMemory;
+};
+
+GBL_TEST_INIT() {
+    pFixture->pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    pFixture->pLcd    = pFixture->pDevice->pLcd;
+    pFixture->pMemory = pFixture->pDevice->pMemory;
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    GBL_BOX_UNREF(pFixture->pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(dirtyRows) {
+    EvmuLcd*       pLcd      = pFixture->pLcd;
+    EvmuIBehavior* pBehavior = EVMU_IBEHAVIOR(pLcd);
+
+    EvmuLcd_setRefreshEnabled(pLcd, GBL_TRUE);
+    pLcd->ghostingEnabled = GBL_TRUE;
+
+    const EvmuTicks refresh = EvmuLcd_refreshRateTicks(pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+
+    // Once drawn, a screen nothing writes to stays as it was
+    GBL_TEST_CALL(EvmuIBehavior_update(pBehavior, refresh));
+    pLcd->screenChanged = GBL_FALSE;
+    GBL_TEST_CALL(EvmuIBehavior_update(pBehavior, refresh));
+    GBL_TEST_VERIFY(!pLcd->screenChanged);
+
+    // Writing XRAM redraws its row, which keeps changing while the new pixel fades in
+    EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_XBNK, EVMU_XRAM_BANK_LCD_TOP);
+    EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SEGMENT_XRAM_BASE, 0x80);
+
+    GBL_TEST_CALL(EvmuIBehavior_update(pBehavior, refresh));
+    GBL_TEST_VERIFY(pLcd->screenChanged);
+    const uint8_t fading = EvmuLcd_decoratedPixel(pLcd, 0, 0);
+
+    pLcd->screenChanged = GBL_FALSE;
+    GBL_TEST_CALL(EvmuIBehavior_update(pBehavior, refresh));
+    GBL_TEST_VERIFY(pLcd->screenChanged);
+    GBL_TEST_VERIFY(EvmuLcd_decoratedPixel(pLcd, 0, 0) != fading);
+
+    // Until it's done fading
+    GBL_TEST_CALL(EvmuIBehavior_update(pBehavior, refresh * EVMU_LCD_GHOSTING_FRAMES));
+    const uint8_t settled = EvmuLcd_decoratedPixel(pLcd, 0, 0);
+
+    pLcd->screenChanged = GBL_FALSE;
+    GBL_TEST_CALL(EvmuIBehavior_update(pBehavior, refresh));
+    GBL_TEST_VERIFY(!pLcd->screenChanged);
+    GBL_TEST_COMPARE(EvmuLcd_decoratedPixel(pLcd, 0, 0), settled);
+    GBL_TEST_VERIFY(EvmuLcd_pixel(pLcd, 0, 0));
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(decoratedFrame) {
+    EvmuLcd*        pLcd    = pFixture->pLcd;
+    const EvmuTicks refresh = EvmuLcd_refreshRateTicks(pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+    uint8_t         frame[EVMU_LCD_PIXEL_HEIGHT][EVMU_LCD_PIXEL_WIDTH];
+
+    EvmuLcd_setRefreshEnabled(pLcd, GBL_TRUE);
+    pLcd->ghostingEnabled = GBL_TRUE;
+
+    // Something mid-fade around the edges and corners, where filtering samples differently
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            EvmuLcd_setPixel(pLcd, x, y, (x * 7 + y * 3) % 5 < 2);
+
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh * 40));
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            EvmuLcd_setPixel(pLcd, x, y, (x + y) % 3 == 0);
+
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh * 15));
+
+    for(int mode = 0; mode < 4; ++mode) {
+        pLcd->filterEnabled = !!(mode & 1);
+        pLcd->invertColors  = !!(mode & 2);
+
+        EvmuLcd_decoratedFrame(pLcd, &frame[0][0]);
+
+        for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+            for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+                GBL_TEST_COMPARE(frame[y][x], EvmuLcd_decoratedPixel(pLcd, x, y));
+    }
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(neverDrawn) {
+    EvmuLcd* pLcd = pFixture->pLcd;
+    uint8_t  frame[EVMU_LCD_PIXEL_HEIGHT][EVMU_LCD_PIXEL_WIDTH];
+
+    // Nothing has been drawn since the reset, so every pixel is blank, not saturated
+    GBL_TEST_CALL(EvmuIBehavior_reset(EVMU_IBEHAVIOR(pLcd)));
+
+    for(int mode = 0; mode < 4; ++mode) {
+        pLcd->filterEnabled = !!(mode & 1);
+        pLcd->invertColors  = !!(mode & 2);
+
+        const uint8_t blank = pLcd->invertColors? 0x00 : 0xff;
+
+        EvmuLcd_decoratedFrame(pLcd, &frame[0][0]);
+
+        for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y) {
+            for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x) {
+                GBL_TEST_COMPARE(EvmuLcd_decoratedPixel(pLcd, x, y), blank);
+                GBL_TEST_COMPARE(frame[y][x], blank);
+            }
+        }
+    }
+
+    pLcd->filterEnabled = GBL_FALSE;
+    pLcd->invertColors  = GBL_FALSE;
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(copyFramebuffer) {
+    EvmuLcd*        pLcd    = pFixture->pLcd;
+    const EvmuTicks refresh = EvmuLcd_refreshRateTicks(pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+    uint8_t         packed[EVMU_LCD_PIXEL_HEIGHT + EVMU_LCD_ICON_ROWS][8];
+    uint8_t         gray[EVMU_LCD_PIXEL_HEIGHT][EVMU_LCD_PIXEL_WIDTH];
+    uint8_t         rgba[EVMU_LCD_PIXEL_HEIGHT][EVMU_LCD_PIXEL_WIDTH * 4];
+
+    EvmuLcd_setRefreshEnabled(pLcd, GBL_TRUE);
+    EvmuLcd_setIcons(pLcd, EVMU_LCD_ICON_FLASH);
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            EvmuLcd_setPixel(pLcd, x, y, (x ^ y) & 1);
+
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+
+    GBL_TEST_CALL(EvmuLcd_copyFramebuffer(pLcd, EVMU_LCD_FORMAT_1BPP | EVMU_LCD_FORMAT_ICONS, packed, 8));
+    GBL_TEST_CALL(EvmuLcd_copyFramebuffer(pLcd, EVMU_LCD_FORMAT_GRAY8, gray, 0));
+    GBL_TEST_CALL(EvmuLcd_copyFramebuffer(pLcd, EVMU_LCD_FORMAT_RGBA8888, rgba, 0));
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y) {
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x) {
+            GBL_TEST_COMPARE(!!(packed[y][x / 8] & (0x80 >> (x % 8))), EvmuLcd_pixel(pLcd, x, y));
+            GBL_TEST_COMPARE(gray[y][x], EvmuLcd_decoratedPixel(pLcd, x, y));
+            GBL_TEST_COMPARE(rgba[y][x * 4 + 1], gray[y][x]);
+            GBL_TEST_COMPARE(rgba[y][x * 4 + 3], 0xff);
+        }
+    }
+
+    // Only the last quarter of the icon rows has anything, for the flash icon
+    for(size_t y = EVMU_LCD_PIXEL_HEIGHT; y < EVMU_LCD_PIXEL_HEIGHT + EVMU_LCD_ICON_ROWS; ++y)
+        GBL_TEST_VERIFY(!packed[y][0] && !packed[y][1] && !packed[y][2] && !packed[y][3] && !(packed[y][4] & 0xf0));
+    GBL_TEST_VERIFY(packed[EVMU_LCD_PIXEL_HEIGHT][4] | packed[EVMU_LCD_PIXEL_HEIGHT][5]);
+
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(EvmuLcd_copyFramebuffer(pLcd, EVMU_LCD_FORMAT_GRAY8, gray, 8),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(scrolledFramebuffer) {
+    EvmuLcd*        pLcd    = pFixture->pLcd;
+    const EvmuTicks refresh = EvmuLcd_refreshRateTicks(pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+    const EvmuWord  stads[] = { 0x03, 0x43 };   // one row down, then across the bank boundary
+    uint8_t         packed[EVMU_LCD_PIXEL_HEIGHT][8];
+    uint8_t         unscrolled[EVMU_LCD_PIXEL_HEIGHT][8];
+
+    EvmuLcd_setRefreshEnabled(pLcd, GBL_TRUE);
+    pLcd->ghostingEnabled = GBL_FALSE;
+    pLcd->filterEnabled   = GBL_FALSE;
+    pLcd->invertColors    = GBL_FALSE;
+
+    // No two rows alike, so any scroll shows up
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            EvmuLcd_setPixel(pLcd, x, y, (x * 3 + y * 5) % 7 < 3);
+
+    EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_STAD, 0);
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+    GBL_TEST_CALL(EvmuLcd_copyFramebuffer(pLcd, EVMU_LCD_FORMAT_1BPP, unscrolled, 0));
+
+    // Packed pixels are the ones a refresh puts on the screen, not the ones at the top of XRAM
+    for(size_t s = 0; s < GBL_COUNT_OF(stads); ++s) {
+        EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_STAD, stads[s]);
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+        GBL_TEST_CALL(EvmuLcd_copyFramebuffer(pLcd, EVMU_LCD_FORMAT_1BPP, packed, 0));
+
+        for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+            for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+                GBL_TEST_COMPARE(!!(packed[y][x / 8] & (0x80 >> (x % 8))),
+                                 EvmuLcd_decoratedPixel(pLcd, x, y) == 0);
+
+        GBL_TEST_VERIFY(memcmp(packed, unscrolled, sizeof(packed)) != 0);
+    }
+
+    EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_STAD, 0);
+    pLcd->ghostingEnabled = GBL_TRUE;
+
+    GBL_TEST_CASE_END;
+}
+
+#define EVMU_LCD_TEST_SUITE_FRAMES_  500
+
+#ifndef __STDC_NO_THREADS__
+typedef struct EvmuLcdTestSuiteReader_ {
+    EvmuLcd*    pLcd;
+    atomic_bool done;
+    size_t      frames;     // distinct frames acquired
+} EvmuLcdTestSuiteReader_;
+
+// Reads frames as fast as it can until told to stop, failing on any which isn't one solid color
+static int EvmuLcdTestSuite_frameReader_(void* pArg) {
+    EvmuLcdTestSuiteReader_* pReader = pArg;
+    const uint8_t*           pPrev   = NULL;
+
+    while(!atomic_load(&pReader->done)) {
+        const uint8_t* pFrame = EvmuLcd_acquireFrame(pReader->pLcd);
+        if(!pFrame || pFrame == pPrev) continue;
+
+        for(size_t p = 1; p < EVMU_LCD_PIXEL_WIDTH * EVMU_LCD_PIXEL_HEIGHT; ++p)
+            if(pFrame[p] != pFrame[0]) return 1;
+
+        pPrev = pFrame;
+        ++pReader->frames;
+    }
+
+    return 0;
+}
+#endif
+
+GBL_TEST_CASE(frameQueue) {
+    EvmuLcd*        pLcd    = pFixture->pLcd;
+    const EvmuTicks refresh = EvmuLcd_refreshRateTicks(pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+
+    EvmuLcd_setRefreshEnabled(pLcd, GBL_TRUE);
+    pLcd->ghostingEnabled = GBL_FALSE;
+    pLcd->filterEnabled   = GBL_FALSE;
+
+    // Nothing is published until someone asks
+    GBL_TEST_COMPARE(EvmuLcd_acquireFrame(pLcd), NULL);
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+
+    const uint8_t* pFrame = EvmuLcd_acquireFrame(pLcd);
+    GBL_TEST_VERIFY(pFrame);
+    GBL_TEST_COMPARE(pFrame[0], EvmuLcd_decoratedPixel(pLcd, 0, 0));
+
+    // Refreshes leave the held frame alone, and it's kept until something newer comes along
+    EvmuLcd_setPixel(pLcd, 0, 0, !EvmuLcd_pixel(pLcd, 0, 0));
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+    GBL_TEST_VERIFY(pFrame[0] != EvmuLcd_decoratedPixel(pLcd, 0, 0));
+
+    const uint8_t* pNext = EvmuLcd_acquireFrame(pLcd);
+    GBL_TEST_VERIFY(pNext != pFrame);
+    GBL_TEST_COMPARE(pNext[0], EvmuLcd_decoratedPixel(pLcd, 0, 0));
+    GBL_TEST_COMPARE(EvmuLcd_acquireFrame(pLcd), pNext);
+
+    // Flashing the whole screen while another thread reads, which must never see half of one
+#ifndef __STDC_NO_THREADS__
+    EvmuLcdTestSuiteReader_ reader = { .pLcd = pLcd };
+    thrd_t                  thread;
+    int                     result = -1;
+
+    for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+        for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+            EvmuLcd_setPixel(pLcd, x, y, GBL_FALSE);
+
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+    GBL_TEST_VERIFY(EvmuLcd_acquireFrame(pLcd));
+
+    atomic_init(&reader.done, false);
+    GBL_TEST_COMPARE(thrd_create(&thread, EvmuLcdTestSuite_frameReader_, &reader), thrd_success);
+
+    for(size_t f = 0; f < EVMU_LCD_TEST_SUITE_FRAMES_; ++f) {
+        for(size_t y = 0; y < EVMU_LCD_PIXEL_HEIGHT; ++y)
+            for(size_t x = 0; x < EVMU_LCD_PIXEL_WIDTH; ++x)
+                EvmuLcd_setPixel(pLcd, x, y, f & 1);
+
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+    }
+
+    atomic_store(&reader.done, true);
+    thrd_join(thread, &result);
+
+    GBL_TEST_COMPARE(result, 0);
+    GBL_TEST_VERIFY(reader.frames);
+#endif
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(hashLog) {
+    EvmuLcd*        pLcd    = pFixture->pLcd;
+    const EvmuTicks refresh = EvmuLcd_refreshRateTicks(pLcd) * EVMU_LCD_SCREEN_REFRESH_DIVISOR;
+    uint64_t        golden[8];
+    size_t          count   = 0;
+
+    EvmuLcd_setRefreshEnabled(pLcd, GBL_TRUE);
+    EvmuLcd_setHashLogging(pLcd, GBL_TRUE);
+    GBL_TEST_VERIFY(EvmuLcd_hashLogging(pLcd));
+
+    // Every refresh is logged, static or not, and nothing is drawn
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh * 4));
+    EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SFR_XBNK, EVMU_XRAM_BANK_LCD_BOTTOM);
+    EvmuMemory_writeData(pFixture->pMemory, EVMU_ADDRESS_SEGMENT_XRAM_BASE + 0x1b, 0x42);
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh * 2));
+    EvmuLcd_setIcons(pLcd, EvmuLcd_icons(pLcd) ^ EVMU_LCD_ICON_CLOCK);
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh * 2));
+
+    const uint64_t* pHashes = EvmuLcd_hashLog(pLcd, &count);
+    GBL_TEST_COMPARE(count, 8);
+    GBL_TEST_COMPARE(pHashes[0], pHashes[3]);
+    GBL_TEST_VERIFY(pHashes[3] != pHashes[4]);
+    GBL_TEST_COMPARE(pHashes[4], pHashes[5]);
+    GBL_TEST_VERIFY(pHashes[5] != pHashes[6]);
+    GBL_TEST_COMPARE(pHashes[7], EvmuLcd_frameHash(pLcd));
+
+    // Comparing against a golden log points out the first frame that differs
+    memcpy(golden, pHashes, sizeof(golden));
+    GBL_TEST_COMPARE(EvmuLcd_compareHashLog(pLcd, golden, 8), GBL_NPOS);
+    GBL_TEST_COMPARE(EvmuLcd_compareHashLog(pLcd, golden, 6), 6);
+    golden[5] ^= 1;
+    GBL_TEST_COMPARE(EvmuLcd_compareHashLog(pLcd, golden, 8), 5);
+
+    EvmuLcd_clearHashLog(pLcd);
+    EvmuLcd_hashLog(pLcd, &count);
+    GBL_TEST_COMPARE(count, 0);
+
+    EvmuLcd_setHashLogging(pLcd, GBL_FALSE);
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pLcd), refresh));
+    EvmuLcd_hashLog(pLcd, &count);
+    GBL_TEST_COMPARE(count, 0);
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(dirtyRows,
+                  decoratedFrame,
+                  neverDrawn,
+                  copyFramebuffer,
+                  scrolledFramebuffer,
+                  frameQueue,
+                  hashLog);
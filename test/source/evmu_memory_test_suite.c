@@ -251,6 +251,142 @@ GBL_RESULT EvmuMemoryTestSuite_xramBankChange_(GblTestSuite* pSelf, GblContext*
     GBL_CTX_END();
 }
 
+static EvmuWord EvmuMemoryTestSuite_readHandler_(EvmuMemory* pMemory, EvmuAddress address, void* pClosure) {
+    const EvmuMemoryHandler* pPrevious = pClosure;
+    return pPrevious->pFnRead(pMemory, address, pPrevious->pClosure) ^ 0xff;
+}
+
+static EVMU_RESULT EvmuMemoryTestSuite_writeHandler_(EvmuMemory* pMemory, EvmuAddress address, EvmuWord value, void* pClosure) {
+    const EvmuMemoryHandler* pPrevious = pClosure;
+    return pPrevious->pFnWrite(pMemory, address, value + 1, pPrevious->pClosure);
+}
+
+GBL_RESULT EvmuMemoryTestSuite_handler_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    EvmuMemoryTestSuite_* pSelf_ = EVMU_MEMORY_TEST_SUITE_(pSelf);
+    EvmuMemoryHandler     previous;
+    EvmuMemoryHandler     handler = {
+        EvmuMemoryTestSuite_readHandler_,
+        EvmuMemoryTestSuite_writeHandler_,
+        &previous
+    };
+
+    GBL_TEST_EXPECT_ERROR();
+    GBL_TEST_COMPARE(EvmuMemory_setHandler(pSelf_->pMemory, 0x200, &handler, NULL),
+                     GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pSelf_->pMemory, 0x20, &handler, &previous));
+    GBL_TEST_VERIFY(EvmuMemory_handler(pSelf_->pMemory, 0x20).pFnRead == EvmuMemoryTestSuite_readHandler_);
+
+    GBL_CTX_VERIFY_CALL(EvmuMemory_writeData(pSelf_->pMemory, 0x20, 0x10));
+    GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, 0x20), 0xee);
+
+    // Chained handlers still see the underlying storage
+    GBL_CTX_VERIFY_CALL(EvmuMemory_setHandler(pSelf_->pMemory, 0x20, &previous, NULL));
+    GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, 0x20), 0x11);
+
+    GBL_CTX_END();
+}
+
+// Runs a single instruction operating on the given address through the CPU's memory fast path
+static EVMU_RESULT EvmuMemoryTestSuite_execute_(EvmuMemoryTestSuite_* pSelf_,
+                                               EvmuWord              opcode,
+                                               EvmuAddress           address,
+                                               EvmuWord              immediate)
+{
+    return EvmuCpu_execute(pSelf_->pDevice->pCpu,
+                           &(const EvmuDecodedInstruction) {
+                               .opcode   = opcode,
+                               .operands = {
+                                   .direct    = address,
+                                   .indirect  = address,
+                                   .immediate = immediate
+                               }
+                           });
+}
+
+GBL_RESULT EvmuMemoryTestSuite_fastPath_(GblTestSuite* pSelf, GblContext* pCtx) {
+    GBL_CTX_BEGIN(pCtx);
+
+    EvmuMemoryTestSuite_* pSelf_ = EVMU_MEMORY_TEST_SUITE_(pSelf);
+    const EvmuWord        psw    = EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_PSW);
+    const EvmuWord        xbnk   = EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_XBNK);
+
+    // Both RAM banks, each side writing what the other reads back
+    for(EvmuWord bank = 0; bank < EVMU_ADDRESS_SEGMENT_RAM_BANKS; ++bank) {
+        EvmuMemory_writeData(pSelf_->pMemory,
+                             EVMU_ADDRESS_SFR_PSW,
+                             bank? psw | EVMU_SFR_PSW_RAMBK0_MASK : psw & ~EVMU_SFR_PSW_RAMBK0_MASK);
+
+        for(EvmuAddress a = EVMU_ADDRESS_SEGMENT_RAM_BASE; a <= EVMU_ADDRESS_SEGMENT_RAM_END; ++a) {
+            const EvmuWord value = (EvmuWord)(a ^ (bank? 0xa5 : 0x5a));
+
+            GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_MOV, a, value));
+            GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, a), value);
+
+            GBL_CTX_VERIFY_CALL(EvmuMemory_writeData(pSelf_->pMemory, a, (EvmuWord)~value));
+            GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_LD, a, 0));
+            GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_ACC), (EvmuWord)~value);
+        }
+
+        // Indirect pointers, from every register bank
+        for(EvmuWord irbk = 0; irbk < 4; ++irbk) {
+            EvmuMemory_writeData(pSelf_->pMemory,
+                                 EVMU_ADDRESS_SFR_PSW,
+                                 (EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_PSW) &
+                                  ~(EVMU_SFR_PSW_IRBK0_MASK|EVMU_SFR_PSW_IRBK1_MASK)) |
+                                 (irbk << 3));
+
+            for(uint8_t mode = 0; mode < 2; ++mode) {
+                const EvmuAddress target = EvmuMemory_indirectAddress(pSelf_->pMemory, mode);
+
+                GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_LD_IND, mode, 0));
+                GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_ACC),
+                                 EvmuMemory_readData(pSelf_->pMemory, target));
+            }
+        }
+    }
+
+    EvmuMemory_writeData(pSelf_->pMemory, EVMU_ADDRESS_SFR_PSW, psw);
+
+    // Every SFR reads the same, peeking at VTRBF so its auto-increment can't get in the way
+    for(EvmuAddress a = EVMU_ADDRESS_SEGMENT_SFR_BASE; a <= EVMU_ADDRESS_SEGMENT_SFR_END; ++a) {
+        const EvmuWord value = EvmuMemory_viewData(pSelf_->pMemory, a);
+
+        GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_LD, a, 0));
+        GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_ACC), value);
+    }
+
+    // Every XRAM bank
+    for(EvmuWord bank = 0; bank < EVMU_ADDRESS_SEGMENT_XRAM_BANKS; ++bank) {
+        EvmuMemory_writeData(pSelf_->pMemory, EVMU_ADDRESS_SFR_XBNK, bank);
+
+        for(EvmuAddress a = EVMU_ADDRESS_SEGMENT_XRAM_BASE; a <= EVMU_ADDRESS_SEGMENT_XRAM_END; ++a) {
+            const EvmuWord value = (EvmuWord)(a + bank);
+
+            GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_MOV, a, value));
+            GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, a), value);
+
+            GBL_CTX_VERIFY_CALL(EvmuMemory_writeData(pSelf_->pMemory, a, (EvmuWord)~value));
+            GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_LD, a, 0));
+            GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_ACC), (EvmuWord)~value);
+        }
+    }
+
+    // Banks really are distinct on both paths
+    for(EvmuWord bank = 0; bank < EVMU_ADDRESS_SEGMENT_XRAM_BANKS; ++bank) {
+        EvmuMemory_writeData(pSelf_->pMemory, EVMU_ADDRESS_SFR_XBNK, bank);
+        GBL_CTX_VERIFY_CALL(EvmuMemoryTestSuite_execute_(pSelf_, EVMU_OPCODE_LD, EVMU_ADDRESS_SEGMENT_XRAM_BASE, 0));
+        GBL_TEST_COMPARE(EvmuMemory_readData(pSelf_->pMemory, EVMU_ADDRESS_SFR_ACC),
+                         (EvmuWord)~(EVMU_ADDRESS_SEGMENT_XRAM_BASE + bank));
+    }
+
+    EvmuMemory_writeData(pSelf_->pMemory, EVMU_ADDRESS_SFR_XBNK, xbnk);
+
+    GBL_CTX_END();
+}
 
 GBL_EXPORT GblType EvmuMemoryTestSuite_type(void) {
     static GblType type = GBL_INVALID_TYPE;
@@ -268,6 +404,8 @@ GBL_EXPORT GblType EvmuMemoryTestSuite_type(void) {
         { "wramWrite",             EvmuMemoryTestSuite_wramWrite_             },
         { "xramBankChangeInvalid", EvmuMemoryTestSuite_xramBankChangeInvalid_ },
         { "xramBankChange",        EvmuMemoryTestSuite_xramBankChange_        },
+        { "handler",               EvmuMemoryTestSuite_handler_               },
+        { "fastPath",              EvmuMemoryTestSuite_fastPath_              },
         { NULL,                    NULL                                       },
     };
 
@@ -0,0 +1,118 @@
+#include "evmu_profiler_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_isa.h>
+#include <string.h>
+
+#define GBL_TEST_SUITE_SELF EvmuProfilerTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuDevice* pDevice;    // call loop reloaded from the top by each case
+};
+
+GBL_TEST_INIT() {
+    pFixture->pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    GBL_BOX_UNREF(pFixture->pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(profile) {
+    EvmuDevice*     pDevice = pFixture->pDevice;
+    GblStringBuffer buffer;
+
+    EvmuTestDevice_loadCallLoop(pDevice);
+
+    GBL_TEST_VERIFY(!EvmuCpu_profiling(pDevice->pCpu));
+    GBL_TEST_CALL(EvmuCpu_setProfiling(pDevice->pCpu, GBL_TRUE));
+
+    for(GblSize i = 0; i < 400; ++i)
+        EvmuCpu_runNext(pDevice->pCpu);
+
+    GBL_TEST_CALL(EvmuCpu_setProfiling(pDevice->pCpu, GBL_FALSE));
+    EvmuCpu_runNext(pDevice->pCpu);
+
+    GBL_TEST_COMPARE(EvmuCpu_profileCount(pDevice->pCpu, 0x0000), 100);
+    GBL_TEST_COMPARE(EvmuCpu_profileCount(pDevice->pCpu, 0x0010), 100);
+    GBL_TEST_COMPARE(EvmuCpu_profileCycles(pDevice->pCpu, 0x0000),
+                     100 * EvmuIsa_format(EVMU_OPCODE_CALLF)->cc);
+
+    GblStringBuffer_construct(&buffer);
+
+    GBL_TEST_CALL(EvmuCpu_writeProfile(pDevice->pCpu, EVMU_CPU_PROFILE_FORMAT_COLLAPSED, &buffer));
+    GBL_TEST_VERIFY(strstr(GblStringBuffer_cString(&buffer), "root;flash:0x0010 "));
+
+    GblStringBuffer_clear(&buffer);
+    GBL_TEST_CALL(EvmuCpu_writeProfile(pDevice->pCpu, EVMU_CPU_PROFILE_FORMAT_CALL_GRAPH, &buffer));
+    GBL_TEST_VERIFY(strstr(GblStringBuffer_cString(&buffer), "flash:0x0010"));
+
+    GblStringBuffer_destruct(&buffer);
+    GBL_TEST_CASE_END;
+}
+
+typedef struct EvmuProfilerTestTrace_ {
+    EvmuPc pcs[64];
+    size_t count;
+    size_t flushes;
+} EvmuProfilerTestTrace_;
+
+static void EvmuProfilerTestSuite_traceFlush_(EvmuCpu* pCpu, const EvmuPc* pPcs, size_t count, void* pClosure) {
+    GBL_UNUSED(pCpu);
+    EvmuProfilerTestTrace_* pTrace = pClosure;
+
+    for(size_t p = 0; p < count && pTrace->count < GBL_COUNT_OF(pTrace->pcs); ++p)
+        pTrace->pcs[pTrace->count++] = pPcs[p];
+
+    ++pTrace->flushes;
+}
+
+GBL_TEST_CASE(trace) {
+    // CALLF, NOP, RET, BR
+    const EvmuPc           expected[] = { 0x0000, 0x0010, 0x0011, 0x0003 };
+    EvmuDevice*            pDevice    = pFixture->pDevice;
+    EvmuProfilerTestTrace_ trace      = { 0 };
+    EvmuPc                 recent[3];
+
+    EvmuTestDevice_loadCallLoop(pDevice);
+
+    // Batched: the callback only sees full buffers, plus whatever is left when flushed
+    GBL_TEST_CALL(EvmuCpu_setTrace(pDevice->pCpu, 3, EvmuProfilerTestSuite_traceFlush_, &trace));
+    GBL_TEST_COMPARE(EvmuCpu_traceCapacity(pDevice->pCpu), 3);
+
+    for(GblSize i = 0; i < 10; ++i)
+        EvmuCpu_runNext(pDevice->pCpu);
+
+    GBL_TEST_COMPARE(trace.flushes, 3);
+    GBL_TEST_COMPARE(trace.count, 9);
+
+    EvmuCpu_flushTrace(pDevice->pCpu);
+
+    GBL_TEST_COMPARE(trace.flushes, 4);
+    GBL_TEST_COMPARE(trace.count, 10);
+
+    for(GblSize i = 0; i < trace.count; ++i)
+        GBL_TEST_COMPARE(trace.pcs[i], expected[i % GBL_COUNT_OF(expected)]);
+
+    // Unbatched: the ring just keeps the most recent history
+    GBL_TEST_CALL(EvmuCpu_setTrace(pDevice->pCpu, 8, NULL, NULL));
+
+    for(GblSize i = 0; i < 10; ++i)
+        EvmuCpu_runNext(pDevice->pCpu);
+
+    GBL_TEST_COMPARE(EvmuCpu_trace(pDevice->pCpu, recent, GBL_COUNT_OF(recent)), 3);
+    GBL_TEST_COMPARE(recent[0], 0x0010);
+    GBL_TEST_COMPARE(recent[1], 0x0011);
+    GBL_TEST_COMPARE(recent[2], 0x0003);
+
+    GBL_TEST_CALL(EvmuCpu_setTrace(pDevice->pCpu, 0, NULL, NULL));
+    GBL_TEST_COMPARE(EvmuCpu_trace(pDevice->pCpu, recent, GBL_COUNT_OF(recent)), 0);
+
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(profile,
+                  trace);
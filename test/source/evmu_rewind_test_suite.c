@@ -0,0 +1,130 @@
+#include "evmu_rewind_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <evmu/types/evmu_rewind.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GBL_TEST_SUITE_SELF EvmuRewindTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuDevice* pDevice;    // already part way through the workload
+};
+
+GBL_TEST_INIT() {
+    pFixture->pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuTestDevice_loadWorkload(pFixture->pDevice, 0);
+    GBL_TEST_CALL(EvmuTestDevice_run(pFixture->pDevice, 20));
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    GBL_BOX_UNREF(pFixture->pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(ring) {
+    EvmuDevice*  pDevice  = pFixture->pDevice;
+    EvmuRewind*  pRewind  = EvmuRewind_create(pDevice, 4);
+    const size_t size     = EvmuDevice_stateSize(pDevice);
+    uint8_t*     pStates  = malloc(size * 7);
+    uint8_t*     pCurrent = malloc(size);
+
+    // Every capture also gets a full save state, which restoring must reproduce byte for byte
+    for(GblSize s = 0; s < 7; ++s) {
+        GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 50000));
+        GBL_TEST_CALL(EvmuFlash_writeByte(pDevice->pFlash, 0x1000 + s * 0x200, s + 1));
+        GBL_TEST_CALL(EvmuRewind_capture(pRewind));
+        GBL_TEST_CALL(EvmuDevice_saveState(pDevice, &pStates[s * size], size));
+    }
+
+    GBL_TEST_COMPARE(EvmuRewind_count(pRewind), 4);
+    GBL_TEST_VERIFY(EvmuRewind_bytes(pRewind) < size * 2);
+
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 50000));
+    GBL_TEST_CALL(EvmuRewind_restore(pRewind, 1));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pCurrent, size));
+    GBL_TEST_VERIFY(!memcmp(pCurrent, &pStates[5 * size], size));
+    GBL_TEST_COMPARE(EvmuRewind_count(pRewind), 3);
+
+    GBL_TEST_CALL(EvmuRewind_restore(pRewind, 2));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pCurrent, size));
+    GBL_TEST_VERIFY(!memcmp(pCurrent, &pStates[3 * size], size));
+    GBL_TEST_COMPARE(EvmuRewind_count(pRewind), 1);
+
+    // Replaying from there lands exactly where it did the first time
+    GBL_TEST_CALL(EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 50000));
+    GBL_TEST_CALL(EvmuFlash_writeByte(pDevice->pFlash, 0x1000 + 4 * 0x200, 5));
+    GBL_TEST_CALL(EvmuRewind_capture(pRewind));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pCurrent, size));
+    GBL_TEST_VERIFY(!memcmp(pCurrent, &pStates[4 * size], size));
+
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(EvmuRewind_restore(pRewind, 2),
+                     GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    free(pCurrent);
+    free(pStates);
+    GBL_TEST_COMPARE(EvmuRewind_unref(pRewind), 0);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(pastOldest) {
+    EvmuDevice*  pDevice  = pFixture->pDevice;
+    EvmuRewind*  pRewind  = EvmuRewind_create(pDevice, 3);
+    const size_t size     = EvmuDevice_stateSize(pDevice);
+    uint8_t*     pStates  = malloc(size * 5);
+    uint8_t*     pCurrent = malloc(size * 2);
+
+    GBL_TEST_VERIFY(pStates && pCurrent);
+
+    GBL_TEST_EXPECT_ERROR();
+
+    // Nothing captured yet, so not even the newest snapshot exists
+    GBL_TEST_COMPARE(EvmuRewind_restore(pRewind, 0),
+                     GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    // Overrun the ring so the two oldest captures are dropped
+    for(GblSize s = 0; s < 5; ++s) {
+        GBL_TEST_CALL(EvmuTestDevice_run(pDevice, 1));
+        GBL_TEST_CALL(EvmuFlash_writeByte(pDevice->pFlash, 0x2000 + s * 0x200, s + 1));
+        GBL_TEST_CALL(EvmuRewind_capture(pRewind));
+        GBL_TEST_CALL(EvmuDevice_saveState(pDevice, &pStates[s * size], size));
+    }
+
+    GBL_TEST_COMPARE(EvmuRewind_count(pRewind), 3);
+    GBL_TEST_CALL(EvmuTestDevice_run(pDevice, 1));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pCurrent, size));
+
+    // Reaching back past the oldest one held neither moves the device nor drops snapshots
+    const size_t ages[] = { 3, 4, SIZE_MAX };
+
+    for(size_t a = 0; a < GBL_COUNT_OF(ages); ++a) {
+        GBL_TEST_COMPARE(EvmuRewind_restore(pRewind, ages[a]),
+                         GBL_RESULT_ERROR_OUT_OF_RANGE);
+        GBL_CTX_CLEAR_LAST_RECORD();
+
+        GBL_TEST_COMPARE(EvmuRewind_count(pRewind), 3);
+        GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pCurrent + size, size));
+        GBL_TEST_VERIFY(!memcmp(pCurrent, pCurrent + size, size));
+    }
+
+    // While the oldest one still there is the third capture, not the first
+    GBL_TEST_CALL(EvmuRewind_restore(pRewind, 2));
+    GBL_TEST_CALL(EvmuDevice_saveState(pDevice, pCurrent, size));
+    GBL_TEST_VERIFY(!memcmp(pCurrent, &pStates[2 * size], size));
+    GBL_TEST_COMPARE(EvmuRewind_count(pRewind), 1);
+
+    free(pCurrent);
+    free(pStates);
+    GBL_TEST_COMPARE(EvmuRewind_unref(pRewind), 0);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(ring,
+                  pastOldest);
@@ -0,0 +1,193 @@
+#include "evmu_state_test_suite.h"
+#include "evmu_test_device.h"
+#include <gimbal/test/gimbal_test_macros.h>
+#include <evmu/hw/evmu_device.h>
+#include <evmu/hw/evmu_address_space.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GBL_TEST_SUITE_SELF EvmuStateTestSuite
+
+GBL_TEST_FIXTURE {
+    EvmuDevice* pDevice;    // already part way through the workload, for the malformed state cases
+};
+
+GBL_TEST_INIT() {
+    pFixture->pDevice = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuTestDevice_loadWorkload(pFixture->pDevice, 0);
+    GBL_TEST_CALL(EvmuTestDevice_run(pFixture->pDevice, 20));
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_FINAL() {
+    GBL_BOX_UNREF(pFixture->pDevice);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(roundTrip) {
+    EvmuDevice*  pSource  = GBL_OBJECT_NEW(EvmuDevice);
+    EvmuDevice*  pRestore = GBL_OBJECT_NEW(EvmuDevice);
+    const size_t size     = EvmuDevice_stateSize(pSource);
+    uint8_t*     pState   = malloc(size);
+
+    EvmuTestDevice_loadWorkload(pSource, 0);
+
+    GBL_TEST_CALL(EvmuTestDevice_run(pSource, 20));
+
+    GBL_TEST_CALL(EvmuDevice_saveState(pSource, pState, size));
+
+    // Running on from the state, on the source and on a fresh device, must land in the same place
+    GBL_TEST_CALL(EvmuTestDevice_run(pSource, 30));
+
+    GBL_TEST_CALL(EvmuDevice_loadState(pRestore, pState, size));
+
+    GBL_TEST_CALL(EvmuTestDevice_run(pRestore, 30));
+
+    GBL_TEST_COMPARE(EvmuCpu_pc(pRestore->pCpu), EvmuCpu_pc(pSource->pCpu));
+
+    for(EvmuAddress a = 0; a < EVMU_ADDRESS_SEGMENT_SFR_BASE; ++a)
+        GBL_TEST_COMPARE(EvmuMemory_readData(pRestore->pMemory, a),
+                         EvmuMemory_readData(pSource->pMemory, a));
+
+    GBL_TEST_COMPARE(EvmuMemory_readData(pRestore->pMemory, EVMU_ADDRESS_SFR_ACC),
+                     EvmuMemory_readData(pSource->pMemory, EVMU_ADDRESS_SFR_ACC));
+    GBL_TEST_COMPARE(EvmuMemory_readData(pRestore->pMemory, EVMU_ADDRESS_SFR_PSW),
+                     EvmuMemory_readData(pSource->pMemory, EVMU_ADDRESS_SFR_PSW));
+    GBL_TEST_COMPARE(EvmuMemory_readData(pRestore->pMemory, EVMU_ADDRESS_SFR_T0L),
+                     EvmuMemory_readData(pSource->pMemory, EVMU_ADDRESS_SFR_T0L));
+
+    // Rolling the source back replays the same way
+    GBL_TEST_CALL(EvmuDevice_loadState(pSource, pState, size));
+
+    GBL_TEST_CALL(EvmuTestDevice_run(pSource, 30));
+
+    GBL_TEST_COMPARE(EvmuCpu_pc(pSource->pCpu), EvmuCpu_pc(pRestore->pCpu));
+
+    for(EvmuAddress a = 0; a < EVMU_ADDRESS_SEGMENT_SFR_BASE; ++a)
+        GBL_TEST_COMPARE(EvmuMemory_readData(pSource->pMemory, a),
+                         EvmuMemory_readData(pRestore->pMemory, a));
+
+    // Undersized buffers and malformed states are rejected without touching the device
+    GBL_TEST_EXPECT_ERROR();
+
+    GBL_TEST_COMPARE(EvmuDevice_saveState(pSource, pState, size - 1),
+                     GBL_RESULT_ERROR_OUT_OF_RANGE);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    const EvmuPc pc = EvmuCpu_pc(pSource->pCpu);
+    pState[0] ^= 0xff;
+
+    GBL_TEST_COMPARE(EvmuDevice_loadState(pSource, pState, size),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    pState[0] ^= 0xff;
+
+    GBL_TEST_COMPARE(EvmuDevice_loadState(pSource, pState, size / 2),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    GBL_TEST_COMPARE(EvmuCpu_pc(pSource->pCpu), pc);
+
+    free(pState);
+    GBL_BOX_UNREF(pRestore);
+    GBL_BOX_UNREF(pSource);
+    GBL_TEST_CASE_END;
+}
+
+// Save states open with a 32-bit magic, then the 16-bit version, chunk count, and 32-bit total size
+#define EVMU_STATE_TEST_SUITE_VERSION_OFFSET_   4
+#define EVMU_STATE_TEST_SUITE_HEADER_SIZE_      12
+
+// Saves the device's state into a new buffer, returning it along with its size
+static uint8_t* EvmuStateTestSuite_save_(EvmuDevice* pDevice, size_t* pSize) {
+    *pSize = EvmuDevice_stateSize(pDevice);
+
+    uint8_t* pState = malloc(*pSize);
+
+    if(pState && !GBL_RESULT_SUCCESS(EvmuDevice_saveState(pDevice, pState, *pSize))) {
+        free(pState);
+        pState = NULL;
+    }
+
+    return pState;
+}
+
+GBL_TEST_CASE(truncated) {
+    size_t   size;
+    uint8_t* pState = EvmuStateTestSuite_save_(pFixture->pDevice, &size);
+    uint8_t* pAfter = malloc(size);
+
+    GBL_TEST_VERIFY(pState && pAfter);
+
+    GBL_TEST_EXPECT_ERROR();
+
+    // Cut off anywhere in the header, or anywhere short of the total it claims
+    for(size_t bytes = 0; bytes < EVMU_STATE_TEST_SUITE_HEADER_SIZE_; ++bytes) {
+        GBL_TEST_COMPARE(EvmuDevice_loadState(pFixture->pDevice, pState, bytes),
+                         GBL_RESULT_ERROR_INVALID_ARG);
+        GBL_CTX_CLEAR_LAST_RECORD();
+    }
+
+    GBL_TEST_COMPARE(EvmuDevice_loadState(pFixture->pDevice, pState, size - 1),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    // A chunk claiming to run past the end of the state
+    uint8_t* pChunkSize = &pState[EVMU_STATE_TEST_SUITE_HEADER_SIZE_ + 4];
+    const uint8_t chunkSize = pChunkSize[3];
+    pChunkSize[3] = 0xff;
+
+    GBL_TEST_COMPARE(EvmuDevice_loadState(pFixture->pDevice, pState, size),
+                     GBL_RESULT_ERROR_INVALID_ARG);
+    GBL_CTX_CLEAR_LAST_RECORD();
+
+    pChunkSize[3] = chunkSize;
+
+    // None of which touched the device
+    GBL_TEST_CALL(EvmuDevice_saveState(pFixture->pDevice, pAfter, size));
+    GBL_TEST_VERIFY(memcmp(pState, pAfter, size) == 0);
+
+    free(pAfter);
+    free(pState);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_CASE(wrongVersion) {
+    size_t   size;
+    uint8_t* pState = EvmuStateTestSuite_save_(pFixture->pDevice, &size);
+    uint8_t* pAfter = malloc(size);
+
+    GBL_TEST_VERIFY(pState && pAfter);
+
+    const uint16_t versions[] = { 0, EVMU_DEVICE_STATE_VERSION + 1, UINT16_MAX };
+
+    GBL_TEST_EXPECT_ERROR();
+
+    // Neither a state from before versioning nor one from the future is ever applied
+    for(size_t v = 0; v < GBL_COUNT_OF(versions); ++v) {
+        pState[EVMU_STATE_TEST_SUITE_VERSION_OFFSET_]     = versions[v] & 0xff;
+        pState[EVMU_STATE_TEST_SUITE_VERSION_OFFSET_ + 1] = versions[v] >> 8;
+
+        GBL_TEST_COMPARE(EvmuDevice_loadState(pFixture->pDevice, pState, size),
+                         GBL_RESULT_ERROR_INVALID_ARG);
+        GBL_CTX_CLEAR_LAST_RECORD();
+    }
+
+    GBL_TEST_CALL(EvmuDevice_saveState(pFixture->pDevice, pAfter, size));
+    GBL_TEST_COMPARE(pAfter[EVMU_STATE_TEST_SUITE_VERSION_OFFSET_], EVMU_DEVICE_STATE_VERSION & 0xff);
+    GBL_TEST_VERIFY(memcmp(pState + EVMU_STATE_TEST_SUITE_HEADER_SIZE_,
+                           pAfter + EVMU_STATE_TEST_SUITE_HEADER_SIZE_,
+                           size - EVMU_STATE_TEST_SUITE_HEADER_SIZE_) == 0);
+
+    // The version it's written with still loads
+    GBL_TEST_CALL(EvmuDevice_loadState(pFixture->pDevice, pAfter, size));
+
+    free(pAfter);
+    free(pState);
+    GBL_TEST_CASE_END;
+}
+
+GBL_TEST_REGISTER(roundTrip,
+                  truncated,
+                  wrongVersion);
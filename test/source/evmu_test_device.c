@@ -0,0 +1,75 @@
+#include "evmu_test_device.h"
+
+void EvmuTestDevice_writeProgram(EvmuDevice*     pDevice,
+                                 EvmuAddress     base,
+                                 const EvmuWord* pProgram,
+                                 size_t          bytes)
+{
+    for(size_t w = 0; w < bytes; ++w)
+        EvmuMemory_writeProgram(pDevice->pMemory, base + w, pProgram[w]);
+}
+
+EvmuDevice* EvmuTestDevice_create(EVMU_CPU_EXEC_MODE mode, const EvmuWord* pProgram, size_t bytes) {
+    EvmuDevice* pDevice = GBL_OBJECT_NEW(EvmuDevice);
+
+    if(!GBL_RESULT_SUCCESS(EvmuCpu_setExecMode(pDevice->pCpu, mode))) {
+        GBL_BOX_UNREF(pDevice);
+        return NULL;
+    }
+
+    EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+    EvmuTestDevice_writeProgram(pDevice, 0x0000, pProgram, bytes);
+    EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+
+    return pDevice;
+}
+
+void EvmuTestDevice_loadCallLoop(EvmuDevice* pDevice) {
+    // loop: CALLF sub; BR loop
+    const EvmuWord program[] = {
+        0x20, 0x00, 0x10,
+        0x01, 0xfb
+    };
+    // sub: NOP; RET
+    const EvmuWord subroutine[] = {
+        0x00,
+        0xa0
+    };
+
+    EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+    EvmuTestDevice_writeProgram(pDevice, 0x0000, program,    sizeof(program));
+    EvmuTestDevice_writeProgram(pDevice, 0x0010, subroutine, sizeof(subroutine));
+    EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+}
+
+void EvmuTestDevice_loadWorkload(EvmuDevice* pDevice, size_t seed) {
+    // MOV #n, 0x10; loop: ADD #k; ST 0x11; INC 0x12; XOR 0x12; ST @R0; DBNZ 0x10, loop; BR $
+    const EvmuWord program[] = {
+        0x22, 0x10, 40 + seed * 25,
+        0x81, 3 + seed,
+        0x12, 0x11,
+        0x62, 0x12,
+        0xf2, 0x12,
+        0x14,
+        0x52, 0x10, 0xf4,
+        0x01, 0xfe
+    };
+
+    EvmuMemory_setProgramSource(pDevice->pMemory, EVMU_MEMORY_EXT_SRC_FLASH_BANK_0);
+    EvmuTestDevice_writeProgram(pDevice, 0x0000, program, sizeof(program));
+
+    EvmuCpu_setExecMode(pDevice->pCpu, seed & 1? EVMU_CPU_EXEC_MODE_BLOCK :
+                                                 EVMU_CPU_EXEC_MODE_INTERPRETER);
+    EvmuCpu_setPc(pDevice->pCpu, 0x0000);
+}
+
+EVMU_RESULT EvmuTestDevice_run(EvmuDevice* pDevice, size_t slices) {
+    for(size_t s = 0; s < slices; ++s) {
+        const EVMU_RESULT result = EvmuIBehavior_update(EVMU_IBEHAVIOR(pDevice), 50000);
+
+        if(!GBL_RESULT_SUCCESS(result))
+            return result;
+    }
+
+    return GBL_RESULT_SUCCESS;
+}
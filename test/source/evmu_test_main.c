@@ -2,6 +2,14 @@
 #include "evmu_memory_test_suite.h"
 #include "evmu_cpu_test_suite.h"
 #include "evmu_isa_test_suite.h"
+#include "evmu_state_test_suite.h"
+#include "evmu_rewind_test_suite.h"
+#include "evmu_journal_test_suite.h"
+#include "evmu_lcd_test_suite.h"
+#include "evmu_emulator_test_suite.h"
+#include "evmu_batch_test_suite.h"
+#include "evmu_profiler_test_suite.h"
+#include "evmu_device_test_suite.h"
 #include <stdlib.h>
 
 #if defined(__DREAMCAST__) && !defined(NDEBUG)
@@ -21,6 +29,22 @@ int main(int argc, char* pArgv[]) {
                                  GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuCpuTestSuite)));
     GblTestScenario_enqueueSuite(pScenario,
                                  GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuIsaTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuStateTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuRewindTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuJournalTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuLcdTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuEmulatorTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuBatchTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuProfilerTestSuite)));
+    GblTestScenario_enqueueSuite(pScenario,
+                                 GBL_TEST_SUITE(GBL_OBJECT_NEW(EvmuDeviceTestSuite)));
 
     const GBL_RESULT result = GblTestScenario_run(pScenario, argc, pArgv);
 